@@ -26,6 +26,20 @@
 #include <spdk/blob.h>
 #include "bio_internal.h"
 
+/* Callbacks for registering DMA chunks as bulk handles */
+static int (*bulk_create_fn)(void *ctxt, d_sg_list_t *sgl, void **bulk_hdl);
+static int (*bulk_free_fn)(void *bulk_hdl);
+
+void
+bio_register_bulk_ops(int (*bulk_create)(void *ctxt, d_sg_list_t *sgl,
+					 void **bulk_hdl),
+		      int (*bulk_free)(void *bulk_hdl))
+{
+	D_ASSERT(bulk_create != NULL && bulk_free != NULL);
+	bulk_create_fn = bulk_create;
+	bulk_free_fn = bulk_free;
+}
+
 static void
 dma_free_chunk(struct bio_dma_chunk *chunk)
 {
@@ -34,6 +48,11 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 	D_ASSERT(chunk->bdc_ref == 0);
 	D_ASSERT(d_list_empty(&chunk->bdc_link));
 
+	if (chunk->bdc_bulk_hdl != NULL) {
+		D_ASSERT(bulk_free_fn != NULL);
+		bulk_free_fn(chunk->bdc_bulk_hdl);
+		chunk->bdc_bulk_hdl = NULL;
+	}
 	spdk_dma_free(chunk->bdc_ptr);
 	D_FREE(chunk);
 }
@@ -136,6 +155,7 @@ dma_buffer_create(unsigned int init_cnt)
 	buf->bdb_cur_chk = NULL;
 	buf->bdb_tot_cnt = 0;
 	buf->bdb_active_iods = 0;
+	buf->bdb_init_cnt = init_cnt;
 
 	rc = ABT_mutex_create(&buf->bdb_mutex);
 	if (rc != ABT_SUCCESS) {
@@ -159,6 +179,47 @@ dma_buffer_create(unsigned int init_cnt)
 	return buf;
 }
 
+/* Interval of adjusting DMA buffer size, in us */
+#define DMA_ADJUST_INTV		(1ULL * 1000 * 1000)
+
+/*
+ * Grow or shrink the DMA buffer by the peak usage observed in last interval:
+ * grow one chunk in advance when the peak usage is above high watermark, and
+ * release one idle chunk when it's below low watermark.
+ */
+void
+dma_buffer_adjust(struct bio_dma_buffer *buf, uint64_t now)
+{
+	unsigned int	peak;
+
+	if (buf->bdb_adjust_age + DMA_ADJUST_INTV >= now)
+		return;
+
+	buf->bdb_adjust_age = now;
+	peak = buf->bdb_used_peak;
+	buf->bdb_used_peak = buf->bdb_used_cnt;
+
+	if (peak * 100 >= buf->bdb_tot_cnt * bio_dma_high_wm) {
+		if (buf->bdb_tot_cnt >= bio_chk_cnt_max)
+			return;
+
+		if (dma_buffer_grow(buf, 1) == 0) {
+			buf->bdb_stats.bds_grows++;
+			D_DEBUG(DB_IO, "Grow DMA buffer to %u chunks, "
+				"peak %u\n", buf->bdb_tot_cnt, peak);
+		}
+	} else if (peak * 100 < buf->bdb_tot_cnt * bio_dma_low_wm) {
+		if (buf->bdb_tot_cnt <= buf->bdb_init_cnt ||
+		    d_list_empty(&buf->bdb_idle_list))
+			return;
+
+		dma_buffer_shrink(buf, 1);
+		buf->bdb_stats.bds_shrinks++;
+		D_DEBUG(DB_IO, "Shrink DMA buffer to %u chunks, peak %u\n",
+			buf->bdb_tot_cnt, peak);
+	}
+}
+
 struct bio_sglist *
 bio_iod_sgl(struct bio_desc *biod, unsigned int idx)
 {
@@ -180,19 +241,15 @@ bio_iod_alloc(struct bio_io_context *ctxt, unsigned int sgl_cnt, bool update)
 	D_ASSERT(ctxt != NULL && ctxt->bic_umem != NULL);
 	D_ASSERT(sgl_cnt != 0);
 
-	D_ALLOC_PTR(biod);
+	/* SG lists are allocated along with the descriptor */
+	D_ALLOC(biod, sizeof(*biod) + sgl_cnt * sizeof(*biod->bd_sgls));
 	if (biod == NULL)
 		return NULL;
 
 	biod->bd_ctxt = ctxt;
 	biod->bd_update = update;
 	biod->bd_sgl_cnt = sgl_cnt;
-
-	D_ALLOC_ARRAY(biod->bd_sgls, sgl_cnt);
-	if (biod->bd_sgls == NULL) {
-		D_FREE(biod);
-		return NULL;
-	}
+	biod->bd_sgls = (struct bio_sglist *)(biod + 1);
 
 	biod->bd_mutex = ABT_MUTEX_NULL;
 	biod->bd_dma_done = ABT_COND_NULL;
@@ -213,7 +270,6 @@ bio_iod_free(struct bio_desc *biod)
 
 	for (i = 0; i < biod->bd_sgl_cnt; i++)
 		bio_sgl_fini(&biod->bd_sgls[i]);
-	D_FREE(biod->bd_sgls);
 	D_FREE(biod);
 }
 
@@ -274,6 +330,8 @@ iod_release_buffer(struct bio_desc *biod)
 			if (chunk == bdb->bdb_cur_chk)
 				bdb->bdb_cur_chk = NULL;
 			d_list_move_tail(&chunk->bdc_link, &bdb->bdb_idle_list);
+			D_ASSERT(bdb->bdb_used_cnt > 0);
+			bdb->bdb_used_cnt--;
 		}
 		rsrvd_dma->brd_dma_chks[i] = NULL;
 	}
@@ -398,6 +456,9 @@ chunk_get_idle(struct bio_dma_buffer *bdb, struct bio_desc *biod)
 	chk = d_list_entry(bdb->bdb_idle_list.next, struct bio_dma_chunk,
 			   bdc_link);
 	d_list_move_tail(&chk->bdc_link, &bdb->bdb_used_list);
+	bdb->bdb_used_cnt++;
+	if (bdb->bdb_used_cnt > bdb->bdb_used_peak)
+		bdb->bdb_used_peak = bdb->bdb_used_cnt;
 
 	return chk;
 }
@@ -527,6 +588,7 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov,
 		}
 		biov->bi_buf = chk->bdc_ptr + pg_off;
 		chk_pg_idx = 0;
+		bdb->bdb_stats.bds_huge_allocs++;
 
 		D_DEBUG(DB_IO, "Huge chunk:%p[%p], cnt:%u, off:%u\n",
 			chk, chk->bdc_ptr, pg_cnt, pg_off);
@@ -626,17 +688,19 @@ add_region:
 	return iod_add_region(biod, chk, chk_pg_idx, off, end);
 }
 
-static void
-rw_completion(void *cb_arg, int err)
+/*
+ * Completion of a blob I/O issued for @biod by the I/O scheduler, @rc is
+ * a DER error code.
+ */
+void
+iod_dma_completion(struct bio_desc *biod, int rc)
 {
-	struct bio_desc *biod = cb_arg;
-
 	ABT_mutex_lock(biod->bd_mutex);
 
 	D_ASSERT(biod->bd_inflights > 0);
 	biod->bd_inflights--;
-	if (biod->bd_result == 0 && err != 0)
-		biod->bd_result = daos_errno2der(-err);
+	if (biod->bd_result == 0 && rc != 0)
+		biod->bd_result = rc;
 
 	if (biod->bd_inflights == 0 && biod->bd_dma_issued)
 		ABT_cond_broadcast(biod->bd_dma_done);
@@ -652,6 +716,7 @@ dma_rw(struct bio_desc *biod, bool prep)
 	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
 	struct bio_rsrvd_region	*rg;
 	struct bio_xs_context	*xs_ctxt;
+	struct bio_io_unit	*unit;
 	uint64_t		 pg_idx, pg_cnt, pg_end;
 	void			*payload, *pg_rmw = NULL;
 	bool			 rmw_read = (prep && biod->bd_update);
@@ -698,14 +763,13 @@ dma_rw(struct bio_desc *biod, bool prep)
 				biod->bd_update ? "Write" : "Read",
 				blob, payload, pg_idx, pg_cnt);
 
-			if (biod->bd_update)
-				spdk_blob_io_write(blob, channel, payload,
-						   pg_idx, pg_cnt,
-						   rw_completion, biod);
-			else
-				spdk_blob_io_read(blob, channel, payload,
-						  pg_idx, pg_cnt,
-						  rw_completion, biod);
+			unit = &rg->brr_unit;
+			unit->biu_biod = biod;
+			unit->biu_blob = blob;
+			unit->biu_payload = payload;
+			unit->biu_pg_idx = pg_idx;
+			unit->biu_pg_cnt = pg_cnt;
+			xs_io_enqueue(xs_ctxt, unit);
 			continue;
 		}
 
@@ -739,6 +803,9 @@ dma_rw(struct bio_desc *biod, bool prep)
 		}
 	}
 
+	if (!rmw_read)
+		xs_io_dispatch(xs_ctxt);
+
 	if (xs_ctxt->bxc_xs_id == -1) {
 		D_DEBUG(DB_IO, "Self poll completion, blob:%p\n", blob);
 		xs_poll_completion(xs_ctxt, &biod->bd_inflights);
@@ -839,11 +906,15 @@ copy_one(struct bio_desc *biod, struct bio_iov *biov,
 }
 
 static void
-dma_drop_iod(struct bio_dma_buffer *bdb)
+dma_drop_iod(struct bio_dma_buffer *bdb, struct bio_desc *biod)
 {
 	D_ASSERT(bdb->bdb_active_iods > 0);
 	bdb->bdb_active_iods--;
 
+	D_ASSERT(bdb->bdb_stats.bds_inflight_bytes >= biod->bd_dma_bytes);
+	bdb->bdb_stats.bds_inflight_bytes -= biod->bd_dma_bytes;
+	biod->bd_dma_bytes = 0;
+
 	ABT_mutex_lock(bdb->bdb_mutex);
 	ABT_cond_broadcast(bdb->bdb_wait_iods);
 	ABT_mutex_unlock(bdb->bdb_mutex);
@@ -853,7 +924,8 @@ int
 bio_iod_prep(struct bio_desc *biod)
 {
 	struct bio_dma_buffer *bdb;
-	int rc, retry_cnt = 0;
+	struct bio_rsrvd_dma *rsrvd_dma = &biod->bd_rsrvd;
+	int i, rc, retry_cnt = 0;
 
 	if (biod->bd_buffer_prep)
 		return -DER_INVAL;
@@ -880,6 +952,7 @@ retry:
 
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n",
 			biod, retry_cnt++);
+		bdb->bdb_stats.bds_chk_waits++;
 
 		ABT_mutex_lock(bdb->bdb_mutex);
 		ABT_cond_wait(bdb->bdb_wait_iods, bdb->bdb_mutex);
@@ -899,6 +972,12 @@ retry:
 	bdb = iod_dma_buf(biod);
 	bdb->bdb_active_iods++;
 
+	biod->bd_dma_bytes = 0;
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++)
+		biod->bd_dma_bytes += rsrvd_dma->brd_regions[i].brr_end -
+				      rsrvd_dma->brd_regions[i].brr_off;
+	bdb->bdb_stats.bds_inflight_bytes += biod->bd_dma_bytes;
+
 	rc = ABT_mutex_create(&biod->bd_mutex);
 	if (rc != ABT_SUCCESS) {
 		rc = -DER_NOMEM;
@@ -920,7 +999,7 @@ retry:
 	return 0;
 failed:
 	iod_release_buffer(biod);
-	dma_drop_iod(bdb);
+	dma_drop_iod(bdb, biod);
 	return rc;
 }
 
@@ -945,7 +1024,7 @@ bio_iod_post(struct bio_desc *biod)
 
 	iod_release_buffer(biod);
 	bdb = iod_dma_buf(biod);
-	dma_drop_iod(bdb);
+	dma_drop_iod(bdb, biod);
 
 	return biod->bd_result;
 }
@@ -966,3 +1045,103 @@ bio_iod_copy(struct bio_desc *biod, d_sg_list_t *sgls, unsigned int nr_sgl)
 
 	return iterate_biov(biod, copy_one, &arg);
 }
+
+/* Register the whole DMA chunk as bulk handle, if it isn't registered yet */
+static void *
+chunk_bulk_hdl(struct bio_dma_chunk *chk, void *ctxt)
+{
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	int		rc;
+
+	if (chk->bdc_bulk_hdl != NULL)
+		return chk->bdc_bulk_hdl;
+
+	d_iov_set(&iov, chk->bdc_ptr, (size_t)bio_chk_sz << BIO_DMA_PAGE_SHIFT);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+
+	rc = bulk_create_fn(ctxt, &sgl, &chk->bdc_bulk_hdl);
+	if (rc) {
+		D_ERROR("Failed to create bulk for chunk:%p[%p] %d\n",
+			chk, chk->bdc_ptr, rc);
+		chk->bdc_bulk_hdl = NULL;
+		return NULL;
+	}
+
+	D_DEBUG(DB_IO, "Created bulk %p for chunk:%p[%p]\n",
+		chk->bdc_bulk_hdl, chk, chk->bdc_ptr);
+	return chk->bdc_bulk_hdl;
+}
+
+/* Find the cacheable DMA chunk where the IOV is mapped */
+static struct bio_dma_chunk *
+iod_iov_chunk(struct bio_desc *biod, unsigned int sgl_idx,
+	      unsigned int iov_idx, struct bio_iov **biovp)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_sglist	*bsgl;
+	struct bio_iov		*biov;
+	size_t			 chk_bytes;
+	int			 i;
+
+	D_ASSERT(biod->bd_buffer_prep);
+	if (bulk_create_fn == NULL)
+		return NULL;
+
+	bsgl = bio_iod_sgl(biod, sgl_idx);
+	D_ASSERT(iov_idx < bsgl->bs_nr_out);
+	biov = &bsgl->bs_iovs[iov_idx];
+
+	if (biov->bi_buf == NULL || biov->bi_addr.ba_type != DAOS_MEDIA_NVME)
+		return NULL;
+
+	chk_bytes = (size_t)bio_chk_sz << BIO_DMA_PAGE_SHIFT;
+	for (i = 0; i < rsrvd_dma->brd_chk_cnt; i++) {
+		struct bio_dma_chunk *chk = rsrvd_dma->brd_dma_chks[i];
+
+		if (biov->bi_buf < chk->bdc_ptr ||
+		    biov->bi_buf >= chk->bdc_ptr + chk_bytes)
+			continue;
+
+		/* Huge chunk is freed on I/O completion, don't cache it */
+		if (dma_chunk_is_huge(chk))
+			return NULL;
+
+		D_ASSERT(biov->bi_buf + biov->bi_data_len <=
+			 chk->bdc_ptr + chk_bytes);
+		*biovp = biov;
+		return chk;
+	}
+
+	return NULL;
+}
+
+void *
+bio_iod_bulk(struct bio_desc *biod, void *ctxt, unsigned int sgl_idx,
+	     unsigned int iov_idx, uint64_t *bulk_off)
+{
+	struct bio_dma_chunk	*chk;
+	struct bio_iov		*biov;
+	void			*bulk_hdl;
+
+	chk = iod_iov_chunk(biod, sgl_idx, iov_idx, &biov);
+	if (chk == NULL)
+		return NULL;
+
+	bulk_hdl = ctxt != NULL ? chunk_bulk_hdl(chk, ctxt) :
+				  chk->bdc_bulk_hdl;
+	if (bulk_hdl != NULL)
+		*bulk_off = biov->bi_buf - chk->bdc_ptr;
+	return bulk_hdl;
+}
+
+bool
+bio_iod_bulk_cacheable(struct bio_desc *biod, unsigned int sgl_idx,
+		       unsigned int iov_idx)
+{
+	struct bio_iov	*biov;
+
+	return iod_iov_chunk(biod, sgl_idx, iov_idx, &biov) != NULL;
+}
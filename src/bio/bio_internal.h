@@ -40,6 +40,21 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_pg_idx;
 	/* Being used by how many I/O descriptors */
 	unsigned int	 bdc_ref;
+	/* Bulk handle registered on the whole chunk, created on demand */
+	void		*bdc_bulk_hdl;
+};
+
+/* Usage statistics of per-xstream DMA buffer */
+struct bio_dma_stats {
+	/* How many times IODs waited for DMA chunks */
+	uint64_t		 bds_chk_waits;
+	/* How many huge chunks allocated for huge IOVs */
+	uint64_t		 bds_huge_allocs;
+	/* How many chunks grown/shrunk by watermarks */
+	uint64_t		 bds_grows;
+	uint64_t		 bds_shrinks;
+	/* Bytes mapped by the active IODs */
+	uint64_t		 bds_inflight_bytes;
 };
 
 /*
@@ -54,6 +69,14 @@ struct bio_dma_buffer {
 	unsigned int		 bdb_active_iods;
 	ABT_cond		 bdb_wait_iods;
 	ABT_mutex		 bdb_mutex;
+	/* Chunks on used list, and the peak of it in current period */
+	unsigned int		 bdb_used_cnt;
+	unsigned int		 bdb_used_peak;
+	/* The buffer never shrinks below the initial size */
+	unsigned int		 bdb_init_cnt;
+	/* Last time the buffer size was adjusted, in us */
+	uint64_t		 bdb_adjust_age;
+	struct bio_dma_stats	 bdb_stats;
 };
 
 /*
@@ -67,6 +90,33 @@ struct bio_blobstore {
 	int			 bb_ref;
 };
 
+/* Blob I/O of a DMA region queued on the per-xstream I/O scheduler */
+struct bio_io_unit {
+	d_list_t		 biu_link;
+	struct bio_desc		*biu_biod;
+	struct spdk_blob	*biu_blob;
+	void			*biu_payload;
+	uint64_t		 biu_pg_idx;
+	uint64_t		 biu_pg_cnt;
+};
+
+/*
+ * Per-xstream NVMe I/O scheduler, it merges the queued blob I/Os contiguous
+ * in blob offset into one NVMe command, caps the in-flight commands, and
+ * serves reads before writes.
+ */
+struct bio_io_sched {
+	d_list_t		 bis_read_q;
+	d_list_t		 bis_write_q;
+	unsigned int		 bis_queued;
+	unsigned int		 bis_inflights;
+	unsigned int		 bis_write_inflights;
+	/* Submitted NVMe commands */
+	uint64_t		 bis_cmds;
+	/* I/O units merged into other commands */
+	uint64_t		 bis_merged;
+};
+
 /* Per-xstream NVMe context */
 struct bio_xs_context {
 	int			 bxc_xs_id;
@@ -78,6 +128,7 @@ struct bio_xs_context {
 	struct bio_dma_buffer	*bxc_dma_buf;
 	struct spdk_bdev_desc	*bxc_desc; /* for io stat only */
 	uint64_t		 bxc_stat_age;
+	struct bio_io_sched	 bxc_io_sched;
 };
 
 /* Per VOS instance I/O context */
@@ -98,6 +149,8 @@ struct bio_rsrvd_region {
 	uint64_t		 brr_off;
 	/* End (not included) in bytes */
 	uint64_t		 brr_end;
+	/* Blob I/O of the region queued to the I/O scheduler */
+	struct bio_io_unit	 brr_unit;
 };
 
 /* Reserved DMA buffer for certain io descriptor */
@@ -133,6 +186,8 @@ struct bio_desc {
 	/* Inflight SPDK DMA transfers */
 	unsigned int		 bd_inflights;
 	int			 bd_result;
+	/* Bytes of DMA buffer mapped by this io descriptor */
+	uint64_t		 bd_dma_bytes;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_update:1,
@@ -143,12 +198,18 @@ struct bio_desc {
 /* bio_xstream.c */
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
+extern unsigned int	bio_dma_high_wm;
+extern unsigned int	bio_dma_low_wm;
 void xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights);
+void xs_io_enqueue(struct bio_xs_context *ctxt, struct bio_io_unit *unit);
+void xs_io_dispatch(struct bio_xs_context *ctxt);
 
 /* bio_buffer.c */
 void dma_buffer_destroy(struct bio_dma_buffer *buf);
 struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt);
+void dma_buffer_adjust(struct bio_dma_buffer *buf, uint64_t now);
 void bio_memcpy(struct bio_desc *biod, uint16_t media, void *media_addr,
 		void *addr, ssize_t n);
+void iod_dma_completion(struct bio_desc *biod, int rc);
 
 #endif /* __BIO_INTERNAL_H__ */
@@ -46,6 +46,12 @@
 #define DAOS_DMA_CHUNK_MB	32		/* 32MB DMA chunks */
 #define DAOS_DMA_CHUNK_CNT_INIT	2		/* Per-xstream init chunks */
 #define DAOS_DMA_CHUNK_CNT_MAX	32		/* Per-xstream max chunks */
+#define DAOS_DMA_HIGH_WM	75		/* Grow above 75% usage */
+#define DAOS_DMA_LOW_WM		25		/* Shrink below 25% usage */
+/* NVMe I/O scheduler parameters */
+#define DAOS_NVME_QD_MAX	64		/* Per-xstream in-flight cmds */
+#define DAOS_NVME_MERGE_PGS	256		/* 1MB max merged cmd */
+#define DAOS_NVME_MERGE_IOVS	16		/* Max IOVs of merged cmd */
 
 enum {
 	BDEV_CLASS_NVME = 0,
@@ -60,6 +66,19 @@ unsigned int bio_chk_sz;
 unsigned int bio_chk_cnt_max;
 /* Per-xstream initial DMA buffer size (in chunk count) */
 static unsigned int bio_chk_cnt_init;
+/* Watermarks (percentage of DMA buffer in use) to grow/shrink DMA buffer */
+unsigned int bio_dma_high_wm;
+unsigned int bio_dma_low_wm;
+/* Per-xstream maximum in-flight NVMe commands */
+static unsigned int bio_nvme_qd_max;
+/* Callback to trace the latency of NVMe commands */
+static void (*io_trace_fn)(uint64_t start);
+
+void
+bio_register_io_trace(void (*io_trace)(uint64_t start))
+{
+	io_trace_fn = io_trace;
+}
 
 struct bio_bdev {
 	d_list_t		 bb_link;
@@ -121,6 +140,25 @@ print_io_stat(struct bio_xs_context *ctxt, uint64_t now)
 			stat.write_latency_ticks);
 	}
 
+	if (ctxt->bxc_dma_buf != NULL) {
+		struct bio_dma_buffer	*bdb = ctxt->bxc_dma_buf;
+		struct bio_dma_stats	*bds = &bdb->bdb_stats;
+
+		D_PRINT("DMA BUF STAT: xs_id[%d] chunks[%u], used_chunks[%u], "
+			"active_iods[%u], inflight_bytes["DF_U64"], "
+			"chunk_waits["DF_U64"], huge_allocs["DF_U64"], "
+			"grows["DF_U64"], shrinks["DF_U64"]\n",
+			ctxt->bxc_xs_id, bdb->bdb_tot_cnt, bdb->bdb_used_cnt,
+			bdb->bdb_active_iods, bds->bds_inflight_bytes,
+			bds->bds_chk_waits, bds->bds_huge_allocs,
+			bds->bds_grows, bds->bds_shrinks);
+	}
+
+	D_PRINT("IO SCHED STAT: xs_id[%d] queued[%u], inflights[%u], "
+		"cmds["DF_U64"], merged["DF_U64"]\n", ctxt->bxc_xs_id,
+		ctxt->bxc_io_sched.bis_queued, ctxt->bxc_io_sched.bis_inflights,
+		ctxt->bxc_io_sched.bis_cmds, ctxt->bxc_io_sched.bis_merged);
+
 	ctxt->bxc_stat_age = now;
 }
 
@@ -190,6 +228,23 @@ bio_nvme_init(const char *storage_path, const char *nvme_conf, int shm_id)
 
 	bio_chk_sz = (size_mb << 20) >> BIO_DMA_PAGE_SHIFT;
 
+	bio_dma_high_wm = DAOS_DMA_HIGH_WM;
+	bio_dma_low_wm = DAOS_DMA_LOW_WM;
+	d_getenv_int("DAOS_DMA_HIGH_WM", &bio_dma_high_wm);
+	d_getenv_int("DAOS_DMA_LOW_WM", &bio_dma_low_wm);
+	if (bio_dma_high_wm > 100 || bio_dma_low_wm >= bio_dma_high_wm) {
+		D_WARN("Invalid DMA watermarks %u/%u, use default %u/%u\n",
+		       bio_dma_high_wm, bio_dma_low_wm, DAOS_DMA_HIGH_WM,
+		       DAOS_DMA_LOW_WM);
+		bio_dma_high_wm = DAOS_DMA_HIGH_WM;
+		bio_dma_low_wm = DAOS_DMA_LOW_WM;
+	}
+
+	bio_nvme_qd_max = DAOS_NVME_QD_MAX;
+	d_getenv_int("DAOS_NVME_QD", &bio_nvme_qd_max);
+	if (bio_nvme_qd_max == 0)
+		bio_nvme_qd_max = DAOS_NVME_QD_MAX;
+
 	env = getenv("IO_STAT_PERIOD");
 	io_stat_period = env ? atoi(env) : 0;
 	io_stat_period *= (NSEC_PER_SEC / NSEC_PER_USEC);
@@ -340,11 +395,23 @@ bio_nvme_poll(struct bio_xs_context *ctxt)
 			poller->bnp_expire_us = now + poller->bnp_period_us;
 	}
 
+	if (ctxt->bxc_dma_buf != NULL)
+		dma_buffer_adjust(ctxt->bxc_dma_buf, now);
 	print_io_stat(ctxt, now);
 
 	return count;
 }
 
+bool
+bio_nvme_busy(struct bio_xs_context *ctxt)
+{
+	if (ctxt == NULL)
+		return false;
+
+	return ctxt->bxc_io_sched.bis_queued != 0 ||
+	       ctxt->bxc_io_sched.bis_inflights != 0;
+}
+
 struct common_cp_arg {
 	unsigned int		 cca_inflights;
 	int			 cca_rc;
@@ -391,6 +458,200 @@ common_bs_cb(void *arg, struct spdk_blob_store *bs, int rc)
 	cp_arg->cca_bs = bs;
 }
 
+/* NVMe command merged from the queued I/O units */
+struct bio_io_cmd {
+	d_list_t		 bcm_units;
+	struct bio_xs_context	*bcm_xs_ctxt;
+	struct iovec		 bcm_iovs[DAOS_NVME_MERGE_IOVS];
+	int			 bcm_iov_cnt;
+	bool			 bcm_write;
+	/* Submit time in ns, only set when tracing */
+	uint64_t		 bcm_submit;
+};
+
+void
+xs_io_enqueue(struct bio_xs_context *ctxt, struct bio_io_unit *unit)
+{
+	struct bio_io_sched	*sched = &ctxt->bxc_io_sched;
+
+	D_ASSERT(unit->biu_pg_cnt > 0);
+	if (unit->biu_biod->bd_update)
+		d_list_add_tail(&unit->biu_link, &sched->bis_write_q);
+	else
+		d_list_add_tail(&unit->biu_link, &sched->bis_read_q);
+	sched->bis_queued++;
+}
+
+static void
+xs_io_cmd_complete(void *cb_arg, int err)
+{
+	struct bio_io_cmd	*cmd = cb_arg;
+	struct bio_xs_context	*ctxt = cmd->bcm_xs_ctxt;
+	struct bio_io_sched	*sched = &ctxt->bxc_io_sched;
+	struct bio_io_unit	*unit, *tmp;
+	int			 rc;
+
+	if (io_trace_fn != NULL)
+		io_trace_fn(cmd->bcm_submit);
+
+	rc = err ? daos_errno2der(-err) : 0;
+	d_list_for_each_entry_safe(unit, tmp, &cmd->bcm_units, biu_link) {
+		d_list_del_init(&unit->biu_link);
+		iod_dma_completion(unit->biu_biod, rc);
+	}
+
+	D_ASSERT(sched->bis_inflights > 0);
+	sched->bis_inflights--;
+	if (cmd->bcm_write) {
+		D_ASSERT(sched->bis_write_inflights > 0);
+		sched->bis_write_inflights--;
+	}
+	D_FREE(cmd);
+
+	xs_io_dispatch(ctxt);
+}
+
+/*
+ * Reads are served before writes, except that one write is always allowed
+ * in flight, so writes won't be starved by sustained reads.
+ */
+static d_list_t *
+xs_io_pick_queue(struct bio_io_sched *sched)
+{
+	if (!d_list_empty(&sched->bis_read_q) &&
+	    (d_list_empty(&sched->bis_write_q) ||
+	     sched->bis_write_inflights != 0))
+		return &sched->bis_read_q;
+
+	if (!d_list_empty(&sched->bis_write_q))
+		return &sched->bis_write_q;
+
+	return NULL;
+}
+
+/* Merge the queued units contiguous in blob offset into the command */
+static uint64_t
+xs_io_merge(struct bio_io_sched *sched, struct bio_io_cmd *cmd, d_list_t *q,
+	    struct spdk_blob *blob, uint64_t pg_idx, uint64_t pg_cnt)
+{
+	struct bio_io_unit	*unit, *tmp;
+	struct iovec		*iov;
+	bool			 merged;
+
+	do {
+		merged = false;
+		d_list_for_each_entry_safe(unit, tmp, q, biu_link) {
+			if (pg_cnt >= DAOS_NVME_MERGE_PGS)
+				return pg_cnt;
+
+			if (unit->biu_blob != blob ||
+			    unit->biu_pg_idx != pg_idx + pg_cnt ||
+			    pg_cnt + unit->biu_pg_cnt > DAOS_NVME_MERGE_PGS)
+				continue;
+
+			iov = &cmd->bcm_iovs[cmd->bcm_iov_cnt - 1];
+			if (iov->iov_base + iov->iov_len == unit->biu_payload) {
+				iov->iov_len += unit->biu_pg_cnt <<
+						BIO_DMA_PAGE_SHIFT;
+			} else if (cmd->bcm_iov_cnt < DAOS_NVME_MERGE_IOVS) {
+				iov++;
+				iov->iov_base = unit->biu_payload;
+				iov->iov_len = unit->biu_pg_cnt <<
+						BIO_DMA_PAGE_SHIFT;
+				cmd->bcm_iov_cnt++;
+			} else {
+				continue;
+			}
+
+			d_list_move_tail(&unit->biu_link, &cmd->bcm_units);
+			D_ASSERT(sched->bis_queued > 0);
+			sched->bis_queued--;
+			sched->bis_merged++;
+			pg_cnt += unit->biu_pg_cnt;
+			merged = true;
+		}
+	} while (merged);
+
+	return pg_cnt;
+}
+
+/* Submit the queued I/O units until reaching the queue depth limit */
+void
+xs_io_dispatch(struct bio_xs_context *ctxt)
+{
+	struct bio_io_sched	*sched = &ctxt->bxc_io_sched;
+	struct spdk_io_channel	*channel = ctxt->bxc_io_channel;
+	struct bio_io_unit	*unit;
+	struct bio_io_cmd	*cmd;
+	struct spdk_blob	*blob;
+	uint64_t		 pg_idx, pg_cnt;
+	d_list_t		*q;
+
+	while (sched->bis_inflights < bio_nvme_qd_max) {
+		q = xs_io_pick_queue(sched);
+		if (q == NULL)
+			break;
+
+		unit = d_list_entry(q->next, struct bio_io_unit, biu_link);
+		D_ALLOC_PTR(cmd);
+		if (cmd == NULL) {
+			/* Retry on the completion of in-flight commands */
+			if (sched->bis_inflights != 0)
+				break;
+
+			d_list_del_init(&unit->biu_link);
+			sched->bis_queued--;
+			iod_dma_completion(unit->biu_biod, -DER_NOMEM);
+			continue;
+		}
+
+		D_INIT_LIST_HEAD(&cmd->bcm_units);
+		cmd->bcm_xs_ctxt = ctxt;
+		cmd->bcm_write = (q == &sched->bis_write_q);
+
+		d_list_move_tail(&unit->biu_link, &cmd->bcm_units);
+		D_ASSERT(sched->bis_queued > 0);
+		sched->bis_queued--;
+
+		blob = unit->biu_blob;
+		pg_idx = unit->biu_pg_idx;
+		cmd->bcm_iovs[0].iov_base = unit->biu_payload;
+		cmd->bcm_iovs[0].iov_len = unit->biu_pg_cnt <<
+						BIO_DMA_PAGE_SHIFT;
+		cmd->bcm_iov_cnt = 1;
+		pg_cnt = xs_io_merge(sched, cmd, q, blob, pg_idx,
+				     unit->biu_pg_cnt);
+
+		sched->bis_inflights++;
+		if (cmd->bcm_write)
+			sched->bis_write_inflights++;
+		sched->bis_cmds++;
+		if (io_trace_fn != NULL)
+			cmd->bcm_submit = daos_get_ntime();
+
+		D_DEBUG(DB_IO, "%s blob:%p pg_idx:"DF_U64", pg_cnt:"DF_U64", "
+			"iovs:%d\n", cmd->bcm_write ? "Write" : "Read", blob,
+			pg_idx, pg_cnt, cmd->bcm_iov_cnt);
+
+		if (cmd->bcm_iov_cnt == 1 && cmd->bcm_write)
+			spdk_blob_io_write(blob, channel,
+					   cmd->bcm_iovs[0].iov_base, pg_idx,
+					   pg_cnt, xs_io_cmd_complete, cmd);
+		else if (cmd->bcm_iov_cnt == 1)
+			spdk_blob_io_read(blob, channel,
+					  cmd->bcm_iovs[0].iov_base, pg_idx,
+					  pg_cnt, xs_io_cmd_complete, cmd);
+		else if (cmd->bcm_write)
+			spdk_blob_io_writev(blob, channel, cmd->bcm_iovs,
+					    cmd->bcm_iov_cnt, pg_idx, pg_cnt,
+					    xs_io_cmd_complete, cmd);
+		else
+			spdk_blob_io_readv(blob, channel, cmd->bcm_iovs,
+					   cmd->bcm_iov_cnt, pg_idx, pg_cnt,
+					   xs_io_cmd_complete, cmd);
+	}
+}
+
 void
 xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights)
 {
@@ -818,6 +1079,9 @@ bio_xsctxt_free(struct bio_xs_context *ctxt)
 	if (ctxt == NULL)
 		return;
 
+	D_ASSERT(ctxt->bxc_io_sched.bis_queued == 0);
+	D_ASSERT(ctxt->bxc_io_sched.bis_inflights == 0);
+
 	if (ctxt->bxc_io_channel != NULL) {
 		spdk_bs_free_io_channel(ctxt->bxc_io_channel);
 		ctxt->bxc_io_channel = NULL;
@@ -906,6 +1170,8 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int xs_id)
 		return -DER_NOMEM;
 
 	D_INIT_LIST_HEAD(&ctxt->bxc_pollers);
+	D_INIT_LIST_HEAD(&ctxt->bxc_io_sched.bis_read_q);
+	D_INIT_LIST_HEAD(&ctxt->bxc_io_sched.bis_write_q);
 	ctxt->bxc_xs_id = xs_id;
 
 	ABT_mutex_lock(nvme_glb.bd_mutex);
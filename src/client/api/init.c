@@ -110,6 +110,7 @@ const struct daos_task_api dc_funcs[] = {
 	{dac_kv_list, sizeof(daos_kv_list_t)},
 	{dac_obj_fetch_multi, sizeof(daos_obj_multi_io_t)},
 	{dac_obj_update_multi, sizeof(daos_obj_multi_io_t)},
+	[DAOS_OPC_OBJ_FLUSH] = {dc_obj_flush, sizeof(daos_obj_flush_t)},
 };
 
 /**
@@ -78,6 +78,19 @@ daos_obj_close(daos_handle_t oh, daos_event_t *ev)
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_obj_flush(daos_handle_t oh, daos_event_t *ev)
+{
+	tse_task_t	*task;
+	int		rc;
+
+	rc = dc_obj_flush_task_create(oh, ev, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_obj_punch(daos_handle_t oh, daos_handle_t th, daos_event_t *ev)
 {
@@ -1978,6 +1978,277 @@ dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 	return btr_tx_end(tcx, rc);
 }
 
+/** A subtree built by bulk loading, and the leftmost leaf of it */
+struct btr_bulk_child {
+	umem_off_t	bc_node;
+	umem_off_t	bc_leaf;
+};
+
+/**
+ * Check if \a key (whose hkey has been generated in \a rec) is strictly
+ * larger than the previously loaded record \a prev.
+ */
+static bool
+btr_bulk_key_ascend(struct btr_context *tcx, struct btr_record *prev,
+		    struct btr_record *rec, d_iov_t *key)
+{
+	int	cmp;
+
+	if (btr_is_direct_key(tcx)) {
+		cmp = btr_key_cmp(tcx, prev, key);
+	} else {
+		cmp = btr_hkey_cmp(tcx, prev, &rec->rec_hkey[0]);
+		if (cmp == BTR_CMP_EQ && btr_has_collision(tcx))
+			cmp = btr_key_cmp(tcx, prev, key);
+	}
+	return (cmp & (BTR_CMP_LT | BTR_CMP_GT | BTR_CMP_ERR)) == BTR_CMP_LT;
+}
+
+/** Release subtrees in \a child[start, end) of an unfinished bulk load */
+static void
+btr_bulk_free(struct btr_context *tcx, struct btr_bulk_child *child,
+	      int start, int end)
+{
+	int	i;
+
+	for (i = start; i < end; i++) {
+		umem_off_t	nd_off = child[i].bc_node;
+		bool		leaf = btr_node_is_leaf(tcx, nd_off);
+
+		btr_node_destroy(tcx, nd_off, NULL);
+		if (leaf) /* btr_node_destroy() only releases records of leaf */
+			btr_node_free(tcx, nd_off);
+	}
+}
+
+/**
+ * Pack as many records as possible from \a keys and \a vals into new leaves,
+ * records are consumed until the first one which is not in tree order.
+ *
+ * \param leaves	[OUT]	Allocated leaves.
+ * \param leaf_nr	[OUT]	Number of allocated leaves.
+ *
+ * \return		number of consumed records, or negative error code.
+ */
+static int
+btr_bulk_load_leaves(struct btr_context *tcx, d_iov_t *keys, d_iov_t *vals,
+		     int nr, struct btr_bulk_child *leaves, int *leaf_nr)
+{
+	struct btr_node		*nd = NULL;
+	struct btr_record	*prev = NULL;
+	struct btr_record	*rec;
+	union btr_rec_buf	 rec_buf;
+	umem_off_t		 nd_off = BTR_NODE_NULL;
+	int			 i;
+	int			 rc;
+
+	*leaf_nr = 0;
+	for (i = 0; i < nr; i++) {
+		rec = &rec_buf.rb_rec;
+		btr_hkey_gen(tcx, &keys[i], &rec->rec_hkey[0]);
+		if (prev != NULL &&
+		    !btr_bulk_key_ascend(tcx, prev, rec, &keys[i])) {
+			D_DEBUG(DB_TRACE, "Record %d is out of order, stop "
+				"bulk loading\n", i);
+			break;
+		}
+
+		if (nd == NULL || nd->tn_keyn == tcx->tc_order - 1) {
+			rc = btr_node_alloc(tcx, &nd_off);
+			if (rc != 0)
+				goto failed;
+
+			btr_node_set(tcx, nd_off, BTR_NODE_LEAF);
+			nd = btr_off2ptr(tcx, nd_off);
+			leaves[*leaf_nr].bc_node = nd_off;
+			leaves[*leaf_nr].bc_leaf = nd_off;
+			(*leaf_nr)++;
+		}
+
+		rc = btr_rec_alloc(tcx, &keys[i], &vals[i], rec);
+		if (rc != 0) {
+			D_DEBUG(DB_TRACE, "Failed to create new record: %d\n",
+				rc);
+			goto failed;
+		}
+
+		prev = btr_node_rec_at(tcx, nd_off, nd->tn_keyn);
+		btr_rec_copy(tcx, prev, rec, 1);
+		nd->tn_keyn++;
+	}
+	return i;
+ failed:
+	btr_bulk_free(tcx, leaves, 0, *leaf_nr);
+	*leaf_nr = 0;
+	return rc;
+}
+
+/**
+ * Build one level of non-leaf nodes on top of \a nr subtrees in \a child,
+ * children are evenly distributed over the minimum number of nodes. The new
+ * nodes are stored in the head of \a child.
+ *
+ * \return		number of nodes of the new level, or negative error
+ *			code.
+ */
+static int
+btr_bulk_load_level(struct btr_context *tcx, struct btr_bulk_child *child,
+		    int nr)
+{
+	struct btr_node		*nd;
+	struct btr_record	*rec;
+	struct btr_bulk_child	 parent;
+	umem_off_t		 nd_off;
+	int			 nd_nr;
+	int			 cnt;
+	int			 i;
+	int			 j;
+	int			 k;
+	int			 rc;
+
+	nd_nr = (nr + tcx->tc_order - 1) / tcx->tc_order;
+	for (i = j = 0; i < nd_nr; i++, j += cnt) {
+		cnt = nr / nd_nr + (i < nr % nd_nr);
+		D_ASSERT(cnt >= 2 && cnt <= tcx->tc_order);
+
+		rc = btr_node_alloc(tcx, &nd_off);
+		if (rc != 0) {
+			btr_bulk_free(tcx, child, 0, i);
+			btr_bulk_free(tcx, child, j, nr);
+			return rc;
+		}
+
+		nd = btr_off2ptr(tcx, nd_off);
+		nd->tn_child = child[j].bc_node;
+		nd->tn_keyn  = cnt - 1;
+		for (k = 1; k < cnt; k++) {
+			/* the first key of the leftmost leaf bubbles up */
+			rec = btr_node_rec_at(tcx, nd_off, k - 1);
+			if (btr_is_direct_key(tcx)) {
+				rec->rec_node[0] = child[j + k].bc_leaf;
+			} else {
+				btr_rec_copy_hkey(tcx, rec,
+					btr_node_rec_at(tcx,
+							child[j + k].bc_leaf,
+							0));
+			}
+			rec->rec_off = child[j + k].bc_node;
+		}
+
+		/* NB: i <= j, child[j] has been consumed */
+		parent.bc_node = nd_off;
+		parent.bc_leaf = child[j].bc_leaf;
+		child[i] = parent;
+	}
+	return nd_nr;
+}
+
+/**
+ * Build an empty tree bottom-up from sorted records, see dbtree_bulk_load.
+ */
+static int
+btr_bulk_load(struct btr_context *tcx, d_iov_t *keys, d_iov_t *vals, int nr)
+{
+	struct btr_root		*root = tcx->tc_tins.ti_root;
+	struct btr_bulk_child	*child;
+	int			 child_nr;
+	int			 loaded;
+	int			 depth;
+	int			 i;
+	int			 rc;
+
+	D_ASSERT(btr_root_empty(tcx));
+
+	if (btr_has_tx(tcx)) {
+		rc = btr_root_tx_add(tcx);
+		if (rc != 0)
+			return rc;
+	}
+	/* nodes are packed, no reason to start from a small root */
+	root->tr_node_size = tcx->tc_order;
+
+	D_ALLOC_ARRAY(child, nr / (tcx->tc_order - 1) + 1);
+	if (child == NULL)
+		return -DER_NOMEM;
+
+	loaded = btr_bulk_load_leaves(tcx, keys, vals, nr, child, &child_nr);
+	if (loaded < 0)
+		D_GOTO(out, rc = loaded);
+
+	for (depth = 1; child_nr > 1; depth++) {
+		child_nr = btr_bulk_load_level(tcx, child, child_nr);
+		if (child_nr < 0)
+			D_GOTO(out, rc = child_nr);
+	}
+
+	btr_node_set(tcx, child[0].bc_node, BTR_NODE_ROOT);
+	root->tr_node  = child[0].bc_node;
+	root->tr_depth = depth;
+	btr_context_set_depth(tcx, depth);
+
+	D_DEBUG(DB_TRACE, "Bulk loaded %d of %d records, depth %d\n",
+		loaded, nr, depth);
+
+	/* the rest are not in tree order, insert them one by one */
+	for (i = loaded, rc = 0; i < nr && rc == 0; i++)
+		rc = btr_upsert(tcx, BTR_PROBE_EQ, DAOS_INTENT_UPDATE,
+				&keys[i], &vals[i]);
+ out:
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN;
+	D_FREE(child);
+	return rc;
+}
+
+/**
+ * Bulk load records into an empty tree.
+ *
+ * Instead of inserting records one by one, leaves are packed with the sorted
+ * records and the tree is built bottom-up, all in one transaction. It can
+ * significantly reduce node splits and undo logs for building a new tree.
+ *
+ * Records should be sorted in the order of the tree (hashed key order for
+ * trees with hashed keys) without duplicates. Records from the first one
+ * not in tree order, or all records if the tree is not empty, are
+ * upserted one by one.
+ *
+ * \param toh		[IN]	Tree open handle.
+ * \param keys		[IN]	Array of keys.
+ * \param vals		[IN]	Array of values.
+ * \param nr		[IN]	Number of records.
+ *
+ * \return		0	success
+ *			-ve	error code
+ */
+int
+dbtree_bulk_load(daos_handle_t toh, d_iov_t *keys, d_iov_t *vals,
+		 unsigned int nr)
+{
+	struct btr_context *tcx;
+	int		    i;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (nr == 0)
+		return 0;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	if (btr_root_empty(tcx)) {
+		rc = btr_bulk_load(tcx, keys, vals, nr);
+	} else {
+		for (i = 0; i < nr && rc == 0; i++)
+			rc = btr_upsert(tcx, BTR_PROBE_EQ, DAOS_INTENT_UPDATE,
+					&keys[i], &vals[i]);
+	}
+
+	return btr_tx_end(tcx, rc);
+}
+
 /**
  * Delete the leaf record pointed by @cur_tr from the current node, then fill
  * the deletion gap by shifting remainded records on the specified direction.
@@ -39,8 +39,26 @@ static struct daos_csum_entry	csum_dict[] = {
 		.cs_name	= "crc64",
 		.cs_size	= sizeof(uint64_t),
 	},
+	[DAOS_CS_ADLER32] = {
+		.cs_name	= "adler32",
+		.cs_size	= sizeof(uint32_t),
+	},
 };
 
+/**
+ * Set the initial value of the running checksum, adler32 starts from 1
+ * while the CRCs start from 0.
+ */
+static inline void
+daos_csum_seed(daos_csum_t *cs_obj)
+{
+	memset(cs_obj->dc_buf, 0, DAOS_CSUM_SIZE);
+#if defined(__x86_64__)
+	if (cs_obj->dc_csum == DAOS_CS_ADLER32)
+		*(uint32_t *)cs_obj->dc_buf = 1;
+#endif
+}
+
 /**
  * This function converts checksum name to csum_type
  */
@@ -60,6 +78,12 @@ daos_name_to_type(const char *cs_name)
 	return DAOS_CS_UNKNOWN;
 }
 
+/** Name of checksum \a type (DAOS_CS_*), NULL if the type is unknown */
+const char *
+daos_csum_type2name(unsigned int type)
+{
+	return type < DAOS_CS_MAX ? csum_dict[type].cs_name : NULL;
+}
 
 /**
  * This function initializes a checksum and
@@ -88,7 +112,7 @@ daos_csum_init(const char *cs_name, daos_csum_t *cs_obj)
 	}
 #endif
 	cs_obj->dc_init = 1;
-	memset(cs_obj->dc_buf, 0, DAOS_CSUM_SIZE);
+	daos_csum_seed(cs_obj);
 	D_DEBUG(DB_IO, "Initialize checksum=%s\n", dict->cs_name);
 	return 0;
 }
@@ -99,7 +123,7 @@ daos_csum_reset(daos_csum_t *cs_obj)
 	if (!cs_obj->dc_init)
 		return -DER_UNINIT;
 #if defined(__x86_64__)
-	memset(cs_obj->dc_buf, 0, DAOS_CSUM_SIZE);
+	daos_csum_seed(cs_obj);
 #else
 	int  rc;
 
@@ -145,8 +169,8 @@ daos_csum_get(daos_csum_t *csum, daos_csum_buf_t *csum_buf)
 
 	return 0;
 #else
-	return mchecksum_get(csum, csum_buf->cs_csum, csum_buf->cs_buf_len,
-			     MCHECKSUM_FINALIZE);
+	return mchecksum_get(csum->dc_csum, csum_buf->cs_csum,
+			     csum_buf->cs_buf_len, MCHECKSUM_FINALIZE);
 #endif
 }
 inline int
@@ -169,6 +193,38 @@ daos_csum_compare(daos_csum_t *csum, daos_csum_t *csum_src)
 #endif
 }
 
+/**
+ * Compare the checksum accumulated in \a csum with the one stored in
+ * \a csum_buf, returns -DER_IO on mismatch.
+ */
+int
+daos_csum_verify(daos_csum_t *csum, daos_csum_buf_t *csum_buf)
+{
+	daos_csum_buf_t	result;
+	uint8_t		buf[DAOS_CSUM_SIZE];
+	daos_size_t	size;
+	int		rc;
+
+	size = daos_csum_get_size(csum);
+	if (csum_buf->cs_len != size) {
+		D_ERROR("Checksum length mismatch: %u/"DF_U64"\n",
+			csum_buf->cs_len, size);
+		return -DER_INVAL;
+	}
+
+	result.cs_csum = buf;
+	result.cs_len = result.cs_buf_len = size;
+	rc = daos_csum_get(csum, &result);
+	if (rc != 0)
+		return rc;
+
+	if (memcmp(buf, csum_buf->cs_csum, size) != 0) {
+		D_ERROR("Checksum mismatch\n");
+		return -DER_IO;
+	}
+	return 0;
+}
+
 static int
 daos_csum_update(daos_csum_t *csum, const void *buf,
 		 uint64_t len)
@@ -195,6 +251,16 @@ daos_csum_update(daos_csum_t *csum, const void *buf,
 					 *cur_crc32);
 		break;
 	}
+	case DAOS_CS_ADLER32:
+	{
+		uint32_t *cur_adler32;
+
+		cur_adler32 = (uint32_t *)csum->dc_buf;
+		*cur_adler32 = isal_adler32(*cur_adler32,
+					    (const unsigned char *)buf,
+					    len);
+		break;
+	}
 	default:
 		D_ERROR("Unknown checksum type\n");
 		return -DER_NOSYS;
@@ -235,3 +301,233 @@ failed:
 	return rc;
 }
 
+
+/** Store the running checksum of \a csum as the \a idx-th one of \a csum_buf */
+static int
+daos_csum_chunk_put(daos_csum_t *csum, daos_csum_buf_t *csum_buf,
+		    uint32_t idx)
+{
+	daos_csum_buf_t	chunk;
+	int		rc;
+
+	chunk.cs_len = chunk.cs_buf_len = csum_buf->cs_len;
+	chunk.cs_csum = csum_buf->cs_csum + idx * csum_buf->cs_len;
+	rc = daos_csum_get(csum, &chunk);
+	if (rc != 0)
+		return rc;
+
+	return daos_csum_reset(csum);
+}
+
+/**
+ * Compute one checksum per \a chunk_size bytes of \a sgl in a single pass,
+ * \a sgl holds the data starting at byte offset \a off of the record.
+ * Chunks are aligned to multiples of \a chunk_size within the record, the
+ * same way as csum_chunk_count() does, so the first and the last checksums
+ * only cover the part of their chunks which is in \a sgl.
+ *
+ * \param[in]	csum		checksum type, the running state is reset
+ * \param[in]	sgl		data, possibly scattered over many iovs
+ * \param[in]	off		byte offset of \a sgl within the record
+ * \param[in]	chunk_size	bytes covered by each checksum
+ * \param[out]	csum_buf	checksums, cs_csum and cs_buf_len are provided
+ *				by caller, cs_nr, cs_len and cs_chunksize
+ *				are set by this function
+ */
+int
+daos_csum_compute_chunks(daos_csum_t *csum, d_sg_list_t *sgl, daos_off_t off,
+			 uint32_t chunk_size, daos_csum_buf_t *csum_buf)
+{
+	daos_size_t	csum_len = daos_csum_get_size(csum);
+	daos_size_t	len = 0;
+	daos_size_t	chunk_nr;
+	daos_off_t	chunk_end;
+	daos_off_t	pos = off;
+	uint32_t	idx = 0;
+	int		i;
+	int		rc;
+
+	if (chunk_size == 0)
+		return -DER_INVAL;
+
+	for (i = 0; sgl->sg_iovs != NULL && i < sgl->sg_nr_out; i++) {
+		if (sgl->sg_iovs[i].iov_buf != NULL)
+			len += sgl->sg_iovs[i].iov_len;
+	}
+
+	csum_buf->cs_nr = 0;
+	csum_buf->cs_len = csum_len;
+	csum_buf->cs_chunksize = chunk_size;
+	if (len == 0)
+		return 0;
+
+	chunk_nr = (off + len - 1) / chunk_size - off / chunk_size + 1;
+	if (csum_buf->cs_buf_len < chunk_nr * csum_len) {
+		D_ERROR("Checksum buffer too small: %u/"DF_U64"\n",
+			csum_buf->cs_buf_len, chunk_nr * csum_len);
+		return -DER_INVAL;
+	}
+
+	rc = daos_csum_reset(csum);
+	if (rc != 0)
+		return rc;
+
+	chunk_end = (off / chunk_size + 1) * chunk_size;
+	for (i = 0; i < sgl->sg_nr_out; i++) {
+		uint8_t		*buf = sgl->sg_iovs[i].iov_buf;
+		daos_size_t	 left = sgl->sg_iovs[i].iov_len;
+
+		if (buf == NULL)
+			continue;
+
+		while (left > 0) {
+			daos_size_t	nob = min(left, chunk_end - pos);
+
+			rc = daos_csum_update(csum, buf, nob);
+			if (rc != 0)
+				return -DER_IO;
+
+			buf += nob;
+			left -= nob;
+			pos += nob;
+			if (pos < chunk_end)
+				continue;
+
+			rc = daos_csum_chunk_put(csum, csum_buf, idx++);
+			if (rc != 0)
+				return rc;
+			chunk_end += chunk_size;
+		}
+	}
+
+	/* partial trailing chunk */
+	if (pos + chunk_size != chunk_end) {
+		rc = daos_csum_chunk_put(csum, csum_buf, idx++);
+		if (rc != 0)
+			return rc;
+	}
+
+	D_ASSERT(idx == chunk_nr);
+	csum_buf->cs_nr = idx;
+	return 0;
+}
+
+#if defined(__x86_64__)
+
+#define CSUM_CRC32C_POLY	0x82F63B78ULL		/* reflected */
+#define CSUM_CRC64_ECMA_POLY	0xC96C5795D7870F42ULL	/* reflected */
+#define CSUM_ADLER_BASE		65521
+
+/**
+ * Multiply \a a by \a b modulo the reflected polynomial \a poly of
+ * \a bits width, x^0 is the top bit in the reflected representation.
+ */
+static uint64_t
+crc_mult_mod(uint64_t a, uint64_t b, uint64_t poly, int bits)
+{
+	uint64_t	m = 1ULL << (bits - 1);
+	uint64_t	p = 0;
+
+	for (; m != 0; m >>= 1) {
+		if (a & m)
+			p ^= b;
+		b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+	}
+	return p;
+}
+
+/** Multiply \a crc by x^(8 * \a len), i.e. append \a len zero bytes */
+static uint64_t
+crc_shift(uint64_t crc, daos_size_t len, uint64_t poly, int bits)
+{
+	uint64_t	sq = 1ULL << (bits - 2);	/* x^1 */
+	int		i;
+
+	/* x^8 */
+	for (i = 0; i < 3; i++)
+		sq = crc_mult_mod(sq, sq, poly, bits);
+
+	for (; len != 0; len >>= 1) {
+		if (len & 1)
+			crc = crc_mult_mod(sq, crc, poly, bits);
+		sq = crc_mult_mod(sq, sq, poly, bits);
+	}
+	return crc;
+}
+
+static uint32_t
+adler32_combine(uint32_t adler1, uint32_t adler2, daos_size_t len2)
+{
+	uint64_t	rem = len2 % CSUM_ADLER_BASE;
+	uint64_t	sum1;
+	uint64_t	sum2;
+
+	sum1 = adler1 & 0xffff;
+	sum2 = (rem * sum1) % CSUM_ADLER_BASE;
+	sum1 += (adler2 & 0xffff) + CSUM_ADLER_BASE - 1;
+	sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) +
+		CSUM_ADLER_BASE - rem;
+	if (sum1 >= CSUM_ADLER_BASE)
+		sum1 -= CSUM_ADLER_BASE;
+	if (sum1 >= CSUM_ADLER_BASE)
+		sum1 -= CSUM_ADLER_BASE;
+	if (sum2 >= (CSUM_ADLER_BASE << 1))
+		sum2 -= (CSUM_ADLER_BASE << 1);
+	if (sum2 >= CSUM_ADLER_BASE)
+		sum2 -= CSUM_ADLER_BASE;
+	return sum1 | (sum2 << 16);
+}
+
+#endif
+
+/**
+ * Combine the checksums of two adjacent pieces of data into the checksum
+ * of their concatenation, without reading the data again.
+ *
+ * \param[in]	csum	checksum type
+ * \param[in]	csum1	checksum of the first piece
+ * \param[in]	csum2	checksum of the second piece
+ * \param[in]	len2	length in bytes of the second piece
+ * \param[out]	result	checksum of both pieces, can be the same as
+ *			\a csum1
+ */
+int
+daos_csum_combine(const daos_csum_t *csum, const void *csum1,
+		  const void *csum2, daos_size_t len2, void *result)
+{
+#if defined(__x86_64__)
+	switch (csum->dc_csum) {
+	case DAOS_CS_CRC64:
+	{
+		uint64_t crc1 = *(const uint64_t *)csum1;
+		uint64_t crc2 = *(const uint64_t *)csum2;
+
+		/* ISA-L crc64 pre/post inverts, which cancels out here */
+		*(uint64_t *)result = crc_shift(crc1, len2,
+						CSUM_CRC64_ECMA_POLY, 64) ^
+				      crc2;
+		break;
+	}
+	case DAOS_CS_CRC32:
+	{
+		uint32_t crc1 = *(const uint32_t *)csum1;
+		uint32_t crc2 = *(const uint32_t *)csum2;
+
+		*(uint32_t *)result = crc_shift(crc1, len2,
+						CSUM_CRC32C_POLY, 32) ^ crc2;
+		break;
+	}
+	case DAOS_CS_ADLER32:
+		*(uint32_t *)result = adler32_combine(*(const uint32_t *)csum1,
+						      *(const uint32_t *)csum2,
+						      len2);
+		break;
+	default:
+		D_ERROR("Unknown checksum type\n");
+		return -DER_NOSYS;
+	}
+	return 0;
+#else
+	return -DER_NOSYS;
+#endif
+}
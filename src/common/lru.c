@@ -121,9 +121,14 @@ daos_lru_cache_create(int bits, uint32_t feats,
 	else /* disable LRU */
 		lru_cache->dlc_csize = 0;
 
+	/* 25% of the cache for items referenced only once, which is the
+	 * recommended size of the A1 queue of the 2Q algorithm.
+	 */
+	lru_cache->dlc_cold_max = lru_cache->dlc_csize / 4;
 	lru_cache->dlc_ops = ops;
 
 	D_INIT_LIST_HEAD(&lru_cache->dlc_idle_list);
+	D_INIT_LIST_HEAD(&lru_cache->dlc_hot_list);
 	D_INIT_LIST_HEAD(&lru_cache->dlc_busy_list);
 
 	*lcache = lru_cache;
@@ -144,6 +149,9 @@ daos_lru_cache_destroy(struct daos_lru_cache *lcache)
 	 * if there are busy references.
 	 */
 	D_DEBUG(DB_TRACE, "refs_held :%u\n", lcache->dlc_busy_nr);
+	D_DEBUG(DB_TRACE, "hits "DF_U64", misses "DF_U64", evicts "DF_U64"\n",
+		lcache->dlc_stats.ls_hits, lcache->dlc_stats.ls_misses,
+		lcache->dlc_stats.ls_evicts);
 	D_ASSERTF(lcache->dlc_busy_nr == 0, "busy=%d", lcache->dlc_busy_nr);
 
 	d_hash_table_debug(&lcache->dlc_htable);
@@ -151,12 +159,39 @@ daos_lru_cache_destroy(struct daos_lru_cache *lcache)
 	D_FREE(lcache);
 }
 
+/** Remove an idle item from the cache, it is freed by the hash callback */
+static void
+lru_del_idle(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	if (llink->ll_hot)
+		lcache->dlc_hot_nr--;
+	lcache->dlc_idle_nr--;
+	d_list_del_init(&llink->ll_qlink);
+	d_hash_rec_delete_at(&lcache->dlc_htable, &llink->ll_hlink);
+}
+
+static unsigned int
+lru_evict_list(struct daos_lru_cache *lcache, d_list_t *head,
+	       daos_lru_cond_cb_t cond, void *args)
+{
+	struct daos_llink *llink;
+	struct daos_llink *tmp;
+	unsigned int	   cntr = 0;
+
+	d_list_for_each_entry_safe(llink, tmp, head, ll_qlink) {
+		if (cond == NULL || cond(llink, args)) {
+			lru_del_idle(lcache, llink);
+			cntr++;
+		}
+	}
+	return cntr;
+}
+
 void
 daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		     daos_lru_cond_cb_t cond, void *args)
 {
 	struct daos_llink *llink;
-	struct daos_llink *tmp;
 	unsigned int	   cntr;
 
 	cntr = 0;
@@ -169,18 +204,11 @@ daos_lru_cache_evict(struct daos_lru_cache *lcache,
 	}
 	D_DEBUG(DB_TRACE, "Marked %d busy items as evicted\n", cntr);
 
-	cntr = 0;
-	d_list_for_each_entry_safe(llink, tmp, &lcache->dlc_idle_list,
-				   ll_qlink) {
-		if (cond == NULL || cond(llink, args)) {
-			d_list_del_init(&llink->ll_qlink);
-			d_hash_rec_delete_at(&lcache->dlc_htable,
-					     &llink->ll_hlink);
-			lcache->dlc_idle_nr--;
-			cntr++;
-		}
-	}
+	cntr = lru_evict_list(lcache, &lcache->dlc_idle_list, cond, args);
 	D_DEBUG(DB_TRACE, "Evicted %d items from idle list\n", cntr);
+
+	cntr = lru_evict_list(lcache, &lcache->dlc_hot_list, cond, args);
+	D_DEBUG(DB_TRACE, "Evicted %d items from hot list\n", cntr);
 }
 
 static struct daos_llink *
@@ -198,7 +226,8 @@ lru_fast_search(struct daos_lru_cache *lcache, d_list_t *head,
 
 	if (llink->ll_ops->lop_cmp_keys(key, key_size, llink)) {
 		D_DEBUG(DB_TRACE, "Found item on the %s list.\n",
-			head == &lcache->dlc_busy_list ? "busy" : "idle");
+			head == &lcache->dlc_busy_list ? "busy" :
+			head == &lcache->dlc_hot_list ? "hot" : "idle");
 
 		llink->ll_ref++; /* +1 for caller */
 		return llink;
@@ -233,12 +262,29 @@ lru_mark_busy(struct daos_lru_cache *lcache, struct daos_llink *llink)
 	if (d_list_empty(&llink->ll_qlink)) { /* new item */
 		d_list_add(&llink->ll_qlink, &lcache->dlc_busy_list);
 	} else {
+		if (llink->ll_hot)
+			lcache->dlc_hot_nr--;
 		lcache->dlc_idle_nr--;
 		d_list_move(&llink->ll_qlink, &lcache->dlc_busy_list);
 	}
 	lcache->dlc_busy_nr++;
 }
 
+/** Select the idle item to be evicted, see daos_lru_cache for the policy */
+static struct daos_llink *
+lru_evict_victim(struct daos_lru_cache *lcache)
+{
+	d_list_t	*head = &lcache->dlc_idle_list;
+
+	if (lcache->dlc_hot_nr != 0 &&
+	    lcache->dlc_idle_nr - lcache->dlc_hot_nr <= lcache->dlc_cold_max)
+		head = &lcache->dlc_hot_list;
+
+	/** evict from the tail of the list */
+	D_ASSERT(!d_list_empty(head));
+	return container_of(head->prev, struct daos_llink, ll_qlink);
+}
+
 int
 daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		  unsigned int key_size, void *create_args,
@@ -255,6 +301,10 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	if (llink)
 		D_GOTO(found, rc = 0);
 
+	llink = lru_fast_search(lcache, &lcache->dlc_hot_list, key, key_size);
+	if (llink)
+		D_GOTO(found, rc = 0);
+
 	llink = lru_fast_search(lcache, &lcache->dlc_idle_list, key, key_size);
 	if (llink)
 		D_GOTO(found, rc = 0);
@@ -263,6 +313,7 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	if (llink)
 		D_GOTO(found, rc = 0);
 
+	lcache->dlc_stats.ls_misses++;
 	if (!create_args)
 		D_GOTO(out, rc = -DER_NONEXIST);
 
@@ -274,6 +325,7 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 
 	D_DEBUG(DB_TRACE, "Inserting into LRU Hash table\n");
 	llink->ll_evicted = 0;
+	llink->ll_hot	  = 0;
 	llink->ll_ref	  = 1; /* 1 for caller */
 	llink->ll_ops	  = lcache->dlc_ops;
 	D_INIT_LIST_HEAD(&llink->ll_qlink);
@@ -281,10 +333,18 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	rc = d_hash_rec_insert(&lcache->dlc_htable, key, key_size,
 			       &llink->ll_hlink, true);
 	D_ASSERT(rc == 0);
+	if (llink->ll_ref == 2) /* 1 for hash, 1 for the first holder */
+		lru_mark_busy(lcache, llink);
+
+	*rlink = llink;
+	return 0;
 found:
+	lcache->dlc_stats.ls_hits++;
 	if (llink->ll_ref == 2) /* 1 for hash, 1 for the first holder */
 		lru_mark_busy(lcache, llink);
 
+	/* referenced again while it is cached, keep it on the hot list */
+	llink->ll_hot = 1;
 	*rlink = llink;
 out:
 	return rc;
@@ -310,6 +370,12 @@ daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 			/* be freed within hash callback */
 			d_hash_rec_delete_at(&lcache->dlc_htable,
 					     &llink->ll_hlink);
+		} else if (llink->ll_hot) {
+			D_DEBUG(DB_TRACE,
+				"Moving %p to the hot list\n", llink);
+			lcache->dlc_idle_nr++;
+			lcache->dlc_hot_nr++;
+			d_list_move(&llink->ll_qlink, &lcache->dlc_hot_list);
 		} else {
 			D_DEBUG(DB_TRACE,
 				"Moving %p to the idle list\n", llink);
@@ -321,17 +387,13 @@ daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 	while (lcache->dlc_idle_nr != 0 &&
 	       (lcache->dlc_busy_nr + lcache->dlc_idle_nr >=
 		lcache->dlc_csize)) {
-		D_DEBUG(DB_TRACE, "Evicting from object cache :%d, %d\n",
-			lcache->dlc_idle_nr, lcache->dlc_busy_nr);
+		D_DEBUG(DB_TRACE, "Evicting from object cache :%d(%d), %d\n",
+			lcache->dlc_idle_nr, lcache->dlc_hot_nr,
+			lcache->dlc_busy_nr);
 
-		/** evict from the tail of the list */
-		D_ASSERT(!d_list_empty(&lcache->dlc_idle_list));
-		llink = container_of(lcache->dlc_idle_list.prev,
-				     struct daos_llink, ll_qlink);
-
-		d_list_del_init(&llink->ll_qlink);
-		d_hash_rec_delete_at(&lcache->dlc_htable, &llink->ll_hlink);
-		lcache->dlc_idle_nr--;
+		llink = lru_evict_victim(lcache);
+		lru_del_idle(lcache, llink);
+		lcache->dlc_stats.ls_evicts++;
 	}
 	D_DEBUG(DB_TRACE, "Done releasing reference\n");
 }
@@ -758,6 +758,79 @@ ik_btr_batch_oper(void **state)
 	ik_btr_query(NULL);
 }
 
+/**
+ * Bulk load @key_nr integer keys in ascending order into the empty tree,
+ * then lookup all of them in random order.
+ */
+static void
+ik_btr_bulk_load(void **state)
+{
+	struct btr_stat	 stat;
+	uint64_t	*keys;
+	d_iov_t		*key_iovs;
+	d_iov_t		*val_iovs;
+	unsigned int	*arr;
+	char		 buf[64];
+	unsigned int	 key_nr;
+	int		 i;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 28)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(keys, key_nr);
+	D_ALLOC_ARRAY(key_iovs, key_nr);
+	D_ALLOC_ARRAY(val_iovs, key_nr);
+	D_ALLOC_ARRAY(arr, key_nr);
+	if (keys == NULL || key_iovs == NULL || val_iovs == NULL ||
+	    arr == NULL)
+		fail_msg("Array allocation failed");
+
+	D_PRINT("Bulk load %d records.\n", key_nr);
+	for (i = 0; i < key_nr; i++) {
+		keys[i] = i + 1;
+		d_iov_set(&key_iovs[i], &keys[i], sizeof(keys[i]));
+		/* value is the key itself, see ik_rec_alloc */
+		d_iov_set(&val_iovs[i], &keys[i], sizeof(keys[i]));
+	}
+
+	rc = dbtree_bulk_load(ik_toh, key_iovs, val_iovs, key_nr);
+	if (rc != 0)
+		fail_msg("Failed to bulk load: %d\n", rc);
+
+	rc = dbtree_query(ik_toh, NULL, &stat);
+	if (rc != 0)
+		fail_msg("Failed to query btree: %d\n", rc);
+	if (stat.bs_rec_nr != key_nr)
+		fail_msg("Expect %u records, found "DF_U64"\n", key_nr,
+			 stat.bs_rec_nr);
+
+	ik_btr_gen_keys(arr, key_nr);
+	for (i = 0; i < key_nr; i++) {
+		d_iov_t		key_iov;
+		d_iov_t		val_iov;
+		uint64_t	key = arr[i];
+
+		d_iov_set(&key_iov, &key, sizeof(key));
+		d_iov_set(&val_iov, NULL, 0);
+		rc = dbtree_lookup(ik_toh, &key_iov, &val_iov);
+		if (rc != 0 || *(uint64_t *)val_iov.iov_buf != key) {
+			sprintf(buf, "Failed to lookup "DF_U64": %d\n",
+				key, rc);
+			fail_msg("%s", buf);
+		}
+	}
+	ik_btr_query(NULL);
+
+	D_FREE(arr);
+	D_FREE(val_iovs);
+	D_FREE(key_iovs);
+	D_FREE(keys);
+}
+
 static void
 ik_btr_perf(void **state)
 {
@@ -903,6 +976,19 @@ run_btree_perf_test(void)
 					btree_perf_test, NULL, NULL);
 }
 
+static int
+run_btree_bulk_load_test(void)
+{
+	static const struct CMUnitTest btree_bulk_load_test[] = {
+		{ "BTR008: btree_bulk_load test", ik_btr_bulk_load,
+			NULL, NULL},
+		{ NULL, NULL, NULL, NULL }
+	};
+
+	return cmocka_run_group_tests_name("btree bulk load test",
+					btree_bulk_load_test, NULL, NULL);
+}
+
 static int
 run_btree_kv_operate_test(void)
 {
@@ -931,6 +1017,7 @@ static struct option btr_ops[] = {
 	{ "iterate",	required_argument,	NULL,	'i'	},
 	{ "batch",	required_argument,	NULL,	'b'	},
 	{ "perf",	required_argument,	NULL,	'p'	},
+	{ "bulk",	required_argument,	NULL,	'l'	},
 	{ NULL,		0,			NULL,	0	},
 };
 
@@ -955,8 +1042,8 @@ main(int argc, char **argv)
 	optind = 0;
 
 	/* Check for -m option first */
-	while ((opt = getopt_long(argc, argv, "tmC:Docqu:d:r:f:i:b:p:", btr_ops,
-				  NULL)) != -1) {
+	while ((opt = getopt_long(argc, argv, "tmC:Docqu:d:r:f:i:b:p:l:",
+				  btr_ops, NULL)) != -1) {
 		if (opt == 'm') {
 			D_PRINT("Using pmem\n");
 			rc = utest_pmem_create(POOL_NAME, POOL_SIZE,
@@ -987,8 +1074,8 @@ main(int argc, char **argv)
 	/* start over */
 	optind = 0;
 
-	while ((opt = getopt_long(argc, argv, "tmC:Docqu:d:r:f:i:b:p:", btr_ops,
-				  NULL)) != -1) {
+	while ((opt = getopt_long(argc, argv, "tmC:Docqu:d:r:f:i:b:p:l:",
+				  btr_ops, NULL)) != -1) {
 		tst_fn_val.optval = optarg;
 		tst_fn_val.input = true;
 		switch (opt) {
@@ -1036,6 +1123,9 @@ main(int argc, char **argv)
 		case 'p':
 			rc = run_btree_perf_test();
 			break;
+		case 'l':
+			rc = run_btree_bulk_load_test();
+			break;
 		default:
 			D_PRINT("Unsupported command %c\n", opt);
 		case 'm':
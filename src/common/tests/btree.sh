@@ -32,6 +32,7 @@ EOF
 
 PERF=""
 UINT=""
+DIRECT=""
 while [ $# -gt 0 ]; do
     case "$1" in
     -s)
@@ -57,6 +58,7 @@ while [ $# -gt 0 ]; do
         ;;
     direct)
         BTR=$DAOS_DIR/build/src/common/tests/btree_direct
+        DIRECT="on"
         KEYS=${KEYS:-"delta,lambda,kappa,omega,beta,alpha,epsilon"}
         RECORDS=${RECORDS:-"omega:loaded,delta:that,kappa:dice,beta:knows,epsilon:the,lambda:are,alpha:Everybody"}
 
@@ -102,6 +104,16 @@ run_test()
         -o                                          \
         -b "$BAT_NUM"                               \
         -D
+
+        if [ -z "${DIRECT}" ]; then
+            echo "B+tree bulk load test..."
+            "${VCMD[@]}" "$BTR" "${DYN}" "${PMEM}" \
+            -C "${UINT}${IPL}o:$ORDER"              \
+            -c                                      \
+            -o                                      \
+            -l "$BAT_NUM"                           \
+            -D
+        fi
     else
         echo "B+tree performance test..."
         "${VCMD[@]}" "$BTR" "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
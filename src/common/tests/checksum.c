@@ -26,6 +26,10 @@
 #include <errno.h>
 
 #include <daos/checksum.h>
+#include <daos/tests_lib.h>
+
+#define CSUM_PERF_BUF_SIZE	(1 << 20)
+#define CSUM_PERF_ITERS		1024
 
 int test_checksum_simple(char *cs_name, daos_csum_t *csum,
 			 daos_csum_buf_t *csum_buf)
@@ -64,6 +68,188 @@ exit:
 	return rc;
 }
 
+/** Verify adler32 against the known value of "Wikipedia" */
+int test_checksum_adler32(void)
+{
+	daos_csum_t	csum;
+	daos_csum_buf_t	csum_buf;
+	d_iov_t		iov;
+	d_sg_list_t	sgl;
+	char		data[] = "Wikipedia";
+	uint32_t	expect = 0x11E60398;
+	int		rc;
+
+	rc = daos_csum_init("adler32", &csum);
+	if (rc != 0)
+		return rc;
+
+	d_iov_set(&iov, data, strlen(data));
+	sgl.sg_nr = sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	rc = daos_csum_compute(&csum, &sgl);
+	if (rc != 0)
+		goto out;
+
+	daos_csum_set(&csum_buf, &expect, sizeof(expect));
+	rc = daos_csum_verify(&csum, &csum_buf);
+	if (rc != 0) {
+		D_PRINT("Wrong adler32 of \"%s\": %d\n", data, rc);
+		goto out;
+	}
+
+	/* a corrupted checksum must be detected */
+	expect ^= 1;
+	rc = daos_csum_verify(&csum, &csum_buf);
+	if (rc != -DER_IO) {
+		D_PRINT("Corrupted adler32 not detected: %d\n", rc);
+		rc = -DER_INVAL;
+		goto out;
+	}
+	rc = 0;
+out:
+	daos_csum_free(&csum);
+	return rc;
+}
+
+/**
+ * Compare the chunked checksums of scattered data with checksums computed
+ * chunk by chunk, then combine the first two chunks.
+ */
+int test_checksum_chunks(char *cs_name)
+{
+	daos_csum_t	csum;
+	daos_csum_buf_t	csum_buf;
+	daos_csum_buf_t	expect;
+	d_iov_t		iovs[3];
+	d_iov_t		iov;
+	d_sg_list_t	sgl;
+	uint8_t		csums[32 * DAOS_CSUM_SIZE];
+	uint8_t		one[DAOS_CSUM_SIZE];
+	uint8_t		combined[DAOS_CSUM_SIZE];
+	char		data[10000];
+	uint32_t	chunk = 1024;
+	daos_off_t	off = 100;
+	daos_off_t	lo;
+	daos_off_t	hi;
+	int		len;
+	int		i;
+	int		rc;
+
+	rc = daos_csum_init(cs_name, &csum);
+	if (rc != 0)
+		return rc;
+	len = daos_csum_get_size(&csum);
+
+	for (i = 0; i < sizeof(data); i++)
+		data[i] = rand();
+
+	/* scattered over iovs which do not match chunk boundaries */
+	d_iov_set(&iovs[0], data, 1000);
+	d_iov_set(&iovs[1], data + 1000, 3333);
+	d_iov_set(&iovs[2], data + 4333, sizeof(data) - 4333);
+	sgl.sg_nr = sgl.sg_nr_out = 3;
+	sgl.sg_iovs = iovs;
+
+	csum_buf.cs_csum = csums;
+	csum_buf.cs_buf_len = sizeof(csums);
+	rc = daos_csum_compute_chunks(&csum, &sgl, off, chunk, &csum_buf);
+	if (rc != 0) {
+		D_PRINT("Error in computing chunked %s: %d\n", cs_name, rc);
+		goto out;
+	}
+	if (csum_buf.cs_nr != (off + sizeof(data) - 1) / chunk + 1) {
+		D_PRINT("Wrong number of %s chunks: %u\n", cs_name,
+			csum_buf.cs_nr);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	sgl.sg_nr = sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	expect.cs_csum = one;
+	expect.cs_len = expect.cs_buf_len = len;
+	for (i = 0; i < csum_buf.cs_nr; i++) {
+		lo = max(off, (daos_off_t)i * chunk);
+		hi = min(off + sizeof(data), (daos_off_t)(i + 1) * chunk);
+		d_iov_set(&iov, data + lo - off, hi - lo);
+
+		daos_csum_reset(&csum);
+		daos_csum_compute(&csum, &sgl);
+		daos_csum_get(&csum, &expect);
+		if (memcmp(one, csums + i * len, len) != 0) {
+			D_PRINT("Mismatch of %s chunk %d\n", cs_name, i);
+			D_GOTO(out, rc = -DER_IO);
+		}
+	}
+
+	/* chunk 0 covers [off, chunk), chunk 1 covers [chunk, 2 * chunk) */
+	d_iov_set(&iov, data, 2 * chunk - off);
+	daos_csum_reset(&csum);
+	daos_csum_compute(&csum, &sgl);
+	daos_csum_get(&csum, &expect);
+	rc = daos_csum_combine(&csum, csums, csums + len, chunk, combined);
+	if (rc != 0) {
+		D_PRINT("Error in combining %s: %d\n", cs_name, rc);
+		goto out;
+	}
+	if (memcmp(one, combined, len) != 0) {
+		D_PRINT("Mismatch of combined %s\n", cs_name);
+		rc = -DER_IO;
+	}
+out:
+	daos_csum_free(&csum);
+	return rc;
+}
+
+/**
+ * Report throughput of \a cs_name over a 1MB buffer, in GB/s. Only run with
+ * "-p", it is not part of the unit test.
+ */
+int test_checksum_perf(char *cs_name)
+{
+	daos_csum_t	csum;
+	d_iov_t		iov;
+	d_sg_list_t	sgl;
+	char		*buf;
+	double		then;
+	double		now;
+	int		i;
+	int		rc;
+
+	rc = daos_csum_init(cs_name, &csum);
+	if (rc != 0) {
+		D_PRINT("Error in initializing checksum %s\n", cs_name);
+		return rc;
+	}
+
+	D_ALLOC(buf, CSUM_PERF_BUF_SIZE);
+	if (buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	for (i = 0; i < CSUM_PERF_BUF_SIZE; i++)
+		buf[i] = rand();
+
+	d_iov_set(&iov, buf, CSUM_PERF_BUF_SIZE);
+	sgl.sg_nr = sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	then = dts_time_now();
+	for (i = 0; i < CSUM_PERF_ITERS; i++) {
+		rc = daos_csum_compute(&csum, &sgl);
+		if (rc != 0) {
+			D_PRINT("Error in computing checksum %s\n", cs_name);
+			D_GOTO(out_buf, rc);
+		}
+	}
+	now = dts_time_now();
+
+	D_PRINT("%-8s %8.2f GB/s\n", cs_name,
+		(double)CSUM_PERF_BUF_SIZE * CSUM_PERF_ITERS /
+		((now - then) * 1000000000.0));
+out_buf:
+	D_FREE(buf);
+out:
+	daos_csum_free(&csum);
+	return rc;
+}
 
 int main(int argc, char *argv[])
 {
@@ -107,10 +293,35 @@ int main(int argc, char *argv[])
 		D_ERROR("Error in generating crc32 checksum\n");
 		test_fail++;
 	}
-	if (test_fail)
+	daos_csum_free(csum);
+
+	rc = test_checksum_simple("adler32", csum, &csum_buf);
+	if (rc != 0) {
+		D_ERROR("Error in generating adler32 checksum\n");
+		test_fail++;
+	}
+	daos_csum_free(csum);
+
+	if (test_checksum_adler32() != 0)
+		test_fail++;
+
+	if (test_checksum_chunks("crc32") != 0 ||
+	    test_checksum_chunks("crc64") != 0 ||
+	    test_checksum_chunks("adler32") != 0)
+		test_fail++;
+
+	/* throughput is only reported on demand, it takes a while */
+	if (argc > 1 && strcmp(argv[1], "-p") == 0 &&
+	    (test_checksum_perf("crc32") != 0 ||
+	     test_checksum_perf("crc64") != 0 ||
+	     test_checksum_perf("adler32") != 0))
+		test_fail++;
+
+	if (test_fail) {
 		D_PRINT("%d tests failed\n", test_fail);
-	else
-		D_PRINT("All tests pass\n");
+		return 1;
+	}
 
-	return rc;
+	D_PRINT("All tests pass\n");
+	return 0;
 }
@@ -81,6 +81,7 @@ type Connect interface {
 	//BurninStorage() (ClientCtrlrMap, ClientModuleMap)
 	ListFeatures() ClientFeatureMap
 	KillRank(uuid string, rank uint32) ResultMap
+	GetMetrics() ClientMetricsMap
 }
 
 // connList is an implementation of Connect and stores controllers
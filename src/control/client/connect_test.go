@@ -62,6 +62,7 @@ var (
 			State:    &exampleState,
 		},
 	}
+	metrics    = Metrics{MockMetricPB()}
 	errExample = errors.New("unknown failure")
 )
 
@@ -77,11 +78,13 @@ type mockControllerFactory struct {
 	modules       ScmModules
 	moduleResults ScmModuleResults
 	mountResults  ScmMountResults
+	metrics       Metrics
 	// to provide error injection into Control objects
 	scanRet    error
 	formatRet  error
 	updateRet  error
 	killRet    error
+	metricsRet error
 	connectRet error
 }
 
@@ -89,8 +92,9 @@ func (m *mockControllerFactory) create(address string) (Control, error) {
 	// returns controller with mock properties specified in constructor
 	controller := newMockControl(
 		address, m.state, m.features, m.ctrlrs, m.ctrlrResults,
-		m.modules, m.moduleResults, m.mountResults,
-		m.scanRet, m.formatRet, m.updateRet, m.killRet, m.connectRet)
+		m.modules, m.moduleResults, m.mountResults, m.metrics,
+		m.scanRet, m.formatRet, m.updateRet, m.killRet, m.metricsRet,
+		m.connectRet)
 
 	err := controller.connect(address)
 
@@ -101,14 +105,14 @@ func newMockConnect(
 	state State, features []*pb.Feature, ctrlrs NvmeControllers,
 	ctrlrResults NvmeControllerResults, modules ScmModules,
 	moduleResults ScmModuleResults, mountResults ScmMountResults,
-	scanRet error, formatRet error, updateRet error, killRet error,
-	connectRet error) Connect {
+	metrics Metrics, scanRet error, formatRet error, updateRet error,
+	killRet error, metricsRet error, connectRet error) Connect {
 
 	return &connList{
 		factory: &mockControllerFactory{
 			state, features, ctrlrs, ctrlrResults, modules,
-			moduleResults, mountResults, scanRet, formatRet,
-			updateRet, killRet, connectRet,
+			moduleResults, mountResults, metrics, scanRet,
+			formatRet, updateRet, killRet, metricsRet, connectRet,
 		},
 	}
 }
@@ -116,7 +120,7 @@ func newMockConnect(
 func defaultMockConnect() Connect {
 	return newMockConnect(
 		Ready, features, ctrlrs, ctrlrResults, modules, moduleResults,
-		mountResults, nil, nil, nil, nil, nil)
+		mountResults, metrics, nil, nil, nil, nil, nil, nil)
 }
 
 func TestConnectClients(t *testing.T) {
@@ -140,7 +144,8 @@ func TestConnectClients(t *testing.T) {
 	for _, tt := range conntests {
 		cc := newMockConnect(
 			tt.state, features, ctrlrs, ctrlrResults, modules,
-			moduleResults, mountResults, nil, nil, nil, nil, tt.connRet)
+			moduleResults, mountResults, metrics, nil, nil, nil,
+			nil, nil, tt.connRet)
 
 		results := cc.ConnectClients(tt.addrsIn)
 
@@ -168,12 +173,12 @@ func clientSetup(
 	ctrlrResults NvmeControllerResults, modules ScmModules,
 	moduleResults ScmModuleResults, mountResults ScmMountResults,
 	scanRet error, formatRet error, updateRet error,
-	killRet error, connectRet error) Connect {
+	killRet error, metricsRet error, connectRet error) Connect {
 
 	cc := newMockConnect(
 		state, features, ctrlrs, ctrlrResults, modules,
-		moduleResults, mountResults, scanRet, formatRet,
-		updateRet, killRet, connectRet)
+		moduleResults, mountResults, metrics, scanRet, formatRet,
+		updateRet, killRet, metricsRet, connectRet)
 
 	_ = cc.ConnectClients(addresses)
 
@@ -266,7 +271,7 @@ func TestFormatStorage(t *testing.T) {
 		cc := clientSetup(
 			Ready, features, ctrlrs, ctrlrResults, modules,
 			moduleResults, mountResults, nil, tt.formatRet,
-			nil, nil, nil)
+			nil, nil, nil, nil)
 
 		cNvmeMap, cMountMap := cc.FormatStorage()
 
@@ -314,7 +319,7 @@ func TestUpdateStorage(t *testing.T) {
 		cc := clientSetup(
 			Ready, features, ctrlrs, ctrlrResults, modules,
 			moduleResults, mountResults, nil, nil, tt.updateRet,
-			nil, nil)
+			nil, nil, nil)
 
 		cNvmeMap, cModuleMap := cc.UpdateStorage(new(pb.UpdateStorageParams))
 
@@ -360,10 +365,46 @@ func TestKillRank(t *testing.T) {
 		cc := clientSetup(
 			Ready, features, ctrlrs, ctrlrResults, modules,
 			moduleResults, mountResults, nil, nil, nil,
-			tt.killRet, nil)
+			tt.killRet, nil, nil)
 
 		resultMap := cc.KillRank("acd", 0)
 
 		checkResults(t, addresses, resultMap, tt.killRet)
 	}
 }
+
+func TestGetMetrics(t *testing.T) {
+	tests := []struct {
+		metricsRet error
+	}{
+		{
+			nil,
+		},
+		{
+			errExample,
+		},
+	}
+
+	for _, tt := range tests {
+		cc := clientSetup(
+			Ready, features, ctrlrs, ctrlrResults, modules,
+			moduleResults, mountResults, nil, nil, nil,
+			nil, tt.metricsRet, nil)
+
+		cMetricsMap := cc.GetMetrics()
+
+		if tt.metricsRet != nil {
+			for _, addr := range addresses {
+				AssertEqual(
+					t, cMetricsMap[addr],
+					MetricsResult{Err: tt.metricsRet},
+					"unexpected error for metrics result")
+			}
+			continue
+		}
+
+		AssertEqual(
+			t, cMetricsMap, NewClientMetrics(metrics, addresses),
+			"unexpected client metrics returned")
+	}
+}
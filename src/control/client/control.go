@@ -45,6 +45,7 @@ type Control interface {
 	//burninStorage(*pb.BurninStorageParams) (*pb.BurninStorageResp, error)
 	listAllFeatures() (FeatureMap, error)
 	killRank(uuid string, rank uint32) error
+	getMetrics() (Metrics, error)
 }
 
 // control is an abstraction around the MgmtControlClient
@@ -81,10 +81,12 @@ type mockControl struct {
 	modules       ScmModules
 	moduleResults ScmModuleResults
 	mountResults  ScmMountResults
+	metrics       Metrics
 	scanRet       error
 	formatRet     error
 	updateRet     error
 	killRet       error
+	metricsRet    error
 	connectRet    error
 }
 
@@ -134,20 +136,36 @@ func (m *mockControl) updateStorage(
 func (m *mockControl) killRank(uuid string, rank uint32) error {
 	return m.killRet
 }
+func (m *mockControl) getMetrics() (Metrics, error) {
+	if m.metricsRet != nil {
+		return nil, m.metricsRet
+	}
+	return m.metrics, nil
+}
 func newMockControl(
 	address string, state connectivity.State, features []*pb.Feature,
 	ctrlrs NvmeControllers, ctrlrResults NvmeControllerResults,
 	modules ScmModules, moduleResults ScmModuleResults,
-	mountResults ScmMountResults, scanRet error, formatRet error,
-	updateRet error, killRet error, connectRet error) Control {
+	mountResults ScmMountResults, metrics Metrics, scanRet error,
+	formatRet error, updateRet error, killRet error, metricsRet error,
+	connectRet error) Control {
 
 	return &mockControl{
 		address, state, features, ctrlrs, ctrlrResults, modules,
-		moduleResults, mountResults, scanRet, formatRet, updateRet,
-		killRet, connectRet,
+		moduleResults, mountResults, metrics, scanRet, formatRet,
+		updateRet, killRet, metricsRet, connectRet,
 	}
 }
 
+// NewClientMetrics provides a mock ClientMetricsMap populated with metrics.
+func NewClientMetrics(metrics Metrics, addrs Addresses) ClientMetricsMap {
+	cMap := make(ClientMetricsMap)
+	for _, addr := range addrs {
+		cMap[addr] = MetricsResult{Metrics: metrics}
+	}
+	return cMap
+}
+
 // NewClientFM provides a mock ClientFeatureMap for testing.
 func NewClientFM(features []*pb.Feature, addrs Addresses) ClientFeatureMap {
 	cf := make(ClientFeatureMap)
@@ -24,6 +24,7 @@
 package client
 
 import (
+	"fmt"
 	"time"
 
 	pb "github.com/daos-stack/daos/src/control/common/proto/mgmt"
@@ -68,3 +69,68 @@ func (c *connList) KillRank(uuid string, rank uint32) ResultMap {
 
 	return results
 }
+
+// Metrics is an alias for protobuf Metric message slice representing the
+// counters and histograms of an I/O server.
+type Metrics []*pb.Metric
+
+// MetricsResult contains the metrics of a server and an error signifying a
+// problem in making the request.
+type MetricsResult struct {
+	Metrics Metrics
+	Err     error
+}
+
+// ClientMetricsMap is an alias for the metrics of connected servers keyed on
+// address.
+type ClientMetricsMap map[string]MetricsResult
+
+func (c *control) getMetrics() (Metrics, error) {
+	ctx, cancel := context.WithTimeout(context.Background(), 10*time.Second)
+	defer cancel()
+
+	resp, err := c.client.GetMetrics(ctx, &pb.EmptyParams{})
+	if err != nil {
+		return nil, err
+	}
+	if resp.Status != 0 {
+		return nil, errors.Errorf("get metrics failed: %d", resp.Status)
+	}
+
+	return resp.Metrics, nil
+}
+
+// getMetricsRequest is to be called as a goroutine and returns result
+// containing the metrics of the I/O server over channel.
+func getMetricsRequest(controller Control, i interface{}, ch chan ClientResult) {
+	metrics, err := controller.getMetrics()
+	ch <- ClientResult{controller.getAddress(), metrics, err}
+}
+
+// GetMetrics returns the metrics of the I/O server for each server connected,
+// each of them is summed up over all xstreams of the server.
+func (c *connList) GetMetrics() ClientMetricsMap {
+	cResults := c.makeRequests(nil, getMetricsRequest)
+	cMetrics := make(ClientMetricsMap)
+
+	for _, res := range cResults {
+		if res.Err != nil {
+			cMetrics[res.Address] = MetricsResult{nil, res.Err}
+			continue
+		}
+
+		metrics, ok := res.Value.(Metrics)
+		if !ok {
+			cMetrics[res.Address] = MetricsResult{
+				nil, fmt.Errorf(
+					"type assertion failed, wanted %+v got %+v",
+					Metrics{}, res.Value),
+			}
+			continue
+		}
+
+		cMetrics[res.Address] = MetricsResult{metrics, nil}
+	}
+
+	return cMetrics
+}
@@ -40,6 +40,7 @@ type MgmtControlClient interface {
 	UpdateStorage(ctx context.Context, in *UpdateStorageParams, opts ...grpc.CallOption) (MgmtControl_UpdateStorageClient, error)
 	BurninStorage(ctx context.Context, in *BurninStorageParams, opts ...grpc.CallOption) (MgmtControl_BurninStorageClient, error)
 	KillRank(ctx context.Context, in *DaosRank, opts ...grpc.CallOption) (*DaosResponse, error)
+	GetMetrics(ctx context.Context, in *EmptyParams, opts ...grpc.CallOption) (*GetMetricsResp, error)
 	FetchFioConfigPaths(ctx context.Context, in *EmptyParams, opts ...grpc.CallOption) (MgmtControl_FetchFioConfigPathsClient, error)
 	GetFeature(ctx context.Context, in *FeatureName, opts ...grpc.CallOption) (*Feature, error)
 	ListAllFeatures(ctx context.Context, in *EmptyParams, opts ...grpc.CallOption) (MgmtControl_ListAllFeaturesClient, error)
@@ -168,6 +169,15 @@ func (c *mgmtControlClient) KillRank(ctx context.Context, in *DaosRank, opts ...
 	return out, nil
 }
 
+func (c *mgmtControlClient) GetMetrics(ctx context.Context, in *EmptyParams, opts ...grpc.CallOption) (*GetMetricsResp, error) {
+	out := new(GetMetricsResp)
+	err := c.cc.Invoke(ctx, "/mgmt.MgmtControl/GetMetrics", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
 func (c *mgmtControlClient) FetchFioConfigPaths(ctx context.Context, in *EmptyParams, opts ...grpc.CallOption) (MgmtControl_FetchFioConfigPathsClient, error) {
 	stream, err := c.cc.NewStream(ctx, &_MgmtControl_serviceDesc.Streams[3], "/mgmt.MgmtControl/FetchFioConfigPaths", opts...)
 	if err != nil {
@@ -280,6 +290,7 @@ type MgmtControlServer interface {
 	UpdateStorage(*UpdateStorageParams, MgmtControl_UpdateStorageServer) error
 	BurninStorage(*BurninStorageParams, MgmtControl_BurninStorageServer) error
 	KillRank(context.Context, *DaosRank) (*DaosResponse, error)
+	GetMetrics(context.Context, *EmptyParams) (*GetMetricsResp, error)
 	FetchFioConfigPaths(*EmptyParams, MgmtControl_FetchFioConfigPathsServer) error
 	GetFeature(context.Context, *FeatureName) (*Feature, error)
 	ListAllFeatures(*EmptyParams, MgmtControl_ListAllFeaturesServer) error
@@ -389,6 +400,24 @@ func _MgmtControl_KillRank_Handler(srv interface{}, ctx context.Context, dec fun
 	return interceptor(ctx, in, info, handler)
 }
 
+func _MgmtControl_GetMetrics_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(EmptyParams)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(MgmtControlServer).GetMetrics(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/mgmt.MgmtControl/GetMetrics",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(MgmtControlServer).GetMetrics(ctx, req.(*EmptyParams))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 func _MgmtControl_FetchFioConfigPaths_Handler(srv interface{}, stream grpc.ServerStream) error {
 	m := new(EmptyParams)
 	if err := stream.RecvMsg(m); err != nil {
@@ -482,6 +511,10 @@ var _MgmtControl_serviceDesc = grpc.ServiceDesc{
 			MethodName: "KillRank",
 			Handler:    _MgmtControl_KillRank_Handler,
 		},
+		{
+			MethodName: "GetMetrics",
+			Handler:    _MgmtControl_GetMetrics_Handler,
+		},
 		{
 			MethodName: "GetFeature",
 			Handler:    _MgmtControl_GetFeature_Handler,
@@ -522,28 +555,29 @@ var _MgmtControl_serviceDesc = grpc.ServiceDesc{
 	Metadata: "control.proto",
 }
 
-func init() { proto.RegisterFile("control.proto", fileDescriptor_control_efd1f5d296773aee) }
-
-var fileDescriptor_control_efd1f5d296773aee = []byte{
-	// 313 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x6c, 0x92, 0xcb, 0x4e, 0xf2, 0x40,
-	0x14, 0xc7, 0x21, 0x21, 0x5f, 0x3e, 0x07, 0x8a, 0x71, 0x8c, 0x21, 0x76, 0xc9, 0x03, 0x10, 0xd4,
-	0x85, 0x1b, 0x13, 0xa3, 0x68, 0x59, 0x78, 0x09, 0x81, 0xf8, 0x00, 0xc7, 0x7a, 0x28, 0x8d, 0x33,
-	0x73, 0x9a, 0x99, 0x83, 0x09, 0x4f, 0xe6, 0xeb, 0x99, 0x3a, 0x03, 0x61, 0xb0, 0xbb, 0xfe, 0x6f,
-	0xbf, 0xd3, 0xa4, 0x15, 0x49, 0x4e, 0x86, 0x2d, 0xa9, 0x51, 0x65, 0x89, 0x49, 0x76, 0x74, 0xa1,
-	0x39, 0xed, 0xe5, 0xa4, 0x35, 0x19, 0xef, 0xa5, 0x89, 0x63, 0xb2, 0x50, 0x60, 0x90, 0xfd, 0x25,
-	0x02, 0xaf, 0x2d, 0xba, 0xa0, 0x8f, 0x9c, 0xfd, 0xf2, 0x8f, 0x97, 0xdf, 0x1d, 0xd1, 0x7d, 0x29,
-	0x34, 0x4f, 0x3c, 0x53, 0xde, 0x8a, 0xee, 0x22, 0x07, 0xb3, 0xf0, 0x7b, 0x39, 0x18, 0xd5, 0xf4,
-	0xd1, 0x9e, 0x35, 0x03, 0x0b, 0xda, 0xa5, 0x67, 0x7f, 0x82, 0x39, 0xba, 0x6a, 0xd8, 0x92, 0x53,
-	0x91, 0x64, 0x64, 0x35, 0xf0, 0x16, 0x71, 0xee, 0x9b, 0x91, 0x19, 0x20, 0x83, 0x86, 0xc8, 0x63,
-	0xc6, 0xed, 0x1a, 0xf4, 0x56, 0x7d, 0x00, 0xe3, 0x01, 0x28, 0x32, 0x63, 0x50, 0x14, 0xed, 0x83,
-	0xee, 0xd7, 0xd6, 0x94, 0xe6, 0x00, 0x14, 0x99, 0x31, 0x28, 0x8a, 0x76, 0xa0, 0xb1, 0xf8, 0xff,
-	0x54, 0x2a, 0x35, 0x07, 0xf3, 0x29, 0xfb, 0xbe, 0xf8, 0x00, 0xe4, 0x6a, 0x9d, 0xca, 0x3d, 0x8d,
-	0xae, 0x22, 0xe3, 0x70, 0xd8, 0x92, 0x37, 0xe2, 0x34, 0x43, 0xce, 0x57, 0x59, 0x49, 0x13, 0x32,
-	0xcb, 0xb2, 0x98, 0x01, 0xaf, 0x9c, 0x3c, 0xf1, 0xe5, 0x47, 0x5d, 0xf1, 0x26, 0x1c, 0x0e, 0xbc,
-	0xac, 0x54, 0x58, 0x77, 0xc2, 0x3d, 0x31, 0x45, 0xce, 0xfc, 0xb7, 0xdb, 0x8e, 0x82, 0x7c, 0x05,
-	0x8d, 0x69, 0x12, 0x59, 0xc3, 0x96, 0xbc, 0x16, 0xc7, 0xcf, 0xa5, 0xe3, 0x3b, 0xa5, 0x82, 0xd7,
-	0x78, 0xeb, 0x70, 0x36, 0x6e, 0xcb, 0x0b, 0xd1, 0xab, 0x87, 0xbb, 0x55, 0x78, 0x9d, 0x09, 0x30,
-	0x16, 0x64, 0x37, 0x0d, 0x93, 0xf7, 0x7f, 0xbf, 0x3f, 0xd0, 0xd5, 0x4f, 0x00, 0x00, 0x00, 0xff,
-	0xff, 0x8e, 0x12, 0x0c, 0x8c, 0x8f, 0x02, 0x00, 0x00,
+func init() { proto.RegisterFile("control.proto", fileDescriptor_control_74ea664fc2c8a4f4) }
+
+var fileDescriptor_control_74ea664fc2c8a4f4 = []byte{
+	// 323 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x6d, 0x92, 0x4d, 0x4e, 0xc3, 0x30,
+	0x10, 0x85, 0x41, 0xaa, 0x10, 0xb8, 0x4d, 0x11, 0x06, 0x54, 0x91, 0x25, 0x07, 0x88, 0x0a, 0x2c,
+	0xd8, 0x20, 0x21, 0x28, 0xa4, 0x0b, 0x28, 0xaa, 0x5a, 0x71, 0x00, 0x13, 0xdc, 0xd4, 0xc2, 0x3f,
+	0x91, 0x3d, 0x45, 0xea, 0xad, 0x39, 0x02, 0x76, 0xed, 0x96, 0x38, 0x64, 0x97, 0x79, 0xf3, 0xde,
+	0x37, 0x23, 0x4f, 0x50, 0x52, 0x28, 0x09, 0x5a, 0xf1, 0xac, 0xd2, 0x0a, 0x14, 0xee, 0x88, 0x52,
+	0x40, 0xda, 0x2b, 0x94, 0x10, 0x4a, 0x7a, 0x2d, 0x4d, 0x0c, 0x28, 0x4d, 0x4a, 0x1a, 0xca, 0xfe,
+	0x82, 0x12, 0x58, 0x69, 0x6a, 0x42, 0x7d, 0x64, 0xf4, 0xb7, 0xff, 0xbc, 0xfe, 0xe9, 0xa0, 0xee,
+	0xc4, 0x02, 0x46, 0x9e, 0x89, 0xef, 0x51, 0x77, 0x5e, 0x10, 0x39, 0xf7, 0x79, 0x3c, 0xc8, 0x1c,
+	0x3d, 0xab, 0x49, 0x53, 0xa2, 0x89, 0x30, 0xe9, 0xf9, 0xbf, 0xc6, 0x8c, 0x9a, 0xea, 0x72, 0x0f,
+	0x8f, 0x51, 0x92, 0x2b, 0x2d, 0x08, 0x6c, 0x11, 0x17, 0xde, 0x19, 0x89, 0x01, 0x32, 0x68, 0x69,
+	0x79, 0xcc, 0x70, 0xdf, 0x81, 0xde, 0xab, 0x4f, 0x02, 0xb4, 0x01, 0x8a, 0xc4, 0x18, 0x14, 0xb5,
+	0xea, 0xa0, 0xc7, 0x95, 0x96, 0x4c, 0x36, 0x40, 0x91, 0x18, 0x83, 0xa2, 0xd6, 0x0e, 0x34, 0x44,
+	0x87, 0x2f, 0x8c, 0xf3, 0x19, 0x91, 0x5f, 0xb8, 0xef, 0x8d, 0x4f, 0x44, 0x19, 0x57, 0xa7, 0xb8,
+	0x56, 0x5b, 0xbf, 0x92, 0x86, 0xda, 0xc7, 0xb8, 0x45, 0x68, 0x4c, 0x61, 0x42, 0x41, 0xb3, 0xc2,
+	0xe0, 0x13, 0xef, 0x79, 0x16, 0x15, 0xac, 0xc3, 0xbc, 0x33, 0x2f, 0xfd, 0x99, 0xc2, 0x2b, 0xde,
+	0xa1, 0xd3, 0x9c, 0x42, 0xb1, 0xcc, 0x99, 0xb2, 0x97, 0x59, 0xb0, 0x72, 0x4a, 0x60, 0xd9, 0x4a,
+	0x08, 0x8b, 0xe4, 0x8c, 0x53, 0xe7, 0x09, 0x8b, 0xba, 0xb1, 0xb9, 0x3f, 0xfa, 0x36, 0x14, 0xca,
+	0x37, 0x22, 0x68, 0x9a, 0x44, 0xd2, 0x66, 0xd1, 0xe3, 0x57, 0x66, 0xe0, 0x81, 0xf3, 0xa0, 0xb5,
+	0xce, 0x6a, 0xc6, 0xec, 0xa8, 0x2b, 0xd4, 0x73, 0xc1, 0x5d, 0x2a, 0xac, 0x33, 0xb2, 0x77, 0x28,
+	0x95, 0x5e, 0xb7, 0x44, 0x3e, 0x0e, 0x36, 0x7f, 0xde, 0xcd, 0x2f, 0xb4, 0xce, 0x8c, 0x94, 0xc8,
+	0x02, 0x00, 0x00,
 }
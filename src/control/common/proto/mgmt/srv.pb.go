@@ -44,7 +44,7 @@ func (x DaosRequestStatus) String() string {
 	return proto.EnumName(DaosRequestStatus_name, int32(x))
 }
 func (DaosRequestStatus) EnumDescriptor() ([]byte, []int) {
-	return fileDescriptor_srv_4a8657ce0239cb25, []int{0}
+	return fileDescriptor_srv_57b959064cc48f07, []int{0}
 }
 
 // Identifier for server rank within DAOS pool
@@ -60,7 +60,7 @@ func (m *DaosRank) Reset()         { *m = DaosRank{} }
 func (m *DaosRank) String() string { return proto.CompactTextString(m) }
 func (*DaosRank) ProtoMessage()    {}
 func (*DaosRank) Descriptor() ([]byte, []int) {
-	return fileDescriptor_srv_4a8657ce0239cb25, []int{0}
+	return fileDescriptor_srv_57b959064cc48f07, []int{0}
 }
 func (m *DaosRank) XXX_Unmarshal(b []byte) error {
 	return xxx_messageInfo_DaosRank.Unmarshal(m, b)
@@ -105,7 +105,7 @@ func (m *DaosResponse) Reset()         { *m = DaosResponse{} }
 func (m *DaosResponse) String() string { return proto.CompactTextString(m) }
 func (*DaosResponse) ProtoMessage()    {}
 func (*DaosResponse) Descriptor() ([]byte, []int) {
-	return fileDescriptor_srv_4a8657ce0239cb25, []int{1}
+	return fileDescriptor_srv_57b959064cc48f07, []int{1}
 }
 func (m *DaosResponse) XXX_Unmarshal(b []byte) error {
 	return xxx_messageInfo_DaosResponse.Unmarshal(m, b)
@@ -143,7 +143,7 @@ func (m *SetRankReq) Reset()         { *m = SetRankReq{} }
 func (m *SetRankReq) String() string { return proto.CompactTextString(m) }
 func (*SetRankReq) ProtoMessage()    {}
 func (*SetRankReq) Descriptor() ([]byte, []int) {
-	return fileDescriptor_srv_4a8657ce0239cb25, []int{2}
+	return fileDescriptor_srv_57b959064cc48f07, []int{2}
 }
 func (m *SetRankReq) XXX_Unmarshal(b []byte) error {
 	return xxx_messageInfo_SetRankReq.Unmarshal(m, b)
@@ -183,7 +183,7 @@ func (m *CreateMsReq) Reset()         { *m = CreateMsReq{} }
 func (m *CreateMsReq) String() string { return proto.CompactTextString(m) }
 func (*CreateMsReq) ProtoMessage()    {}
 func (*CreateMsReq) Descriptor() ([]byte, []int) {
-	return fileDescriptor_srv_4a8657ce0239cb25, []int{3}
+	return fileDescriptor_srv_57b959064cc48f07, []int{3}
 }
 func (m *CreateMsReq) XXX_Unmarshal(b []byte) error {
 	return xxx_messageInfo_CreateMsReq.Unmarshal(m, b)
@@ -224,34 +224,172 @@ func (m *CreateMsReq) GetAddr() string {
 	return ""
 }
 
+// Metric is a counter or histogram of an IO server, summed up over all
+// xstreams.
+type Metric struct {
+	Name      string `protobuf:"bytes,1,opt,name=name,proto3" json:"name,omitempty"`
+	Histogram bool   `protobuf:"varint,2,opt,name=histogram,proto3" json:"histogram,omitempty"`
+	// Counter value, or sample count of histogram.
+	Value uint64 `protobuf:"varint,3,opt,name=value,proto3" json:"value,omitempty"`
+	// Sum of the samples of histogram.
+	Sum uint64 `protobuf:"varint,4,opt,name=sum,proto3" json:"sum,omitempty"`
+	// Lower bounds and sample counts of non-empty histogram buckets.
+	Bounds               []uint64 `protobuf:"varint,5,rep,packed,name=bounds,proto3" json:"bounds,omitempty"`
+	Counts               []uint64 `protobuf:"varint,6,rep,packed,name=counts,proto3" json:"counts,omitempty"`
+	XXX_NoUnkeyedLiteral struct{} `json:"-"`
+	XXX_unrecognized     []byte   `json:"-"`
+	XXX_sizecache        int32    `json:"-"`
+}
+
+func (m *Metric) Reset()         { *m = Metric{} }
+func (m *Metric) String() string { return proto.CompactTextString(m) }
+func (*Metric) ProtoMessage()    {}
+func (*Metric) Descriptor() ([]byte, []int) {
+	return fileDescriptor_srv_57b959064cc48f07, []int{4}
+}
+func (m *Metric) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_Metric.Unmarshal(m, b)
+}
+func (m *Metric) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_Metric.Marshal(b, m, deterministic)
+}
+func (dst *Metric) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_Metric.Merge(dst, src)
+}
+func (m *Metric) XXX_Size() int {
+	return xxx_messageInfo_Metric.Size(m)
+}
+func (m *Metric) XXX_DiscardUnknown() {
+	xxx_messageInfo_Metric.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_Metric proto.InternalMessageInfo
+
+func (m *Metric) GetName() string {
+	if m != nil {
+		return m.Name
+	}
+	return ""
+}
+
+func (m *Metric) GetHistogram() bool {
+	if m != nil {
+		return m.Histogram
+	}
+	return false
+}
+
+func (m *Metric) GetValue() uint64 {
+	if m != nil {
+		return m.Value
+	}
+	return 0
+}
+
+func (m *Metric) GetSum() uint64 {
+	if m != nil {
+		return m.Sum
+	}
+	return 0
+}
+
+func (m *Metric) GetBounds() []uint64 {
+	if m != nil {
+		return m.Bounds
+	}
+	return nil
+}
+
+func (m *Metric) GetCounts() []uint64 {
+	if m != nil {
+		return m.Counts
+	}
+	return nil
+}
+
+type GetMetricsResp struct {
+	Status               int32     `protobuf:"varint,1,opt,name=status,proto3" json:"status,omitempty"`
+	Metrics              []*Metric `protobuf:"bytes,2,rep,name=metrics,proto3" json:"metrics,omitempty"`
+	XXX_NoUnkeyedLiteral struct{}  `json:"-"`
+	XXX_unrecognized     []byte    `json:"-"`
+	XXX_sizecache        int32     `json:"-"`
+}
+
+func (m *GetMetricsResp) Reset()         { *m = GetMetricsResp{} }
+func (m *GetMetricsResp) String() string { return proto.CompactTextString(m) }
+func (*GetMetricsResp) ProtoMessage()    {}
+func (*GetMetricsResp) Descriptor() ([]byte, []int) {
+	return fileDescriptor_srv_57b959064cc48f07, []int{5}
+}
+func (m *GetMetricsResp) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_GetMetricsResp.Unmarshal(m, b)
+}
+func (m *GetMetricsResp) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_GetMetricsResp.Marshal(b, m, deterministic)
+}
+func (dst *GetMetricsResp) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_GetMetricsResp.Merge(dst, src)
+}
+func (m *GetMetricsResp) XXX_Size() int {
+	return xxx_messageInfo_GetMetricsResp.Size(m)
+}
+func (m *GetMetricsResp) XXX_DiscardUnknown() {
+	xxx_messageInfo_GetMetricsResp.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_GetMetricsResp proto.InternalMessageInfo
+
+func (m *GetMetricsResp) GetStatus() int32 {
+	if m != nil {
+		return m.Status
+	}
+	return 0
+}
+
+func (m *GetMetricsResp) GetMetrics() []*Metric {
+	if m != nil {
+		return m.Metrics
+	}
+	return nil
+}
+
 func init() {
 	proto.RegisterType((*DaosRank)(nil), "mgmt.DaosRank")
 	proto.RegisterType((*DaosResponse)(nil), "mgmt.DaosResponse")
 	proto.RegisterType((*SetRankReq)(nil), "mgmt.SetRankReq")
 	proto.RegisterType((*CreateMsReq)(nil), "mgmt.CreateMsReq")
+	proto.RegisterType((*Metric)(nil), "mgmt.Metric")
+	proto.RegisterType((*GetMetricsResp)(nil), "mgmt.GetMetricsResp")
 	proto.RegisterEnum("mgmt.DaosRequestStatus", DaosRequestStatus_name, DaosRequestStatus_value)
 }
 
-func init() { proto.RegisterFile("srv.proto", fileDescriptor_srv_4a8657ce0239cb25) }
-
-var fileDescriptor_srv_4a8657ce0239cb25 = []byte{
-	// 276 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x74, 0x50, 0xcd, 0x4b, 0xc3, 0x30,
-	0x1c, 0xb5, 0x73, 0xcc, 0xf6, 0x57, 0x95, 0x9a, 0x8b, 0x05, 0x15, 0x4a, 0x4f, 0xc3, 0x43, 0x05,
-	0x3d, 0x7a, 0x90, 0xd1, 0xee, 0x50, 0xa6, 0x11, 0x12, 0xa2, 0xc7, 0x92, 0xd1, 0x20, 0x63, 0xae,
-	0xe9, 0xf2, 0x21, 0xfe, 0xf3, 0x7e, 0x90, 0x4c, 0xa7, 0x20, 0xe6, 0xf4, 0x78, 0xef, 0xfd, 0xde,
-	0x7b, 0x04, 0x22, 0xad, 0x5e, 0x8a, 0x5e, 0x49, 0x23, 0xd1, 0x70, 0xf5, 0xb4, 0x32, 0xf9, 0x35,
-	0x84, 0x15, 0x97, 0x9a, 0xf0, 0x6e, 0x89, 0x4e, 0x20, 0xea, 0xa5, 0x7c, 0x6e, 0xac, 0x5d, 0xb4,
-	0x69, 0x90, 0x05, 0xe3, 0x88, 0x84, 0x8e, 0x60, 0x76, 0xd1, 0x22, 0x04, 0x43, 0xc5, 0xbb, 0x65,
-	0x3a, 0xc8, 0x82, 0xf1, 0x01, 0xf1, 0x38, 0xbf, 0x81, 0x7d, 0x7f, 0x2c, 0x74, 0x2f, 0x3b, 0x2d,
-	0xd0, 0x05, 0x8c, 0xb4, 0xe1, 0xc6, 0x6a, 0x7f, 0x7d, 0x78, 0x79, 0x5c, 0xb8, 0x8e, 0x62, 0xe3,
-	0x59, 0x5b, 0xa1, 0x0d, 0xf5, 0x32, 0xf9, 0xb2, 0xe5, 0x19, 0x00, 0x15, 0xc6, 0x95, 0x13, 0xb1,
-	0xde, 0x56, 0x04, 0xbf, 0x2a, 0x28, 0xc4, 0xa5, 0x12, 0xdc, 0x88, 0x3b, 0x17, 0x81, 0x4e, 0x21,
-	0x9a, 0x4b, 0x69, 0xb4, 0x51, 0xbc, 0xf7, 0xbe, 0x90, 0xfc, 0x10, 0x2e, 0xc0, 0x6f, 0x1f, 0xf8,
-	0xed, 0x1e, 0x3b, 0x8e, 0xb7, 0xad, 0x4a, 0x77, 0x37, 0x9c, 0xc3, 0xe7, 0xaf, 0x70, 0xf4, 0x67,
-	0x13, 0x8a, 0x61, 0x8f, 0xb2, 0xb2, 0x9c, 0x52, 0x9a, 0xec, 0xa0, 0x14, 0xe2, 0x29, 0x21, 0x0d,
-	0xc3, 0x33, 0x7c, 0xff, 0x88, 0x93, 0x8f, 0xef, 0x17, 0xa0, 0x33, 0x48, 0x9c, 0x52, 0xe3, 0x87,
-	0xc9, 0x6d, 0x5d, 0x35, 0x64, 0x82, 0x67, 0xc9, 0xfb, 0xbf, 0x32, 0x63, 0x75, 0x95, 0xbc, 0x6d,
-	0xe5, 0xf9, 0xc8, 0xff, 0xfd, 0xd5, 0x67, 0x00, 0x00, 0x00, 0xff, 0xff, 0x49, 0x36, 0x3e, 0x25,
-	0x88, 0x01, 0x00, 0x00,
+func init() { proto.RegisterFile("srv.proto", fileDescriptor_srv_57b959064cc48f07) }
+
+var fileDescriptor_srv_57b959064cc48f07 = []byte{
+	// 385 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x75, 0x52, 0x4d, 0x4f, 0xc2, 0x40,
+	0x10, 0xb5, 0x7c, 0x14, 0x98, 0xa2, 0xa9, 0x1b, 0xa3, 0x4d, 0xd4, 0x84, 0xf4, 0x60, 0x88, 0x07,
+	0x4c, 0xf0, 0xe8, 0xc1, 0x10, 0x20, 0x86, 0x20, 0xd5, 0x6c, 0x53, 0x3d, 0x92, 0x85, 0x6e, 0x90,
+	0x48, 0xbb, 0xb8, 0xbb, 0x25, 0xfe, 0x0e, 0xff, 0xaf, 0x1f, 0xdd, 0x5d, 0x40, 0x12, 0x63, 0x4f,
+	0x6f, 0xde, 0x7b, 0x33, 0x6f, 0x76, 0x52, 0xa8, 0x09, 0xbe, 0x6a, 0x2d, 0x39, 0x93, 0x0c, 0x95,
+	0x92, 0x59, 0x22, 0xfd, 0x1b, 0xa8, 0xf6, 0x08, 0x13, 0x98, 0xa4, 0xaf, 0xe8, 0x14, 0x6a, 0x4b,
+	0xc6, 0x16, 0xe3, 0x2c, 0x9b, 0xc7, 0x9e, 0xd5, 0xb0, 0x9a, 0x35, 0x5c, 0x55, 0x44, 0x94, 0xd7,
+	0x08, 0x41, 0x89, 0xe7, 0x26, 0xaf, 0x90, 0xf3, 0xfb, 0x58, 0x63, 0xff, 0x16, 0xea, 0xba, 0x99,
+	0x8a, 0x25, 0x4b, 0x05, 0x45, 0x57, 0x60, 0x0b, 0x49, 0x64, 0x26, 0x74, 0xf7, 0x41, 0xfb, 0xa4,
+	0xa5, 0x32, 0x5a, 0xc6, 0xf3, 0x96, 0x51, 0x21, 0x43, 0x2d, 0xe3, 0xb5, 0xcd, 0x6f, 0x00, 0x84,
+	0x54, 0xaa, 0xf0, 0x5c, 0xdf, 0x46, 0x58, 0x3b, 0x11, 0x21, 0x38, 0x5d, 0x4e, 0x89, 0xa4, 0x23,
+	0x35, 0x02, 0x9d, 0x41, 0x6d, 0xc2, 0x98, 0x14, 0x92, 0x93, 0xa5, 0xf6, 0x55, 0xf1, 0x2f, 0xa1,
+	0x06, 0xe8, 0xdd, 0x0b, 0x7a, 0x77, 0x8d, 0x15, 0x47, 0xe2, 0x98, 0x7b, 0x45, 0xc3, 0x29, 0xec,
+	0x7f, 0x58, 0x60, 0x8f, 0xa8, 0xe4, 0xf3, 0xa9, 0x92, 0x53, 0x92, 0xd0, 0xf5, 0x73, 0x35, 0x56,
+	0x21, 0x2f, 0x73, 0x21, 0xd9, 0x8c, 0x93, 0x44, 0xcf, 0xca, 0x43, 0xb6, 0x04, 0x3a, 0x82, 0xf2,
+	0x8a, 0x2c, 0x32, 0xaa, 0x27, 0x96, 0xb0, 0x29, 0x90, 0x0b, 0x45, 0x91, 0x25, 0x5e, 0x49, 0x73,
+	0x0a, 0xa2, 0x63, 0xb0, 0x27, 0x2c, 0x4b, 0x63, 0xe1, 0x95, 0x1b, 0xc5, 0x9c, 0x5c, 0x57, 0x8a,
+	0x9f, 0xe6, 0x48, 0x0a, 0xcf, 0x36, 0xbc, 0xa9, 0xfc, 0x47, 0x38, 0xb8, 0xa3, 0xd2, 0xac, 0xa5,
+	0x4f, 0xaa, 0x9c, 0x3b, 0xe7, 0x2c, 0x6f, 0xae, 0x86, 0x2e, 0xa0, 0x92, 0x18, 0x5b, 0xbe, 0x5d,
+	0xb1, 0xe9, 0xb4, 0xeb, 0xe6, 0xce, 0xa6, 0x17, 0x6f, 0xc4, 0xcb, 0x77, 0x38, 0xfc, 0x73, 0x7a,
+	0xe4, 0x40, 0x25, 0x8c, 0xba, 0xdd, 0x7e, 0x18, 0xba, 0x7b, 0xc8, 0x03, 0xa7, 0x8f, 0xf1, 0x38,
+	0x0a, 0x86, 0xc1, 0xc3, 0x73, 0xe0, 0x7e, 0x6f, 0x3e, 0x0b, 0x9d, 0x83, 0xab, 0x94, 0x41, 0xf0,
+	0xd4, 0xb9, 0x1f, 0xf4, 0xc6, 0xb8, 0x13, 0x0c, 0xdd, 0xaf, 0x7f, 0xe5, 0x28, 0x1a, 0xf4, 0xdc,
+	0xcf, 0xad, 0x3c, 0xb1, 0xf5, 0x2f, 0x76, 0xfd, 0x03, 0x75, 0x83, 0x57, 0x34, 0x6f, 0x02, 0x00,
+	0x00,
 }
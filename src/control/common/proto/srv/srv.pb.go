@@ -30,7 +30,7 @@ func (m *NotifyReadyReq) Reset()         { *m = NotifyReadyReq{} }
 func (m *NotifyReadyReq) String() string { return proto.CompactTextString(m) }
 func (*NotifyReadyReq) ProtoMessage()    {}
 func (*NotifyReadyReq) Descriptor() ([]byte, []int) {
-	return fileDescriptor_srv_064e53ee8ccaf2f4, []int{0}
+	return fileDescriptor_srv_5fcc6fc1e316794f, []int{0}
 }
 func (m *NotifyReadyReq) XXX_Unmarshal(b []byte) error {
 	return xxx_messageInfo_NotifyReadyReq.Unmarshal(m, b)
@@ -64,19 +64,157 @@ func (m *NotifyReadyReq) GetNctxs() uint32 {
 	return 0
 }
 
+// Metric is a counter or histogram summed up over all xstreams.
+type Metric struct {
+	Name      string `protobuf:"bytes,1,opt,name=name,proto3" json:"name,omitempty"`
+	Histogram bool   `protobuf:"varint,2,opt,name=histogram,proto3" json:"histogram,omitempty"`
+	// Counter value, or sample count of histogram.
+	Value uint64 `protobuf:"varint,3,opt,name=value,proto3" json:"value,omitempty"`
+	// Sum of the samples of histogram.
+	Sum uint64 `protobuf:"varint,4,opt,name=sum,proto3" json:"sum,omitempty"`
+	// Lower bounds and sample counts of non-empty histogram buckets.
+	Bounds               []uint64 `protobuf:"varint,5,rep,packed,name=bounds,proto3" json:"bounds,omitempty"`
+	Counts               []uint64 `protobuf:"varint,6,rep,packed,name=counts,proto3" json:"counts,omitempty"`
+	XXX_NoUnkeyedLiteral struct{} `json:"-"`
+	XXX_unrecognized     []byte   `json:"-"`
+	XXX_sizecache        int32    `json:"-"`
+}
+
+func (m *Metric) Reset()         { *m = Metric{} }
+func (m *Metric) String() string { return proto.CompactTextString(m) }
+func (*Metric) ProtoMessage()    {}
+func (*Metric) Descriptor() ([]byte, []int) {
+	return fileDescriptor_srv_5fcc6fc1e316794f, []int{1}
+}
+func (m *Metric) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_Metric.Unmarshal(m, b)
+}
+func (m *Metric) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_Metric.Marshal(b, m, deterministic)
+}
+func (dst *Metric) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_Metric.Merge(dst, src)
+}
+func (m *Metric) XXX_Size() int {
+	return xxx_messageInfo_Metric.Size(m)
+}
+func (m *Metric) XXX_DiscardUnknown() {
+	xxx_messageInfo_Metric.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_Metric proto.InternalMessageInfo
+
+func (m *Metric) GetName() string {
+	if m != nil {
+		return m.Name
+	}
+	return ""
+}
+
+func (m *Metric) GetHistogram() bool {
+	if m != nil {
+		return m.Histogram
+	}
+	return false
+}
+
+func (m *Metric) GetValue() uint64 {
+	if m != nil {
+		return m.Value
+	}
+	return 0
+}
+
+func (m *Metric) GetSum() uint64 {
+	if m != nil {
+		return m.Sum
+	}
+	return 0
+}
+
+func (m *Metric) GetBounds() []uint64 {
+	if m != nil {
+		return m.Bounds
+	}
+	return nil
+}
+
+func (m *Metric) GetCounts() []uint64 {
+	if m != nil {
+		return m.Counts
+	}
+	return nil
+}
+
+type GetMetricsResp struct {
+	Status               int32     `protobuf:"varint,1,opt,name=status,proto3" json:"status,omitempty"`
+	Metrics              []*Metric `protobuf:"bytes,2,rep,name=metrics,proto3" json:"metrics,omitempty"`
+	XXX_NoUnkeyedLiteral struct{}  `json:"-"`
+	XXX_unrecognized     []byte    `json:"-"`
+	XXX_sizecache        int32     `json:"-"`
+}
+
+func (m *GetMetricsResp) Reset()         { *m = GetMetricsResp{} }
+func (m *GetMetricsResp) String() string { return proto.CompactTextString(m) }
+func (*GetMetricsResp) ProtoMessage()    {}
+func (*GetMetricsResp) Descriptor() ([]byte, []int) {
+	return fileDescriptor_srv_5fcc6fc1e316794f, []int{2}
+}
+func (m *GetMetricsResp) XXX_Unmarshal(b []byte) error {
+	return xxx_messageInfo_GetMetricsResp.Unmarshal(m, b)
+}
+func (m *GetMetricsResp) XXX_Marshal(b []byte, deterministic bool) ([]byte, error) {
+	return xxx_messageInfo_GetMetricsResp.Marshal(b, m, deterministic)
+}
+func (dst *GetMetricsResp) XXX_Merge(src proto.Message) {
+	xxx_messageInfo_GetMetricsResp.Merge(dst, src)
+}
+func (m *GetMetricsResp) XXX_Size() int {
+	return xxx_messageInfo_GetMetricsResp.Size(m)
+}
+func (m *GetMetricsResp) XXX_DiscardUnknown() {
+	xxx_messageInfo_GetMetricsResp.DiscardUnknown(m)
+}
+
+var xxx_messageInfo_GetMetricsResp proto.InternalMessageInfo
+
+func (m *GetMetricsResp) GetStatus() int32 {
+	if m != nil {
+		return m.Status
+	}
+	return 0
+}
+
+func (m *GetMetricsResp) GetMetrics() []*Metric {
+	if m != nil {
+		return m.Metrics
+	}
+	return nil
+}
+
 func init() {
 	proto.RegisterType((*NotifyReadyReq)(nil), "srv.NotifyReadyReq")
+	proto.RegisterType((*Metric)(nil), "srv.Metric")
+	proto.RegisterType((*GetMetricsResp)(nil), "srv.GetMetricsResp")
 }
 
-func init() { proto.RegisterFile("srv.proto", fileDescriptor_srv_064e53ee8ccaf2f4) }
+func init() { proto.RegisterFile("srv.proto", fileDescriptor_srv_5fcc6fc1e316794f) }
 
-var fileDescriptor_srv_064e53ee8ccaf2f4 = []byte{
-	// 97 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xe2, 0xe2, 0x2c, 0x2e, 0x2a, 0xd3,
-	0x2b, 0x28, 0xca, 0x2f, 0xc9, 0x17, 0x62, 0x2e, 0x2e, 0x2a, 0x53, 0xb2, 0xe0, 0xe2, 0xf3, 0xcb,
-	0x2f, 0xc9, 0x4c, 0xab, 0x0c, 0x4a, 0x4d, 0x4c, 0xa9, 0x0c, 0x4a, 0x2d, 0x14, 0x12, 0xe0, 0x62,
-	0x2e, 0x2d, 0xca, 0x94, 0x60, 0x54, 0x60, 0xd4, 0xe0, 0x0c, 0x02, 0x31, 0x85, 0x44, 0xb8, 0x58,
-	0xf3, 0x92, 0x4b, 0x2a, 0x8a, 0x25, 0x98, 0x14, 0x18, 0x35, 0x78, 0x83, 0x20, 0x9c, 0x24, 0x36,
-	0xb0, 0x29, 0xc6, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0x0e, 0x62, 0xdc, 0x0f, 0x52, 0x00, 0x00,
-	0x00,
+var fileDescriptor_srv_5fcc6fc1e316794f = []byte{
+	// 237 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x44, 0x90, 0xc1, 0x4a, 0xc4, 0x30,
+	0x10, 0x86, 0xc9, 0xa6, 0xad, 0x76, 0x16, 0x17, 0x09, 0x22, 0x39, 0x78, 0x08, 0x05, 0x21, 0xa7,
+	0x3d, 0xe8, 0xc5, 0x37, 0xf0, 0xa4, 0xc2, 0xbc, 0x41, 0xb6, 0x1b, 0xb5, 0x60, 0x9b, 0x35, 0x93,
+	0x14, 0xfb, 0x1a, 0x3e, 0xb1, 0x24, 0xa9, 0xec, 0xed, 0xff, 0xfe, 0xcc, 0x9f, 0x19, 0x7e, 0x68,
+	0xc9, 0xcf, 0xfb, 0x93, 0x77, 0xc1, 0x09, 0x4e, 0x7e, 0xee, 0x9e, 0x60, 0xf7, 0xea, 0xc2, 0xf0,
+	0xbe, 0xa0, 0x35, 0xc7, 0x05, 0xed, 0xb7, 0xb8, 0x06, 0x1e, 0xfd, 0x20, 0x99, 0x62, 0xba, 0xc5,
+	0x24, 0xc5, 0x0d, 0xd4, 0x53, 0x1f, 0x7e, 0x48, 0x6e, 0x14, 0xd3, 0x57, 0x58, 0xa0, 0xfb, 0x65,
+	0xd0, 0xbc, 0xd8, 0xe0, 0x87, 0x5e, 0x08, 0xa8, 0x26, 0x33, 0xda, 0x35, 0x93, 0xb5, 0xb8, 0x83,
+	0xf6, 0x73, 0xa0, 0xe0, 0x3e, 0xbc, 0x19, 0x73, 0xf0, 0x12, 0xcf, 0x46, 0xfa, 0x72, 0x36, 0x5f,
+	0xd1, 0x4a, 0xae, 0x98, 0xae, 0xb0, 0x40, 0x5a, 0x4d, 0x71, 0x94, 0x55, 0xf6, 0x92, 0x14, 0xb7,
+	0xd0, 0x1c, 0x5c, 0x9c, 0x8e, 0x24, 0x6b, 0xc5, 0x75, 0x85, 0x2b, 0x25, 0xbf, 0x77, 0x71, 0x0a,
+	0x24, 0x9b, 0xe2, 0x17, 0xea, 0xde, 0x60, 0xf7, 0x6c, 0x43, 0x39, 0x8b, 0xd0, 0xd2, 0x29, 0x4d,
+	0x52, 0x30, 0x21, 0x52, 0xbe, 0xae, 0xc6, 0x95, 0xc4, 0x3d, 0x5c, 0x8c, 0x65, 0x4c, 0x6e, 0x14,
+	0xd7, 0xdb, 0x87, 0xed, 0x3e, 0x55, 0x53, 0xa2, 0xf8, 0xff, 0x76, 0x68, 0x72, 0x57, 0x8f, 0x7f,
+	0x01, 0x00, 0x00, 0xff, 0xff, 0x27, 0x35, 0x7c, 0x0a, 0x38, 0x01, 0x00, 0x00,
 }
@@ -37,6 +37,19 @@ func MockFeaturePB() *pb.Feature {
 	}
 }
 
+// MockMetricPB is a mock protobuf Metric message used in tests for multiple
+// packages.
+func MockMetricPB() *pb.Metric {
+	return &pb.Metric{
+		Name:      "obj_update_latency",
+		Histogram: true,
+		Value:     3,
+		Sum:       1200,
+		Bounds:    []uint64{256, 512},
+		Counts:    []uint64{2, 1},
+	}
+}
+
 // MockNamespacePB is a mock protobuf Namespace message used in tests for
 // multiple packages.
 func MockNamespacePB() *pb.NvmeController_Namespace {
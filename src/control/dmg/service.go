@@ -30,7 +30,8 @@ import (
 
 // SvcCmd is the struct representing the top-level service subcommand.
 type SvcCmd struct {
-	KillRank KillRankSvcCmd `command:"kill-rank" alias:"kr" description:"Terminate server running as specific rank on a DAOS pool"`
+	KillRank   KillRankSvcCmd   `command:"kill-rank" alias:"kr" description:"Terminate server running as specific rank on a DAOS pool"`
+	GetMetrics GetMetricsSvcCmd `command:"metrics" alias:"m" description:"Display the counters and histograms of the I/O servers"`
 }
 
 // KillRankSvcCmd is the struct representing the command to kill server
@@ -60,3 +61,26 @@ func (k *KillRankSvcCmd) Execute(args []string) error {
 	// never reached
 	return nil
 }
+
+// GetMetricsSvcCmd is the struct representing the command to display the
+// metrics of the I/O servers.
+type GetMetricsSvcCmd struct{}
+
+// run get metrics command on all connected servers
+func getMetricsSvc() {
+	fmt.Printf(unpackClientMap(conns.GetMetrics()), "I/O server metric")
+}
+
+// Execute is run when GetMetricsSvcCmd activates
+func (g *GetMetricsSvcCmd) Execute(args []string) error {
+	if err := appSetup(); err != nil {
+		return err
+	}
+
+	getMetricsSvc()
+
+	// exit immediately to avoid continuation of main
+	os.Exit(0)
+	// never reached
+	return nil
+}
@@ -198,5 +198,17 @@ func setupShell() *ishell.Shell {
 		},
 	})
 
+	shell.AddCmd(&ishell.Cmd{
+		Name: "getmetrics",
+		Help: "Command to retrieve the counters and histograms of the " +
+			"I/O servers",
+		Func: func(c *ishell.Context) {
+			_, out := hasConns(conns.GetActiveConns(nil))
+			c.Println(out)
+
+			getMetricsSvc()
+		},
+	})
+
 	return shell
 }
@@ -147,6 +147,15 @@ func unpackClientMap(i interface{}) string {
 			}
 			decoded[addr] = answer
 		}
+	case client.ClientMetricsMap:
+		for addr, res := range v {
+			if res.Err != nil {
+				decoded[addr] = res.Err.Error()
+				continue
+			}
+
+			decoded[addr] = res.Metrics
+		}
 	case client.ResultMap:
 		for addr, res := range v {
 			if res.Err != nil {
@@ -39,6 +39,7 @@ var (
 	features   = []*pb.Feature{MockFeaturePB()}
 	ctrlrs     = NvmeControllers{MockControllerPB("")}
 	modules    = ScmModules{MockModulePB()}
+	metrics    = Metrics{MockMetricPB()}
 	errExample = errors.New("something went wrong")
 )
 
@@ -113,6 +114,10 @@ func TestCheckSprint(t *testing.T) {
 			ResultMap{"1.2.3.4:10000": ClientResult{"1.2.3.4:10000", nil, errExample}, "1.2.3.5:10001": ClientResult{"1.2.3.5:10001", nil, errExample}},
 			"Listing %[1]ss on connected storage servers:\n1.2.3.4:10000: something went wrong\n1.2.3.5:10001: something went wrong\n\n\n",
 		},
+		{
+			NewClientMetrics(metrics, addresses),
+			"Listing %[1]ss on connected storage servers:\n1.2.3.4:10000:\n- name: obj_update_latency\n  histogram: true\n  value: 3\n  sum: 1200\n  bounds:\n  - 256\n  - 512\n  counts:\n  - 2\n  - 1\n1.2.3.5:10001:\n- name: obj_update_latency\n  histogram: true\n  value: 3\n  sum: 1200\n  bounds:\n  - 256\n  - 512\n  counts:\n  - 2\n  - 1\n\n\n",
+		},
 		{
 			NewClientMountResults(
 				[]*pb.ScmMountResult{
@@ -45,6 +45,9 @@ const (
 
 	srvModuleID = C.DRPC_MODULE_SRV
 	notifyReady = C.DRPC_METHOD_SRV_NOTIFY_READY
+
+	iosrvModuleID = C.DRPC_MODULE_IOSRV
+	getMetrics    = C.DRPC_METHOD_IOSRV_GET_METRICS
 )
 
 // mgmtModule is the management drpc module struct
@@ -25,6 +25,7 @@ package main
 
 import (
 	pb "github.com/daos-stack/daos/src/control/common/proto/mgmt"
+	srvpb "github.com/daos-stack/daos/src/control/common/proto/srv"
 	"github.com/daos-stack/daos/src/control/log"
 	"github.com/golang/protobuf/proto"
 	"github.com/pkg/errors"
@@ -60,3 +61,36 @@ func (c *controlService) KillRank(
 
 	return c.callDrpcMethodWithMessage(killRank, rank)
 }
+
+// GetMetrics implements the method defined for the MgmtControl protobuf
+// service. It retrieves the counters and histograms registered by the modules
+// of the I/O server, each of them is summed up over all xstreams.
+func (c *controlService) GetMetrics(
+	ctx context.Context, params *pb.EmptyParams) (*pb.GetMetricsResp, error) {
+
+	log.Debugf("ControlService.GetMetrics dispatch")
+
+	drpcResp, err := makeDrpcCall(c.drpc, iosrvModuleID, getMetrics, nil)
+	if err != nil {
+		return nil, errors.WithStack(err)
+	}
+
+	srvResp := &srvpb.GetMetricsResp{}
+	if err = proto.Unmarshal(drpcResp.Body, srvResp); err != nil {
+		return nil, errors.Errorf("invalid dRPC response body: %v", err)
+	}
+
+	resp := &pb.GetMetricsResp{Status: srvResp.Status}
+	for _, m := range srvResp.Metrics {
+		resp.Metrics = append(resp.Metrics, &pb.Metric{
+			Name:      m.Name,
+			Histogram: m.Histogram,
+			Value:     m.Value,
+			Sum:       m.Sum,
+			Bounds:    m.Bounds,
+			Counts:    m.Counts,
+		})
+	}
+
+	return resp, nil
+}
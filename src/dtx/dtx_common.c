@@ -39,6 +39,22 @@ struct dtx_batched_commit_args {
 	struct ds_pool_child	*dbca_pool;
 	struct ds_cont_child	*dbca_cont;
 	uint32_t		 dbca_shares;
+	/* The count of in-flight batched commits. */
+	uint32_t		 dbca_inflight;
+	/* The count of the DTXs in the in-flight batched commits. */
+	uint32_t		 dbca_inflight_cnt;
+	/* Set when the in-flight batched commits are all done, it is only
+	 * created by dtx_batched_commit_wait().
+	 */
+	ABT_eventual		 dbca_inflight_done;
+};
+
+struct dtx_commit_ult_args {
+	struct dtx_batched_commit_args	*dcua_dbca;
+	struct dtx_entry		*dcua_dtes;
+	int				 dcua_count;
+	/* Pool map version when the batch was built. */
+	uint32_t			 dcua_version;
 };
 
 void
@@ -87,7 +103,7 @@ dtx_flush_committable(struct dss_module_info *dmi,
 	do {
 		struct dtx_entry	*dtes = NULL;
 
-		rc = vos_dtx_fetch_committable(cont->sc_hdl,
+		rc = vos_dtx_fetch_committable(cont->sc_hdl, 0,
 					       DTX_THRESHOLD_COUNT, &dtes);
 		if (rc <= 0)
 			break;
@@ -119,6 +135,128 @@ dtx_flush_committable(struct dss_module_info *dmi,
 	}
 }
 
+static void
+dtx_commit_ult(void *arg)
+{
+	struct dtx_commit_ult_args	*dcua = arg;
+	struct dtx_batched_commit_args	*dbca = dcua->dcua_dbca;
+	struct ds_cont_child		*cont = dbca->dbca_cont;
+	int				 rc;
+
+	/* It may run on a sibling xstream until dtx_commit() brings it back
+	 * home, so only the immutable fields of dbca are used before that.
+	 */
+	rc = dtx_commit(dbca->dbca_pool->spc_uuid, cont->sc_uuid,
+			dcua->dcua_dtes, dcua->dcua_count, dcua->dcua_version);
+	if (rc < 0)
+		D_DEBUG(DB_TRACE, DF_UUID": Fail to commit %d DTXs in batch: "
+			"rc = %d\n", DP_UUID(cont->sc_uuid),
+			dcua->dcua_count, rc);
+
+	/* The uncommitted ones are still in the committable list, they will
+	 * be fetched again by the subsequent batch.
+	 */
+	D_ASSERT(dbca->dbca_inflight > 0);
+	D_ASSERT(dbca->dbca_inflight_cnt >= dcua->dcua_count);
+	dbca->dbca_inflight--;
+	dbca->dbca_inflight_cnt -= dcua->dcua_count;
+	if (dbca->dbca_inflight == 0 &&
+	    dbca->dbca_inflight_done != ABT_EVENTUAL_NULL)
+		ABT_eventual_set(dbca->dbca_inflight_done, NULL, 0);
+
+	dtx_free_committable(dcua->dcua_dtes);
+	D_FREE_PTR(dcua);
+}
+
+/**
+ * Build the next batch from the committable DTXs that are not in flight,
+ * and commit it via a dedicated ULT, then the batched commit ULT can go
+ * ahead to build the next batch (for the same or other containers) while
+ * the former one is waiting for the replies of the commit RPCs.
+ *
+ * Both the batch size and the age threshold are driven by the depth of the
+ * CoS cache: a full batch is sent as soon as there are enough committable
+ * DTXs; otherwise the age threshold is halved for each 1/8 of a full batch
+ * that is pending, so that a busy container does not keep the conflicting
+ * DTXs in the CoS cache for DTX_COMMIT_THRESHOLD_AGE.
+ *
+ * Return true if a batch has been sent.
+ */
+static bool
+dtx_batched_commit_one(struct dtx_batched_commit_args *dbca,
+		       struct dtx_stat *stat)
+{
+	struct ds_cont_child		*cont = dbca->dbca_cont;
+	struct dtx_commit_ult_args	*dcua;
+	struct dtx_entry		*dtes = NULL;
+	uint64_t			 depth;
+	uint32_t			 age;
+	int				 rc;
+
+	if (dbca->dbca_inflight >= DTX_COMMIT_PIPELINE_DEPTH)
+		return false;
+
+	if (stat->dtx_committable_count <= dbca->dbca_inflight_cnt)
+		return false;
+
+	depth = stat->dtx_committable_count - dbca->dbca_inflight_cnt;
+	if (depth < DTX_THRESHOLD_COUNT) {
+		age = DTX_COMMIT_THRESHOLD_AGE >>
+			(depth * 8 / DTX_THRESHOLD_COUNT);
+		/* The oldest committable one may be in flight, then the age
+		 * is overestimated, that only makes the batch be sent sooner.
+		 */
+		if (stat->dtx_oldest_committable_time == 0 ||
+		    dtx_hlc_age2sec(stat->dtx_oldest_committable_time) <= age)
+			return false;
+	}
+
+	rc = vos_dtx_fetch_committable(cont->sc_hdl, dbca->dbca_inflight_cnt,
+				       DTX_THRESHOLD_COUNT, &dtes);
+	if (rc <= 0)
+		return false;
+
+	D_ALLOC_PTR(dcua);
+	if (dcua == NULL) {
+		dtx_free_committable(dtes);
+		return false;
+	}
+
+	dcua->dcua_dbca = dbca;
+	dcua->dcua_dtes = dtes;
+	dcua->dcua_count = rc;
+	dcua->dcua_version = dbca->dbca_pool->spc_map_version;
+	dbca->dbca_inflight++;
+	dbca->dbca_inflight_cnt += rc;
+
+	rc = dss_ult_create(dtx_commit_ult, dcua, DSS_ULT_DTX_COMMIT,
+			    DSS_TGT_SELF, 0, NULL);
+	if (rc != 0)
+		/* Commit it synchronously. */
+		dtx_commit_ult(dcua);
+	return true;
+}
+
+/* Wait for the in-flight batched commits of the container to be done. */
+static void
+dtx_batched_commit_wait(struct dtx_batched_commit_args *dbca)
+{
+	int	rc;
+
+	if (dbca->dbca_inflight == 0)
+		return;
+
+	rc = ABT_eventual_create(0, &dbca->dbca_inflight_done);
+	if (rc != ABT_SUCCESS) {
+		while (dbca->dbca_inflight > 0)
+			ABT_thread_yield();
+		return;
+	}
+
+	ABT_eventual_wait(dbca->dbca_inflight_done, NULL);
+	ABT_eventual_free(&dbca->dbca_inflight_done);
+}
+
 void
 dtx_batched_commit(void *arg)
 {
@@ -128,7 +266,6 @@ dtx_batched_commit(void *arg)
 	while (1) {
 		ABT_bool			 state;
 		struct ds_cont_child		*cont;
-		struct dtx_entry		*dtes = NULL;
 		struct dtx_stat			 stat = { 0 };
 		int				 rc;
 
@@ -139,34 +276,21 @@ dtx_batched_commit(void *arg)
 				    struct dtx_batched_commit_args, dbca_link);
 		cont = dbca->dbca_cont;
 		if (cont->sc_closing) {
-			dtx_flush_committable(dmi, dbca);
+			/* Flush after the in-flight batches are done. */
+			if (dbca->dbca_inflight == 0)
+				dtx_flush_committable(dmi, dbca);
+			else
+				d_list_move_tail(&dbca->dbca_link,
+						 &dmi->dmi_dtx_batched_list);
 			goto check;
 		}
 
 		d_list_move_tail(&dbca->dbca_link, &dmi->dmi_dtx_batched_list);
 		vos_dtx_stat(cont->sc_hdl, &stat);
-
-		if ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
-		    (stat.dtx_oldest_committable_time != 0 &&
-		     dtx_hlc_age2sec(stat.dtx_oldest_committable_time) >
-		     DTX_COMMIT_THRESHOLD_AGE)) {
-			rc = vos_dtx_fetch_committable(cont->sc_hdl,
-						DTX_THRESHOLD_COUNT, &dtes);
-			if (rc > 0) {
-				rc = dtx_commit(dbca->dbca_pool->spc_uuid,
-					cont->sc_uuid, dtes, rc,
-					dbca->dbca_pool->spc_map_version);
-				dtx_free_committable(dtes);
-
-				if (cont->sc_closing) {
-					dtx_flush_committable(dmi, dbca);
-					goto check;
-				}
-
-				if (!cont->sc_dtx_aggregating)
-					vos_dtx_stat(cont->sc_hdl, &stat);
-			}
-		}
+		/* The committed count changes after a commit. */
+		if (dtx_batched_commit_one(dbca, &stat) &&
+		    !cont->sc_dtx_aggregating)
+			vos_dtx_stat(cont->sc_hdl, &stat);
 
 		if (!cont->sc_dtx_aggregating &&
 		    ((stat.dtx_committed_count > DTX_AGG_THRESHOLD_CNT) ||
@@ -195,6 +319,7 @@ check:
 	while (!d_list_empty(&dmi->dmi_dtx_batched_list)) {
 		dbca = d_list_entry(dmi->dmi_dtx_batched_list.next,
 				    struct dtx_batched_commit_args, dbca_link);
+		dtx_batched_commit_wait(dbca);
 		dtx_free_dbca(dbca);
 	}
 }
@@ -37,7 +37,7 @@
  * These are for daos_rpc::dr_opc and DAOS_RPC_OPCODE(opc, ...) rather than
  * crt_req_create(..., opc, ...). See src/include/daos/rpc.h.
  */
-#define DAOS_DTX_VERSION	1
+#define DAOS_DTX_VERSION	2
 
 /* LIST of internal RPCS in form of:
  * OPCODE, flags, FMT, handler, corpc_hdlr,
@@ -59,9 +59,12 @@ enum dtx_operation {
 	((uuid_t)		(di_co_uuid)		CRT_VAR)	\
 	((struct dtx_id)	(di_dtx_array)		CRT_ARRAY)
 
-/* DTX RPC output fields */
+/* DTX RPC output fields, do_sub_rets is the per-DTX state for the DTX_CHECK
+ * against multiple DTXs, otherwise do_status is the (only) DTX state.
+ */
 #define DAOS_OSEQ_DTX							\
-	((int32_t)		(do_status)		CRT_VAR)
+	((int32_t)		(do_status)		CRT_VAR)	\
+	((int32_t)		(do_sub_rets)		CRT_ARRAY)
 
 CRT_RPC_DECLARE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
 
@@ -77,6 +80,11 @@ CRT_RPC_DECLARE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
 /* The time threshould for batched DTX commit. */
 #define DTX_COMMIT_THRESHOLD_AGE	60
 
+/* The max count of in-flight batched DTX commits per container. The next
+ * batch is built and sent while the former ones are still in flight.
+ */
+#define DTX_COMMIT_PIPELINE_DEPTH	2
+
 /* The count threshould for triggerring DTX aggregation.
  * This threshould should consider the real SCM size.
  */
@@ -106,5 +114,7 @@ int dtx_abort(uuid_t po_uuid, uuid_t co_uuid,
 	      struct dtx_entry *dtes, int count, uint32_t version);
 int dtx_check(uuid_t po_uuid, uuid_t co_uuid,
 	      struct dtx_entry *dte, struct pl_obj_layout *layout);
+int dtx_check_batch(uuid_t po_uuid, uuid_t co_uuid, struct dtx_entry *dtes,
+		    struct pl_obj_layout **layouts, int count, int *results);
 
 #endif /* __DTX_INTERNAL_H__ */
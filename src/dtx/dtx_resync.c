@@ -55,6 +55,11 @@ struct dtx_resync_args {
 	uuid_t			 po_uuid;
 	struct dtx_resync_head	 tables;
 	uint32_t		 version;
+	/* Statistics for the resync progress. */
+	uint32_t		 scanned;
+	uint32_t		 committed;
+	uint32_t		 aborted;
+	uint32_t		 skipped;
 };
 
 static inline void
@@ -105,28 +110,165 @@ dtx_resync_commit(uuid_t po_uuid, struct ds_cont_child *cont,
 	return rc > 0 ? 0 : rc;
 }
 
+/* Handle the result of the DTX check for one DTX. Return 1 if the DTX is
+ * to be committed, then it is kept in the list for dtx_resync_commit().
+ */
+static int
+dtx_status_handle_one(struct dtx_resync_args *dra,
+		      struct dtx_resync_entry *dre, int rc)
+{
+	struct ds_cont_child		*cont = dra->cont;
+	struct dtx_resync_head		*drh = &dra->tables;
+	int				 rc1;
+
+	if (rc != DTX_ST_COMMITTED && rc != DTX_ST_PREPARED) {
+		/* We are not sure about whether the DTX can be
+		 * committed or not, then we have to skip it.
+		 */
+		D_WARN("Not sure about whether the DTX "DF_UOID
+		       "/"DF_DTI" can be committed or not: %d (1)\n",
+		       DP_UOID(dre->dre_oid), DP_DTI(&dre->dre_xid), rc);
+		dra->skipped++;
+		dtx_dre_release(drh, dre);
+		return 0;
+	}
+
+	/* It is possible that the current DTX becomes committable (in
+	 * CoS cache) or has been committed (on-disk) during above dtx
+	 * check remotely. Let's re-check its state locally.
+	 */
+	rc1 = vos_dtx_check_committable(cont->sc_hdl, &dre->dre_oid,
+				&dre->dre_xid, dre->dre_hash,
+				dre->dre_intent == DAOS_INTENT_PUNCH ?
+				true : false);
+	if (rc1 == DTX_ST_COMMITTED) {
+		/* The DTX is in CoS cache (committable), do nothing. */
+		dtx_dre_release(drh, dre);
+		return 0;
+	}
+
+	/* The DTX has been committed on some remote replica(s), let's
+	 * commit the it globally.
+	 */
+	if (rc == DTX_ST_COMMITTED)
+		return 1;
+
+	switch (rc1) {
+	case DTX_ST_PREPARED:
+		/* Both local and remote replicas are 'prepared', then
+		 * it is committable.
+		 */
+		if (rc == DTX_ST_PREPARED)
+			return 1;
+
+		/* If we abort multiple non-ready DTXs together, then
+		 * there is race that one DTX may become committable
+		 * when we abort some other DTX(s). To avoid complex
+		 * rollback logic, let's abort the DTXs one by one.
+		 */
+		rc = dtx_abort(dra->po_uuid, cont->sc_uuid,
+			       &dre->dre_dte, 1, dra->version);
+		dtx_dre_release(drh, dre);
+		if (rc < 0)
+			return rc;
+		dra->aborted++;
+		return 0;
+	default:
+		D_WARN("Not sure about whether the DTX "DF_UOID
+		       "/"DF_DTI" can be committed or not: %d (3)\n",
+		       DP_UOID(dre->dre_oid), DP_DTI(&dre->dre_xid), rc);
+		dra->skipped++;
+		dtx_dre_release(drh, dre);
+		return 0;
+	}
+}
+
+/* Check a batch of DTXs against the remote replicas, the committable ones
+ * are committed every DTX_THRESHOLD_COUNT, \a count is the number of the
+ * committable ones not committed yet.
+ */
+static int
+dtx_status_handle_batch(struct dtx_resync_args *dra,
+			struct dtx_resync_entry **dres,
+			struct pl_obj_layout **layouts, struct dtx_entry *dtes,
+			int *results, int nr, int *count)
+{
+	struct ds_cont_child	*cont = dra->cont;
+	struct dtx_resync_head	*drh = &dra->tables;
+	int			 err = 0;
+	int			 rc;
+	int			 rc1;
+	int			 i;
+
+	rc1 = dtx_check_batch(dra->po_uuid, cont->sc_uuid, dtes, layouts, nr,
+			      results);
+	for (i = 0; i < nr; i++) {
+		pl_obj_layout_free(layouts[i]);
+		layouts[i] = NULL;
+
+		rc = dtx_status_handle_one(dra, dres[i],
+					   rc1 < 0 ? rc1 : results[i]);
+		if (rc < 0) {
+			err = rc;
+			continue;
+		}
+
+		/* The ones before the committable DTXs in the list
+		 * have been released.
+		 */
+		if (rc == 0 || ++(*count) < DTX_THRESHOLD_COUNT)
+			continue;
+
+		rc = dtx_resync_commit(dra->po_uuid, cont, drh, *count,
+				       dra->version);
+		if (rc < 0)
+			err = rc;
+		else
+			dra->committed += *count;
+		*count = 0;
+	}
+	return err;
+}
+
 static int
 dtx_status_handle(struct dtx_resync_args *dra)
 {
 	struct ds_cont_child		*cont = dra->cont;
-	struct pl_obj_layout		*layout = NULL;
 	struct dtx_resync_head		*drh = &dra->tables;
 	struct dtx_resync_entry		*dre;
 	struct dtx_resync_entry		*next;
+	struct dtx_resync_entry		**dres = NULL;
+	struct pl_obj_layout		**layouts = NULL;
+	struct dtx_entry		*dtes = NULL;
+	int				*results = NULL;
 	int				 count = 0;
+	int				 nr = 0;
 	int				 err = 0;
 	int				 rc;
 
 	if (drh->drh_count == 0)
 		return 0;
 
-	d_list_for_each_entry_safe(dre, next, &drh->drh_list, dre_link) {
-		int	rc1;
+	/* The DTXs are checked against the remote replicas in batches, each
+	 * batch sends one DTX_CHECK RPC to each related server.
+	 */
+	D_ALLOC_ARRAY(dres, DTX_THRESHOLD_COUNT);
+	D_ALLOC_ARRAY(layouts, DTX_THRESHOLD_COUNT);
+	D_ALLOC_ARRAY(dtes, DTX_THRESHOLD_COUNT);
+	D_ALLOC_ARRAY(results, DTX_THRESHOLD_COUNT);
+	if (dres == NULL || layouts == NULL || dtes == NULL ||
+	    results == NULL) {
+		/* Drop all the scanned DTXs, they will be resynced next
+		 * time.
+		 */
+		d_list_for_each_entry_safe(dre, next, &drh->drh_list,
+					   dre_link)
+			dtx_dre_release(drh, dre);
+		D_GOTO(out, err = -DER_NOMEM);
+	}
 
-		if (layout != NULL) {
-			pl_obj_layout_free(layout);
-			layout = NULL;
-		}
+	d_list_for_each_entry_safe(dre, next, &drh->drh_list, dre_link) {
+		struct pl_obj_layout	*layout = NULL;
 
 		rc = ds_pool_check_leader(dra->po_uuid, &dre->dre_oid,
 					  dra->version, &layout);
@@ -142,80 +284,31 @@ dtx_status_handle(struct dtx_resync_args *dra)
 					DF_UOID"/"DF_DTI" (ver = %u) skip it\n",
 					DP_UOID(dre->dre_oid),
 					DP_DTI(&dre->dre_xid), dra->version);
+			if (layout != NULL)
+				pl_obj_layout_free(layout);
 			dtx_dre_release(drh, dre);
 			continue;
 		}
 
-		rc = dtx_check(dra->po_uuid, cont->sc_uuid,
-			       &dre->dre_dte, layout);
-		if (rc != DTX_ST_COMMITTED && rc != DTX_ST_PREPARED) {
-			/* We are not sure about whether the DTX can be
-			 * committed or not, then we have to skip it.
-			 */
-			D_WARN("Not sure about whether the DTX "DF_UOID
-			       "/"DF_DTI" can be committed or not: %d (1)\n",
-			       DP_UOID(dre->dre_oid),
-			       DP_DTI(&dre->dre_xid), rc);
-			dtx_dre_release(drh, dre);
+		dres[nr] = dre;
+		layouts[nr] = layout;
+		dtes[nr] = dre->dre_dte;
+		if (++nr < DTX_THRESHOLD_COUNT)
 			continue;
-		}
 
-		/* It is possible that the current DTX becomes committable (in
-		 * CoS cache) or has been committed (on-disk) during above dtx
-		 * check remotely. Let's re-check its state locally.
-		 */
-		rc1 = vos_dtx_check_committable(cont->sc_hdl, &dre->dre_oid,
-					&dre->dre_xid, dre->dre_hash,
-					dre->dre_intent == DAOS_INTENT_PUNCH ?
-					true : false);
-		if (rc1 == DTX_ST_COMMITTED) {
-			/* The DTX is in CoS cache (committable), do nothing. */
-			dtx_dre_release(drh, dre);
-			continue;
-		}
-
-		/* The DTX has been committed on some remote replica(s), let's
-		 * commit the it globally.
-		 */
-		if (rc == DTX_ST_COMMITTED)
-			goto commit;
-
-		switch (rc1) {
-		case DTX_ST_PREPARED:
-			/* Both local and remote replicas are 'prepared', then
-			 * it is committable.
-			 */
-			if (rc == DTX_ST_PREPARED)
-				goto commit;
-
-			/* If we abort multiple non-ready DTXs together, then
-			 * there is race that one DTX may become committable
-			 * when we abort some other DTX(s). To avoid complex
-			 * rollback logic, let's abort the DTXs one by one.
-			 */
-			rc = dtx_abort(dra->po_uuid, cont->sc_uuid,
-				       &dre->dre_dte, 1, dra->version);
-			dtx_dre_release(drh, dre);
-			if (rc < 0)
-				err = rc;
-			continue;
-		default:
-			D_WARN("Not sure about whether the DTX "DF_UOID
-			       "/"DF_DTI" can be committed or not: %d (3)\n",
-			       DP_UOID(dre->dre_oid),
-			       DP_DTI(&dre->dre_xid), rc);
-			dtx_dre_release(drh, dre);
-			continue;
-		}
+		rc = dtx_status_handle_batch(dra, dres, layouts, dtes, results,
+					     nr, &count);
+		if (rc < 0)
+			err = rc;
+		nr = 0;
+	}
 
-commit:
-		if (++count >= DTX_THRESHOLD_COUNT) {
-			rc = dtx_resync_commit(dra->po_uuid, cont, drh, count,
-					       dra->version);
-			if (rc < 0)
-				err = rc;
-			count = 0;
-		}
+	/* The last batch is not full */
+	if (nr > 0) {
+		rc = dtx_status_handle_batch(dra, dres, layouts, dtes, results,
+					     nr, &count);
+		if (rc < 0)
+			err = rc;
 	}
 
 	if (count > 0) {
@@ -223,11 +316,15 @@ commit:
 				       dra->version);
 		if (rc < 0)
 			err = rc;
+		else
+			dra->committed += count;
 	}
 
-	if (layout != NULL)
-		pl_obj_layout_free(layout);
-
+out:
+	D_FREE(dres);
+	D_FREE(layouts);
+	D_FREE(dtes);
+	D_FREE(results);
 	return err;
 }
 
@@ -258,6 +355,7 @@ dtx_iter_cb(uuid_t co_uuid, vos_iter_entry_t *ent, void *args)
 	dre->dre_hash = ent->ie_dtx_hash;
 	d_list_add_tail(&dre->dre_link, &dra->tables.drh_list);
 	dra->tables.drh_count++;
+	dra->scanned++;
 
 	return 0;
 }
@@ -331,6 +429,12 @@ dtx_resync(daos_handle_t po_hdl, uuid_t po_uuid, uuid_t co_uuid, uint32_t ver,
 	D_DEBUG(DB_TRACE, "resync DTX scan "DF_UUID"/"DF_UUID" stop: rc = %d\n",
 		DP_UUID(po_uuid), DP_UUID(co_uuid), rc);
 
+	if (dra.scanned > 0)
+		D_INFO("resync DTX "DF_UUID"/"DF_UUID": scanned %u, committed "
+		       "%u, aborted %u, skipped %u, rc = %d\n",
+		       DP_UUID(po_uuid), DP_UUID(co_uuid), dra.scanned,
+		       dra.committed, dra.aborted, dra.skipped, rc);
+
 	cont->sc_dtx_resyncing = 0;
 
 	if (cont->sc_dtx_resync_cbdata != NULL) {
@@ -106,6 +106,11 @@ struct dtx_req_rec {
 	int				 drr_count; /* DTX count */
 	int				 drr_result; /* The RPC result */
 	struct dtx_id			*drr_dti; /* The DTX array */
+	/* For batched DTX_CHECK: the index of each DTX in the caller's
+	 * array, and the state of each DTX replied by the server.
+	 */
+	int				*drr_idx;
+	int				*drr_sub_rets;
 };
 
 struct dtx_cf_rec_bundle {
@@ -139,7 +144,7 @@ dtx_req_cb(const struct crt_cb_info *cb_info)
 	crt_rpc_t		*req = cb_info->cci_rpc;
 	struct dtx_req_rec	*drr = cb_info->cci_arg;
 	struct dtx_req_args	*dra = drr->drr_parent;
-	struct dtx_out		*dout;
+	struct dtx_out		*dout = NULL;
 	int			 rc = cb_info->cci_rc;
 
 	if (rc == 0) {
@@ -147,6 +152,24 @@ dtx_req_cb(const struct crt_cb_info *cb_info)
 		rc = dout->do_status;
 	}
 
+	if (drr->drr_sub_rets != NULL) {
+		int	i;
+
+		/* Single DTX check is replied via do_status. */
+		if (drr->drr_count == 1)
+			drr->drr_sub_rets[0] = rc;
+		else if (rc == 0 &&
+			 dout->do_sub_rets.ca_count != drr->drr_count)
+			rc = -DER_PROTO;
+
+		if (drr->drr_count > 1) {
+			for (i = 0; i < drr->drr_count; i++)
+				drr->drr_sub_rets[i] = rc != 0 ? rc :
+					dout->do_sub_rets.ca_arrays[i];
+		}
+		rc = 0;
+	}
+
 	drr->drr_result = rc;
 	rc = ABT_future_set(dra->dra_future, drr);
 	D_ASSERTF(rc == ABT_SUCCESS,
@@ -191,6 +214,12 @@ dtx_req_send(struct dtx_req_rec *drr)
 		dra->dra_opc, rc);
 
 	if (rc != 0) {
+		if (drr->drr_sub_rets != NULL) {
+			int	i;
+
+			for (i = 0; i < drr->drr_count; i++)
+				drr->drr_sub_rets[i] = rc;
+		}
 		drr->drr_result = rc;
 		ABT_future_set(dra->dra_future, drr);
 	}
@@ -206,6 +235,10 @@ dtx_req_list_cb(void **args)
 	int			 i;
 
 	if (dra->dra_opc == DTX_CHECK) {
+		/* The batched check results are merged by the caller. */
+		if (drr->drr_sub_rets != NULL)
+			return;
+
 		for (i = 0; i < dra->dra_length; i++) {
 			drr = args[i];
 			switch (drr->drr_result) {
@@ -289,6 +322,12 @@ dtx_req_list_send(crt_opcode_t opc, d_list_t *head, int length, uuid_t po_uuid,
 					   struct dtx_req_rec, drr_link);
 			drr->drr_parent = &dra;
 			drr->drr_result = rc;
+			if (drr->drr_sub_rets != NULL) {
+				int	i;
+
+				for (i = 0; i < drr->drr_count; i++)
+					drr->drr_sub_rets[i] = rc;
+			}
 			ABT_future_set(future, drr);
 		}
 	}
@@ -555,13 +594,12 @@ dtx_commit(uuid_t po_uuid, uuid_t co_uuid, struct dtx_entry *dtes,
 	struct btr_root		 tree_root = { 0 };
 	daos_handle_t		 tree_hdl = DAOS_HDL_INVAL;
 	d_list_t		 head;
+	uint64_t		 ts;
 	int			 length;
 	int			 rc;
 	int			 rc1 = 0;
 
-	rc = ds_cont_child_lookup(po_uuid, co_uuid, &cont);
-	if (rc != 0)
-		return rc;
+	DSS_TRACE_BEGIN(ts);
 
 	D_INIT_LIST_HEAD(&head);
 	memset(&uma, 0, sizeof(uma));
@@ -580,11 +618,17 @@ dtx_commit(uuid_t po_uuid, uuid_t co_uuid, struct dtx_entry *dtes,
 		rc = dtx_req_list_send(DTX_COMMIT, &head, length, po_uuid,
 				       co_uuid);
 
-	if (dti != NULL)
+out:
+	/* The batched commit ULT may have been stolen by a sibling xstream,
+	 * the local commit has to be done on the target xstream.
+	 */
+	rc1 = dss_ult_home();
+	if (rc1 == 0 && dti != NULL)
+		rc1 = ds_cont_child_lookup(po_uuid, co_uuid, &cont);
+	if (rc1 == 0 && dti != NULL)
 		/* We cannot rollback the commit, so commit locally anyway. */
 		rc1 = vos_dtx_commit(cont->sc_hdl, dti, count);
 
-out:
 	D_DEBUG(DB_TRACE, "Commit DTXs "DF_DTI", count %d: rc %d %d\n",
 		DP_DTI(&dtes[0].dte_xid), count, rc, rc1);
 
@@ -599,6 +643,7 @@ out:
 	if (cont != NULL)
 		ds_cont_child_put(cont);
 
+	DSS_TRACE_END(DSS_TR_DTX_COMMIT, ts);
 	return rc >= 0 ? rc1 : rc;
 }
 
@@ -753,3 +798,176 @@ out:
 	ds_pool_put(pool);
 	return rc;
 }
+
+/* Merge one replica's state of the DTX into the result, same as what
+ * dtx_req_list_cb() does for single DTX check.
+ */
+static void
+dtx_check_merge(int *result, int rc)
+{
+	if (*result == DTX_ST_COMMITTED)
+		return;
+
+	switch (rc) {
+	case DTX_ST_COMMITTED:
+		*result = DTX_ST_COMMITTED;
+		break;
+	case DTX_ST_PREPARED:
+		if (*result == 0)
+			*result = DTX_ST_PREPARED;
+		break;
+	default:
+		*result = rc >= 0 ? -DER_IO : rc;
+		break;
+	}
+}
+
+static struct dtx_req_rec *
+dtx_check_drr_get(d_list_t *head, int *length, d_rank_t rank, uint32_t tag,
+		  int count)
+{
+	struct dtx_req_rec	*drr;
+
+	d_list_for_each_entry(drr, head, drr_link) {
+		if (drr->drr_rank == rank && drr->drr_tag == tag)
+			return drr;
+	}
+
+	D_ALLOC_PTR(drr);
+	if (drr == NULL)
+		return NULL;
+
+	D_ALLOC_ARRAY(drr->drr_dti, count);
+	D_ALLOC_ARRAY(drr->drr_idx, count);
+	D_ALLOC_ARRAY(drr->drr_sub_rets, count);
+	if (drr->drr_dti == NULL || drr->drr_idx == NULL ||
+	    drr->drr_sub_rets == NULL) {
+		D_FREE(drr->drr_dti);
+		D_FREE(drr->drr_idx);
+		D_FREE(drr->drr_sub_rets);
+		D_FREE_PTR(drr);
+		return NULL;
+	}
+
+	drr->drr_rank = rank;
+	drr->drr_tag = tag;
+	d_list_add_tail(&drr->drr_link, head);
+	++(*length);
+
+	return drr;
+}
+
+/**
+ * Check the state of the given DTX array on the other replicas, the DTXs
+ * to be checked on the same server (rank + tag) are sent via single
+ * DTX_CHECK RPC, and all the RPCs are sent in parallel.
+ *
+ * \param po_uuid	[IN]	Pool UUID.
+ * \param co_uuid	[IN]	Container UUID.
+ * \param dtes		[IN]	The DTX array to be checked.
+ * \param layouts	[IN]	The object layout for each DTX.
+ * \param count		[IN]	The size of above arrays.
+ * \param results	[OUT]	The state for each DTX, DTX_ST_COMMITTED if
+ *				some replica has committed it, DTX_ST_PREPARED
+ *				if all replicas have prepared it, otherwise
+ *				negative value.
+ *
+ * \return			Zero on success, negative value if error.
+ */
+int
+dtx_check_batch(uuid_t po_uuid, uuid_t co_uuid, struct dtx_entry *dtes,
+		struct pl_obj_layout **layouts, int count, int *results)
+{
+	struct ds_pool		*pool;
+	struct dtx_req_rec	*drr;
+	struct dtx_req_rec	*next;
+	d_list_t		 head;
+	d_rank_t		 myrank;
+	int			 length = 0;
+	int			 rc = 0;
+	int			 i;
+	int			 j;
+
+	pool = ds_pool_lookup(po_uuid);
+	if (pool == NULL)
+		return -DER_INVAL;
+
+	D_INIT_LIST_HEAD(&head);
+	crt_group_rank(pool->sp_group, &myrank);
+	for (i = 0; i < count; i++) {
+		daos_unit_oid_t		*oid = &dtes[i].dte_oid;
+		struct pl_obj_layout	*layout = layouts[i];
+		int			 replicas;
+		int			 start;
+
+		results[i] = 0;
+		replicas = dtx_get_replicas(oid, layout);
+		if (replicas < 0) {
+			results[i] = replicas;
+			continue;
+		}
+
+		start = (oid->id_shard / replicas) * replicas;
+		for (j = start; j < start + replicas; j++) {
+			struct pl_obj_shard	*shard;
+			struct pool_target	*target;
+
+			/* skip unavailable replica(s). */
+			shard = &layout->ol_shards[j];
+			if (shard->po_target == -1 || shard->po_rebuilding)
+				continue;
+
+			rc = pool_map_find_target(pool->sp_map,
+						  shard->po_target, &target);
+			D_ASSERT(rc == 1);
+
+			/* skip myself. */
+			if (myrank == target->ta_comp.co_rank)
+				continue;
+
+			drr = dtx_check_drr_get(&head, &length,
+						target->ta_comp.co_rank,
+						target->ta_comp.co_index,
+						count);
+			if (drr == NULL)
+				D_GOTO(out, rc = -DER_NOMEM);
+
+			drr->drr_dti[drr->drr_count] = dtes[i].dte_xid;
+			drr->drr_idx[drr->drr_count] = i;
+			drr->drr_count++;
+		}
+	}
+
+	rc = 0;
+	if (!d_list_empty(&head))
+		rc = dtx_req_list_send(DTX_CHECK, &head, length, po_uuid,
+				       co_uuid);
+	if (rc < 0)
+		goto out;
+
+	d_list_for_each_entry(drr, &head, drr_link) {
+		for (j = 0; j < drr->drr_count; j++)
+			dtx_check_merge(&results[drr->drr_idx[j]],
+					drr->drr_sub_rets[j]);
+	}
+
+	/* If no other available replicas, then currnet replica is the
+	 * unique valid one, it can be committed if it is also 'prepared'.
+	 */
+	for (i = 0; i < count; i++) {
+		if (results[i] == 0)
+			results[i] = DTX_ST_PREPARED;
+	}
+
+out:
+	d_list_for_each_entry_safe(drr, next, &head, drr_link) {
+		d_list_del(&drr->drr_link);
+		D_FREE(drr->drr_dti);
+		D_FREE(drr->drr_idx);
+		D_FREE(drr->drr_sub_rets);
+		D_FREE_PTR(drr);
+	}
+
+	ds_pool_put(pool);
+	return rc;
+}
@@ -39,8 +39,10 @@ dtx_handler(crt_rpc_t *rpc)
 	struct dtx_in		*din = crt_req_get(rpc);
 	struct dtx_out		*dout = crt_reply_get(rpc);
 	struct ds_cont_child	*cont = NULL;
+	int32_t			*rets = NULL;
 	uint32_t		 opc = opc_get(rpc->cr_opc);
 	int			 rc;
+	int			 i;
 
 	rc = ds_cont_child_lookup(din->di_po_uuid, din->di_co_uuid, &cont);
 	if (rc != 0) {
@@ -60,16 +62,32 @@ dtx_handler(crt_rpc_t *rpc)
 				   din->di_dtx_array.ca_count, true);
 		break;
 	case DTX_CHECK:
-		/* Currently, only support to check single DTX state. */
-		if (din->di_dtx_array.ca_count != 1)
-			rc = -DER_PROTO;
-		else
-			/* For the remote query about DTX check, it is NOT
-			 * necessary to lookup CoS cache, so set the 'oid'
-			 * as zero to bypass CoS cache.
-			 */
+		/* For the remote query about DTX check, it is NOT necessary
+		 * to lookup CoS cache, so set the 'oid' as zero to bypass CoS
+		 * cache.
+		 */
+		if (din->di_dtx_array.ca_count == 1) {
 			rc = vos_dtx_check_committable(cont->sc_hdl, NULL,
 					din->di_dtx_array.ca_arrays, 0, false);
+			break;
+		}
+
+		if (din->di_dtx_array.ca_count == 0)
+			D_GOTO(out, rc = -DER_PROTO);
+
+		/* Batched check, reply the state for each DTX. */
+		D_ALLOC_ARRAY(rets, din->di_dtx_array.ca_count);
+		if (rets == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		for (i = 0; i < din->di_dtx_array.ca_count; i++)
+			rets[i] = vos_dtx_check_committable(cont->sc_hdl, NULL,
+					&din->di_dtx_array.ca_arrays[i],
+					0, false);
+
+		dout->do_sub_rets.ca_arrays = rets;
+		dout->do_sub_rets.ca_count = din->di_dtx_array.ca_count;
+		rc = 0;
 		break;
 	default:
 		rc = -DER_INVAL;
@@ -85,6 +103,8 @@ out:
 	if (rc != 0)
 		D_ERROR("send reply failed for DTX rpc %u: rc = %d\n", opc, rc);
 
+	D_FREE(rets);
+
 	if (cont != NULL)
 		ds_cont_child_put(cont);
 }
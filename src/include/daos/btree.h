@@ -503,6 +503,8 @@ int  dbtree_fetch(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 		  d_iov_t *key, d_iov_t *key_out, d_iov_t *val_out);
 int  dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 		   d_iov_t *key, d_iov_t *val);
+int  dbtree_bulk_load(daos_handle_t toh, d_iov_t *keys, d_iov_t *vals,
+		      unsigned int nr);
 int  dbtree_delete(daos_handle_t toh, d_iov_t *key, void *args);
 int  dbtree_query(daos_handle_t toh, struct btr_attr *attr,
 		  struct btr_stat *stat);
@@ -36,6 +36,7 @@
 enum {
 	DAOS_CS_CRC32 = 0,
 	DAOS_CS_CRC64 = 1,
+	DAOS_CS_ADLER32 = 2,
 	DAOS_CS_MAX,
 	DAOS_CS_UNKNOWN,
 };
@@ -53,10 +54,18 @@ struct daos_csum {
 
 typedef struct daos_csum daos_csum_t;
 int		daos_csum_init(const char *cs_name, daos_csum_t *checksum);
+const char	*daos_csum_type2name(unsigned int type);
 int		daos_csum_free(daos_csum_t *csum);
 int		daos_csum_reset(daos_csum_t *csum);
 int		daos_csum_compute(daos_csum_t *csum, d_sg_list_t *sgl);
 daos_size_t	daos_csum_get_size(const daos_csum_t *csum);
 int		daos_csum_get(daos_csum_t *csum, daos_csum_buf_t *csum_buf);
 int		daos_csum_compare(daos_csum_t *csum, daos_csum_t *csum_src);
+int		daos_csum_verify(daos_csum_t *csum, daos_csum_buf_t *csum_buf);
+int		daos_csum_compute_chunks(daos_csum_t *csum, d_sg_list_t *sgl,
+					 daos_off_t off, uint32_t chunk_size,
+					 daos_csum_buf_t *csum_buf);
+int		daos_csum_combine(const daos_csum_t *csum, const void *csum1,
+				  const void *csum2, daos_size_t len2,
+				  void *result);
 #endif
@@ -349,6 +349,10 @@ enum {
 	DSS_KEY_FAIL_VALUE,
 	DSS_KEY_FAIL_NUM,
 	DSS_REBUILD_RES_PERCENTAGE,
+	/** rebuild pull budget of each target, in MiB/sec, 0 is unlimited */
+	DSS_REBUILD_PULL_BW,
+	/** rebuild pull budget of each target, in dkeys/sec, 0 is unlimited */
+	DSS_REBUILD_PULL_IOPS,
 	DSS_KEY_NUM,
 };
 
@@ -38,6 +38,7 @@ enum drpc_module {
 	DRPC_MODULE_SECURITY_AGENT	= 1,
 	DRPC_MODULE_MGMT		= 2,	/* daos_server mgmt */
 	DRPC_MODULE_SRV			= 3,	/* daos_server */
+	DRPC_MODULE_IOSRV		= 4,	/* daos_io_server */
 
 	NUM_DRPC_MODULES			/* Must be last */
 };
@@ -58,4 +59,10 @@ enum drpc_srv_method {
 	NUM_DRPC_SRV_METHODS			/* Must be last */
 };
 
+enum drpc_iosrv_method {
+	DRPC_METHOD_IOSRV_GET_METRICS	= 401,
+
+	NUM_DRPC_IOSRV_METHODS			/* Must be last */
+};
+
 #endif /* __DAOS_DRPC_MODULES_H__ */
@@ -52,6 +52,8 @@ struct daos_llink {
 	unsigned int		ll_ref:30;
 	/** has been evicted */
 	unsigned int		ll_evicted:1;
+	/** has been referenced again after being cached */
+	unsigned int		ll_hot:1;
 	/**
 	 * ops to allocate and free reference
 	 * for this llink.
@@ -59,25 +61,49 @@ struct daos_llink {
 	struct daos_llink_ops	*ll_ops;
 };
 
+/** Statistics of LRU cache */
+struct daos_lru_stats {
+	/** # lookups found the item in the cache */
+	uint64_t		ls_hits;
+	/** # lookups did not find the item */
+	uint64_t		ls_misses;
+	/** # idle items evicted to make room for new items */
+	uint64_t		ls_evicts;
+};
+
 /**
  * LRU cache implementation using d_hash_table
  * and d_list_t
+ *
+ * Idle items are managed by the simplified 2Q algorithm to resist scans: a
+ * new item is queued on the cold list, and it is queued on the hot list
+ * only if it has been referenced again while it is cached. Items of the
+ * cold list are evicted first unless the cold list is shorter than
+ * dlc_cold_max, so a scan can only flush the cold list.
  */
 struct daos_lru_cache {
 	/* Provided cache size */
 	uint32_t		dlc_csize;
-	/* # idle items in the LRU */
+	/* # idle items in the LRU, including both cold and hot items */
 	uint32_t		dlc_idle_nr;
+	/* # idle items on the hot list */
+	uint32_t		dlc_hot_nr;
+	/* cold items are evicted first if there are more than this */
+	uint32_t		dlc_cold_max;
 	/* # busy items in the LRU (referenced by caller) */
 	uint32_t		dlc_busy_nr;
-	/* Queue head, holds idle refs (no refcnt) */
+	/* Queue head, holds idle refs which are referenced once */
 	d_list_t		dlc_idle_list;
+	/* Queue head, holds idle refs which are referenced more than once */
+	d_list_t		dlc_hot_list;
 	/** list head of busy items in the LRU */
 	d_list_t		dlc_busy_list;
 	/* Holds all refs but needs lookup */
 	struct d_hash_table	dlc_htable;
 	/* ops to allocate and free reference */
 	struct daos_llink_ops	*dlc_ops;
+	/* hit, miss and eviction counters */
+	struct daos_lru_stats	 dlc_stats;
 };
 
 /**
@@ -177,4 +203,17 @@ daos_lru_ref_add(struct daos_llink *llink)
 	llink->ll_ref++;
 }
 
+/**
+ * Return hit, miss and eviction counters of the cache.
+ *
+ * \param lcache	[IN]	DAOS LRU cache
+ * \param stats		[OUT]	Returned counters
+ */
+static inline void
+daos_lru_cache_stats_get(struct daos_lru_cache *lcache,
+			 struct daos_lru_stats *stats)
+{
+	*stats = lcache->dlc_stats;
+}
+
 #endif
@@ -55,6 +55,9 @@ int
 dc_obj_close_task_create(daos_handle_t oh, daos_event_t *ev,
 			 tse_sched_t *tse, tse_task_t **task);
 int
+dc_obj_flush_task_create(daos_handle_t oh, daos_event_t *ev,
+			 tse_sched_t *tse, tse_task_t **task);
+int
 dc_obj_punch_task_create(daos_handle_t oh, daos_handle_t th,
 			 daos_event_t *ev, tse_sched_t *tse,
 			 tse_task_t **task);
@@ -884,7 +884,7 @@ daos_obj_id2version(daos_obj_id_t oid)
  *
  * \param[in]	coh	Container open handle.
  * \param[in]	oid	Object ID.
- * \param[in]	mode	Open mode: DAOS_OO_RO/RW/EXCL/IO_RAND/IO_SEQ
+ * \param[in]	mode	Open mode: DAOS_OO_RO/RW/EXCL/IO_RAND/IO_SEQ/IO_COMBINE
  * \param[out]	oh	Returned object open handle.
  * \param[in]	ev	Completion event, it is optional and can be NULL.
  *			The function will run in blocking mode if \a ev is NULL.
@@ -919,6 +919,25 @@ daos_obj_open(daos_handle_t coh, daos_obj_id_t oid, unsigned int mode,
 int
 daos_obj_close(daos_handle_t oh, daos_event_t *ev);
 
+/**
+ * Flush the updates buffered for an object opened with DAOS_OO_IO_COMBINE,
+ * the function completes after all of them are persistent. It does nothing
+ * for an object without this open mode.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			Otherwise, the first error of the buffered updates
+ *			which has not been reported yet.
+ */
+int
+daos_obj_flush(daos_handle_t oh, daos_event_t *ev);
+
 /**
  * Punch an entire object with all keys associated with it.
  *
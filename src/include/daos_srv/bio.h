@@ -207,6 +207,15 @@ void bio_xsctxt_free(struct bio_xs_context *ctxt);
  */
 size_t bio_nvme_poll(struct bio_xs_context *ctxt);
 
+/**
+ * Check if there are NVMe I/Os queued or in-flight on the xstream.
+ *
+ * \param[IN] ctxt	Per-xstream NVMe context
+ *
+ * \return		true if any I/O is outstanding
+ */
+bool bio_nvme_busy(struct bio_xs_context *ctxt);
+
 /*
  * Create per VOS instance blob.
  *
@@ -389,6 +398,60 @@ int bio_iod_copy(struct bio_desc *biod, d_sg_list_t *sgls, unsigned int nr_sgl);
  */
 struct bio_sglist *bio_iod_sgl(struct bio_desc *biod, unsigned int idx);
 
+/*
+ * Register the callbacks used to create/free the bulk handles for DMA chunks.
+ *
+ * Once registered, bio_iod_bulk() registers each per-xstream DMA chunk as a
+ * bulk handle on its first use, and keeps the handle until the chunk is freed,
+ * so that data in DMA buffer can be transferred over network directly without
+ * registering memory for each I/O.
+ *
+ * \param bulk_create	[IN]	Callback to create bulk handle on a sgl
+ * \param bulk_free	[IN]	Callback to free bulk handle
+ */
+void bio_register_bulk_ops(int (*bulk_create)(void *ctxt, d_sg_list_t *sgl,
+					      void **bulk_hdl),
+			   int (*bulk_free)(void *bulk_hdl));
+
+/*
+ * Helper function to get the bulk handle of the DMA chunk where the specified
+ * IOV of an io descriptor is mapped, it must be called after bio_iod_prep().
+ *
+ * \param biod       [IN]	io descriptor
+ * \param ctxt       [IN]	Context for bulk handle creation, NULL to only
+ *				return the handle registered already
+ * \param sgl_idx    [IN]	Index of the SG list
+ * \param iov_idx    [IN]	IOV index within the SG list
+ * \param bulk_off   [OUT]	Offset of the IOV within the bulk handle
+ *
+ * \return			Bulk handle, or NULL when the IOV isn't mapped
+ *				in any cached DMA chunk (SCM, hole, huge IOV)
+ *				or bulk ops aren't registered
+ */
+void *bio_iod_bulk(struct bio_desc *biod, void *ctxt, unsigned int sgl_idx,
+		   unsigned int iov_idx, uint64_t *bulk_off);
+
+/*
+ * Check if the specified IOV is mapped in a cached DMA chunk, i.e. it can be
+ * transferred by bio_iod_bulk() handle. It never creates the bulk handle.
+ *
+ * \param biod       [IN]	io descriptor
+ * \param sgl_idx    [IN]	Index of the SG list
+ * \param iov_idx    [IN]	IOV index within the SG list
+ *
+ * \return			true if the IOV is in a cached DMA chunk
+ */
+bool bio_iod_bulk_cacheable(struct bio_desc *biod, unsigned int sgl_idx,
+			    unsigned int iov_idx);
+
+/*
+ * Register the callback to trace NVMe commands, it's called on the completion
+ * of each NVMe command with the submit time (in nanoseconds) of the command.
+ *
+ * \param io_trace	[IN]	Trace callback
+ */
+void bio_register_io_trace(void (*io_trace)(uint64_t start));
+
 /*
  * Wrapper of ABT_thread_yield()
  */
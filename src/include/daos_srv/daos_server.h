@@ -43,6 +43,10 @@
 /** number of target (XS set) per server */
 extern unsigned int	dss_tgt_nr;
 
+/** rebuild pull budget of each target, MiB/sec and dkeys/sec, 0 is unlimited */
+extern unsigned int	dss_rebuild_pull_bw;
+extern unsigned int	dss_rebuild_pull_iops;
+
 /** Storage path (hack) */
 extern const char      *dss_storage_path;
 
@@ -153,7 +157,7 @@ void dss_register_key(struct dss_module_key *key);
 void dss_unregister_key(struct dss_module_key *key);
 
 /**
- * Different type of ES pools, there are 4 pools for now
+ * Different type of ES pools, there are 5 pools for now
  *
  *  DSS_POOL_URGENT	The highest priority pool. ULTs in this pool will be
  *			scheduled firstly.
@@ -161,12 +165,17 @@ void dss_unregister_key(struct dss_module_key *key);
  *  DSS_POOL_SHARE	Shared pool: Other requests and ULT created during
  *			processing rpc.
  *  DSS_POOL_REBUILD	rebuild pool: pools specially for rebuild tasks.
+ *  DSS_POOL_STEALABLE	Stealable pool: ULTs not bound to the xstream, such
+ *			as EC/checksum/compress offload, collective fan-out
+ *			and batched DTX commit, they could be stolen by idle
+ *			sibling xstreams when work stealing is enabled.
  */
 enum {
 	DSS_POOL_URGENT,
 	DSS_POOL_PRIV,
 	DSS_POOL_SHARE,
 	DSS_POOL_REBUILD,
+	DSS_POOL_STEALABLE,
 	DSS_POOL_CNT,
 };
 
@@ -191,6 +200,10 @@ struct dss_xstream {
 	int		dx_ctx_id;
 	bool		dx_main_xs;	/* true for main XS */
 	bool		dx_comm;	/* true with cart context */
+	/* NUMA node of the bound core, -1 if unknown */
+	int		dx_numa_node;
+	/* progress ULT has network or NVMe work outstanding */
+	bool		dx_busy;
 };
 
 struct dss_module_info {
@@ -205,6 +218,10 @@ struct dss_module_info {
 	int			dmi_ctx_id;
 	d_list_t		dmi_dtx_batched_list;
 	tse_sched_t		dmi_sched;
+	/* hot-path tracer of the xstream, NULL if tracing is disabled */
+	struct dss_tracer	*dmi_tracer;
+	/* metric slots of the xstream, see dss_metric_register() */
+	uint64_t		*dmi_metrics;
 	uint64_t		dmi_tse_ult_created:1;
 };
 
@@ -292,6 +309,181 @@ int srv_profile_count(struct srv_profile *sp, int id, int time);
 int srv_profile_start(struct srv_profile **sp_p, char *path, char **names);
 void srv_profile_destroy(struct srv_profile *sp);
 
+/**
+ * Stages traced by the hot-path tracer. Unlike the profile above, the tracer
+ * is always on (unless DAOS_TRACE=0), each xstream records latency of the
+ * stages into its own histograms and ring buffer without any locking.
+ */
+enum dss_trace_stage {
+	DSS_TR_RPC_DISPATCH = 0,	/* choose pool & create ULT for RPC */
+	DSS_TR_OBJ_RW,			/* the whole ds_obj_rw_handler() */
+	DSS_TR_OBJ_PRE_CHECK,		/* ds_pre_check() */
+	DSS_TR_OBJ_UPDATE_BEGIN,	/* vos_update_begin() */
+	DSS_TR_OBJ_FETCH_BEGIN,		/* vos_fetch_begin() */
+	DSS_TR_OBJ_IOD_PREP,		/* bio_iod_prep() */
+	DSS_TR_OBJ_BULK,		/* bulk transfer or sgl copy */
+	DSS_TR_OBJ_UPDATE_END,		/* vos_update_end() */
+	DSS_TR_OBJ_FETCH_END,		/* vos_fetch_end() */
+	DSS_TR_DTX_COMMIT,		/* dtx_commit() */
+	DSS_TR_NVME_IO,			/* NVMe submit to completion */
+	DSS_TR_MAX,
+};
+
+/* Latency histogram buckets, bucket N holds latency in [2^(N-1), 2^N) ns */
+#define DSS_TRACE_BUCKETS	40
+/* Number of recent samples kept in the ring buffer of each xstream */
+#define DSS_TRACE_RING_SIZE	(1 << 12)
+
+struct dss_trace_rec {
+	uint64_t	tr_start;	/* start time in ns */
+	uint32_t	tr_lat;		/* latency in ns, saturated */
+	uint32_t	tr_stage;
+};
+
+/* Per-xstream tracer, only accessed by the owner xstream */
+struct dss_tracer {
+	uint64_t		dt_hist[DSS_TR_MAX][DSS_TRACE_BUCKETS];
+	uint64_t		dt_total[DSS_TR_MAX];	/* sum of latency */
+	uint64_t		dt_max[DSS_TR_MAX];
+	uint64_t		dt_head;		/* next slot of ring */
+	struct dss_trace_rec	dt_ring[DSS_TRACE_RING_SIZE];
+};
+
+extern bool dss_trace_enabled;
+
+static inline void
+dss_trace_record(int stage, uint64_t start)
+{
+	struct dss_tracer	*tr = dss_get_module_info()->dmi_tracer;
+	struct dss_trace_rec	*rec;
+	uint64_t		 lat;
+	int			 bkt;
+
+	D_ASSERT(stage < DSS_TR_MAX);
+	if (tr == NULL || start == 0)
+		return;
+
+	lat = daos_get_ntime() - start;
+	bkt = lat == 0 ? 0 : 64 - __builtin_clzll(lat);
+	if (bkt >= DSS_TRACE_BUCKETS)
+		bkt = DSS_TRACE_BUCKETS - 1;
+
+	tr->dt_hist[stage][bkt]++;
+	tr->dt_total[stage] += lat;
+	if (lat > tr->dt_max[stage])
+		tr->dt_max[stage] = lat;
+
+	rec = &tr->dt_ring[tr->dt_head++ & (DSS_TRACE_RING_SIZE - 1)];
+	rec->tr_start = start;
+	rec->tr_lat = lat > UINT32_MAX ? UINT32_MAX : lat;
+	rec->tr_stage = stage;
+}
+
+/**
+ * Trace probes, \a ts is a uint64_t declared by the caller to hold the start
+ * time of the stage. Build with DAOS_TRACE_DISABLED to compile them out.
+ */
+#ifndef DAOS_TRACE_DISABLED
+#define DSS_TRACE_BEGIN(ts)						\
+	((ts) = dss_trace_enabled ? daos_get_ntime() : 0)
+#define DSS_TRACE_END(stage, ts)	dss_trace_record(stage, ts)
+#else
+#define DSS_TRACE_BEGIN(ts)		((ts) = 0)
+#define DSS_TRACE_END(stage, ts)	do { (void)(ts); } while (0)
+#endif
+
+void dss_trace_reset(void);
+int dss_trace_dump(const char *path);
+
+/**
+ * Metrics registry. Modules register counters and histograms on module
+ * initialization, then update them on the hot path. Each xstream updates
+ * its own copy of the metrics, which are summed up on read (through the
+ * DRPC_METHOD_IOSRV_GET_METRICS dRPC), so updates need neither lock nor
+ * atomic operation.
+ */
+enum dss_metric_type {
+	DSS_METRIC_COUNTER,
+	DSS_METRIC_HISTOGRAM,
+};
+
+#define DSS_METRIC_NAME_LEN	64
+#define DSS_METRICS_MAX		1024
+
+/*
+ * Histograms are log-linear like HDR histogram: each power of two range is
+ * split into (1 << DSS_METRIC_SUB_BITS) sub-buckets, so the relative error
+ * is less than 12.5%. Values beyond 2^DSS_METRIC_MAX_BITS fall into the last
+ * bucket.
+ */
+#define DSS_METRIC_SUB_BITS	3
+#define DSS_METRIC_MAX_BITS	48
+#define DSS_METRIC_BUCKETS						\
+	((DSS_METRIC_MAX_BITS - DSS_METRIC_SUB_BITS + 1) << DSS_METRIC_SUB_BITS)
+
+/* Slots of a histogram: sample count, sum of samples, then buckets */
+#define DSS_METRIC_HIST_CNT	0
+#define DSS_METRIC_HIST_SUM	1
+#define DSS_METRIC_HIST_BKT	2
+
+struct dss_metric {
+	char		dm_name[DSS_METRIC_NAME_LEN];
+	int		dm_type;
+	/* Offset of the metric in the per-xstream slots */
+	int		dm_off;
+};
+
+extern struct dss_metric dss_metrics[];
+
+int dss_metric_register(const char *name, enum dss_metric_type type,
+			int *id);
+
+static inline int
+dss_metric_bucket(uint64_t val)
+{
+	int	bits;
+
+	if (val < (1 << DSS_METRIC_SUB_BITS))
+		return val;
+
+	bits = 63 - __builtin_clzll(val);
+	if (bits >= DSS_METRIC_MAX_BITS)
+		return DSS_METRIC_BUCKETS - 1;
+
+	return ((bits - DSS_METRIC_SUB_BITS + 1) << DSS_METRIC_SUB_BITS) +
+	       ((val >> (bits - DSS_METRIC_SUB_BITS)) &
+		((1 << DSS_METRIC_SUB_BITS) - 1));
+}
+
+/* Add \a val to the counter \a id */
+static inline void
+dss_metric_add(int id, uint64_t val)
+{
+	uint64_t	*slots = dss_get_module_info()->dmi_metrics;
+
+	if (slots == NULL || id < 0)
+		return;
+
+	D_ASSERT(dss_metrics[id].dm_type == DSS_METRIC_COUNTER);
+	slots[dss_metrics[id].dm_off] += val;
+}
+
+/* Record a sample \a val into the histogram \a id */
+static inline void
+dss_metric_observe(int id, uint64_t val)
+{
+	uint64_t	*slots = dss_get_module_info()->dmi_metrics;
+
+	if (slots == NULL || id < 0)
+		return;
+
+	D_ASSERT(dss_metrics[id].dm_type == DSS_METRIC_HISTOGRAM);
+	slots += dss_metrics[id].dm_off;
+	slots[DSS_METRIC_HIST_CNT]++;
+	slots[DSS_METRIC_HIST_SUM] += val;
+	slots[DSS_METRIC_HIST_BKT + dss_metric_bucket(val)]++;
+}
+
 /**
  * Each module should provide a dss_module structure which defines the module
  * interface. The name of the allocated structure must be the library name
@@ -345,6 +537,11 @@ struct dss_module {
 enum dss_ult_type {
 	/** for dtx_resync */
 	DSS_ULT_DTX_RESYNC = 100,
+	/**
+	 * batched DTX commit, it could be stolen by the sibling xstreams
+	 * until it calls dss_ult_home()
+	 */
+	DSS_ULT_DTX_COMMIT,
 	/** forward/dispatch IO request for TX coordinator */
 	DSS_ULT_IOFW,
 	/** EC/checksum/compress computing offload */
@@ -374,6 +571,7 @@ void dss_abt_pool_choose_cb_register(unsigned int mod_id,
 int dss_ult_create(void (*func)(void *), void *arg, int ult_type, int tgt_id,
 		   size_t stack_size, ABT_thread *ult);
 int dss_ult_create_all(void (*func)(void *), void *arg, bool main);
+int dss_ult_home(void);
 int dss_ult_create_execute(int (*func)(void *), void *arg,
 			   void (*user_cb)(void *), void *cb_args,
 			   int ult_type, int tgt_id, size_t stack_size);
@@ -492,6 +690,36 @@ enum {
 	DSS_OFFLOAD_MAX		= 7
 };
 
+/** Opcodes of dss_acc_task */
+enum {
+	/** Compute the chunk checksums of ac_sgl into ac_csum_buf */
+	DSS_ACC_CSUM_COMPUTE	= 0,
+	/** Verify the chunk checksums of ac_sgl against ac_csum_buf */
+	DSS_ACC_CSUM_VERIFY	= 1,
+};
+
+struct daos_csum;
+
+/** Parameters of checksum offload, i.e. dss_acc_task::at_params */
+struct dss_acc_csum {
+	/**
+	 * [IN] checksum type, initialized by daos_csum_init(), its running
+	 * state is used by the offloaded ULT, so don't share it meanwhile
+	 */
+	struct daos_csum	*ac_csum;
+	/** [IN] data to be checksummed */
+	d_sg_list_t		*ac_sgl;
+	/** [IN] byte offset of ac_sgl within the record, chunks are aligned
+	 *  to multiples of cs_chunksize of ac_csum_buf from the record start
+	 */
+	daos_off_t		 ac_off;
+	/** [OUT] computed checksums (DSS_ACC_CSUM_COMPUTE), cs_csum,
+	 *  cs_buf_len and cs_chunksize are provided by caller, or
+	 *  [IN] checksums to be verified (DSS_ACC_CSUM_VERIFY)
+	 */
+	daos_csum_buf_t		*ac_csum_buf;
+};
+
 struct dss_acc_task {
 	/**
 	 * Type of offload for this operation
@@ -428,6 +428,23 @@ int evt_destroy(daos_handle_t toh);
  */
 int evt_insert(daos_handle_t toh, const struct evt_entry_in *entry);
 
+/**
+ * Bulk load versioned extents to an empty tree. Leaves are packed with the
+ * sorted entries and the tree is built bottom-up in one transaction, which
+ * avoids node splits and undo logs of inserting entries one by one.
+ *
+ * Entries should be sorted by start offset, then high to low epoch, then
+ * end offset, and should not have duplicates. Entries from the first one
+ * not in this order, or all entries if the tree is not empty, are inserted
+ * one by one.
+ *
+ * \param toh		[IN]	The tree open handle
+ * \param ents		[IN]	Sorted entries to insert
+ * \param nr		[IN]	Number of entries
+ */
+int evt_bulk_load(daos_handle_t toh, const struct evt_entry_in *ents,
+		  unsigned int nr);
+
 /**
  * Delete an extent \a rect from an opened tree.
  *
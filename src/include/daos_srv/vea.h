@@ -129,6 +129,9 @@ struct vea_attr {
 	uint64_t	va_tot_blks;	/* Total capacity in blocks */
 };
 
+/* Buckets of free extent size histogram, see vea_stat::vs_frags_hist */
+#define VEA_FRAGS_HIST_SZ	16
+
 /* VEA statistics */
 struct vea_stat {
 	uint64_t	vs_free_persistent;	/* Persistent free blocks */
@@ -139,6 +142,12 @@ struct vea_stat {
 	uint64_t	vs_resrv_large;	/* Number of large reserve */
 	uint64_t	vs_resrv_small;	/* Number of small reserve */
 	uint64_t	vs_resrv_vec;	/* Number of vector reserve */
+	uint64_t	vs_resrv_fail;	/* Number of failed reserve */
+	/*
+	 * Histogram of free frags, bucket i counts the frags in size of
+	 * [2^i, 2^(i+1)) blocks, the last bucket counts all larger frags.
+	 */
+	uint64_t	vs_frags_hist[VEA_FRAGS_HIST_SZ];
 	uint32_t	vs_largest_blks;/* Largest free frag size in blocks */
 };
 
@@ -235,6 +244,27 @@ void vea_hint_unload(struct vea_hint_context *thc);
 int vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
 		struct vea_hint_context *hint, d_list_t *resrvd_list);
 
+/**
+ * Reserve a batch of extents on block device in one call. The extents will
+ * be carved from a single contiguous region whenever possible, so that the
+ * data of the whole batch can be written by one large I/O. Otherwise, they
+ * are reserved one by one like calling vea_reserve() @nr times.
+ *
+ * \param vsi         [IN]	In-memory compound index
+ * \param nr          [IN]	Number of extents to be reserved
+ * \param blk_cnts    [IN]	Block count of each extent
+ * \param hint        [IN]	Hint data
+ * \param resrvd_list [OUT]	List for storing the reserved extents
+ *
+ * \return			Zero on success, @nr reserved extents will be
+ *				appended to the @resrvd_list in the order of
+ *				@blk_cnts; Appropriated negative value on
+ *				error, nothing is reserved on error.
+ */
+int vea_reserve_vec(struct vea_space_info *vsi, unsigned int nr,
+		    uint32_t *blk_cnts, struct vea_hint_context *hint,
+		    d_list_t *resrvd_list);
+
 /**
  * Cancel the reserved extent(s)
  *
@@ -92,6 +92,8 @@ vos_dtx_list_cos(daos_handle_t coh, daos_unit_oid_t *oid, uint64_t dkey_hash,
  * Fetch the list of the DTXs that can be committed.
  *
  * \param coh	[IN]	Container open handle.
+ * \param skip	[IN]	The number of the oldest committable DTXs to be
+ *			skipped, such as those being committed.
  * \param max	[IN]	The max size of the array for DTX entries.
  * \param dtes	[OUT]	The array for DTX entries can be committed.
  *
@@ -99,7 +101,8 @@ vos_dtx_list_cos(daos_handle_t coh, daos_unit_oid_t *oid, uint64_t dkey_hash,
  *			Negative value on failure.
  */
 int
-vos_dtx_fetch_committable(daos_handle_t coh, int max, struct dtx_entry **dtes);
+vos_dtx_fetch_committable(daos_handle_t coh, int skip, int max,
+			  struct dtx_entry **dtes);
 
 /**
  * Check whether the specified DTX can be committed or not.
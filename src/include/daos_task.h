@@ -123,6 +123,7 @@ typedef enum {
 	DAOS_OPC_KV_LIST,
 	DAOS_OPC_OBJ_FETCH_MULTI,
 	DAOS_OPC_OBJ_UPDATE_MULTI,
+	DAOS_OPC_OBJ_FLUSH,
 
 	DAOS_OPC_MAX
 } daos_opc_t;
@@ -386,6 +387,10 @@ typedef struct {
 	daos_handle_t		oh;
 } daos_obj_close_t;
 
+typedef struct {
+	daos_handle_t		oh;
+} daos_obj_flush_t;
+
 /* NB:
  * - If @dkey is NULL, it is parameter for object punch.
  * - If @akeys is NULL, it is parameter for dkey punch.
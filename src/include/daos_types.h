@@ -441,6 +441,12 @@ enum {
 	DAOS_OO_IO_RAND        = (1 << 4),
 	/** Sequential I/O */
 	DAOS_OO_IO_SEQ         = (1 << 5),
+	/**
+	 * Combine small updates to the same dkey into one RPC. Updates are
+	 * buffered by the client until daos_obj_flush(), close, or any other
+	 * I/O against the object handle.
+	 */
+	DAOS_OO_IO_COMBINE     = (1 << 6),
 };
 
 typedef struct {
@@ -570,6 +576,12 @@ enum {
 	DAOS_OC_EC_K8P2_L1M,	/* Erasure code, 8 data cells, 2 parity cells,
 				 * cell size 1MB.
 				 */
+	DAOS_OC_EC_K2P1_SRV_L32K,	/* Same as DAOS_OC_EC_K2P1_L32K, parity
+					 * is encoded by the leader server.
+					 */
+	DAOS_OC_EC_K8P2_SRV_L1M,	/* Same as DAOS_OC_EC_K8P2_L1M, parity
+					 * is encoded by the leader server.
+					 */
 };
 
 /** Object class attributes */
@@ -0,0 +1,396 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of the DAOS server. It implements the metrics registry
+ * of the I/O server, and the dRPC handler to read the metrics.
+ */
+#define D_LOGFAC       DD_FAC(server)
+
+#include <daos/drpc.h>
+#include <daos/rpc.h>
+#include <daos/drpc_modules.h>
+#include <daos_srv/daos_server.h>
+#include "drpc_handler.h"
+#include "srv.pb-c.h"
+#include "srv_internal.h"
+
+struct dss_metric	 dss_metrics[DSS_METRICS_MAX];
+static int		 metrics_nr;
+/* Total slots of all registered metrics */
+static int		 metrics_slots;
+/* Per-xstream slots, indexed by xstream id */
+static uint64_t		**metrics_xs;
+static int		 metrics_xs_nr;
+/* Set once any xstream attached its slots, no more registration */
+static bool		 metrics_frozen;
+
+/* Counters of an RPC opcode */
+struct rpc_metric {
+	int	rm_recv;
+	int	rm_err;
+};
+
+/* RPC counters of the modules, indexed by module id then by opcode */
+static struct rpc_metric	*rpc_metrics[DAOS_MAX_MODULE];
+static int			 rpc_metrics_nr[DAOS_MAX_MODULE];
+
+/**
+ * Register a metric, it must be called before the xstreams are started, i.e.
+ * on module initialization.
+ *
+ * \param[in]	name	unique name of the metric
+ * \param[in]	type	counter or histogram
+ * \param[out]	id	id used to update the metric
+ */
+int
+dss_metric_register(const char *name, enum dss_metric_type type, int *id)
+{
+	struct dss_metric	*metric;
+	int			 i;
+
+	if (name == NULL || strlen(name) >= DSS_METRIC_NAME_LEN ||
+	    (type != DSS_METRIC_COUNTER && type != DSS_METRIC_HISTOGRAM))
+		return -DER_INVAL;
+
+	if (metrics_frozen) {
+		D_ERROR("Cannot register metric %s after xstreams started\n",
+			name);
+		return -DER_BUSY;
+	}
+
+	for (i = 0; i < metrics_nr; i++) {
+		if (strcmp(dss_metrics[i].dm_name, name) == 0) {
+			D_ERROR("Metric %s is registered already\n", name);
+			return -DER_EXIST;
+		}
+	}
+
+	if (metrics_nr == DSS_METRICS_MAX) {
+		D_ERROR("Too many metrics, cannot register %s\n", name);
+		return -DER_NOSPACE;
+	}
+
+	metric = &dss_metrics[metrics_nr];
+	strcpy(metric->dm_name, name);
+	metric->dm_type = type;
+	metric->dm_off = metrics_slots;
+	metrics_slots += type == DSS_METRIC_COUNTER ? 1 :
+			 DSS_METRIC_HIST_BKT + DSS_METRIC_BUCKETS;
+
+	*id = metrics_nr++;
+	D_DEBUG(DB_TRACE, "Registered metric %s, id %d\n", name, *id);
+	return 0;
+}
+
+/**
+ * Register the counters of received RPCs and of failures to dispatch them,
+ * for each opcode of the module. It is called on module load, which is
+ * before the xstreams are started.
+ */
+int
+dss_rpc_metrics_register(struct dss_module *smod)
+{
+	struct rpc_metric	*metrics;
+	char			 name[DSS_METRIC_NAME_LEN];
+	int			 nr;
+	int			 i;
+	int			 rc;
+
+	if (smod->sm_proto_fmt == NULL)
+		return 0;
+
+	D_ASSERT(smod->sm_mod_id < DAOS_MAX_MODULE);
+	D_ASSERT(rpc_metrics[smod->sm_mod_id] == NULL);
+	nr = smod->sm_proto_fmt->cpf_count;
+	D_ALLOC_ARRAY(metrics, nr);
+	if (metrics == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < nr; i++) {
+		snprintf(name, sizeof(name), "rpc_received_%s_%d",
+			 smod->sm_name, i);
+		rc = dss_metric_register(name, DSS_METRIC_COUNTER,
+					 &metrics[i].rm_recv);
+		if (rc != 0)
+			goto failed;
+
+		snprintf(name, sizeof(name), "rpc_dispatch_errors_%s_%d",
+			 smod->sm_name, i);
+		rc = dss_metric_register(name, DSS_METRIC_COUNTER,
+					 &metrics[i].rm_err);
+		if (rc != 0)
+			goto failed;
+	}
+
+	rpc_metrics[smod->sm_mod_id] = metrics;
+	rpc_metrics_nr[smod->sm_mod_id] = nr;
+	return 0;
+failed:
+	D_FREE(metrics);
+	return rc;
+}
+
+void
+dss_rpc_metrics_unregister(struct dss_module *smod)
+{
+	if (rpc_metrics[smod->sm_mod_id] == NULL)
+		return;
+
+	D_FREE(rpc_metrics[smod->sm_mod_id]);
+	rpc_metrics_nr[smod->sm_mod_id] = 0;
+}
+
+/**
+ * Count a received RPC, and whether it failed to be dispatched, against the
+ * module and opcode of \a opc. RPCs of CART and of modules without protocol
+ * are not counted.
+ */
+void
+dss_rpc_metrics_add(crt_opcode_t opc, bool failed)
+{
+	int			 mod_id = opc_get_mod_id(opc);
+	int			 idx = opc_get(opc);
+	struct rpc_metric	*metric;
+
+	if (mod_id >= DAOS_MAX_MODULE || idx >= rpc_metrics_nr[mod_id])
+		return;
+
+	metric = &rpc_metrics[mod_id][idx];
+	dss_metric_add(metric->rm_recv, 1);
+	if (failed)
+		dss_metric_add(metric->rm_err, 1);
+}
+
+/* Allocate the metric slots for current xstream */
+int
+dss_metrics_xs_attach(struct dss_module_info *dmi)
+{
+	uint64_t	*slots;
+
+	D_ASSERT(dmi->dmi_xs_id < metrics_xs_nr);
+	metrics_frozen = true;
+	if (metrics_slots == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(slots, metrics_slots);
+	if (slots == NULL)
+		return -DER_NOMEM;
+
+	metrics_xs[dmi->dmi_xs_id] = slots;
+	dmi->dmi_metrics = slots;
+	return 0;
+}
+
+/* Lower bound of the histogram bucket */
+static uint64_t
+metric_bucket_bound(int bkt)
+{
+	int	mask = (1 << DSS_METRIC_SUB_BITS) - 1;
+	int	bits;
+
+	if (bkt <= mask)
+		return bkt;
+
+	bits = (bkt >> DSS_METRIC_SUB_BITS) + DSS_METRIC_SUB_BITS - 1;
+	return (uint64_t)((bkt & mask) | (mask + 1)) <<
+	       (bits - DSS_METRIC_SUB_BITS);
+}
+
+static void
+metric_free(Srv__Metric *metric)
+{
+	if (metric->bounds != NULL)
+		D_FREE(metric->bounds);
+	if (metric->counts != NULL)
+		D_FREE(metric->counts);
+	D_FREE(metric);
+}
+
+/*
+ * Sum up the metric over all xstreams. Xstreams keep updating the slots while
+ * they are read w/o any synchronization, the result is a snapshot which may
+ * miss some concurrent updates.
+ */
+static Srv__Metric *
+metric_read(struct dss_metric *dm, uint64_t *buckets)
+{
+	Srv__Metric	*metric;
+	uint64_t	*slots;
+	int		 i, j, nr;
+
+	D_ALLOC_PTR(metric);
+	if (metric == NULL)
+		return NULL;
+
+	srv__metric__init(metric);
+	metric->name = dm->dm_name;
+	metric->histogram = (dm->dm_type == DSS_METRIC_HISTOGRAM);
+
+	if (!metric->histogram) {
+		for (i = 0; i < metrics_xs_nr; i++) {
+			if (metrics_xs[i] != NULL)
+				metric->value += metrics_xs[i][dm->dm_off];
+		}
+		return metric;
+	}
+
+	memset(buckets, 0, sizeof(*buckets) * DSS_METRIC_BUCKETS);
+	for (i = 0; i < metrics_xs_nr; i++) {
+		if (metrics_xs[i] == NULL)
+			continue;
+
+		slots = metrics_xs[i] + dm->dm_off;
+		metric->value += slots[DSS_METRIC_HIST_CNT];
+		metric->sum += slots[DSS_METRIC_HIST_SUM];
+		for (j = 0; j < DSS_METRIC_BUCKETS; j++)
+			buckets[j] += slots[DSS_METRIC_HIST_BKT + j];
+	}
+
+	for (j = 0, nr = 0; j < DSS_METRIC_BUCKETS; j++) {
+		if (buckets[j] != 0)
+			nr++;
+	}
+	if (nr == 0)
+		return metric;
+
+	D_ALLOC_ARRAY(metric->bounds, nr);
+	D_ALLOC_ARRAY(metric->counts, nr);
+	if (metric->bounds == NULL || metric->counts == NULL) {
+		metric_free(metric);
+		return NULL;
+	}
+
+	for (j = 0; j < DSS_METRIC_BUCKETS; j++) {
+		if (buckets[j] == 0)
+			continue;
+		metric->bounds[metric->n_bounds++] = metric_bucket_bound(j);
+		metric->counts[metric->n_counts++] = buckets[j];
+	}
+
+	return metric;
+}
+
+static int
+metrics_get(Srv__GetMetricsResp *resp)
+{
+	uint64_t	*buckets;
+	int		 i;
+
+	if (metrics_nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(resp->metrics, metrics_nr);
+	D_ALLOC_ARRAY(buckets, DSS_METRIC_BUCKETS);
+	if (resp->metrics == NULL || buckets == NULL) {
+		if (buckets != NULL)
+			D_FREE(buckets);
+		return -DER_NOMEM;
+	}
+
+	for (i = 0; i < metrics_nr; i++) {
+		resp->metrics[i] = metric_read(&dss_metrics[i], buckets);
+		if (resp->metrics[i] == NULL) {
+			D_FREE(buckets);
+			return -DER_NOMEM;
+		}
+		resp->n_metrics++;
+	}
+
+	D_FREE(buckets);
+	return 0;
+}
+
+/*
+ * dRPC handler of DRPC_MODULE_IOSRV, the response body is a
+ * Srv__GetMetricsResp for DRPC_METHOD_IOSRV_GET_METRICS.
+ */
+static void
+metrics_drpc_handler(Drpc__Call *drpc_req, Drpc__Response *drpc_resp)
+{
+	Srv__GetMetricsResp	 resp = SRV__GET_METRICS_RESP__INIT;
+	uint8_t			*body;
+	size_t			 len;
+	int			 i;
+
+	if (drpc_req->method != DRPC_METHOD_IOSRV_GET_METRICS) {
+		drpc_resp->status = DRPC__STATUS__UNKNOWN_METHOD;
+		D_ERROR("Unknown method %d\n", drpc_req->method);
+		return;
+	}
+
+	resp.status = metrics_get(&resp);
+
+	len = srv__get_metrics_resp__get_packed_size(&resp);
+	D_ALLOC(body, len);
+	if (body == NULL) {
+		drpc_resp->status = DRPC__STATUS__FAILURE;
+		D_ERROR("Failed to allocate drpc response body\n");
+		goto out;
+	}
+
+	srv__get_metrics_resp__pack(&resp, body);
+	drpc_resp->body.len = len;
+	drpc_resp->body.data = body;
+out:
+	for (i = 0; i < resp.n_metrics; i++)
+		metric_free(resp.metrics[i]);
+	if (resp.metrics != NULL)
+		D_FREE(resp.metrics);
+}
+
+int
+dss_metrics_init(void)
+{
+	int	rc;
+
+	metrics_xs_nr = DSS_XS_NR_TOTAL;
+	D_ALLOC_ARRAY(metrics_xs, metrics_xs_nr);
+	if (metrics_xs == NULL)
+		return -DER_NOMEM;
+
+	rc = drpc_hdlr_register(DRPC_MODULE_IOSRV, metrics_drpc_handler);
+	if (rc != 0) {
+		D_FREE(metrics_xs);
+		return rc;
+	}
+
+	return 0;
+}
+
+void
+dss_metrics_fini(void)
+{
+	int	i;
+
+	drpc_hdlr_unregister(DRPC_MODULE_IOSRV);
+
+	for (i = 0; i < metrics_xs_nr; i++) {
+		if (metrics_xs[i] != NULL)
+			D_FREE(metrics_xs[i]);
+	}
+	D_FREE(metrics_xs);
+	metrics_xs_nr = 0;
+	metrics_nr = 0;
+	metrics_slots = 0;
+	metrics_frozen = false;
+}
@@ -154,12 +154,20 @@ dss_module_load(const char *modname, uint64_t *mod_facs)
 		D_GOTO(err_mod_init, rc);
 	}
 
+	/* register per-opcode RPC metrics */
+	rc = dss_rpc_metrics_register(smod);
+	if (rc) {
+		D_ERROR("failed to register RPC metrics for %s: %d\n",
+			modname, rc);
+		D_GOTO(err_rpc, rc);
+	}
+
 	/* register dRPC handlers */
 	rc = drpc_hdlr_register_all(smod->sm_drpc_handlers);
 	if (rc) {
 		D_ERROR("failed to register dRPC for %s: %d\n",
 			modname, rc);
-		D_GOTO(err_rpc, rc);
+		D_GOTO(err_rpc_metrics, rc);
 	}
 
 	if (mod_facs != NULL)
@@ -173,6 +181,8 @@ dss_module_load(const char *modname, uint64_t *mod_facs)
 
 	return 0;
 
+err_rpc_metrics:
+	dss_rpc_metrics_unregister(smod);
 err_rpc:
 	daos_rpc_unregister(smod->sm_proto_fmt);
 err_mod_init:
@@ -204,6 +214,7 @@ dss_module_unload_internal(struct loaded_mod *lmod)
 	}
 
 	dss_unregister_key(smod->sm_key);
+	dss_rpc_metrics_unregister(smod);
 
 	dss_modules[smod->sm_mod_id] = NULL;
 	/* finalize the module */
@@ -293,12 +304,23 @@ dss_module_cleanup_all(void)
 int
 dss_module_init(void)
 {
-	return drpc_hdlr_init();
+	int	rc;
+
+	rc = drpc_hdlr_init();
+	if (rc != 0)
+		return rc;
+
+	rc = dss_metrics_init();
+	if (rc != 0)
+		drpc_hdlr_fini();
+
+	return rc;
 }
 
 int
 dss_module_fini(bool force)
 {
+	dss_metrics_fini();
 	return drpc_hdlr_fini();
 }
 
@@ -339,3 +339,170 @@ srv_profile_stop(struct srv_profile *sp)
 
 	return 0;
 }
+
+static char *dss_trace_names[] = {
+	[DSS_TR_RPC_DISPATCH]		= "rpc_dispatch",
+	[DSS_TR_OBJ_RW]			= "obj_rw",
+	[DSS_TR_OBJ_PRE_CHECK]		= "obj_pre_check",
+	[DSS_TR_OBJ_UPDATE_BEGIN]	= "obj_update_begin",
+	[DSS_TR_OBJ_FETCH_BEGIN]	= "obj_fetch_begin",
+	[DSS_TR_OBJ_IOD_PREP]		= "obj_iod_prep",
+	[DSS_TR_OBJ_BULK]		= "obj_bulk",
+	[DSS_TR_OBJ_UPDATE_END]		= "obj_update_end",
+	[DSS_TR_OBJ_FETCH_END]		= "obj_fetch_end",
+	[DSS_TR_DTX_COMMIT]		= "dtx_commit",
+	[DSS_TR_NVME_IO]		= "nvme_io",
+};
+
+struct dss_tracer *
+dss_tracer_create(void)
+{
+	struct dss_tracer *tr;
+
+	D_ALLOC_PTR(tr);
+	return tr;
+}
+
+void
+dss_tracer_destroy(struct dss_tracer *tr)
+{
+	D_FREE(tr);
+}
+
+/* Callback for the NVMe command completion in BIO */
+void
+dss_trace_nvme_io(uint64_t start)
+{
+	DSS_TRACE_END(DSS_TR_NVME_IO, start);
+}
+
+/* Reset the tracer of current xstream */
+void
+dss_trace_reset(void)
+{
+	struct dss_tracer *tr = dss_get_module_info()->dmi_tracer;
+
+	if (tr != NULL)
+		memset(tr, 0, sizeof(*tr));
+}
+
+/* Upper bound (ns) of the bucket where the @pct percentile falls in */
+static uint64_t
+trace_percentile(uint64_t *hist, uint64_t cnt, int pct)
+{
+	uint64_t	sum = 0;
+	uint64_t	target;
+	int		i;
+
+	target = (cnt * pct + 99) / 100;
+	for (i = 0; i < DSS_TRACE_BUCKETS; i++) {
+		sum += hist[i];
+		if (sum >= target)
+			break;
+	}
+
+	return i >= DSS_TRACE_BUCKETS - 1 ? UINT64_MAX : (uint64_t)1 << i;
+}
+
+static int
+trace_dump_file(struct dss_tracer *tr, FILE *file)
+{
+	uint64_t	 start;
+	int		 i, j;
+
+	fprintf(file, "# stage bucket_upper_ns count\n");
+	for (i = 0; i < DSS_TR_MAX; i++) {
+		for (j = 0; j < DSS_TRACE_BUCKETS; j++) {
+			if (tr->dt_hist[i][j] == 0)
+				continue;
+			fprintf(file, "%s "DF_U64" "DF_U64"\n",
+				dss_trace_names[i], (uint64_t)1 << j,
+				tr->dt_hist[i][j]);
+		}
+	}
+
+	/* Then the recent samples, from the oldest to the newest */
+	fprintf(file, "# stage start_ns latency_ns\n");
+	start = tr->dt_head > DSS_TRACE_RING_SIZE ?
+		tr->dt_head - DSS_TRACE_RING_SIZE : 0;
+	for (; start < tr->dt_head; start++) {
+		struct dss_trace_rec *rec;
+
+		rec = &tr->dt_ring[start & (DSS_TRACE_RING_SIZE - 1)];
+		fprintf(file, "%s "DF_U64" %u\n",
+			dss_trace_names[rec->tr_stage], rec->tr_start,
+			rec->tr_lat);
+	}
+
+	/* errno isn't reliable after a buffered write failed */
+	if (ferror(file)) {
+		D_ERROR("dump trace failed\n");
+		return -DER_IO;
+	}
+	return 0;
+}
+
+/**
+ * Export the latency of each stage traced by current xstream: print the
+ * count, average, max and p50/p90/p99 (upper bound of the histogram bucket),
+ * and dump the histograms and recent samples into "trace-<rank>-<tgt>.dump"
+ * under \a path if it's not NULL.
+ */
+int
+dss_trace_dump(const char *path)
+{
+	struct dss_tracer	*tr = dss_get_module_info()->dmi_tracer;
+	int			 tgt_id = dss_get_module_info()->dmi_tgt_id;
+	d_rank_t		 rank;
+	FILE			*file;
+	char			*name;
+	uint64_t		 cnt;
+	int			 i, j;
+	int			 rc;
+
+	if (tr == NULL)
+		return 0;
+
+	rc = crt_group_rank(NULL, &rank);
+	if (rc)
+		return rc;
+
+	for (i = 0; i < DSS_TR_MAX; i++) {
+		for (j = 0, cnt = 0; j < DSS_TRACE_BUCKETS; j++)
+			cnt += tr->dt_hist[i][j];
+		if (cnt == 0)
+			continue;
+
+		D_PRINT("TRACE rank:%u tgt:%d %-16s cnt:"DF_U64" avg:"DF_U64
+			" max:"DF_U64" p50:<"DF_U64" p90:<"DF_U64
+			" p99:<"DF_U64" (ns)\n", rank, tgt_id,
+			dss_trace_names[i], cnt, tr->dt_total[i] / cnt,
+			tr->dt_max[i],
+			trace_percentile(tr->dt_hist[i], cnt, 50),
+			trace_percentile(tr->dt_hist[i], cnt, 90),
+			trace_percentile(tr->dt_hist[i], cnt, 99));
+	}
+
+	if (path == NULL)
+		return 0;
+
+	D_ASPRINTF(name, "%s/trace-%u-%d.dump", path, rank, tgt_id);
+	if (name == NULL)
+		return -DER_NOMEM;
+
+	file = fopen(name, "w");
+	if (file == NULL) {
+		rc = daos_errno2der(errno);
+		D_ERROR("open %s: %s\n", name, strerror(errno));
+		goto out;
+	}
+
+	rc = trace_dump_file(tr, file);
+	if (fclose(file) != 0 && rc == 0) {
+		rc = daos_errno2der(errno);
+		D_ERROR("close %s failed: %d\n", name, rc);
+	}
+out:
+	D_FREE(name);
+	return rc;
+}
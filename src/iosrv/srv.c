@@ -29,8 +29,10 @@
  */
 #define D_LOGFAC       DD_FAC(server)
 
+#include <sched.h>
 #include <abt.h>
 #include <daos/common.h>
+#include <daos/checksum.h>
 #include <daos/event.h>
 #include <daos_errno.h>
 #include <daos_srv/bio.h>
@@ -100,6 +102,8 @@ dss_ctx_nr_get(void)
 #define REBUILD_DEFAULT_SCHEDULE_RATIO	30
 unsigned int	dss_rebuild_res_percentage = REBUILD_DEFAULT_SCHEDULE_RATIO;
 unsigned int	dss_first_res_percentage = FIRST_DEFAULT_SCHEDULE_RATIO;
+unsigned int	dss_rebuild_pull_bw;
+unsigned int	dss_rebuild_pull_iops;
 
 #define DSS_SYS_XS_NAME_FMT	"daos_sys_%d"
 #define DSS_TGT_XS_NAME_FMT	"daos_tgt_%d_xs_%d"
@@ -118,18 +122,96 @@ struct dss_xstream_data {
 	/** barrier for all ULTs to enter handling loop */
 	ABT_cond		  xd_ult_barrier;
 	ABT_mutex		  xd_mutex;
+	/** cached arenas for collective operations, protected by xd_mutex */
+	d_list_t		  xd_coll_arenas;
 };
 
 static struct dss_xstream_data	xstream_data;
 
+/**
+ * Work stealing mode (DAOS_WORK_STEALING), idle target xstreams steal ULTs
+ * from DSS_POOL_STEALABLE of the sibling xstreams on the same NUMA node.
+ */
+bool		dss_work_stealing;
+/**
+ * All xstreams are started and none is stopping, stealing is allowed.
+ * Accessed with atomic builtins, see dss_sched_steal() and dss_steal_quiesce()
+ */
+static bool	dss_steal_ready;
+/** Number of xstreams in the middle of stealing */
+static int	dss_steal_active;
+/** Hot-path tracing (DAOS_TRACE), enabled by default */
+bool		dss_trace_enabled = true;
+/**
+ * Metrics of all received RPCs and failures to dispatch them, including the
+ * CART ones, see dss_rpc_metrics_add() for the per-opcode ones.
+ */
+static int	dss_rpc_recv_metric = -1;
+static int	dss_rpc_dispatch_err_metric = -1;
+
+/**
+ * The pools are scheduled in three classes by weighted deficit round robin,
+ * the weight of DSS_POOL_URGENT is dss_first_res_percentage, the weight of
+ * DSS_POOL_REBUILD is dss_rebuild_res_percentage of what's left, and the rest
+ * is the weight of the normal pools (DSS_POOL_PRIV and DSS_POOL_SHARE).
+ */
+enum {
+	SCHED_CLS_URGENT,
+	SCHED_CLS_NORMAL,
+	SCHED_CLS_REBUILD,
+	SCHED_CLS_NR,
+};
+
+static const char *sched_cls_names[SCHED_CLS_NR] = {
+	"urgent", "normal", "rebuild",
+};
+
+/** Spin this many times on empty pools before backing off */
+#define SCHED_IDLE_SPINS	1024
+/** Maximum sleep time in us on idle */
+#define SCHED_IDLE_MAX_US	128
+
+struct sched_cls {
+	/** Units can be popped in current turn */
+	int		sc_credits;
+	/**
+	 * Start time (us) of waiting for next turn with units left in the
+	 * pools, 0 if not waiting.
+	 */
+	uint64_t	sc_wait_start;
+	/** Stats */
+	uint64_t	sc_pops;
+	uint64_t	sc_turns;
+	uint64_t	sc_wait_total;
+	uint64_t	sc_wait_max;
+	size_t		sc_qlen_max;
+};
+
 struct sched_data {
-    uint32_t event_freq;
+	uint32_t		event_freq;
+	int			xs_id;
+	/** The class being served */
+	int			cur_cls;
+	/** Consecutive pops on empty pools, and current idle sleep in us */
+	uint32_t		idle_cnt;
+	uint32_t		idle_us;
+	/** Progress ULT of the xstream, and if any other unit ran after it */
+	ABT_thread		progress;
+	bool			ran_other;
+	/** Stats print period in us, 0 to disable */
+	uint64_t		stat_period;
+	uint64_t		stat_age;
+	struct sched_cls	cls[SCHED_CLS_NR];
+	/** Stealable pools of the sibling xstreams on same NUMA node */
+	struct dss_steal	steal;
+	bool			victims_init;
 };
 
 static int
 dss_sched_init(ABT_sched sched, ABT_sched_config config)
 {
 	struct sched_data	*p_data;
+	unsigned int		 period = 0;
 	int			 ret;
 
 	D_ALLOC_PTR(p_data);
@@ -137,10 +219,15 @@ dss_sched_init(ABT_sched sched, ABT_sched_config config)
 		return ABT_ERR_MEM;
 
 	/* Set the variables from the config */
-	ret = ABT_sched_config_read(config, 1, &p_data->event_freq);
+	ret = ABT_sched_config_read(config, 2, &p_data->event_freq,
+				    &p_data->xs_id);
 	if (ret != ABT_SUCCESS)
 		return ret;
 
+	d_getenv_int("DAOS_SCHED_STAT_PERIOD", &period);
+	p_data->stat_period = (uint64_t)period * 1000000;
+	p_data->stat_age = d_timeus_secdiff(0);
+
 	ret = ABT_sched_set_data(sched, (void *)p_data);
 
 	return ret;
@@ -178,38 +265,326 @@ normal_unit_pop(ABT_pool *pools, ABT_pool *pool)
 	return ABT_UNIT_NULL;
 }
 
-/**
- * Choose ULT from the pool.
- * Firstly with dss_first_res_percentage to schedule the task in
- * DSS_POOL_URGENT, then with dss_rebuild_res_percentage (of left) to
- * schedule rebuild task.
- */
 static ABT_unit
-dss_sched_unit_pop(ABT_pool *pools, ABT_pool *pool)
+sched_cls_pop(ABT_pool *pools, int cls, ABT_pool *pool)
 {
-	size_t		cnt;
-	int		rc;
+	ABT_unit	unit;
 
-	/* pop highest priority pool first */
-	rc = ABT_pool_get_total_size(pools[DSS_POOL_URGENT], &cnt);
-	if (rc != ABT_SUCCESS)
-		return ABT_UNIT_NULL;
-	if (cnt != 0 && rand() % 100 <= dss_first_res_percentage)
+	switch (cls) {
+	case SCHED_CLS_URGENT:
 		return unit_pop(pools, DSS_POOL_URGENT, pool);
+	case SCHED_CLS_REBUILD:
+		return unit_pop(pools, DSS_POOL_REBUILD, pool);
+	default:
+		unit = normal_unit_pop(pools, pool);
+		if (unit != ABT_UNIT_NULL)
+			return unit;
+		return unit_pop(pools, DSS_POOL_STEALABLE, pool);
+	}
+}
 
-	/* then pop other pools */
-	rc = ABT_pool_get_total_size(pools[DSS_POOL_REBUILD], &cnt);
-	if (rc != ABT_SUCCESS)
-		return ABT_UNIT_NULL;
+static size_t
+sched_cls_size(ABT_pool *pools, int cls)
+{
+	size_t	size = 0;
+	size_t	cnt;
 
-	if (cnt == 0 || rand() % 100 >= dss_rebuild_res_percentage)
-		return normal_unit_pop(pools, pool);
-	else
-		return unit_pop(pools, DSS_POOL_REBUILD, pool);
+	switch (cls) {
+	case SCHED_CLS_URGENT:
+		ABT_pool_get_size(pools[DSS_POOL_URGENT], &size);
+		break;
+	case SCHED_CLS_REBUILD:
+		ABT_pool_get_size(pools[DSS_POOL_REBUILD], &size);
+		break;
+	default:
+		ABT_pool_get_size(pools[DSS_POOL_PRIV], &size);
+		cnt = 0;
+		ABT_pool_get_size(pools[DSS_POOL_SHARE], &cnt);
+		size += cnt;
+		cnt = 0;
+		ABT_pool_get_size(pools[DSS_POOL_STEALABLE], &cnt);
+		size += cnt;
+		break;
+	}
+	return size;
+}
+
+/** Number of units a class can pop in each turn */
+static int
+sched_cls_quantum(int cls)
+{
+	unsigned int	left = 100 - min(dss_first_res_percentage, 99);
+	unsigned int	rebuild = left * dss_rebuild_res_percentage / 100;
+	unsigned int	quantum;
+
+	switch (cls) {
+	case SCHED_CLS_URGENT:
+		quantum = dss_first_res_percentage;
+		break;
+	case SCHED_CLS_REBUILD:
+		quantum = rebuild;
+		break;
+	default:
+		quantum = left - rebuild;
+		break;
+	}
+	/* Every class makes progress */
+	return quantum == 0 ? 1 : quantum;
+}
+
+/**
+ * Switch to the turn of next class, @qlen is the number of units left in the
+ * pools of current class.
+ */
+static void
+sched_next_turn(struct sched_data *data, size_t qlen)
+{
+	struct sched_cls	*cls = &data->cls[data->cur_cls];
+	uint64_t		 now = 0;
+
+	cls->sc_credits = 0;
+	if (qlen != 0) {
+		if (qlen > cls->sc_qlen_max)
+			cls->sc_qlen_max = qlen;
+		/* The class still has units, it waits for the next turn */
+		if (cls->sc_wait_start == 0)
+			cls->sc_wait_start = now = d_timeus_secdiff(0);
+	}
+
+	data->cur_cls = (data->cur_cls + 1) % SCHED_CLS_NR;
+	cls = &data->cls[data->cur_cls];
+	cls->sc_credits = sched_cls_quantum(data->cur_cls);
+	cls->sc_turns++;
+
+	if (cls->sc_wait_start != 0) {
+		uint64_t	wait;
+
+		if (now == 0)
+			now = d_timeus_secdiff(0);
+		wait = now - cls->sc_wait_start;
+		cls->sc_wait_total += wait;
+		if (wait > cls->sc_wait_max)
+			cls->sc_wait_max = wait;
+		cls->sc_wait_start = 0;
+	}
+}
+
+/**
+ * Choose ULT from the pools by weighted deficit round robin, each class
+ * pops up to its quantum of units in its turn, then the turn goes to the
+ * next class. The turn of class with empty pools is skipped immediately.
+ */
+static ABT_unit
+dss_sched_unit_pop(struct sched_data *data, ABT_pool *pools, ABT_pool *pool)
+{
+	struct sched_cls	*cls;
+	ABT_unit		 unit;
+	int			 i;
+
+	for (i = 0; i <= SCHED_CLS_NR; i++) {
+		cls = &data->cls[data->cur_cls];
+		if (cls->sc_credits > 0) {
+			unit = sched_cls_pop(pools, data->cur_cls, pool);
+			if (unit != ABT_UNIT_NULL) {
+				cls->sc_credits--;
+				cls->sc_pops++;
+				return unit;
+			}
+			sched_next_turn(data, 0);
+		} else {
+			sched_next_turn(data,
+					sched_cls_size(pools, data->cur_cls));
+		}
+	}
 
 	return ABT_UNIT_NULL;
 }
 
+/**
+ * The progress ULT is always runnable, so the xstream is considered idle
+ * when it runs the progress ULT twice in a row and nothing in between. This
+ * is cheap enough to check on each pop, the pools are only checked with
+ * dss_sched_pools_empty() before sleeping.
+ */
+static bool
+dss_sched_unit_idle(struct sched_data *data, ABT_unit unit)
+{
+	struct dss_xstream	*dx;
+	ABT_thread		 thread;
+	bool			 idle;
+
+	if (unit == ABT_UNIT_NULL)
+		return true;
+
+	if (data->progress == ABT_THREAD_NULL) {
+		dx = xstream_data.xd_xs_ptrs[data->xs_id];
+		if (dx == NULL)
+			return false;
+		data->progress = dx->dx_progress;
+	}
+
+	if (ABT_unit_get_thread(unit, &thread) != ABT_SUCCESS ||
+	    thread != data->progress) {
+		data->ran_other = true;
+		return false;
+	}
+
+	idle = !data->ran_other;
+	data->ran_other = false;
+	return idle;
+}
+
+/**
+ * Check if there isn't any unit to run except the progress ULT, which always
+ * sits in the DSS_POOL_SHARE pool when it's not running.
+ */
+static bool
+dss_sched_pools_empty(struct sched_data *data, ABT_pool *pools)
+{
+	size_t	size;
+	int	i;
+
+	for (i = 0; i < DSS_POOL_CNT; i++) {
+		size = 0;
+		ABT_pool_get_size(pools[i], &size);
+		if (i == DSS_POOL_SHARE && data->progress != ABT_THREAD_NULL &&
+		    size == 1)
+			continue;
+		if (size != 0)
+			return false;
+	}
+	return true;
+}
+
+/** Collect the stealable pools of sibling target xstreams on same NUMA */
+static void
+dss_sched_victims_init(struct sched_data *data)
+{
+	struct dss_xstream	*self, *dx;
+	int			 i;
+
+	data->victims_init = true;
+	if (data->xs_id < dss_sys_xs_nr)
+		return;
+
+	self = xstream_data.xd_xs_ptrs[data->xs_id];
+	if (self == NULL || self->dx_numa_node < 0)
+		return;
+
+	D_ALLOC_ARRAY(data->steal.st_victims, xstream_data.xd_xs_nr);
+	if (data->steal.st_victims == NULL)
+		return;
+
+	for (i = dss_sys_xs_nr; i < xstream_data.xd_xs_nr; i++) {
+		dx = xstream_data.xd_xs_ptrs[i];
+		if (dx == NULL || dx == self ||
+		    dx->dx_numa_node != self->dx_numa_node)
+			continue;
+		data->steal.st_victims[data->steal.st_victim_nr++] =
+			dx->dx_pools[DSS_POOL_STEALABLE];
+	}
+
+	D_DEBUG(DB_TRACE, "xs_id %d, NUMA %d, %d victims for stealing\n",
+		data->xs_id, self->dx_numa_node, data->steal.st_victim_nr);
+}
+
+/**
+ * Steal a ULT from sibling xstreams and run it, victims are tried in round
+ * robin. dss_steal_active is raised before dss_steal_ready is checked and
+ * dropped only after the stolen ULT returns, so once dss_steal_quiesce()
+ * returns no xstream touches the pools of another one.
+ *
+ * \return	true if a stolen ULT was run
+ */
+static bool
+dss_sched_steal(struct sched_data *data)
+{
+	bool	stolen = false;
+
+	__atomic_add_fetch(&dss_steal_active, 1, __ATOMIC_SEQ_CST);
+	if (!__atomic_load_n(&dss_steal_ready, __ATOMIC_SEQ_CST))
+		goto out;
+
+	if (!data->victims_init)
+		dss_sched_victims_init(data);
+
+	stolen = dss_steal_one(&data->steal);
+out:
+	__atomic_sub_fetch(&dss_steal_active, 1, __ATOMIC_SEQ_CST);
+	return stolen;
+}
+
+/** Stop stealing and wait for the in-progress steals to finish */
+static void
+dss_steal_quiesce(void)
+{
+	__atomic_store_n(&dss_steal_ready, false, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&dss_steal_active, __ATOMIC_SEQ_CST) != 0)
+		sched_yield();
+}
+
+/**
+ * Back off when there isn't any unit to run, so that idle xstreams don't
+ * burn the cores. Never back off while the progress ULT still has network
+ * or NVMe work outstanding, the completions would be delayed by the sleep.
+ */
+static void
+dss_sched_idle(struct sched_data *data, ABT_pool *pools, bool idle)
+{
+	struct dss_xstream	*dx = xstream_data.xd_xs_ptrs[data->xs_id];
+
+	if (!idle || (dx != NULL && dx->dx_busy)) {
+		data->idle_cnt = 0;
+		data->idle_us = 0;
+		return;
+	}
+
+	if (++data->idle_cnt < SCHED_IDLE_SPINS)
+		return;
+
+	if (!dss_sched_pools_empty(data, pools)) {
+		data->idle_cnt = 0;
+		data->idle_us = 0;
+		return;
+	}
+
+	data->idle_us = data->idle_us == 0 ? 1 :
+			min(data->idle_us * 2, SCHED_IDLE_MAX_US);
+	usleep(data->idle_us);
+}
+
+static void
+dss_sched_stat_print(struct sched_data *data)
+{
+	struct sched_cls	*cls;
+	uint64_t		 now;
+	int			 i;
+
+	if (data->stat_period == 0)
+		return;
+
+	now = d_timeus_secdiff(0);
+	if (data->stat_age + data->stat_period >= now)
+		return;
+
+	for (i = 0; i < SCHED_CLS_NR; i++) {
+		cls = &data->cls[i];
+		D_PRINT("SCHED STAT: xs_id[%d] %s: pops["DF_U64"], "
+			"turns["DF_U64"], wait_avg_us["DF_U64"], "
+			"wait_max_us["DF_U64"], qlen_max[%zu]\n",
+			data->xs_id, sched_cls_names[i], cls->sc_pops,
+			cls->sc_turns, cls->sc_turns ?
+			cls->sc_wait_total / cls->sc_turns : 0,
+			cls->sc_wait_max, cls->sc_qlen_max);
+		cls->sc_wait_max = 0;
+		cls->sc_qlen_max = 0;
+	}
+	if (dss_work_stealing)
+		D_PRINT("SCHED STAT: xs_id[%d] steals["DF_U64"]\n",
+			data->xs_id, data->steal.st_steals);
+	data->stat_age = now;
+}
+
 static void
 dss_sched_run(ABT_sched sched)
 {
@@ -218,6 +593,7 @@ dss_sched_run(ABT_sched sched)
 	ABT_pool		pools[DSS_POOL_CNT];
 	ABT_pool		pool = ABT_POOL_NULL;
 	ABT_unit		unit;
+	bool			idle;
 	int			ret;
 
 	ABT_sched_get_data(sched, (void **)&p_data);
@@ -230,9 +606,14 @@ dss_sched_run(ABT_sched sched)
 
 	while (1) {
 		/* Execute one work unit from the scheduler's pool */
-		unit = dss_sched_unit_pop(pools, &pool);
+		unit = dss_sched_unit_pop(p_data, pools, &pool);
+		idle = dss_sched_unit_idle(p_data, unit);
 		if (unit != ABT_UNIT_NULL && pool != ABT_UNIT_NULL)
 			ABT_xstream_run_unit(unit, pool);
+
+		if (idle && dss_work_stealing && dss_sched_steal(p_data))
+			idle = false;
+		dss_sched_idle(p_data, pools, idle);
 		if (++work_count >= p_data->event_freq) {
 			ABT_bool stop;
 
@@ -243,6 +624,7 @@ dss_sched_run(ABT_sched sched)
 			}
 			work_count = 0;
 			ABT_xstream_check_events(sched);
+			dss_sched_stat_print(p_data);
 		}
 	}
 }
@@ -253,6 +635,8 @@ dss_sched_free(ABT_sched sched)
 	struct sched_data *p_data;
 
 	ABT_sched_get_data(sched, (void **)&p_data);
+	if (p_data->steal.st_victims != NULL)
+		D_FREE(p_data->steal.st_victims);
 	D_FREE(p_data);
 
 	return ABT_SUCCESS;
@@ -262,7 +646,8 @@ dss_sched_free(ABT_sched sched)
  * Create scheduler
  */
 static int
-dss_sched_create(ABT_pool *pools, int pool_num, ABT_sched *new_sched)
+dss_sched_create(ABT_pool *pools, int pool_num, int xs_id,
+		 ABT_sched *new_sched)
 {
 	int			ret;
 	ABT_sched_config	config;
@@ -270,6 +655,10 @@ dss_sched_create(ABT_pool *pools, int pool_num, ABT_sched *new_sched)
 		.idx	= 0,
 		.type	= ABT_SCHED_CONFIG_INT
 	};
+	ABT_sched_config_var	cv_xs_id = {
+		.idx	= 1,
+		.type	= ABT_SCHED_CONFIG_INT
+	};
 
 	ABT_sched_def		sched_def = {
 		.type	= ABT_SCHED_TYPE_ULT,
@@ -281,6 +670,7 @@ dss_sched_create(ABT_pool *pools, int pool_num, ABT_sched *new_sched)
 
 	/* Create a scheduler config */
 	ret = ABT_sched_config_create(&config, cv_event_freq, 512,
+				      cv_xs_id, xs_id,
 				      ABT_sched_config_var_end);
 	if (ret != ABT_SUCCESS)
 		return dss_abterr2der(ret);
@@ -303,8 +693,10 @@ dss_process_rpc(crt_context_t *ctx, crt_rpc_t *rpc,
 	struct dss_module *module = dss_module_get(mod_id);
 	ABT_pool	*pools = arg;
 	ABT_pool	pool;
+	uint64_t	ts;
 	int		rc;
 
+	DSS_TRACE_BEGIN(ts);
 	/* For RPC originally from CART might still come here, and its mod_id
 	 * is 0xfe, and module would be NULL.
 	 */
@@ -316,8 +708,13 @@ dss_process_rpc(crt_context_t *ctx, crt_rpc_t *rpc,
 
 	rc = ABT_thread_create(pool, real_rpc_hdlr, rpc,
 			       ABT_THREAD_ATTR_NULL, NULL);
-	if (rc != ABT_SUCCESS)
+	if (rc != ABT_SUCCESS) {
 		rc = dss_abterr2der(rc);
+		dss_metric_add(dss_rpc_dispatch_err_metric, 1);
+	}
+	dss_metric_add(dss_rpc_recv_metric, 1);
+	dss_rpc_metrics_add(rpc->cr_opc, rc != 0);
+	DSS_TRACE_END(DSS_TR_RPC_DISPATCH, ts);
 	return rc;
 }
 
@@ -359,6 +756,11 @@ dss_srv_handler(void *arg)
 	dmi->dmi_ctx_id	= -1;
 	D_INIT_LIST_HEAD(&dmi->dmi_dtx_batched_list);
 
+	/* Metrics are best effort, go ahead w/o them on failure */
+	rc = dss_metrics_xs_attach(dmi);
+	if (rc != 0)
+		D_WARN("failed to attach metrics: %d\n", rc);
+
 	if (dx->dx_comm) {
 		/* create private transport context */
 		rc = crt_context_create(&dmi->dmi_ctx);
@@ -436,6 +838,7 @@ dss_srv_handler(void *arg)
 	/* main service progress loop */
 	for (;;) {
 		ABT_bool state;
+		bool	 busy = false;
 
 		if (dx->dx_comm) {
 			rc = crt_progress(dmi->dmi_ctx, 0 /* no wait */, NULL,
@@ -447,10 +850,17 @@ dss_srv_handler(void *arg)
 				 * temporary, Let's keep progressing for now.
 				 */
 			}
+			/* Made progress, more events are likely coming */
+			if (rc == 0)
+				busy = true;
 		}
 
-		if (dx->dx_main_xs)
-			bio_nvme_poll(dmi->dmi_nvme_ctxt);
+		if (dx->dx_main_xs) {
+			if (bio_nvme_poll(dmi->dmi_nvme_ctxt) != 0 ||
+			    bio_nvme_busy(dmi->dmi_nvme_ctxt))
+				busy = true;
+		}
+		dx->dx_busy = busy;
 
 		rc = ABT_future_test(dx->dx_shutdown, &state);
 		D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
@@ -550,6 +960,17 @@ dss_xstream_free(struct dss_xstream *dx)
 	D_FREE(dx);
 }
 
+/** Get the NUMA node covering the cpuset, -1 if unknown */
+static int
+dss_cpuset2numa(hwloc_cpuset_t cpus)
+{
+	hwloc_obj_t	obj;
+
+	obj = hwloc_get_next_obj_covering_cpuset_by_type(dss_topo, cpus,
+						HWLOC_OBJ_NUMANODE, NULL);
+	return obj == NULL ? -1 : obj->logical_index;
+}
+
 /**
  * Start one xstream.
  *
@@ -583,8 +1004,11 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 		 * is fine.
 		 */
 		access = (i == DSS_POOL_SHARE || i == DSS_POOL_REBUILD ||
-			  i == DSS_POOL_URGENT) ?
+			  i == DSS_POOL_URGENT || i == DSS_POOL_STEALABLE) ?
 			 ABT_POOL_ACCESS_MPSC : ABT_POOL_ACCESS_PRIV;
+		/* Stealable pool is popped by sibling xstreams */
+		if (i == DSS_POOL_STEALABLE && dss_work_stealing)
+			access = ABT_POOL_ACCESS_MPMC;
 
 		rc = ABT_pool_create_basic(ABT_POOL_FIFO, access, ABT_TRUE,
 					   &dx->dx_pools[i]);
@@ -611,8 +1035,10 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 	dx->dx_ctx_id	= -1;
 	dx->dx_comm	= comm;
 	dx->dx_main_xs	= xs_id >= dss_sys_xs_nr && xs_offset == 0;
+	dx->dx_numa_node = dss_cpuset2numa(cpus);
 
-	rc = dss_sched_create(dx->dx_pools, DSS_POOL_CNT, &dx->dx_sched);
+	rc = dss_sched_create(dx->dx_pools, DSS_POOL_CNT, xs_id,
+			      &dx->dx_sched);
 	if (rc != 0) {
 		D_ERROR("create scheduler fails: %d\n", rc);
 		D_GOTO(out_pool, rc);
@@ -685,6 +1111,8 @@ out_pool:
 	return rc;
 }
 
+static void coll_arenas_fini(void);
+
 static void
 dss_xstreams_fini(bool force)
 {
@@ -693,6 +1121,8 @@ dss_xstreams_fini(bool force)
 	int			 rc;
 
 	D_DEBUG(DB_TRACE, "Stopping execution streams\n");
+	/* No xstream may pop from the pools of others once teardown starts */
+	dss_steal_quiesce();
 
 	/** Stop & free progress ULTs */
 	for (i = 0; i < xstream_data.xd_xs_nr; i++) {
@@ -730,6 +1160,7 @@ dss_xstreams_fini(bool force)
 	}
 
 	/* All other xstreams have terminated. */
+	coll_arenas_fini();
 	xstream_data.xd_xs_nr = 0;
 	dss_tgt_nr = 0;
 
@@ -792,6 +1223,10 @@ dss_xstreams_init()
 		return -DER_NOMEM;
 	}
 
+	d_getenv_bool("DAOS_WORK_STEALING", &dss_work_stealing);
+	if (dss_work_stealing)
+		D_INFO("Work stealing is enabled\n");
+
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE, "%d cores detected, starting %d main xstreams\n",
 		dss_core_nr, dss_tgt_nr);
@@ -830,6 +1265,8 @@ dss_xstreams_init()
 	D_DEBUG(DB_TRACE, "%d execution streams successfully started "
 		"(first core %d)\n", dss_tgt_nr, dss_core_offset);
 out:
+	if (rc == 0)
+		__atomic_store_n(&dss_steal_ready, true, __ATOMIC_SEQ_CST);
 	dss_xstreams_open_barrier();
 	if (dss_xstreams_empty()) /* started nothing */
 		pthread_key_delete(dss_tls_key);
@@ -848,6 +1285,9 @@ dss_srv_tls_init(const struct dss_thread_local_storage *dtls,
 	struct dss_module_info *info;
 
 	D_ALLOC_PTR(info);
+	if (info != NULL && dss_trace_enabled)
+		/* Tracing is best effort, go ahead w/o tracer on failure */
+		info->dmi_tracer = dss_tracer_create();
 
 	return info;
 }
@@ -858,6 +1298,8 @@ dss_srv_tls_fini(const struct dss_thread_local_storage *dtls,
 {
 	struct dss_module_info *info = (struct dss_module_info *)data;
 
+	if (info->dmi_tracer != NULL)
+		dss_tracer_destroy(info->dmi_tracer);
 	D_FREE(info);
 }
 
@@ -980,6 +1422,48 @@ dss_ult_create_all(void (*func)(void *), void *arg, bool main)
 	return rc;
 }
 
+/**
+ * Bring the calling ULT back to the xstream it was created on, if it was
+ * created in DSS_POOL_STEALABLE and has been stolen by a sibling xstream.
+ * A stealable ULT must call it before touching anything bound to its target,
+ * such as the per-target module TLS or VOS, then it stays in DSS_POOL_SHARE
+ * of its own xstream and can't be stolen again.
+ *
+ * It is a no-op for the other ULTs or when work stealing is disabled.
+ */
+int
+dss_ult_home(void)
+{
+	struct dss_xstream	*dx;
+	ABT_thread		 self;
+	ABT_pool		 pool;
+	bool			 stolen;
+	int			 rc;
+	int			 i;
+
+	if (!dss_work_stealing)
+		return 0;
+
+	rc = ABT_thread_self(&self);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	rc = ABT_thread_get_last_pool(self, &pool);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	for (i = dss_sys_xs_nr; i < xstream_data.xd_xs_nr; i++) {
+		dx = xstream_data.xd_xs_ptrs[i];
+		if (dx == NULL || dx->dx_pools[DSS_POOL_STEALABLE] != pool)
+			continue;
+
+		stolen = (dx != dss_get_module_info()->dmi_xstream);
+		return dss_ult_migrate(dx->dx_pools[DSS_POOL_SHARE], stolen);
+	}
+
+	return 0;
+}
+
 struct aggregator_arg_type {
 	struct dss_stream_arg_type	at_args;
 	void				(*at_reduce)(void *a_args,
@@ -1078,44 +1562,214 @@ free:
 	return rc;
 }
 
-struct collective_arg {
-	struct dss_future_arg		ca_future;
+/** Fan-out degree of the collective tree within a NUMA node */
+#define DSS_COLL_FANOUT		4
+
+struct dss_coll_arena;
+
+/** Node of the collective tree, one for each target */
+struct dss_coll_node {
+	struct dss_coll_arena	*ccn_arena;
+	int			 ccn_tid;
+	/** Position range of the NUMA group where the node is located */
+	int			 ccn_grp_start;
+	int			 ccn_grp_nr;
+};
+
+/**
+ * Arena of a collective operation. The ULTs of collective are created in a
+ * tree: the caller creates ULT for the first target of each NUMA node, then
+ * each target creates ULTs for its DSS_COLL_FANOUT children in the same NUMA
+ * node before executing the function. Targets only count down on
+ * completion, the results are reduced by the caller after all of them are
+ * done, so co_reduce never runs on the target xstreams.
+ *
+ * Arenas are cached after use, so the collective doesn't allocate per target
+ * on every call.
+ */
+struct dss_coll_arena {
+	d_list_t			 cca_link;
+	int				 cca_xs_nr;
+	struct dss_stream_arg_type	*cca_streams;
+	/** Tree nodes ordered by NUMA node */
+	struct dss_coll_node		*cca_nodes;
+	/** Start positions of the NUMA groups */
+	int				*cca_grps;
+	int				 cca_grp_nr;
+	ABT_eventual			 cca_eventual;
+	pthread_spinlock_t		 cca_lock;
+	/** Parameters of current collective call */
+	struct dss_coll_ops		*cca_ops;
+	void				*cca_func_args;
+	bool				 cca_create_ult;
+	/** Targets not completed yet, protected by cca_lock */
+	int				 cca_remaining;
 };
 
 static void
-collective_func(void *varg)
+coll_arena_free(struct dss_coll_arena *arena)
 {
-	struct dss_stream_arg_type	*a_args	= varg;
-	struct collective_arg		*carg	= a_args->st_coll_args;
-	struct dss_future_arg		*f_arg	= &carg->ca_future;
-	int				rc;
+	if (arena->cca_eventual != ABT_EVENTUAL_NULL)
+		ABT_eventual_free(&arena->cca_eventual);
+	D_SPIN_DESTROY(&arena->cca_lock);
+	D_FREE(arena->cca_grps);
+	D_FREE(arena->cca_nodes);
+	D_FREE(arena->cca_streams);
+	D_FREE(arena);
+}
+
+static struct dss_coll_arena *
+coll_arena_alloc(int xs_nr)
+{
+	struct dss_coll_arena	*arena;
+	struct dss_xstream	*dx;
+	int			*numa;
+	int			 i, j, pos, rc;
+
+	D_ALLOC_PTR(arena);
+	if (arena == NULL)
+		return NULL;
+
+	D_INIT_LIST_HEAD(&arena->cca_link);
+	arena->cca_xs_nr = xs_nr;
+	arena->cca_eventual = ABT_EVENTUAL_NULL;
+	rc = D_SPIN_INIT(&arena->cca_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc) {
+		D_FREE(arena);
+		return NULL;
+	}
 
-	/** Update just the rc value */
-	a_args->st_rc = f_arg->dfa_func(f_arg->dfa_arg);
+	D_ALLOC_ARRAY(arena->cca_streams, xs_nr);
+	D_ALLOC_ARRAY(arena->cca_nodes, xs_nr);
+	D_ALLOC_ARRAY(arena->cca_grps, xs_nr);
+	D_ALLOC_ARRAY(numa, xs_nr);
+	if (arena->cca_streams == NULL || arena->cca_nodes == NULL ||
+	    arena->cca_grps == NULL || numa == NULL)
+		goto failed;
 
-	rc = ABT_future_set(f_arg->dfa_future, (void *)a_args);
+	rc = ABT_eventual_create(0, &arena->cca_eventual);
 	if (rc != ABT_SUCCESS)
-		D_ERROR("future set failure %d\n", rc);
+		goto failed;
+
+	for (i = 0; i < xs_nr; i++) {
+		dx = dss_xstream_get(DSS_MAIN_XS_ID(i));
+		numa[i] = dx->dx_numa_node;
+	}
+
+	/* Group the targets by NUMA node */
+	for (i = 0, pos = 0; i < xs_nr; i++) {
+		int	start = pos;
+
+		for (j = 0; j < i; j++) {
+			if (numa[j] == numa[i])
+				break;
+		}
+		if (j < i) /* the NUMA node has been grouped */
+			continue;
+
+		for (j = i; j < xs_nr; j++) {
+			if (numa[j] != numa[i])
+				continue;
+			arena->cca_nodes[pos].ccn_arena = arena;
+			arena->cca_nodes[pos].ccn_tid = j;
+			arena->cca_nodes[pos].ccn_grp_start = start;
+			pos++;
+		}
+		for (j = start; j < pos; j++)
+			arena->cca_nodes[j].ccn_grp_nr = pos - start;
+		arena->cca_grps[arena->cca_grp_nr++] = start;
+	}
+	D_ASSERT(pos == xs_nr);
+	D_FREE(numa);
+
+	D_DEBUG(DB_TRACE, "Collective arena for %d targets, %d NUMA groups\n",
+		xs_nr, arena->cca_grp_nr);
+	return arena;
+failed:
+	if (numa != NULL)
+		D_FREE(numa);
+	coll_arena_free(arena);
+	return NULL;
+}
+
+static struct dss_coll_arena *
+coll_arena_get(int xs_nr)
+{
+	struct dss_coll_arena	*arena = NULL;
+
+	ABT_mutex_lock(xstream_data.xd_mutex);
+	if (!d_list_empty(&xstream_data.xd_coll_arenas)) {
+		arena = d_list_entry(xstream_data.xd_coll_arenas.next,
+				     struct dss_coll_arena, cca_link);
+		d_list_del_init(&arena->cca_link);
+	}
+	ABT_mutex_unlock(xstream_data.xd_mutex);
+
+	if (arena != NULL && arena->cca_xs_nr != xs_nr) {
+		coll_arena_free(arena);
+		arena = NULL;
+	}
+
+	if (arena == NULL)
+		return coll_arena_alloc(xs_nr);
+
+	memset(arena->cca_streams, 0, sizeof(*arena->cca_streams) * xs_nr);
+	ABT_eventual_reset(arena->cca_eventual);
+	return arena;
+}
+
+static void
+coll_arena_put(struct dss_coll_arena *arena)
+{
+	arena->cca_ops = NULL;
+	arena->cca_func_args = NULL;
+
+	ABT_mutex_lock(xstream_data.xd_mutex);
+	d_list_add(&arena->cca_link, &xstream_data.xd_coll_arenas);
+	ABT_mutex_unlock(xstream_data.xd_mutex);
+}
+
+static void
+coll_arenas_fini(void)
+{
+	struct dss_coll_arena	*arena, *tmp;
+
+	d_list_for_each_entry_safe(arena, tmp, &xstream_data.xd_coll_arenas,
+				   cca_link) {
+		d_list_del_init(&arena->cca_link);
+		coll_arena_free(arena);
+	}
+}
+
+/** Wake up the caller on the completion of the last target */
+static void
+collective_complete(struct dss_coll_arena *arena)
+{
+	bool	last;
+
+	D_SPIN_LOCK(&arena->cca_lock);
+	D_ASSERT(arena->cca_remaining > 0);
+	last = (--arena->cca_remaining == 0);
+	D_SPIN_UNLOCK(&arena->cca_lock);
+
+	if (last)
+		ABT_eventual_set(arena->cca_eventual, NULL, 0);
 }
 
-/* Reduce the return codes into the first element. */
+/** Reduce the results of all targets into the aggregator, on the caller */
 static void
-collective_reduce(void **arg)
+collective_reduce(struct aggregator_arg_type *aggregator,
+		  struct dss_stream_arg_type *streams)
 {
-	struct aggregator_arg_type	*aggregator;
 	struct dss_stream_arg_type	*stream;
-	int				*nfailed;
 	int				 i;
 
-	aggregator = (struct aggregator_arg_type *)arg[0];
-	nfailed = &aggregator->at_args.st_rc;
-
-	for (i = 1; i < aggregator->at_xs_nr + 1; i++) {
-		stream = (struct dss_stream_arg_type *)arg[i];
+	for (i = 0; i < aggregator->at_xs_nr; i++) {
+		stream = &streams[i];
 		if (stream->st_rc != 0) {
 			if (aggregator->at_rc == 0)
 				aggregator->at_rc = stream->st_rc;
-			(*nfailed)++;
+			aggregator->at_args.st_rc++;
 		}
 
 		/** optional custom aggregator call provided across streams */
@@ -1125,17 +1779,88 @@ collective_reduce(void **arg)
 	}
 }
 
+static void collective_func(void *varg);
+
+/** Fail the subtree rooted at @pos, which can't be scheduled */
+static void
+collective_fail(struct dss_coll_arena *arena, int pos, int rc)
+{
+	struct dss_coll_node	*node = &arena->cca_nodes[pos];
+	struct dss_stream_arg_type *stream;
+	int			 local = pos - node->ccn_grp_start;
+	int			 i, child;
+
+	for (i = 1; i <= DSS_COLL_FANOUT; i++) {
+		child = local * DSS_COLL_FANOUT + i;
+		if (child >= node->ccn_grp_nr)
+			break;
+		collective_fail(arena, node->ccn_grp_start + child, rc);
+	}
+
+	stream = &arena->cca_streams[node->ccn_tid];
+	stream->st_rc = rc;
+	collective_complete(arena);
+}
+
+/** Create the ULT (or tasklet) for the tree node at @pos */
+static void
+collective_spawn(struct dss_coll_arena *arena, int pos)
+{
+	struct dss_coll_node	*node = &arena->cca_nodes[pos];
+	struct dss_xstream	*dx;
+	int			 rc;
+
+	dx = dss_xstream_get(DSS_MAIN_XS_ID(node->ccn_tid));
+	/* The fan-out of a busy target could be done by an idle sibling */
+	if (arena->cca_create_ult)
+		rc = ABT_thread_create(dx->dx_pools[dss_work_stealing ?
+				       DSS_POOL_STEALABLE : DSS_POOL_SHARE],
+				       collective_func, node,
+				       ABT_THREAD_ATTR_NULL, NULL);
+	else
+		rc = ABT_task_create(dx->dx_pools[DSS_POOL_SHARE],
+				     collective_func, node, NULL);
+
+	if (rc != ABT_SUCCESS)
+		collective_fail(arena, pos, dss_abterr2der(rc));
+}
+
+static void
+collective_func(void *varg)
+{
+	struct dss_coll_node		*node = varg;
+	struct dss_coll_arena		*arena = node->ccn_arena;
+	struct dss_stream_arg_type	*stream;
+	int				 local;
+	int				 i, child;
+
+	/* Fan out to the children in the same NUMA node first */
+	local = (node - arena->cca_nodes) - node->ccn_grp_start;
+	for (i = 1; i <= DSS_COLL_FANOUT; i++) {
+		child = local * DSS_COLL_FANOUT + i;
+		if (child >= node->ccn_grp_nr)
+			break;
+		collective_spawn(arena, node->ccn_grp_start + child);
+	}
+
+	stream = &arena->cca_streams[node->ccn_tid];
+	/* The function itself must run on the target xstream */
+	if (arena->cca_create_ult)
+		stream->st_rc = dss_ult_home();
+	if (stream->st_rc == 0)
+		stream->st_rc = arena->cca_ops->co_func(arena->cca_func_args);
+	collective_complete(arena);
+}
+
 static int
 dss_collective_reduce_internal(struct dss_coll_ops *ops,
 			       struct dss_coll_args *args, bool create_ult,
 			       int flag)
 {
-	struct collective_arg		carg;
 	struct dss_coll_stream_args	*stream_args;
 	struct dss_stream_arg_type	*stream;
 	struct aggregator_arg_type	aggregator;
-	struct dss_xstream		*dx;
-	ABT_future			future;
+	struct dss_coll_arena		*arena;
 	int				xs_nr;
 	int				rc;
 	int				tid;
@@ -1158,23 +1883,12 @@ dss_collective_reduce_internal(struct dss_coll_ops *ops,
 	}
 
 	xs_nr = dss_tgt_nr;
-	stream_args = &args->ca_stream_args;
-	D_ALLOC_ARRAY(stream_args->csa_streams, xs_nr);
-	if (stream_args->csa_streams == NULL)
+	arena = coll_arena_get(xs_nr);
+	if (arena == NULL)
 		return -DER_NOMEM;
 
-	/*
-	 * Use the first, extra element of the value array to store the number
-	 * of failed tasks.
-	 */
-	rc = ABT_future_create(xs_nr + 1, collective_reduce, &future);
-	if (rc != ABT_SUCCESS)
-		D_GOTO(out_streams, rc = dss_abterr2der(rc));
-
-	carg.ca_future.dfa_future = future;
-	carg.ca_future.dfa_func	= ops->co_func;
-	carg.ca_future.dfa_arg	= args->ca_func_args;
-	carg.ca_future.dfa_status = 0;
+	stream_args = &args->ca_stream_args;
+	stream_args->csa_streams = arena->cca_streams;
 
 	memset(&aggregator, 0, sizeof(aggregator));
 	aggregator.at_xs_nr = xs_nr;
@@ -1183,52 +1897,39 @@ dss_collective_reduce_internal(struct dss_coll_ops *ops,
 		aggregator.at_reduce	  = ops->co_reduce;
 	}
 
+	arena->cca_ops		= ops;
+	arena->cca_func_args	= args->ca_func_args;
+	arena->cca_create_ult	= create_ult;
+	arena->cca_remaining	= xs_nr;
+
+	rc = 0;
 	if (ops->co_reduce_arg_alloc)
 		for (tid = 0; tid < xs_nr; tid++) {
 			stream = &stream_args->csa_streams[tid];
 			rc = ops->co_reduce_arg_alloc(stream,
 						     aggregator.at_args.st_arg);
 			if (rc)
-				D_GOTO(out_future, rc);
+				D_GOTO(out_args, rc);
 		}
 
-	rc = ABT_future_set(future, (void *)&aggregator);
-	D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-
-	for (tid = 0; tid < xs_nr; tid++) {
-		stream			= &stream_args->csa_streams[tid];
-		stream->st_coll_args	= &carg;
+	for (tid = 0; tid < xs_nr; tid++)
+		stream_args->csa_streams[tid].st_coll_args = arena;
 
-		dx = dss_xstream_get(DSS_MAIN_XS_ID(tid));
-		if (create_ult)
-			rc = ABT_thread_create(dx->dx_pools[DSS_POOL_SHARE],
-					       collective_func, stream,
-					       ABT_THREAD_ATTR_NULL, NULL);
-		else
-			rc = ABT_task_create(dx->dx_pools[DSS_POOL_SHARE],
-					     collective_func, stream, NULL);
-
-		if (rc != ABT_SUCCESS) {
-			aggregator.at_args.st_rc = dss_abterr2der(rc);
-			rc = ABT_future_set(future,
-					    (void *)&aggregator);
-			D_ASSERTF(rc == ABT_SUCCESS, "%d\n", rc);
-		}
-	}
+	for (tid = 0; tid < arena->cca_grp_nr; tid++)
+		collective_spawn(arena, arena->cca_grps[tid]);
 
-	ABT_future_wait(future);
+	ABT_eventual_wait(arena->cca_eventual, NULL);
 
+	collective_reduce(&aggregator, stream_args->csa_streams);
 	rc = aggregator.at_rc;
 
-out_future:
-	ABT_future_free(&future);
-
+out_args:
 	if (ops->co_reduce_arg_free)
 		for (tid = 0; tid < xs_nr; tid++)
 			ops->co_reduce_arg_free(&stream_args->csa_streams[tid]);
 
-out_streams:
-	D_FREE(args->ca_stream_args.csa_streams);
+	stream_args->csa_streams = NULL;
+	coll_arena_put(arena);
 
 	return rc;
 }
@@ -1299,24 +2000,76 @@ dss_collective_internal(int (*func)(void *), void *arg, bool thread, int flag)
 	return rc;
 }
 
-/** TODO: use daos checksum library to offload checksum calculation */
+/** Compute or verify the chunk checksums of a dss_acc_task */
 static int
 compute_checksum_ult(void *args)
 {
-	return 0;
+	struct dss_acc_task	*at_args = args;
+	struct dss_acc_csum	*params = at_args->at_params;
+	daos_csum_buf_t		*csum_buf = params->ac_csum_buf;
+	daos_csum_buf_t		 result;
+	int			 rc;
+
+	switch (at_args->at_opcode) {
+	case DSS_ACC_CSUM_COMPUTE:
+		return daos_csum_compute_chunks(params->ac_csum, params->ac_sgl,
+						params->ac_off,
+						csum_buf->cs_chunksize,
+						csum_buf);
+	case DSS_ACC_CSUM_VERIFY:
+		break;
+	default:
+		D_ERROR("Unknown offload opcode %d\n", at_args->at_opcode);
+		return -DER_INVAL;
+	}
+
+	memset(&result, 0, sizeof(result));
+	result.cs_buf_len = csum_buf->cs_nr * csum_buf->cs_len;
+	D_ALLOC(result.cs_csum, result.cs_buf_len);
+	if (result.cs_csum == NULL)
+		return -DER_NOMEM;
+
+	rc = daos_csum_compute_chunks(params->ac_csum, params->ac_sgl,
+				      params->ac_off, csum_buf->cs_chunksize,
+				      &result);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (result.cs_nr != csum_buf->cs_nr ||
+	    result.cs_len != csum_buf->cs_len) {
+		D_ERROR("Checksum count/length mismatch: %u/%u, %u/%u\n",
+			result.cs_nr, csum_buf->cs_nr, result.cs_len,
+			csum_buf->cs_len);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	if (memcmp(result.cs_csum, csum_buf->cs_csum,
+		   result.cs_nr * result.cs_len) != 0) {
+		D_ERROR("Checksum mismatch\n");
+		rc = -DER_IO;
+	}
+out:
+	D_FREE(result.cs_csum);
+	return rc;
 }
 
-/** TODO: use OFI calls to calculate checksum on FPGA */
+/**
+ * TODO: use OFI calls to calculate checksum on FPGA, compute it on the
+ * calling ULT until then.
+ */
 static int
 compute_checksum_acc(void *args)
 {
-	return 0;
+	return compute_checksum_ult(args);
 }
 
 /**
  * Generic offload call - abstraction for accelaration with
  *
  * \param[in] at_args	accelaration tasks with both ULT and FPGA
+ *
+ * \return		0 on success, -DER_IO if checksum verification
+ *			failed, or other negative error code
  */
 int
 dss_acc_offload(struct dss_acc_task *at_args)
@@ -1325,12 +2078,8 @@ dss_acc_offload(struct dss_acc_task *at_args)
 	int		rc = 0;
 	int		tid;
 
-	/**
-	 * Currently just launching it in this stream,
-	 * ideally will move to a separate exclusive xstream
-	 */
 	tid = dss_get_module_info()->dmi_tgt_id;
-	if (at_args == NULL) {
+	if (at_args == NULL || at_args->at_params == NULL) {
 		D_ERROR("missing arguments for acc_offload\n");
 		return -DER_INVAL;
 	}
@@ -1343,8 +2092,18 @@ dss_acc_offload(struct dss_acc_task *at_args)
 
 	switch (at_args->at_offload_type) {
 	case DSS_OFFLOAD_ULT:
+		/**
+		 * Run on the helper xstream of this target (DSS_ULT_CHECKSUM)
+		 * and wait for the result, so the target xstream can serve
+		 * other ULTs in the meantime. System xstreams have no helper,
+		 * compute in place.
+		 */
+		if (tid < 0) {
+			rc = compute_checksum_ult(at_args);
+			break;
+		}
 		rc = dss_ult_create_execute(compute_checksum_ult,
-				at_args->at_params,
+				at_args,
 				NULL /* user-cb */,
 				NULL /* user-cb args */,
 				DSS_ULT_CHECKSUM, tid,
@@ -1352,10 +2111,13 @@ dss_acc_offload(struct dss_acc_task *at_args)
 		break;
 	case DSS_OFFLOAD_ACC:
 		/** calls to offload to FPGA*/
-		rc = compute_checksum_acc(at_args->at_params);
+		rc = compute_checksum_acc(at_args);
 		break;
 	}
 
+	if (rc == 0 && at_args->at_cb != NULL)
+		rc = at_args->at_cb(at_args->at_params);
+
 	return rc;
 }
 
@@ -1566,6 +2328,7 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 		break;
 	case DSS_KEY_FAIL_NUM:
 		daos_fail_num_set(value);
+		break;
 	case DSS_REBUILD_RES_PERCENTAGE:
 		if (value >= 100) {
 			D_ERROR("invalid value "DF_U64"\n", value);
@@ -1575,6 +2338,21 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 		D_WARN("set rebuild percentage to "DF_U64"\n", value);
 		dss_rebuild_res_percentage = value;
 		break;
+	case DSS_REBUILD_PULL_BW:
+	case DSS_REBUILD_PULL_IOPS:
+		if (value > UINT_MAX) {
+			D_ERROR("invalid value "DF_U64"\n", value);
+			rc = -DER_INVAL;
+			break;
+		}
+		D_WARN("set rebuild pull %s budget to "DF_U64"\n",
+		       key_id == DSS_REBUILD_PULL_BW ? "MiB/sec" : "dkeys/sec",
+		       value);
+		if (key_id == DSS_REBUILD_PULL_BW)
+			dss_rebuild_pull_bw = value;
+		else
+			dss_rebuild_pull_iops = value;
+		break;
 	default:
 		D_ERROR("invalid key_id %d\n", key_id);
 		rc = -DER_INVAL;
@@ -1640,6 +2418,7 @@ dss_srv_init()
 
 	xstream_data.xd_init_step  = XD_INIT_NONE;
 	xstream_data.xd_ult_signal = false;
+	D_INIT_LIST_HEAD(&xstream_data.xd_coll_arenas);
 
 	D_ALLOC_ARRAY(xstream_data.xd_xs_ptrs, DSS_XS_NR_TOTAL);
 	if (xstream_data.xd_xs_ptrs == NULL)
@@ -1676,6 +2455,22 @@ dss_srv_init()
 		D_GOTO(failed, rc);
 	xstream_data.xd_init_step = XD_INIT_NVME;
 
+	/* Metrics must be registered before starting xstreams */
+	rc = dss_metric_register("rpc_received", DSS_METRIC_COUNTER,
+				 &dss_rpc_recv_metric);
+	if (rc == 0)
+		rc = dss_metric_register("rpc_dispatch_errors",
+					 DSS_METRIC_COUNTER,
+					 &dss_rpc_dispatch_err_metric);
+	if (rc != 0)
+		D_GOTO(failed, rc);
+
+	d_getenv_bool("DAOS_TRACE", &dss_trace_enabled);
+	if (dss_trace_enabled)
+		bio_register_io_trace(dss_trace_nvme_io);
+	D_INFO("Hot-path tracing is %s\n",
+	       dss_trace_enabled ? "enabled" : "disabled");
+
 	/* start xstreams */
 	rc = dss_xstreams_init();
 	if (!dss_xstreams_empty()) /* cleanup if we started something */
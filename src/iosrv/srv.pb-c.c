@@ -52,6 +52,96 @@ void   srv__notify_ready_req__free_unpacked
   assert(message->base.descriptor == &srv__notify_ready_req__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   srv__metric__init
+                     (Srv__Metric         *message)
+{
+  static const Srv__Metric init_value = SRV__METRIC__INIT;
+  *message = init_value;
+}
+size_t srv__metric__get_packed_size
+                     (const Srv__Metric *message)
+{
+  assert(message->base.descriptor == &srv__metric__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t srv__metric__pack
+                     (const Srv__Metric *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &srv__metric__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t srv__metric__pack_to_buffer
+                     (const Srv__Metric *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &srv__metric__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Srv__Metric *
+       srv__metric__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Srv__Metric *)
+     protobuf_c_message_unpack (&srv__metric__descriptor,
+                                allocator, len, data);
+}
+void   srv__metric__free_unpacked
+                     (Srv__Metric *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &srv__metric__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   srv__get_metrics_resp__init
+                     (Srv__GetMetricsResp         *message)
+{
+  static const Srv__GetMetricsResp init_value = SRV__GET_METRICS_RESP__INIT;
+  *message = init_value;
+}
+size_t srv__get_metrics_resp__get_packed_size
+                     (const Srv__GetMetricsResp *message)
+{
+  assert(message->base.descriptor == &srv__get_metrics_resp__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t srv__get_metrics_resp__pack
+                     (const Srv__GetMetricsResp *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &srv__get_metrics_resp__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t srv__get_metrics_resp__pack_to_buffer
+                     (const Srv__GetMetricsResp *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &srv__get_metrics_resp__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Srv__GetMetricsResp *
+       srv__get_metrics_resp__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Srv__GetMetricsResp *)
+     protobuf_c_message_unpack (&srv__get_metrics_resp__descriptor,
+                                allocator, len, data);
+}
+void   srv__get_metrics_resp__free_unpacked
+                     (Srv__GetMetricsResp *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &srv__get_metrics_resp__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 static const ProtobufCFieldDescriptor srv__notify_ready_req__field_descriptors[2] =
 {
   {
@@ -103,3 +193,157 @@ const ProtobufCMessageDescriptor srv__notify_ready_req__descriptor =
   (ProtobufCMessageInit) srv__notify_ready_req__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
+static const ProtobufCFieldDescriptor srv__metric__field_descriptors[6] =
+{
+  {
+    "name",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(Srv__Metric, name),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "histogram",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(Srv__Metric, histogram),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "value",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(Srv__Metric, value),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "sum",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(Srv__Metric, sum),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds",
+    5,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(Srv__Metric, n_bounds),   /* quantifier_offset */
+    offsetof(Srv__Metric, bounds),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "counts",
+    6,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(Srv__Metric, n_counts),   /* quantifier_offset */
+    offsetof(Srv__Metric, counts),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned srv__metric__field_indices_by_name[] = {
+  4,   /* field[4] = bounds */
+  5,   /* field[5] = counts */
+  1,   /* field[1] = histogram */
+  0,   /* field[0] = name */
+  3,   /* field[3] = sum */
+  2,   /* field[2] = value */
+};
+static const ProtobufCIntRange srv__metric__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 6 }
+};
+const ProtobufCMessageDescriptor srv__metric__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "srv.Metric",
+  "Metric",
+  "Srv__Metric",
+  "srv",
+  sizeof(Srv__Metric),
+  6,
+  srv__metric__field_descriptors,
+  srv__metric__field_indices_by_name,
+  1,  srv__metric__number_ranges,
+  (ProtobufCMessageInit) srv__metric__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor srv__get_metrics_resp__field_descriptors[2] =
+{
+  {
+    "status",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(Srv__GetMetricsResp, status),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "metrics",
+    2,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Srv__GetMetricsResp, n_metrics),   /* quantifier_offset */
+    offsetof(Srv__GetMetricsResp, metrics),
+    &srv__metric__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned srv__get_metrics_resp__field_indices_by_name[] = {
+  1,   /* field[1] = metrics */
+  0,   /* field[0] = status */
+};
+static const ProtobufCIntRange srv__get_metrics_resp__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 2 }
+};
+const ProtobufCMessageDescriptor srv__get_metrics_resp__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "srv.GetMetricsResp",
+  "GetMetricsResp",
+  "Srv__GetMetricsResp",
+  "srv",
+  sizeof(Srv__GetMetricsResp),
+  2,
+  srv__get_metrics_resp__field_descriptors,
+  srv__get_metrics_resp__field_indices_by_name,
+  1,  srv__get_metrics_resp__number_ranges,
+  (ProtobufCMessageInit) srv__get_metrics_resp__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
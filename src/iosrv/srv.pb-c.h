@@ -16,6 +16,8 @@ PROTOBUF_C__BEGIN_DECLS
 
 
 typedef struct _Srv__NotifyReadyReq Srv__NotifyReadyReq;
+typedef struct _Srv__Metric Srv__Metric;
+typedef struct _Srv__GetMetricsResp Srv__GetMetricsResp;
 
 
 /* --- enums --- */
@@ -34,6 +36,47 @@ struct  _Srv__NotifyReadyReq
     , (char *)protobuf_c_empty_string, 0 }
 
 
+/*
+ * Metric is a counter or histogram summed up over all xstreams.
+ */
+struct  _Srv__Metric
+{
+  ProtobufCMessage base;
+  char *name;
+  protobuf_c_boolean histogram;
+  /*
+   * Counter value, or sample count of histogram.
+   */
+  uint64_t value;
+  /*
+   * Sum of the samples of histogram.
+   */
+  uint64_t sum;
+  /*
+   * Lower bounds and sample counts of non-empty histogram buckets.
+   */
+  size_t n_bounds;
+  uint64_t *bounds;
+  size_t n_counts;
+  uint64_t *counts;
+};
+#define SRV__METRIC__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&srv__metric__descriptor) \
+    , (char *)protobuf_c_empty_string, 0, 0, 0, 0,NULL, 0,NULL }
+
+
+struct  _Srv__GetMetricsResp
+{
+  ProtobufCMessage base;
+  int32_t status;
+  size_t n_metrics;
+  Srv__Metric **metrics;
+};
+#define SRV__GET_METRICS_RESP__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&srv__get_metrics_resp__descriptor) \
+    , 0, 0,NULL }
+
+
 /* Srv__NotifyReadyReq methods */
 void   srv__notify_ready_req__init
                      (Srv__NotifyReadyReq         *message);
@@ -53,11 +96,55 @@ Srv__NotifyReadyReq *
 void   srv__notify_ready_req__free_unpacked
                      (Srv__NotifyReadyReq *message,
                       ProtobufCAllocator *allocator);
+/* Srv__Metric methods */
+void   srv__metric__init
+                     (Srv__Metric         *message);
+size_t srv__metric__get_packed_size
+                     (const Srv__Metric   *message);
+size_t srv__metric__pack
+                     (const Srv__Metric   *message,
+                      uint8_t             *out);
+size_t srv__metric__pack_to_buffer
+                     (const Srv__Metric   *message,
+                      ProtobufCBuffer     *buffer);
+Srv__Metric *
+       srv__metric__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   srv__metric__free_unpacked
+                     (Srv__Metric *message,
+                      ProtobufCAllocator *allocator);
+/* Srv__GetMetricsResp methods */
+void   srv__get_metrics_resp__init
+                     (Srv__GetMetricsResp         *message);
+size_t srv__get_metrics_resp__get_packed_size
+                     (const Srv__GetMetricsResp   *message);
+size_t srv__get_metrics_resp__pack
+                     (const Srv__GetMetricsResp   *message,
+                      uint8_t             *out);
+size_t srv__get_metrics_resp__pack_to_buffer
+                     (const Srv__GetMetricsResp   *message,
+                      ProtobufCBuffer     *buffer);
+Srv__GetMetricsResp *
+       srv__get_metrics_resp__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   srv__get_metrics_resp__free_unpacked
+                     (Srv__GetMetricsResp *message,
+                      ProtobufCAllocator *allocator);
 /* --- per-message closures --- */
 
 typedef void (*Srv__NotifyReadyReq_Closure)
                  (const Srv__NotifyReadyReq *message,
                   void *closure_data);
+typedef void (*Srv__Metric_Closure)
+                 (const Srv__Metric *message,
+                  void *closure_data);
+typedef void (*Srv__GetMetricsResp_Closure)
+                 (const Srv__GetMetricsResp *message,
+                  void *closure_data);
 
 /* --- services --- */
 
@@ -65,6 +152,8 @@ typedef void (*Srv__NotifyReadyReq_Closure)
 /* --- descriptors --- */
 
 extern const ProtobufCMessageDescriptor srv__notify_ready_req__descriptor;
+extern const ProtobufCMessageDescriptor srv__metric__descriptor;
+extern const ProtobufCMessageDescriptor srv__get_metrics_resp__descriptor;
 
 PROTOBUF_C__END_DECLS
 
@@ -38,6 +38,8 @@ extern int		dss_core_offset;
 extern unsigned int	dss_tgt_offload_xs_nr;
 /** number of system XS */
 extern unsigned int	dss_sys_xs_nr;
+/** Work stealing among the sibling xstreams is enabled */
+extern bool		dss_work_stealing;
 
 /* module.c */
 int dss_module_init(void);
@@ -53,6 +55,32 @@ int dss_srv_init(void);
 int dss_srv_fini(bool force);
 void dss_dump_ABT_state(void);
 
+/* metrics.c */
+int dss_metrics_init(void);
+void dss_metrics_fini(void);
+int dss_metrics_xs_attach(struct dss_module_info *dmi);
+int dss_rpc_metrics_register(struct dss_module *smod);
+void dss_rpc_metrics_unregister(struct dss_module *smod);
+void dss_rpc_metrics_add(crt_opcode_t opc, bool failed);
+
+/* steal.c */
+/** Stealable pools of the sibling xstreams, and the stealing stats */
+struct dss_steal {
+	ABT_pool	*st_victims;
+	int		 st_victim_nr;
+	/** The last victim tried, victims are tried in round robin */
+	int		 st_victim_idx;
+	uint64_t	 st_steals;
+};
+
+bool dss_steal_one(struct dss_steal *st);
+int dss_ult_migrate(ABT_pool pool, bool yield);
+
+/* profile.c */
+struct dss_tracer *dss_tracer_create(void);
+void dss_tracer_destroy(struct dss_tracer *tr);
+void dss_trace_nvme_io(uint64_t start);
+
 /* tls.c */
 void dss_tls_fini(struct dss_thread_local_storage *dtls);
 struct dss_thread_local_storage *dss_tls_init(int tag);
@@ -104,6 +132,8 @@ dss_ult_xs(int ult_type, int tgt_id)
 
 	D_ASSERT(tgt_id >= 0 && tgt_id < dss_tgt_nr);
 	switch (ult_type) {
+	case DSS_ULT_DTX_COMMIT:
+		return DSS_MAIN_XS_ID(tgt_id);
 	case DSS_ULT_IOFW:
 	case DSS_ULT_MISC:
 		return (DSS_MAIN_XS_ID(tgt_id) + 1) % DSS_XS_NR_TOTAL;
@@ -137,10 +167,14 @@ dss_ult_pool(int ult_type)
 	switch (ult_type) {
 	case DSS_ULT_DTX_RESYNC:
 		return DSS_POOL_URGENT;
-	case DSS_ULT_IOFW:
 	case DSS_ULT_EC:
 	case DSS_ULT_CHECKSUM:
 	case DSS_ULT_COMPRESS:
+		return DSS_POOL_STEALABLE;
+	case DSS_ULT_DTX_COMMIT:
+		/* Could be stolen by the siblings if the target is busy */
+		return dss_work_stealing ? DSS_POOL_STEALABLE : DSS_POOL_SHARE;
+	case DSS_ULT_IOFW:
 	case DSS_ULT_POOL_SRV:
 	case DSS_ULT_DRPC:
 	case DSS_ULT_RDB:
@@ -0,0 +1,84 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of the DAOS server. It implements the xstream agnostic
+ * part of work stealing: running the ULTs stolen from the DSS_POOL_STEALABLE
+ * of sibling xstreams, and moving a ULT to another pool.
+ */
+#define D_LOGFAC       DD_FAC(server)
+
+#include "srv_internal.h"
+
+/**
+ * Pop a ULT from the victims in round robin, and run it on the calling
+ * xstream, it must be called by the scheduler.
+ *
+ * \return	true if a stolen ULT was run
+ */
+bool
+dss_steal_one(struct dss_steal *st)
+{
+	ABT_pool	pool;
+	ABT_unit	unit = ABT_UNIT_NULL;
+	int		i;
+
+	for (i = 0; i < st->st_victim_nr; i++) {
+		st->st_victim_idx = (st->st_victim_idx + 1) % st->st_victim_nr;
+		pool = st->st_victims[st->st_victim_idx];
+		ABT_pool_pop(pool, &unit);
+		if (unit != ABT_UNIT_NULL) {
+			st->st_steals++;
+			ABT_xstream_run_unit(unit, pool);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Make \a pool the associated pool of the calling ULT, so that it is pushed
+ * to \a pool instead of the one it was popped from once it yields.
+ *
+ * \param[in] pool	the new associated pool
+ * \param[in] yield	yield to be scheduled from \a pool right now
+ */
+int
+dss_ult_migrate(ABT_pool pool, bool yield)
+{
+	ABT_thread	self;
+	int		rc;
+
+	rc = ABT_thread_self(&self);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	/* The ULT is pushed to its associated pool when it yields */
+	rc = ABT_thread_set_associated_pool(self, pool);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	if (yield)
+		ABT_thread_yield();
+	return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+
+/*
+ * Unit tests for work stealing
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "../srv_internal.h"
+
+#define VICTIM_NR	2
+
+/* Pools not served by any scheduler, only the thief pops them */
+static ABT_pool		victims[VICTIM_NR];
+static struct dss_steal	steal;
+/* Served by the thief, it stays empty */
+static ABT_pool		thief_pool;
+static ABT_xstream	thief;
+/* Served by the home xstream of the migrated ULT */
+static ABT_pool		home_pool;
+static ABT_xstream	home;
+
+struct ult_arg {
+	ABT_eventual	ua_done;
+	/* Ranks of the xstreams the ULT ran on, before and after migration */
+	int		ua_rank;
+	int		ua_home_rank;
+	bool		ua_migrate;
+};
+
+/*
+ * Scheduler of the thief, it runs nothing but the stolen ULTs
+ */
+static int
+thief_sched_init(ABT_sched sched, ABT_sched_config config)
+{
+	return ABT_SUCCESS;
+}
+
+static void
+thief_sched_run(ABT_sched sched)
+{
+	ABT_bool	stop;
+
+	while (1) {
+		dss_steal_one(&steal);
+
+		ABT_sched_has_to_stop(sched, &stop);
+		if (stop == ABT_TRUE)
+			break;
+		ABT_xstream_check_events(sched);
+	}
+}
+
+static int
+thief_sched_free(ABT_sched sched)
+{
+	return ABT_SUCCESS;
+}
+
+/*
+ * Setup and teardown
+ */
+static int
+steal_test_setup(void **state)
+{
+	ABT_sched_def	sched_def = {
+		.type		= ABT_SCHED_TYPE_ULT,
+		.init		= thief_sched_init,
+		.run		= thief_sched_run,
+		.free		= thief_sched_free,
+		.get_migr_pool	= NULL
+	};
+	ABT_sched	sched;
+	int		i;
+	int		rc;
+
+	rc = ABT_init(0, NULL);
+	assert_int_equal(rc, ABT_SUCCESS);
+
+	for (i = 0; i < VICTIM_NR; i++) {
+		rc = ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPMC,
+					   ABT_FALSE, &victims[i]);
+		assert_int_equal(rc, ABT_SUCCESS);
+	}
+
+	memset(&steal, 0, sizeof(steal));
+	steal.st_victims = victims;
+	steal.st_victim_nr = VICTIM_NR;
+
+	rc = ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPSC,
+				   ABT_TRUE, &home_pool);
+	assert_int_equal(rc, ABT_SUCCESS);
+	rc = ABT_xstream_create_basic(ABT_SCHED_DEFAULT, 1, &home_pool,
+				      ABT_SCHED_CONFIG_NULL, &home);
+	assert_int_equal(rc, ABT_SUCCESS);
+
+	rc = ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPSC,
+				   ABT_TRUE, &thief_pool);
+	assert_int_equal(rc, ABT_SUCCESS);
+	rc = ABT_sched_create(&sched_def, 1, &thief_pool,
+			      ABT_SCHED_CONFIG_NULL, &sched);
+	assert_int_equal(rc, ABT_SUCCESS);
+	rc = ABT_xstream_create(sched, &thief);
+	assert_int_equal(rc, ABT_SUCCESS);
+
+	return 0;
+}
+
+static int
+steal_test_teardown(void **state)
+{
+	int	i;
+
+	ABT_xstream_join(thief);
+	ABT_xstream_free(&thief);
+	ABT_xstream_join(home);
+	ABT_xstream_free(&home);
+	for (i = 0; i < VICTIM_NR; i++)
+		ABT_pool_free(&victims[i]);
+	ABT_finalize();
+
+	return 0;
+}
+
+/*
+ * Unit tests
+ */
+static void
+stealable_ult(void *data)
+{
+	struct ult_arg	*arg = data;
+
+	ABT_xstream_self_rank(&arg->ua_rank);
+	if (arg->ua_migrate) {
+		assert_int_equal(dss_ult_migrate(home_pool, true), 0);
+		ABT_xstream_self_rank(&arg->ua_home_rank);
+	}
+	ABT_eventual_set(arg->ua_done, NULL, 0);
+}
+
+static void
+ult_arg_init(struct ult_arg *arg, bool migrate)
+{
+	memset(arg, 0, sizeof(*arg));
+	arg->ua_rank = -1;
+	arg->ua_home_rank = -1;
+	arg->ua_migrate = migrate;
+	assert_int_equal(ABT_eventual_create(0, &arg->ua_done), ABT_SUCCESS);
+}
+
+static void
+ult_arg_wait(struct ult_arg *arg)
+{
+	assert_int_equal(ABT_eventual_wait(arg->ua_done, NULL), ABT_SUCCESS);
+	ABT_eventual_free(&arg->ua_done);
+}
+
+static int
+xstream_rank(ABT_xstream xstream)
+{
+	int	rank;
+
+	assert_int_equal(ABT_xstream_get_rank(xstream, &rank), ABT_SUCCESS);
+	return rank;
+}
+
+static void
+test_steal_one(void **state)
+{
+	struct ult_arg	arg;
+	size_t		size;
+	int		rc;
+
+	ult_arg_init(&arg, false);
+	rc = ABT_thread_create(victims[1], stealable_ult, &arg,
+			       ABT_THREAD_ATTR_NULL, NULL);
+	assert_int_equal(rc, ABT_SUCCESS);
+	ult_arg_wait(&arg);
+
+	/* Nobody serves the victim pool, so the thief must have run it */
+	assert_int_equal(arg.ua_rank, xstream_rank(thief));
+	ABT_pool_get_size(victims[1], &size);
+	assert_int_equal(size, 0);
+}
+
+static void
+test_steal_all_victims(void **state)
+{
+	struct ult_arg	args[VICTIM_NR];
+	int		i;
+	int		rc;
+
+	for (i = 0; i < VICTIM_NR; i++) {
+		ult_arg_init(&args[i], false);
+		rc = ABT_thread_create(victims[i], stealable_ult, &args[i],
+				       ABT_THREAD_ATTR_NULL, NULL);
+		assert_int_equal(rc, ABT_SUCCESS);
+	}
+
+	for (i = 0; i < VICTIM_NR; i++) {
+		ult_arg_wait(&args[i]);
+		assert_int_equal(args[i].ua_rank, xstream_rank(thief));
+	}
+}
+
+static void
+test_steal_migrate_home(void **state)
+{
+	struct ult_arg	arg;
+	int		rc;
+
+	ult_arg_init(&arg, true);
+	rc = ABT_thread_create(victims[0], stealable_ult, &arg,
+			       ABT_THREAD_ATTR_NULL, NULL);
+	assert_int_equal(rc, ABT_SUCCESS);
+	ult_arg_wait(&arg);
+
+	/* Stolen first, then finished on the xstream serving its new pool */
+	assert_int_equal(arg.ua_rank, xstream_rank(thief));
+	assert_int_equal(arg.ua_home_rank, xstream_rank(home));
+}
+
+/* Run last, it checks the number of ULTs stolen by the former tests */
+static void
+test_steal_count(void **state)
+{
+	assert_int_equal(steal.st_steals, 1 + VICTIM_NR + 1);
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_steal_one),
+		cmocka_unit_test(test_steal_all_victims),
+		cmocka_unit_test(test_steal_migrate_home),
+		cmocka_unit_test(test_steal_count),
+	};
+
+	return cmocka_run_group_tests(tests, steal_test_setup,
+				      steal_test_teardown);
+}
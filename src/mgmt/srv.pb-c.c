@@ -187,6 +187,96 @@ void   mgmt__create_ms_req__free_unpacked
   assert(message->base.descriptor == &mgmt__create_ms_req__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   mgmt__metric__init
+                     (Mgmt__Metric         *message)
+{
+  static const Mgmt__Metric init_value = MGMT__METRIC__INIT;
+  *message = init_value;
+}
+size_t mgmt__metric__get_packed_size
+                     (const Mgmt__Metric *message)
+{
+  assert(message->base.descriptor == &mgmt__metric__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t mgmt__metric__pack
+                     (const Mgmt__Metric *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &mgmt__metric__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t mgmt__metric__pack_to_buffer
+                     (const Mgmt__Metric *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &mgmt__metric__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Mgmt__Metric *
+       mgmt__metric__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Mgmt__Metric *)
+     protobuf_c_message_unpack (&mgmt__metric__descriptor,
+                                allocator, len, data);
+}
+void   mgmt__metric__free_unpacked
+                     (Mgmt__Metric *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &mgmt__metric__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   mgmt__get_metrics_resp__init
+                     (Mgmt__GetMetricsResp         *message)
+{
+  static const Mgmt__GetMetricsResp init_value = MGMT__GET_METRICS_RESP__INIT;
+  *message = init_value;
+}
+size_t mgmt__get_metrics_resp__get_packed_size
+                     (const Mgmt__GetMetricsResp *message)
+{
+  assert(message->base.descriptor == &mgmt__get_metrics_resp__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t mgmt__get_metrics_resp__pack
+                     (const Mgmt__GetMetricsResp *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &mgmt__get_metrics_resp__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t mgmt__get_metrics_resp__pack_to_buffer
+                     (const Mgmt__GetMetricsResp *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &mgmt__get_metrics_resp__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Mgmt__GetMetricsResp *
+       mgmt__get_metrics_resp__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Mgmt__GetMetricsResp *)
+     protobuf_c_message_unpack (&mgmt__get_metrics_resp__descriptor,
+                                allocator, len, data);
+}
+void   mgmt__get_metrics_resp__free_unpacked
+                     (Mgmt__GetMetricsResp *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &mgmt__get_metrics_resp__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 static const ProtobufCFieldDescriptor mgmt__daos_rank__field_descriptors[2] =
 {
   {
@@ -378,6 +468,160 @@ const ProtobufCMessageDescriptor mgmt__create_ms_req__descriptor =
   (ProtobufCMessageInit) mgmt__create_ms_req__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
+static const ProtobufCFieldDescriptor mgmt__metric__field_descriptors[6] =
+{
+  {
+    "name",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(Mgmt__Metric, name),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "histogram",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(Mgmt__Metric, histogram),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "value",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(Mgmt__Metric, value),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "sum",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(Mgmt__Metric, sum),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds",
+    5,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(Mgmt__Metric, n_bounds),   /* quantifier_offset */
+    offsetof(Mgmt__Metric, bounds),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "counts",
+    6,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(Mgmt__Metric, n_counts),   /* quantifier_offset */
+    offsetof(Mgmt__Metric, counts),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned mgmt__metric__field_indices_by_name[] = {
+  4,   /* field[4] = bounds */
+  5,   /* field[5] = counts */
+  1,   /* field[1] = histogram */
+  0,   /* field[0] = name */
+  3,   /* field[3] = sum */
+  2,   /* field[2] = value */
+};
+static const ProtobufCIntRange mgmt__metric__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 6 }
+};
+const ProtobufCMessageDescriptor mgmt__metric__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "mgmt.Metric",
+  "Metric",
+  "Mgmt__Metric",
+  "mgmt",
+  sizeof(Mgmt__Metric),
+  6,
+  mgmt__metric__field_descriptors,
+  mgmt__metric__field_indices_by_name,
+  1,  mgmt__metric__number_ranges,
+  (ProtobufCMessageInit) mgmt__metric__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor mgmt__get_metrics_resp__field_descriptors[2] =
+{
+  {
+    "status",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(Mgmt__GetMetricsResp, status),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "metrics",
+    2,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Mgmt__GetMetricsResp, n_metrics),   /* quantifier_offset */
+    offsetof(Mgmt__GetMetricsResp, metrics),
+    &mgmt__metric__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned mgmt__get_metrics_resp__field_indices_by_name[] = {
+  1,   /* field[1] = metrics */
+  0,   /* field[0] = status */
+};
+static const ProtobufCIntRange mgmt__get_metrics_resp__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 2 }
+};
+const ProtobufCMessageDescriptor mgmt__get_metrics_resp__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "mgmt.GetMetricsResp",
+  "GetMetricsResp",
+  "Mgmt__GetMetricsResp",
+  "mgmt",
+  sizeof(Mgmt__GetMetricsResp),
+  2,
+  mgmt__get_metrics_resp__field_descriptors,
+  mgmt__get_metrics_resp__field_indices_by_name,
+  1,  mgmt__get_metrics_resp__number_ranges,
+  (ProtobufCMessageInit) mgmt__get_metrics_resp__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
 static const ProtobufCEnumValue mgmt__daos_request_status__enum_values_by_number[4] =
 {
   { "ERR_INVALID_UUID", "MGMT__DAOS_REQUEST_STATUS__ERR_INVALID_UUID", -3 },
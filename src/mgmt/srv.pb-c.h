@@ -19,6 +19,8 @@ typedef struct _Mgmt__DaosRank Mgmt__DaosRank;
 typedef struct _Mgmt__DaosResponse Mgmt__DaosResponse;
 typedef struct _Mgmt__SetRankReq Mgmt__SetRankReq;
 typedef struct _Mgmt__CreateMsReq Mgmt__CreateMsReq;
+typedef struct _Mgmt__Metric Mgmt__Metric;
+typedef struct _Mgmt__GetMetricsResp Mgmt__GetMetricsResp;
 
 
 /* --- enums --- */
@@ -94,6 +96,48 @@ struct  _Mgmt__CreateMsReq
     , 0, (char *)protobuf_c_empty_string, (char *)protobuf_c_empty_string }
 
 
+/*
+ * Metric is a counter or histogram of an IO server, summed up over all
+ * xstreams.
+ */
+struct  _Mgmt__Metric
+{
+  ProtobufCMessage base;
+  char *name;
+  protobuf_c_boolean histogram;
+  /*
+   * Counter value, or sample count of histogram.
+   */
+  uint64_t value;
+  /*
+   * Sum of the samples of histogram.
+   */
+  uint64_t sum;
+  /*
+   * Lower bounds and sample counts of non-empty histogram buckets.
+   */
+  size_t n_bounds;
+  uint64_t *bounds;
+  size_t n_counts;
+  uint64_t *counts;
+};
+#define MGMT__METRIC__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&mgmt__metric__descriptor) \
+    , (char *)protobuf_c_empty_string, 0, 0, 0, 0,NULL, 0,NULL }
+
+
+struct  _Mgmt__GetMetricsResp
+{
+  ProtobufCMessage base;
+  int32_t status;
+  size_t n_metrics;
+  Mgmt__Metric **metrics;
+};
+#define MGMT__GET_METRICS_RESP__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&mgmt__get_metrics_resp__descriptor) \
+    , 0, 0,NULL }
+
+
 /* Mgmt__DaosRank methods */
 void   mgmt__daos_rank__init
                      (Mgmt__DaosRank         *message);
@@ -170,6 +214,44 @@ Mgmt__CreateMsReq *
 void   mgmt__create_ms_req__free_unpacked
                      (Mgmt__CreateMsReq *message,
                       ProtobufCAllocator *allocator);
+/* Mgmt__Metric methods */
+void   mgmt__metric__init
+                     (Mgmt__Metric         *message);
+size_t mgmt__metric__get_packed_size
+                     (const Mgmt__Metric   *message);
+size_t mgmt__metric__pack
+                     (const Mgmt__Metric   *message,
+                      uint8_t             *out);
+size_t mgmt__metric__pack_to_buffer
+                     (const Mgmt__Metric   *message,
+                      ProtobufCBuffer     *buffer);
+Mgmt__Metric *
+       mgmt__metric__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   mgmt__metric__free_unpacked
+                     (Mgmt__Metric *message,
+                      ProtobufCAllocator *allocator);
+/* Mgmt__GetMetricsResp methods */
+void   mgmt__get_metrics_resp__init
+                     (Mgmt__GetMetricsResp         *message);
+size_t mgmt__get_metrics_resp__get_packed_size
+                     (const Mgmt__GetMetricsResp   *message);
+size_t mgmt__get_metrics_resp__pack
+                     (const Mgmt__GetMetricsResp   *message,
+                      uint8_t             *out);
+size_t mgmt__get_metrics_resp__pack_to_buffer
+                     (const Mgmt__GetMetricsResp   *message,
+                      ProtobufCBuffer     *buffer);
+Mgmt__GetMetricsResp *
+       mgmt__get_metrics_resp__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   mgmt__get_metrics_resp__free_unpacked
+                     (Mgmt__GetMetricsResp *message,
+                      ProtobufCAllocator *allocator);
 /* --- per-message closures --- */
 
 typedef void (*Mgmt__DaosRank_Closure)
@@ -184,6 +266,12 @@ typedef void (*Mgmt__SetRankReq_Closure)
 typedef void (*Mgmt__CreateMsReq_Closure)
                  (const Mgmt__CreateMsReq *message,
                   void *closure_data);
+typedef void (*Mgmt__Metric_Closure)
+                 (const Mgmt__Metric *message,
+                  void *closure_data);
+typedef void (*Mgmt__GetMetricsResp_Closure)
+                 (const Mgmt__GetMetricsResp *message,
+                  void *closure_data);
 
 /* --- services --- */
 
@@ -195,6 +283,8 @@ extern const ProtobufCMessageDescriptor mgmt__daos_rank__descriptor;
 extern const ProtobufCMessageDescriptor mgmt__daos_response__descriptor;
 extern const ProtobufCMessageDescriptor mgmt__set_rank_req__descriptor;
 extern const ProtobufCMessageDescriptor mgmt__create_ms_req__descriptor;
+extern const ProtobufCMessageDescriptor mgmt__metric__descriptor;
+extern const ProtobufCMessageDescriptor mgmt__get_metrics_resp__descriptor;
 
 PROTOBUF_C__END_DECLS
 
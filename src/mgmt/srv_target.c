@@ -735,6 +735,17 @@ tgt_profile_task(void *arg)
 	int mod_id = 0;
 	int rc = 0;
 
+	/* The hot-path tracer is always on, profiling starts a new window */
+	if (in->p_op == MGMT_PROFILE_START) {
+		dss_trace_reset();
+	} else {
+		/* Failing to dump trace shouldn't fail the profile request */
+		rc = dss_trace_dump(in->p_path);
+		if (rc)
+			D_ERROR("dump trace failed: rc %d\n", rc);
+		rc = 0;
+	}
+
 	for (mod_id = 0; mod_id < 64; mod_id++) {
 		uint64_t mask = 1 << mod_id;
 		struct dss_module *module;
@@ -45,14 +45,9 @@ struct ec_params {
 	unsigned int		nr;	/* number of records in iods and sgls
 					 * (same as update_t)
 					 */
-	daos_iod_t		niod;	/* replacement IOD for an input IOD
-					 * that includes full stripe.
-					 */
-	d_sg_list_t		nsgl;	/* replacement SGL for an input IOD that
-					 * includes full stripe.
-					 */
-	struct obj_ec_parity	p_segs;	/* Structure containing array of
-					 * pointers to parity extents.
+	struct obj_ec_iod	eiod;	/* replacement IOD and SGL for an input
+					 * IOD that includes full stripe, with
+					 * the parity extents.
 					 */
 	struct ec_params        *next;	/* Pointer to next entry in list. */
 };
@@ -64,17 +59,19 @@ static bool
 ec_has_full_stripe(daos_iod_t *iod, struct daos_oclass_attr *oca,
 		   uint64_t *tgt_set)
 {
-	unsigned int	ss = oca->u.ec.e_k * oca->u.ec.e_len;
+	uint64_t	ss = (uint64_t)oca->u.ec.e_k * oca->u.ec.e_len;
 	unsigned int	i;
 
 	for (i = 0; i < iod->iod_nr; i++) {
 		if (iod->iod_type == DAOS_IOD_ARRAY) {
-			int start = iod->iod_recxs[i].rx_idx * iod->iod_size;
-			int length = iod->iod_recxs[i].rx_nr * iod->iod_size;
-
-			if (length < ss) {
-				continue;
-			} else if (length - (start % ss) >= ss) {
+			uint64_t start = iod->iod_recxs[i].rx_idx *
+					 iod->iod_size;
+			uint64_t end = iod->iod_recxs[i].rx_nr *
+				       iod->iod_size + start;
+
+			/* the first stripe boundary in the recx */
+			start = (start + ss - 1) / ss * ss;
+			if (start + ss <= end) {
 				*tgt_set = ~0UL;
 				return true;
 			}
@@ -87,15 +84,6 @@ ec_has_full_stripe(daos_iod_t *iod, struct daos_oclass_attr *oca,
 	return false;
 }
 
-/* Initialize a param structure for an IOD--SGL pair. */
-static void
-ec_init_params(struct ec_params *params, daos_iod_t *iod, d_sg_list_t *sgl)
-{
-	memset(params, 0, sizeof(struct ec_params));
-	params->niod		= *iod;
-	params->nsgl		= *sgl;
-}
-
 /* The head of the params list contains the replacement IOD and SGL arrays.
  * These are used only when stripes have been encoded for the update.
  *
@@ -124,146 +112,6 @@ ec_set_head_params(struct ec_params *head, daos_obj_update_t *args,
 	return 0;
 }
 
-/* Moves the SGL "cursors" to the start of a full stripe */
-static void
-ec_move_sgl_cursors(d_sg_list_t *sgl, size_t size, unsigned int *sg_idx,
-		 size_t *sg_off)
-{
-	if (size < sgl->sg_iovs[*sg_idx].iov_len - *sg_off) {
-		*sg_off += size;
-	} else {
-		size_t buf_len = sgl->sg_iovs[*sg_idx].iov_len - *sg_off;
-
-		for (*sg_off = 0; *sg_idx < sgl->sg_nr; (*sg_idx)++) {
-			if (buf_len + sgl->sg_iovs[*sg_idx].iov_len > size) {
-				*sg_off = size - buf_len;
-				break;
-			}
-			buf_len += sgl->sg_iovs[*sg_idx].iov_len;
-		}
-	}
-}
-
-/* Allocates a stripe's worth of parity cells. */
-static int
-ec_allocate_parity(struct obj_ec_parity *par, unsigned int len, unsigned int p,
-		unsigned int prior_cnt)
-{
-	unsigned char	**nbuf;
-	unsigned int	i;
-	int		rc = 0;
-
-	D_REALLOC_ARRAY(nbuf, par->p_bufs, (prior_cnt + p));
-	if (nbuf == NULL)
-		return -DER_NOMEM;
-	par->p_bufs = nbuf;
-
-	for (i = prior_cnt; i < prior_cnt + p; i++) {
-		D_ALLOC(par->p_bufs[i], len);
-		if (par->p_bufs[i] == NULL)
-			return -DER_NOMEM;
-		par->p_nr++;
-	}
-	return rc;
-}
-
-/* Encode all of the full stripes contained within the recx at recx_idx.
- */
-static int
-ec_array_encode(struct ec_params *params, daos_obj_id_t oid, daos_iod_t *iod,
-		d_sg_list_t *sgl, struct daos_oclass_attr *oca,
-		int recx_idx, unsigned int *sg_idx, size_t *sg_off)
-{
-	uint64_t	 s_cur;
-	unsigned int	 len = oca->u.ec.e_len;
-	unsigned int	 k = oca->u.ec.e_k;
-	unsigned int	 p = oca->u.ec.e_p;
-	daos_recx_t     *this_recx = &iod->iod_recxs[recx_idx];
-	uint64_t	 recx_start_offset = this_recx->rx_idx * iod->iod_size;
-	uint64_t	 recx_end_offset = (this_recx->rx_nr * iod->iod_size) +
-					   recx_start_offset;
-	unsigned int	 i;
-	int		 rc = 0;
-
-	/* s_cur is the index (in bytes) into the recx where a full stripe
-	 * begins.
-	 */
-	s_cur = recx_start_offset + (recx_start_offset % (len * k));
-	if (s_cur != recx_start_offset)
-		/* if the start of stripe is not at beginning of recx, move
-		 * the sgl index to where the stripe begins).
-		 */
-		ec_move_sgl_cursors(sgl, recx_start_offset % (len * k), sg_idx,
-				    sg_off);
-
-	for ( ; s_cur + len*k <= recx_end_offset; s_cur += len*k) {
-		daos_recx_t *nrecx;
-
-		rc = ec_allocate_parity(&(params->p_segs), len, p,
-					params->niod.iod_nr);
-		if (rc != 0)
-			return rc;
-		rc = obj_encode_full_stripe(oid, sgl, sg_idx, sg_off,
-					    &(params->p_segs),
-					    params->niod.iod_nr);
-		if (rc != 0)
-			return rc;
-		/* Parity is prepended to the recx array, so we have to add
-		 * them here for each encoded stripe.
-		 */
-		D_REALLOC_ARRAY(nrecx, (params->niod.iod_recxs),
-				(params->niod.iod_nr+p));
-		if (nrecx == NULL)
-			return -DER_NOMEM;
-		params->niod.iod_recxs = nrecx;
-		for (i = 0; i < p; i++) {
-			params->niod.iod_recxs[params->niod.iod_nr].rx_idx =
-			PARITY_INDICATOR | (s_cur+i*len)/params->niod.iod_size;
-			params->niod.iod_recxs[params->niod.iod_nr++].rx_nr =
-				len / params->niod.iod_size;
-		}
-	}
-	return rc;
-}
-
-/* Updates the params instance for a IOD -- SGL pair.
- * The parity recxs have already been added, this function appends the
- * original recx entries.
- * The parity cells are placed first in the SGL, followed by the
- * input entries.
- */
-static int
-ec_update_params(struct ec_params *params, daos_iod_t *iod, d_sg_list_t *sgl,
-		 unsigned int len)
-{
-	daos_recx_t	*nrecx;
-	unsigned int	 i;
-	int		 rc = 0;
-
-	D_REALLOC_ARRAY(nrecx, (params->niod.iod_recxs),
-			(params->niod.iod_nr + iod->iod_nr));
-	if (nrecx == NULL)
-		return -DER_NOMEM;
-	params->niod.iod_recxs = nrecx;
-	for (i = 0; i < iod->iod_nr; i++)
-		params->niod.iod_recxs[params->niod.iod_nr++] =
-			iod->iod_recxs[i];
-
-	D_ALLOC_ARRAY(params->nsgl.sg_iovs, (params->p_segs.p_nr + sgl->sg_nr));
-	if (params->nsgl.sg_iovs == NULL)
-		return -DER_NOMEM;
-	for (i = 0; i < params->p_segs.p_nr; i++) {
-		params->nsgl.sg_iovs[i].iov_buf = params->p_segs.p_bufs[i];
-		params->nsgl.sg_iovs[i].iov_buf_len = len;
-		params->nsgl.sg_iovs[i].iov_len = len;
-		params->nsgl.sg_nr++;
-	}
-	for (i = 0; i < sgl->sg_nr; i++)
-		params->nsgl.sg_iovs[params->nsgl.sg_nr++] = sgl->sg_iovs[i];
-
-	return rc;
-}
-
 /* Recover EC allocated memory */
 static void
 ec_free_params(struct ec_params *head)
@@ -271,14 +119,9 @@ ec_free_params(struct ec_params *head)
 	D_FREE(head->iods);
 	D_FREE(head->sgls);
 	while (head != NULL) {
-		int i;
 		struct ec_params *current = head;
 
-		D_FREE(current->niod.iod_recxs);
-		D_FREE(current->nsgl.sg_iovs);
-		for (i = 0; i < current->p_segs.p_nr; i++)
-			D_FREE(current->p_segs.p_bufs[i]);
-		D_FREE(current->p_segs.p_bufs);
+		obj_ec_iod_fini(&current->eiod);
 		head = current->next;
 		D_FREE(current);
 	}
@@ -354,7 +197,7 @@ ec_obj_update_encode(tse_task_t *task, daos_obj_id_t oid,
 	daos_obj_update_t	*args = dc_task_get_args(task);
 	struct ec_params	*head = NULL;
 	struct ec_params	*current = NULL;
-	unsigned int		 i, j;
+	unsigned int		 i;
 	int			 rc = 0;
 
 	for (i = 0; i < args->nr; i++) {
@@ -369,7 +212,6 @@ ec_obj_update_encode(tse_task_t *task, daos_obj_id_t oid,
 				rc = -DER_NOMEM;
 				break;
 			}
-			ec_init_params(params, iod, sgl);
 			if (head == NULL) {
 				head = params;
 				current = head;
@@ -380,30 +222,14 @@ ec_obj_update_encode(tse_task_t *task, daos_obj_id_t oid,
 				current->next = params;
 				current = params;
 			}
-			if (args->iods[i].iod_type == DAOS_IOD_ARRAY) {
-				unsigned int sg_idx = 0;
-				size_t sg_off = 0;
-
-				for (j = 0; j < iod->iod_nr; j++) {
-					rc = ec_array_encode(params, oid, iod,
-							     sgl, oca, j,
-							     &sg_idx, &sg_off);
-					if (rc != 0)
-						break;
-				}
-				rc = ec_update_params(params, iod, sgl,
-						      oca->u.ec.e_len);
-				head->iods[i] = params->niod;
-				head->sgls[i] = params->nsgl;
-				D_ASSERT(head->nr == i);
-				head->nr++;
-			} else {
-				D_ASSERT(iod->iod_type ==
-					 DAOS_IOD_SINGLE && iod->iod_size >=
-					 oca->u.ec.e_len * oca->u.ec.e_k);
-				/* Encode single value */
-			}
-		} else if (head != NULL && &(head->sgls[i]) != NULL) {
+			rc = obj_ec_encode_iod(oid, iod, sgl, &params->eiod);
+			if (rc != 0)
+				break;
+			head->iods[i] = params->eiod.ei_iod;
+			head->sgls[i] = params->eiod.ei_sgl;
+			D_ASSERT(head->nr == i);
+			head->nr++;
+		} else if (head != NULL) {
 			/* Add sgls[i] and iods[i] to head. Since we're
 			 * adding ec parity (head != NULL) and thus need to
 			 * replace the arrays in the update struct.
@@ -441,4 +267,3 @@ ec_obj_update_encode(tse_task_t *task, daos_obj_id_t oid,
 	}
 	return rc;
 }
-
@@ -33,6 +33,8 @@
 #include "obj_internal.h"
 
 bool	srv_io_dispatch = true;
+unsigned int	obj_wcomb_size = (64 << 10);
+unsigned int	obj_wcomb_usec = 1000;
 
 /**
  * Initialize object interface
@@ -51,6 +53,9 @@ dc_obj_init(void)
 		D_DEBUG(DB_IO, "Server IO dispatch enabled.\n");
 	}
 
+	d_getenv_int("DAOS_IO_COMBINE_SIZE", &obj_wcomb_size);
+	d_getenv_int("DAOS_IO_COMBINE_USEC", &obj_wcomb_usec);
+
 	rc = daos_rpc_register(&obj_proto_fmt, OBJ_PROTO_CLI_COUNT,
 				NULL, DAOS_OBJ_MODULE);
 	if (rc != 0) {
@@ -135,6 +135,9 @@ obj_layout_free(struct dc_object *obj)
 		D_FREE(layout);
 }
 
+struct obj_wcomb;
+static void obj_wcomb_free(struct obj_wcomb *wc);
+
 static void
 obj_free(struct d_hlink *hlink)
 {
@@ -142,9 +145,14 @@ obj_free(struct d_hlink *hlink)
 
 	obj = container_of(hlink, struct dc_object, cob_hlink);
 	D_ASSERT(daos_hhash_link_empty(&obj->cob_hlink));
+	D_ASSERT(d_list_empty(&obj->cob_wcomb_flushes));
+	D_ASSERT(d_list_empty(&obj->cob_wcomb_waiters));
+	if (obj->cob_wcomb != NULL)
+		obj_wcomb_free(obj->cob_wcomb);
 	obj_layout_free(obj);
 	D_SPIN_DESTROY(&obj->cob_spin);
 	D_RWLOCK_DESTROY(&obj->cob_lock);
+	D_MUTEX_DESTROY(&obj->cob_wcomb_lock);
 	D_FREE(obj);
 }
 
@@ -161,6 +169,8 @@ obj_alloc(void)
 	if (obj == NULL)
 		return NULL;
 
+	D_INIT_LIST_HEAD(&obj->cob_wcomb_flushes);
+	D_INIT_LIST_HEAD(&obj->cob_wcomb_waiters);
 	daos_hhash_hlink_init(&obj->cob_hlink, &obj_h_ops);
 	return obj;
 }
@@ -225,6 +235,588 @@ dc_obj_hdl2cont_hdl(daos_handle_t oh)
 	return hdl;
 }
 
+/**
+ * Write-combining of DAOS_OO_IO_COMBINE: small updates without transaction
+ * are copied into a per-object buffer instead of being sent. The buffer holds
+ * a single dkey, one iod per akey, and the data of each iod in a single iov.
+ * Array updates of an already buffered akey are appended to its iod if their
+ * extents do not overlap.
+ *
+ * The buffer is flushed by an internal update task when it is full or stale,
+ * when the next update cannot be combined, or before any other operation on
+ * the object handle. The detached buffers of an object are flushed one by
+ * one, and the operations after a flush wait for it, so the order of I/O
+ * submitted through the handle is preserved, also across event queues.
+ */
+struct obj_wcomb {
+	/** copy of the dkey of all buffered updates */
+	daos_key_t		 wc_dkey;
+	/** buffered iods and their sgls, each sgl has a single iov */
+	daos_iod_t		*wc_iods;
+	d_sg_list_t		*wc_sgls;
+	unsigned int		 wc_nr;
+	/** number of buffered bytes */
+	daos_size_t		 wc_bytes;
+	/** when the first update was buffered, in nanoseconds */
+	uint64_t		 wc_start;
+	/** link on cob_wcomb_flushes once detached */
+	d_list_t		 wc_link;
+	/** sequence number of the flush */
+	uint64_t		 wc_seq;
+	/** scheduler of the operation which detached the buffer */
+	tse_sched_t		*wc_sched;
+};
+
+/** updates larger than this are not worth to be buffered */
+#define OBJ_WCOMB_IO_MAX	(4 << 10)
+/** bound the number of extents checked for overlap per akey */
+#define OBJ_WCOMB_RECX_MAX	256
+
+struct obj_wcomb_cb_args {
+	struct dc_object	*obj;
+	struct obj_wcomb	*wc;
+};
+
+static int obj_update_internal(tse_task_t *task, bool combine);
+
+static void
+obj_wcomb_free(struct obj_wcomb *wc)
+{
+	int	i;
+
+	for (i = 0; i < wc->wc_nr; i++) {
+		daos_iov_free(&wc->wc_iods[i].iod_name);
+		D_FREE(wc->wc_iods[i].iod_recxs);
+		daos_sgl_fini(&wc->wc_sgls[i], true);
+	}
+	D_FREE(wc->wc_iods);
+	D_FREE(wc->wc_sgls);
+	daos_iov_free(&wc->wc_dkey);
+	D_FREE(wc);
+}
+
+static int
+obj_wcomb_alloc(daos_key_t *dkey, struct obj_wcomb **wcp)
+{
+	struct obj_wcomb	*wc;
+	void			*buf;
+
+	D_ALLOC_PTR(wc);
+	if (wc == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC(buf, dkey->iov_len);
+	if (buf == NULL) {
+		D_FREE(wc);
+		return -DER_NOMEM;
+	}
+	memcpy(buf, dkey->iov_buf, dkey->iov_len);
+	d_iov_set(&wc->wc_dkey, buf, dkey->iov_len);
+	wc->wc_start = daos_get_ntime();
+
+	*wcp = wc;
+	return 0;
+}
+
+/** Whether the update can be buffered at all */
+static bool
+obj_wcomb_eligible(struct daos_oclass_attr *oca, daos_obj_update_t *args)
+{
+	daos_size_t	len;
+	int		i;
+	int		j;
+
+	if (!daos_handle_is_inval(args->th) || oca->ca_resil == DAOS_RES_EC ||
+	    args->sgls == NULL || args->dkey->iov_len == 0)
+		return false;
+
+	len = daos_iods_len(args->iods, args->nr);
+	if (len == (daos_size_t)-1 || len > OBJ_WCOMB_IO_MAX)
+		return false;
+
+	for (i = 0; i < args->nr; i++) {
+		daos_iod_t	*iod = &args->iods[i];
+
+		len = daos_iods_len(iod, 1);
+		if (len == 0 || iod->iod_name.iov_len == 0 ||
+		    iod->iod_csums != NULL || iod->iod_eprs != NULL ||
+		    iod->iod_nr > OBJ_WCOMB_RECX_MAX ||
+		    daos_sgl_data_len(&args->sgls[i]) < len)
+			return false;
+
+		/* the same akey twice in one update is left to the server */
+		for (j = 0; j < i; j++) {
+			if (daos_key_match(&iod->iod_name,
+					   &args->iods[j].iod_name))
+				return false;
+		}
+	}
+	return true;
+}
+
+static bool
+obj_wcomb_recx_overlap(daos_iod_t *iod1, daos_iod_t *iod2)
+{
+	int	i;
+	int	j;
+
+	for (i = 0; i < iod1->iod_nr; i++) {
+		daos_recx_t *r1 = &iod1->iod_recxs[i];
+
+		for (j = 0; j < iod2->iod_nr; j++) {
+			daos_recx_t *r2 = &iod2->iod_recxs[j];
+
+			if (r1->rx_idx < r2->rx_idx + r2->rx_nr &&
+			    r2->rx_idx < r1->rx_idx + r1->rx_nr)
+				return true;
+		}
+	}
+	return false;
+}
+
+/** Return the buffered iod of the akey, or NULL if there is none */
+static daos_iod_t *
+obj_wcomb_iod_find(struct obj_wcomb *wc, daos_iod_t *iod)
+{
+	int	i;
+
+	for (i = 0; i < wc->wc_nr; i++) {
+		if (daos_key_match(&wc->wc_iods[i].iod_name, &iod->iod_name))
+			return &wc->wc_iods[i];
+	}
+	return NULL;
+}
+
+/** Whether the update has to be flushed separately from the buffer */
+static bool
+obj_wcomb_conflict(struct obj_wcomb *wc, daos_obj_update_t *args)
+{
+	int	i;
+
+	if (!daos_key_match(&wc->wc_dkey, args->dkey))
+		return true;
+
+	for (i = 0; i < args->nr; i++) {
+		daos_iod_t	*iod = &args->iods[i];
+		daos_iod_t	*wiod = obj_wcomb_iod_find(wc, iod);
+
+		if (wiod == NULL)
+			continue;
+
+		if (iod->iod_type != DAOS_IOD_ARRAY ||
+		    wiod->iod_type != DAOS_IOD_ARRAY ||
+		    iod->iod_size != wiod->iod_size ||
+		    wiod->iod_nr + iod->iod_nr > OBJ_WCOMB_RECX_MAX ||
+		    obj_wcomb_recx_overlap(wiod, iod))
+			return true;
+	}
+	return false;
+}
+
+/** Copy the first \a len bytes described by \a sgl to \a buf */
+static void
+obj_wcomb_sgl_copy(d_sg_list_t *sgl, char *buf, daos_size_t len)
+{
+	daos_size_t	size;
+	int		i;
+
+	for (i = 0; i < sgl->sg_nr && len > 0; i++) {
+		size = min(sgl->sg_iovs[i].iov_len, len);
+		memcpy(buf, sgl->sg_iovs[i].iov_buf, size);
+		buf += size;
+		len -= size;
+	}
+}
+
+/**
+ * Copy the update into the buffer. All the memory is reserved before any
+ * change of the buffered iods, so a failure leaves the buffer intact.
+ */
+static int
+obj_wcomb_merge(struct obj_wcomb *wc, daos_obj_update_t *args)
+{
+	daos_iod_t	*iods;
+	d_sg_list_t	*sgls;
+	daos_iod_t	*wiod;
+	d_iov_t		*iov;
+	unsigned int	 nr = wc->wc_nr;
+	void		*buf;
+	daos_size_t	 len;
+	int		 i;
+	int		 rc = 0;
+
+	D_REALLOC(iods, wc->wc_iods, (nr + args->nr) * sizeof(*iods));
+	if (iods == NULL)
+		return -DER_NOMEM;
+	wc->wc_iods = iods;
+
+	D_REALLOC(sgls, wc->wc_sgls, (nr + args->nr) * sizeof(*sgls));
+	if (sgls == NULL)
+		return -DER_NOMEM;
+	wc->wc_sgls = sgls;
+
+	/* Reserve, new akeys take the slots after the buffered iods */
+	for (i = 0; i < args->nr; i++) {
+		daos_iod_t	*iod = &args->iods[i];
+
+		len = daos_iods_len(iod, 1);
+		wiod = obj_wcomb_iod_find(wc, iod);
+		if (wiod != NULL) {
+			iov = &wc->wc_sgls[wiod - wc->wc_iods].sg_iovs[0];
+			D_REALLOC(buf, wiod->iod_recxs, (wiod->iod_nr +
+				  iod->iod_nr) * sizeof(*wiod->iod_recxs));
+			if (buf == NULL)
+				D_GOTO(failed, rc = -DER_NOMEM);
+			wiod->iod_recxs = buf;
+
+			D_REALLOC(buf, iov->iov_buf, iov->iov_len + len);
+			if (buf == NULL)
+				D_GOTO(failed, rc = -DER_NOMEM);
+			iov->iov_buf = buf;
+			iov->iov_buf_len = iov->iov_len + len;
+			continue;
+		}
+
+		wiod = &wc->wc_iods[nr];
+		memset(wiod, 0, sizeof(*wiod));
+		rc = daos_sgl_init(&wc->wc_sgls[nr], 1);
+		nr++;
+		if (rc != 0)
+			goto failed;
+
+		D_ALLOC(buf, iod->iod_name.iov_len);
+		if (buf == NULL)
+			D_GOTO(failed, rc = -DER_NOMEM);
+		memcpy(buf, iod->iod_name.iov_buf, iod->iod_name.iov_len);
+		d_iov_set(&wiod->iod_name, buf, iod->iod_name.iov_len);
+
+		if (iod->iod_recxs != NULL) {
+			D_ALLOC_ARRAY(wiod->iod_recxs, iod->iod_nr);
+			if (wiod->iod_recxs == NULL)
+				D_GOTO(failed, rc = -DER_NOMEM);
+		}
+
+		D_ALLOC(buf, len);
+		if (buf == NULL)
+			D_GOTO(failed, rc = -DER_NOMEM);
+		d_iov_set(&wc->wc_sgls[nr - 1].sg_iovs[0], buf, 0);
+		wc->wc_sgls[nr - 1].sg_iovs[0].iov_buf_len = len;
+	}
+
+	/* Copy, cannot fail anymore */
+	nr = wc->wc_nr;
+	for (i = 0; i < args->nr; i++) {
+		daos_iod_t	*iod = &args->iods[i];
+
+		len = daos_iods_len(iod, 1);
+		wiod = obj_wcomb_iod_find(wc, iod);
+		if (wiod == NULL) {
+			wiod = &wc->wc_iods[nr++];
+			wiod->iod_type = iod->iod_type;
+			wiod->iod_size = iod->iod_size;
+			wc->wc_nr = nr;
+		}
+
+		if (iod->iod_recxs != NULL) {
+			memcpy(&wiod->iod_recxs[wiod->iod_nr], iod->iod_recxs,
+			       iod->iod_nr * sizeof(*iod->iod_recxs));
+			wiod->iod_nr += iod->iod_nr;
+		} else {
+			wiod->iod_nr = iod->iod_nr;
+		}
+
+		iov = &wc->wc_sgls[wiod - wc->wc_iods].sg_iovs[0];
+		obj_wcomb_sgl_copy(&args->sgls[i],
+				   (char *)iov->iov_buf + iov->iov_len, len);
+		iov->iov_len += len;
+		wc->wc_bytes += len;
+	}
+	return 0;
+
+failed:
+	/* the slots of the new akeys are not visible yet */
+	for (i = wc->wc_nr; i < nr; i++) {
+		daos_iov_free(&wc->wc_iods[i].iod_name);
+		D_FREE(wc->wc_iods[i].iod_recxs);
+		daos_sgl_fini(&wc->wc_sgls[i], true);
+	}
+	return rc;
+}
+
+/** Move the waiters satisfied by a completed flush out of cob_wcomb_waiters */
+struct obj_wcomb_wake_args {
+	uint64_t	seq;
+	d_list_t	waiters;
+};
+
+static int
+obj_wcomb_waiter_take(tse_task_t *waiter, void *data)
+{
+	struct obj_wcomb_wake_args	*args = data;
+
+	if ((uintptr_t)tse_task_get_priv(waiter) <= args->seq) {
+		tse_task_list_del(waiter);
+		tse_task_list_add(waiter, &args->waiters);
+	}
+	return 0;
+}
+
+static void obj_wcomb_flush_start(struct dc_object *obj);
+
+/** Retire the flush of \a wc, wake up its waiters and start the next one */
+static void
+obj_wcomb_flush_done(struct dc_object *obj, struct obj_wcomb *wc, int rc)
+{
+	struct obj_wcomb_wake_args	 wake;
+	tse_task_t			*waiter;
+	bool				 next;
+
+	if (rc != 0)
+		D_ERROR("flush "DF_OID" failed: %d\n",
+			DP_OID(obj->cob_md.omd_id), rc);
+
+	wake.seq = wc->wc_seq;
+	D_INIT_LIST_HEAD(&wake.waiters);
+
+	D_MUTEX_LOCK(&obj->cob_wcomb_lock);
+	if (rc != 0 && obj->cob_wcomb_rc == 0)
+		obj->cob_wcomb_rc = rc;
+	d_list_del(&wc->wc_link);
+	obj->cob_wcomb_done = wc->wc_seq;
+	tse_task_list_traverse(&obj->cob_wcomb_waiters, obj_wcomb_waiter_take,
+			       &wake);
+	next = !d_list_empty(&obj->cob_wcomb_flushes);
+	D_MUTEX_UNLOCK(&obj->cob_wcomb_lock);
+
+	while ((waiter = tse_task_list_first(&wake.waiters)) != NULL) {
+		tse_task_list_del(waiter);
+		tse_task_complete(waiter, rc);
+		tse_task_decref(waiter);
+	}
+
+	obj_wcomb_free(wc);
+	if (next)
+		obj_wcomb_flush_start(obj);
+}
+
+static int
+obj_wcomb_comp_cb(tse_task_t *task, void *data)
+{
+	struct obj_wcomb_cb_args	*cb_args = data;
+	struct dc_object		*obj = cb_args->obj;
+
+	obj_wcomb_flush_done(obj, cb_args->wc, task->dt_result);
+	obj_decref(obj);
+	return 0;
+}
+
+static int
+obj_wcomb_flush_task(tse_task_t *task)
+{
+	return obj_update_internal(task, false);
+}
+
+/**
+ * Send the first buffer of cob_wcomb_flushes. The task is executed
+ * instantly, so the flush does not rely on anyone progressing the scheduler
+ * it is created on, which may be the one of an event queue not polled
+ * anymore.
+ */
+static void
+obj_wcomb_flush_start(struct dc_object *obj)
+{
+	struct obj_wcomb_cb_args	 cb_args;
+	struct obj_wcomb		*wc;
+	daos_obj_update_t		*args;
+	tse_task_t			*task;
+	int				 rc;
+
+	D_MUTEX_LOCK(&obj->cob_wcomb_lock);
+	D_ASSERT(!d_list_empty(&obj->cob_wcomb_flushes));
+	wc = d_list_entry(obj->cob_wcomb_flushes.next, struct obj_wcomb,
+			  wc_link);
+	D_MUTEX_UNLOCK(&obj->cob_wcomb_lock);
+
+	rc = dc_task_create(obj_wcomb_flush_task, wc->wc_sched, NULL, &task);
+	if (rc != 0) {
+		obj_wcomb_flush_done(obj, wc, rc);
+		return;
+	}
+
+	args = dc_task_get_args(task);
+	args->oh	= obj_ptr2hdl(obj);
+	args->th	= DAOS_TX_NONE;
+	args->dkey	= &wc->wc_dkey;
+	args->nr	= wc->wc_nr;
+	args->iods	= wc->wc_iods;
+	args->sgls	= wc->wc_sgls;
+
+	cb_args.obj = obj;
+	cb_args.wc = wc;
+	obj_addref(obj);
+	tse_task_register_comp_cb(task, obj_wcomb_comp_cb, &cb_args,
+				  sizeof(cb_args));
+
+	D_DEBUG(DB_IO, "flush "DF_OID" %u iods, "DF_U64" bytes\n",
+		DP_OID(obj->cob_md.omd_id), wc->wc_nr, wc->wc_bytes);
+	tse_task_schedule(task, true);
+}
+
+/**
+ * Detach the buffer and queue it for flush.
+ *
+ * \return	true if the caller should start the flush by
+ *		obj_wcomb_flush_start() after releasing cob_wcomb_lock,
+ *		false if there is nothing to flush, or if the flush is
+ *		started on completion of the previous one.
+ */
+static bool
+obj_wcomb_detach_locked(struct dc_object *obj, tse_sched_t *sched)
+{
+	struct obj_wcomb	*wc = obj->cob_wcomb;
+	bool			 start;
+
+	if (wc == NULL)
+		return false;
+
+	obj->cob_wcomb = NULL;
+	wc->wc_seq = ++obj->cob_wcomb_seq;
+	wc->wc_sched = sched;
+	start = d_list_empty(&obj->cob_wcomb_flushes);
+	d_list_add_tail(&wc->wc_link, &obj->cob_wcomb_flushes);
+	return start;
+}
+
+/**
+ * Return a task of \a sched which completes after all the detached buffers
+ * have been flushed, or NULL if there is nothing to wait for. The task has
+ * no body function, it is completed by obj_wcomb_flush_done(), so the
+ * flushes can be waited for from the scheduler of any event queue. The
+ * caller should release the returned task.
+ */
+static int
+obj_wcomb_wait_locked(struct dc_object *obj, tse_sched_t *sched,
+		      tse_task_t **waiterp)
+{
+	tse_task_t	*waiter;
+	int		 rc;
+
+	*waiterp = NULL;
+	if (obj->cob_wcomb_done == obj->cob_wcomb_seq)
+		return 0;
+
+	rc = tse_task_create(NULL, sched, (void *)(uintptr_t)obj->cob_wcomb_seq,
+			     &waiter);
+	if (rc != 0)
+		return rc;
+
+	/* without body function, it is running until being completed */
+	tse_task_schedule(waiter, false);
+
+	/* one reference for cob_wcomb_waiters, one for the caller */
+	tse_task_addref(waiter);
+	tse_task_addref(waiter);
+	tse_task_list_add(waiter, &obj->cob_wcomb_waiters);
+	*waiterp = waiter;
+	return 0;
+}
+
+/**
+ * Buffer the update, the buffer is flushed in advance if the update cannot
+ * be combined with it or if it is stale, and is flushed afterward if it is
+ * full.
+ */
+static int
+obj_wcomb_add(struct dc_object *obj, tse_task_t *task, daos_obj_update_t *args)
+{
+	tse_sched_t		*sched = tse_task2sched(task);
+	struct obj_wcomb	*wc;
+	bool			 start = false;
+	int			 rc;
+
+	D_MUTEX_LOCK(&obj->cob_wcomb_lock);
+	wc = obj->cob_wcomb;
+	if (wc != NULL &&
+	    (obj_wcomb_conflict(wc, args) || daos_get_ntime() - wc->wc_start >=
+	     (uint64_t)obj_wcomb_usec * NSEC_PER_USEC)) {
+		start = obj_wcomb_detach_locked(obj, sched);
+		wc = NULL;
+	}
+
+	if (wc == NULL) {
+		rc = obj_wcomb_alloc(args->dkey, &wc);
+		if (rc != 0)
+			goto out;
+		obj->cob_wcomb = wc;
+	}
+
+	rc = obj_wcomb_merge(wc, args);
+	if (rc == 0 && wc->wc_bytes >= obj_wcomb_size)
+		start |= obj_wcomb_detach_locked(obj, sched);
+out:
+	D_MUTEX_UNLOCK(&obj->cob_wcomb_lock);
+
+	if (start)
+		obj_wcomb_flush_start(obj);
+	return rc;
+}
+
+/**
+ * Flush the buffer and make \a task wait for all the flushes of the object.
+ *
+ * \return	0	Nothing to wait for, the caller can go ahead
+ *		1	\a task has been reinitialized and will be executed
+ *			again after the flushes
+ *		-ve	Error code
+ */
+static int
+obj_wcomb_barrier(struct dc_object *obj, tse_task_t *task)
+{
+	tse_task_t	*waiter = NULL;
+	bool		 start;
+	int		 rc;
+
+	if (!(obj->cob_mode & DAOS_OO_IO_COMBINE))
+		return 0;
+
+	D_MUTEX_LOCK(&obj->cob_wcomb_lock);
+	start = obj_wcomb_detach_locked(obj, tse_task2sched(task));
+	rc = obj_wcomb_wait_locked(obj, tse_task2sched(task), &waiter);
+	D_MUTEX_UNLOCK(&obj->cob_wcomb_lock);
+
+	if (start)
+		obj_wcomb_flush_start(obj);
+	if (rc != 0 || waiter == NULL)
+		goto out;
+
+	rc = tse_task_reinit(task);
+	if (rc != 0)
+		goto out;
+
+	rc = tse_task_register_deps(task, 1, &waiter);
+	if (rc != 0)
+		D_ERROR("task %p failed to wait for flush: %d\n", task, rc);
+	/* it is executed again anyway, and will wait again if needed */
+	rc = 1;
+out:
+	if (waiter != NULL)
+		tse_task_decref(waiter);
+	return rc;
+}
+
+/** Return and clear the first flush error not reported yet */
+static int
+obj_wcomb_result(struct dc_object *obj)
+{
+	int	rc;
+
+	D_MUTEX_LOCK(&obj->cob_wcomb_lock);
+	rc = obj->cob_wcomb_rc;
+	obj->cob_wcomb_rc = 0;
+	D_MUTEX_UNLOCK(&obj->cob_wcomb_lock);
+	return rc;
+}
+
 static int
 obj_layout_create(struct dc_object *obj, bool refresh)
 {
@@ -761,6 +1353,10 @@ dc_obj_open(tse_task_t *task)
 	if (rc != 0)
 		D_GOTO(out, rc);
 
+	rc = D_MUTEX_INIT(&obj->cob_wcomb_lock, NULL);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
 	/* it is a local operation for now, does not require event */
 	rc = dc_obj_fetch_md(args->oid, &obj->cob_md);
 	if (rc != 0)
@@ -797,6 +1393,14 @@ dc_obj_close(tse_task_t *task)
 	if (obj == NULL)
 		D_GOTO(out, rc = -DER_NO_HDL);
 
+	rc = obj_wcomb_barrier(obj, task);
+	if (rc > 0) {
+		obj_decref(obj);
+		return 0;
+	}
+	if (rc == 0)
+		rc = obj_wcomb_result(obj);
+
 	obj_hdl_unlink(obj);
 	obj_decref(obj);
 
@@ -805,6 +1409,34 @@ out:
 	return 0;
 }
 
+int
+dc_obj_flush(tse_task_t *task)
+{
+	daos_obj_flush_t	*args;
+	struct dc_object	*obj;
+	int			 rc = 0;
+
+	args = dc_task_get_args(task);
+	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
+
+	obj = obj_hdl2ptr(args->oh);
+	if (obj == NULL)
+		D_GOTO(out, rc = -DER_NO_HDL);
+
+	rc = obj_wcomb_barrier(obj, task);
+	if (rc > 0) {
+		obj_decref(obj);
+		return 0;
+	}
+	if (rc == 0)
+		rc = obj_wcomb_result(obj);
+	obj_decref(obj);
+
+out:
+	tse_task_complete(task, rc);
+	return 0;
+}
+
 int
 dc_obj_fetch_md(daos_obj_id_t oid, struct daos_obj_md *md)
 {
@@ -1884,6 +2516,15 @@ dc_obj_fetch(tse_task_t *task)
 	obj = obj_hdl2ptr(args->oh);
 	if (obj == NULL)
 		D_GOTO(out_task, rc = -DER_NO_HDL);
+
+	rc = obj_wcomb_barrier(obj, task);
+	if (rc != 0) {
+		obj_decref(obj);
+		if (rc < 0)
+			D_GOTO(out_task, rc);
+		return 0;
+	}
+
 	rc = obj_ptr2pm_ver(obj, &map_ver);
 	if (rc) {
 		obj_decref(obj);
@@ -1950,8 +2591,8 @@ shard_update_prep(struct shard_auxi_args *shard_auxi, struct dc_object *obj,
 	return 0;
 }
 
-int
-dc_obj_update(tse_task_t *task)
+static int
+obj_update_internal(tse_task_t *task, bool combine)
 {
 	daos_obj_update_t	*args = dc_task_get_args(task);
 	struct obj_auxi_args	*obj_auxi;
@@ -1981,7 +2622,25 @@ dc_obj_update(tse_task_t *task)
 	}
 
 	oca = daos_oclass_attr_find(obj->cob_md.omd_id);
-	if (oca->ca_resil == DAOS_RES_EC) {
+	if (combine && (obj->cob_mode & DAOS_OO_IO_COMBINE)) {
+		if (obj_wcomb_eligible(oca, args)) {
+			rc = obj_wcomb_add(obj, task, args);
+			obj_decref(obj);
+			goto out_task;
+		}
+
+		rc = obj_wcomb_barrier(obj, task);
+		if (rc != 0) {
+			obj_decref(obj);
+			if (rc < 0)
+				goto out_task;
+			return 0;
+		}
+	}
+
+	/* The leader encodes the parity if the update is dispatched by it */
+	if (oca->ca_resil == DAOS_RES_EC &&
+	    !(obj_ec_srv_encode(oca) && srv_io_dispatch)) {
 		rc = ec_obj_update_encode(task, obj->cob_md.omd_id, oca,
 					  &tgt_set);
 		if (rc != 0) {
@@ -2031,6 +2690,12 @@ out_task:
 	return rc;
 }
 
+int
+dc_obj_update(tse_task_t *task)
+{
+	return obj_update_internal(task, true);
+}
+
 static int
 dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 		     daos_key_t *dkey, daos_key_t *akey,
@@ -2070,6 +2735,14 @@ dc_obj_list_internal(daos_handle_t oh, uint32_t op, daos_handle_t th,
 	if (obj == NULL)
 		D_GOTO(out_task, rc = -DER_NO_HDL);
 
+	rc = obj_wcomb_barrier(obj, task);
+	if (rc != 0) {
+		obj_decref(obj);
+		if (rc < 0)
+			D_GOTO(out_task, rc);
+		return 0;
+	}
+
 	list_args.obj = obj;
 	list_args.anchor = anchor;
 	list_args.dkey_anchor = dkey_anchor;
@@ -2261,6 +2934,15 @@ obj_punch_internal(tse_task_t *task, enum obj_rpc_opc opc,
 		rc = -DER_NO_HDL;
 		goto out_task;
 	}
+
+	rc = obj_wcomb_barrier(obj, task);
+	if (rc != 0) {
+		obj_decref(obj);
+		if (rc < 0)
+			goto out_task;
+		return 0;
+	}
+
 	rc = obj_ptr2pm_ver(obj, &map_ver);
 	if (rc) {
 		obj_decref(obj);
@@ -2501,6 +3183,14 @@ dc_obj_query_key(tse_task_t *api_task)
 	if (obj == NULL)
 		D_GOTO(out_task, rc = -DER_NO_HDL);
 
+	rc = obj_wcomb_barrier(obj, api_task);
+	if (rc != 0) {
+		obj_decref(obj);
+		if (rc < 0)
+			D_GOTO(out_task, rc);
+		return 0;
+	}
+
 	rc = check_query_flags(obj->cob_md.omd_id, api_args->flags,
 			       api_args->dkey, api_args->akey, api_args->recx);
 	if (rc)
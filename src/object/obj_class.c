@@ -32,6 +32,11 @@ struct daos_obj_class {
 	/** unique class ID */
 	daos_oclass_id_t		 oc_id;
 	struct daos_oclass_attr		 oc_attr;
+	/**
+	 * EC only, the client sends the data cells to the leader shard, which
+	 * encodes and forwards the parity.
+	 */
+	bool				 oc_srv_encode;
 };
 
 /** predefined object classes */
@@ -277,6 +282,36 @@ static struct daos_obj_class daos_obj_classes[] = {
 			},
 		},
 	},
+	{
+		.oc_name	= "ec_k2p1_srv_len32k",
+		.oc_id		= DAOS_OC_EC_K2P1_SRV_L32K,
+		{
+			.ca_schema		= DAOS_OS_SINGLE,
+			.ca_resil		= DAOS_RES_EC,
+			.ca_grp_nr		= 1,
+			.u.ec			= {
+				.e_k		= 2,
+				.e_p		= 1,
+				.e_len		= 1 << 15,
+			},
+		},
+		.oc_srv_encode	= true,
+	},
+	{
+		.oc_name	= "ec_k8p2_srv_len1m",
+		.oc_id		= DAOS_OC_EC_K8P2_SRV_L1M,
+		{
+			.ca_schema		= DAOS_OS_SINGLE,
+			.ca_resil		= DAOS_RES_EC,
+			.ca_grp_nr		= 1,
+			.u.ec			= {
+				.e_k		= 8,
+				.e_p		= 2,
+				.e_len		= 1 << 20,
+			},
+		},
+		.oc_srv_encode	= true,
+	},
 	{
 		.oc_name	= NULL,
 		.oc_id		= DAOS_OC_UNKNOWN,
@@ -308,6 +343,16 @@ daos_oclass_attr_find(daos_obj_id_t oid)
 	return &oc->oc_attr;
 }
 
+/** Check if the parity of the EC class \a oca is encoded by the server */
+bool
+obj_ec_srv_encode(struct daos_oclass_attr *oca)
+{
+	struct daos_obj_class	*oc;
+
+	oc = container_of(oca, struct daos_obj_class, oc_attr);
+	return oca->ca_resil == DAOS_RES_EC && oc->oc_srv_encode;
+}
+
 int
 daos_oclass_name2id(const char *name)
 {
@@ -402,7 +447,7 @@ obj_ec_codec_fini(void)
 		  oc_ec_codec_nr, ocnr);
 
 	for (i = 0; i < ocnr; i++) {
-		ec_codec = &oc_ec_codecs[i++].ec_codec;
+		ec_codec = &oc_ec_codecs[i].ec_codec;
 		if (ec_codec->ec_en_matrix != NULL)
 			D_FREE(ec_codec->ec_en_matrix);
 		if (ec_codec->ec_gftbls != NULL)
@@ -571,3 +616,150 @@ out:
 		D_FREE(ldata[i]);
 	return rc;
 }
+
+/* Moves the SGL "cursors" forward by size bytes */
+static void
+ec_sgl_cursors_move(d_sg_list_t *sgl, daos_size_t size, uint32_t *sg_idx,
+		    size_t *sg_off)
+{
+	while (*sg_idx < sgl->sg_nr) {
+		daos_size_t left = sgl->sg_iovs[*sg_idx].iov_len - *sg_off;
+
+		if (size < left) {
+			*sg_off += size;
+			return;
+		}
+		size -= left;
+		*sg_off = 0;
+		(*sg_idx)++;
+	}
+}
+
+/* Allocates a stripe's worth of parity cells. */
+static int
+ec_parity_alloc(struct obj_ec_parity *par, unsigned int len, unsigned int p)
+{
+	unsigned char	**nbuf;
+	unsigned int	  i;
+
+	D_REALLOC_ARRAY(nbuf, par->p_bufs, par->p_nr + p);
+	if (nbuf == NULL)
+		return -DER_NOMEM;
+	par->p_bufs = nbuf;
+
+	for (i = 0; i < p; i++) {
+		D_ALLOC(par->p_bufs[par->p_nr], len);
+		if (par->p_bufs[par->p_nr] == NULL)
+			return -DER_NOMEM;
+		par->p_nr++;
+	}
+	return 0;
+}
+
+/**
+ * Encode all of the full stripes contained within the recxs of an IOD.
+ *
+ * oid		[IN]		The object id of the object undergoing encode.
+ * iod		[IN]		The IOD of the update.
+ * sgl		[IN]		The SGL containing the user data of \a iod.
+ * eiod		[OUT]		The IOD and SGL with the parity prepended, it
+ *				should be released by obj_ec_iod_fini(). Single
+ *				values are not encoded for now.
+ */
+int
+obj_ec_encode_iod(daos_obj_id_t oid, daos_iod_t *iod, d_sg_list_t *sgl,
+		  struct obj_ec_iod *eiod)
+{
+	struct daos_oclass_attr	*oca = daos_oclass_attr_find(oid);
+	unsigned int		 len = oca->u.ec.e_len;
+	unsigned int		 p = oca->u.ec.e_p;
+	uint64_t		 ss = (uint64_t)len * oca->u.ec.e_k;
+	daos_iod_t		*niod = &eiod->ei_iod;
+	d_sg_list_t		*nsgl = &eiod->ei_sgl;
+	daos_size_t		 data_off = 0;
+	daos_recx_t		*nrecx;
+	unsigned int		 i, j;
+	int			 rc = 0;
+
+	memset(eiod, 0, sizeof(*eiod));
+	*niod = *iod;
+	niod->iod_nr = 0;
+	niod->iod_recxs = NULL;
+
+	for (i = 0; iod->iod_type == DAOS_IOD_ARRAY && iod->iod_size != 0 &&
+		    i < iod->iod_nr; i++) {
+		daos_recx_t	*recx = &iod->iod_recxs[i];
+		uint64_t	 start = recx->rx_idx * iod->iod_size;
+		uint64_t	 end = start + recx->rx_nr * iod->iod_size;
+		/* s_cur is the offset (in bytes) where a full stripe begins */
+		uint64_t	 s_cur = (start + ss - 1) / ss * ss;
+		uint32_t	 sg_idx = 0;
+		size_t		 sg_off = 0;
+
+		if (s_cur + ss <= end)
+			ec_sgl_cursors_move(sgl, data_off + s_cur - start,
+					    &sg_idx, &sg_off);
+
+		for (; s_cur + ss <= end; s_cur += ss) {
+			rc = ec_parity_alloc(&eiod->ei_parity, len, p);
+			if (rc != 0)
+				goto out;
+			rc = obj_encode_full_stripe(oid, sgl, &sg_idx, &sg_off,
+						    &eiod->ei_parity,
+						    eiod->ei_parity.p_nr - p);
+			if (rc != 0)
+				goto out;
+			/* Parity is prepended to the recx array, so we have
+			 * to add them here for each encoded stripe.
+			 */
+			D_REALLOC_ARRAY(nrecx, niod->iod_recxs,
+					niod->iod_nr + p);
+			if (nrecx == NULL)
+				D_GOTO(out, rc = -DER_NOMEM);
+			niod->iod_recxs = nrecx;
+			for (j = 0; j < p; j++) {
+				nrecx[niod->iod_nr].rx_idx = PARITY_INDICATOR |
+					(s_cur + j * len) / iod->iod_size;
+				nrecx[niod->iod_nr++].rx_nr =
+					len / iod->iod_size;
+			}
+		}
+		data_off += end - start;
+	}
+
+	/* Append the input recxs and iovs after the parity */
+	D_REALLOC_ARRAY(nrecx, niod->iod_recxs, niod->iod_nr + iod->iod_nr);
+	if (nrecx == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	niod->iod_recxs = nrecx;
+	for (i = 0; i < iod->iod_nr; i++)
+		nrecx[niod->iod_nr++] = iod->iod_recxs[i];
+
+	D_ALLOC_ARRAY(nsgl->sg_iovs, eiod->ei_parity.p_nr + sgl->sg_nr);
+	if (nsgl->sg_iovs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	for (i = 0; i < eiod->ei_parity.p_nr; i++)
+		d_iov_set(&nsgl->sg_iovs[nsgl->sg_nr++],
+			  eiod->ei_parity.p_bufs[i], len);
+	for (i = 0; i < sgl->sg_nr; i++)
+		nsgl->sg_iovs[nsgl->sg_nr++] = sgl->sg_iovs[i];
+	nsgl->sg_nr_out = nsgl->sg_nr;
+out:
+	if (rc != 0)
+		obj_ec_iod_fini(eiod);
+	return rc;
+}
+
+/* Recover memory allocated by obj_ec_encode_iod() */
+void
+obj_ec_iod_fini(struct obj_ec_iod *eiod)
+{
+	unsigned int i;
+
+	D_FREE(eiod->ei_iod.iod_recxs);
+	D_FREE(eiod->ei_sgl.sg_iovs);
+	for (i = 0; i < eiod->ei_parity.p_nr; i++)
+		D_FREE(eiod->ei_parity.p_bufs[i]);
+	D_FREE(eiod->ei_parity.p_bufs);
+	eiod->ei_parity.p_nr = 0;
+}
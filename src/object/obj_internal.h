@@ -63,6 +63,13 @@ extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern bool	srv_io_dispatch;
 extern bool	srv_enable_dtx;
+/**
+ * Buffered updates of an object opened with DAOS_OO_IO_COMBINE are flushed
+ * once they reach this many bytes, or once the oldest one is older than
+ * obj_wcomb_usec.
+ */
+extern unsigned int	obj_wcomb_size;
+extern unsigned int	obj_wcomb_usec;
 
 /** client object shard */
 struct dc_obj_shard {
@@ -117,6 +124,20 @@ struct dc_object {
 	unsigned int		cob_shards_nr;
 	/** shard object ptrs */
 	struct dc_obj_layout	*cob_shards;
+
+	/** cob_wcomb_lock protects the write-combining states below */
+	pthread_mutex_t		 cob_wcomb_lock;
+	/** updates buffered for DAOS_OO_IO_COMBINE */
+	struct obj_wcomb	*cob_wcomb;
+	/** detached buffers, the first one is being flushed */
+	d_list_t		 cob_wcomb_flushes;
+	/** tasks waiting for flushes, see obj_wcomb_wait_locked() */
+	d_list_t		 cob_wcomb_waiters;
+	/** sequence numbers of the last detached and flushed buffers */
+	uint64_t		 cob_wcomb_seq;
+	uint64_t		 cob_wcomb_done;
+	/** the first flush error which has not been reported yet */
+	int			 cob_wcomb_rc;
 };
 
 /** EC codec for object EC encoding/decoding */
@@ -147,9 +168,37 @@ enum obj_profile_op {
 	OBJ_PF_UPDATE,
 };
 
+/* Metrics of object RPCs, registered on module initialization */
+enum obj_metric {
+	OBJ_MT_UPDATE_CNT,
+	OBJ_MT_UPDATE_ERR,
+	OBJ_MT_UPDATE_BYTES,
+	OBJ_MT_UPDATE_LAT,
+	OBJ_MT_FETCH_CNT,
+	OBJ_MT_FETCH_ERR,
+	OBJ_MT_FETCH_BYTES,
+	OBJ_MT_FETCH_LAT,
+	OBJ_MT_NR,
+};
+
+extern int obj_metrics[OBJ_MT_NR];
+
 struct obj_tls {
 	d_sg_list_t		ot_echo_sgl;
 	struct srv_profile	*ot_sp;
+	/** cached buffers for the arrays of fetch replies */
+	d_list_t		ot_reply_bufs;
+	unsigned int		ot_reply_buf_nr;
+};
+
+/** Reply arrays up to this size are taken from obj_tls::ot_reply_bufs */
+#define OBJ_REPLY_BUF_SIZE	(64 * sizeof(uint64_t))
+/** The maximum number of cached reply buffers per xstream */
+#define OBJ_REPLY_BUF_MAX	64
+
+struct obj_reply_buf {
+	d_list_t		rb_link;
+	uint64_t		rb_data[OBJ_REPLY_BUF_SIZE / sizeof(uint64_t)];
 };
 
 struct obj_ec_parity {
@@ -157,6 +206,16 @@ struct obj_ec_parity {
 	unsigned int	  p_nr;
 };
 
+/** An IOD--SGL pair with the parity of its full stripes */
+struct obj_ec_iod {
+	/** the parity recxs, followed by the input recxs */
+	daos_iod_t		ei_iod;
+	/** the parity cells, followed by the input iovs */
+	d_sg_list_t		ei_sgl;
+	/** parity cells of all encoded stripes */
+	struct obj_ec_parity	ei_parity;
+};
+
 static inline struct obj_tls *
 obj_tls_get()
 {
@@ -255,13 +314,45 @@ void obj_addref(struct dc_object *obj);
 void obj_decref(struct dc_object *obj);
 int obj_get_grp_size(struct dc_object *obj);
 
+/** Parity encoded by the leader for an update of an EC object */
+struct ds_obj_ec_enc {
+	/** encoded IOD and SGL of each IOD of the update */
+	struct obj_ec_iod	*ee_eiods;
+	/** data pulled from the client, NULL if it was sent inline */
+	d_sg_list_t		*ee_data;
+	/** IODs and SGLs replacing the ones of the update */
+	daos_iod_t		*ee_iods;
+	d_sg_list_t		*ee_sgls;
+	/** bulk handles of ee_sgls, for the forwarded updates */
+	crt_bulk_t		*ee_bulks;
+	/** original IODs, SGLs and bulks of the update */
+	daos_iod_t		*ee_orig_iods;
+	d_sg_list_t		*ee_orig_sgls;
+	crt_bulk_t		*ee_orig_bulks;
+	uint64_t		 ee_orig_sgl_nr;
+	uint64_t		 ee_orig_bulk_nr;
+	/** number of IODs, 0 if not encoded */
+	unsigned int		 ee_nr;
+	unsigned int		 ee_swapped:1;
+};
+
 struct ds_obj_exec_arg {
 	crt_rpc_t		*rpc;
 	struct ds_cont_hdl	*cont_hdl;
 	struct ds_cont_child	*cont;
 	uint32_t		flags;
+	/** parity encoded by the leader, NULL if not an EC update */
+	struct ds_obj_ec_enc	*ec_enc;
 };
 
+int ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
+		     crt_bulk_t *remote_bulks, daos_handle_t ioh,
+		     d_sg_list_t **sgls, int sgl_nr);
+
+/* srv_ec.c */
+int ds_obj_ec_encode(crt_rpc_t *rpc, struct ds_obj_ec_enc *enc);
+void ds_obj_ec_encode_fini(crt_rpc_t *rpc, struct ds_obj_ec_enc *enc);
+
 int
 ds_obj_remote_update(struct dtx_handle *dth, void *arg, int idx,
 		     dtx_exec_shard_comp_cb_t comp_cb, void *cb_arg);
@@ -293,9 +384,13 @@ obj_dkey2hash(daos_key_t *dkey)
 /* obj_class.c */
 int obj_ec_codec_init(void);
 void obj_ec_codec_fini(void);
+bool obj_ec_srv_encode(struct daos_oclass_attr *oca);
 struct obj_ec_codec *obj_ec_codec_get(daos_oclass_id_t oc_id);
 int obj_encode_full_stripe(daos_obj_id_t oid, d_sg_list_t *sgl,
 			   uint32_t *sg_idx, size_t *sg_off,
 			   struct obj_ec_parity *parity, int p_idx);
+int obj_ec_encode_iod(daos_obj_id_t oid, daos_iod_t *iod, d_sg_list_t *sgl,
+		      struct obj_ec_iod *eiod);
+void obj_ec_iod_fini(struct obj_ec_iod *eiod);
 
 #endif /* __DAOS_OBJ_INTENRAL_H__ */
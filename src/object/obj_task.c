@@ -73,6 +73,24 @@ dc_obj_close_task_create(daos_handle_t oh, daos_event_t *ev,
 	return 0;
 }
 
+int
+dc_obj_flush_task_create(daos_handle_t oh, daos_event_t *ev,
+			 tse_sched_t *tse, tse_task_t **task)
+{
+	daos_obj_flush_t *args;
+	int		 rc;
+
+	DAOS_API_ARG_ASSERT(*args, OBJ_FLUSH);
+	rc = dc_task_create(dc_obj_flush, tse, ev, task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(*task);
+	args->oh = oh;
+
+	return 0;
+}
+
 int
 dc_obj_punch_task_create(daos_handle_t oh, daos_handle_t th,
 			 daos_event_t *ev, tse_sched_t *tse,
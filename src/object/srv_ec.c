@@ -0,0 +1,220 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * Erasure code encoding of object updates on the leader server, for object
+ * classes which do not encode on the client side, see obj_ec_srv_encode().
+ *
+ * src/object/srv_ec.c
+ */
+#define D_LOGFAC	DD_FAC(object)
+
+#include <daos/rpc.h>
+#include <daos_srv/daos_server.h>
+#include "obj_rpc.h"
+#include "obj_internal.h"
+
+/* Checks if the leader should encode the parity of this update */
+static bool
+ds_obj_ec_need_encode(struct obj_rw_in *orw)
+{
+	struct daos_oclass_attr	*oca;
+	daos_iod_t		*iods = orw->orw_iods.ca_arrays;
+	unsigned int		 i, j;
+
+	oca = daos_oclass_attr_find(orw->orw_oid.id_pub);
+	if (oca == NULL || !obj_ec_srv_encode(oca))
+		return false;
+
+	/* Already encoded by the client */
+	for (i = 0; i < orw->orw_nr; i++) {
+		if (iods[i].iod_type != DAOS_IOD_ARRAY)
+			continue;
+		for (j = 0; j < iods[i].iod_nr; j++) {
+			if (iods[i].iod_recxs[j].rx_idx & PARITY_INDICATOR)
+				return false;
+		}
+	}
+	return true;
+}
+
+/* Pulls the data of the update from the client into DRAM */
+static int
+ds_obj_ec_data_pull(crt_rpc_t *rpc, struct ds_obj_ec_enc *enc)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	daos_iod_t		*iods = orw->orw_iods.ca_arrays;
+	d_sg_list_t		**sgls;
+	unsigned int		 i;
+	int			 rc;
+
+	D_ALLOC_ARRAY(enc->ee_data, enc->ee_nr);
+	D_ALLOC_ARRAY(sgls, enc->ee_nr);
+	if (enc->ee_data == NULL || sgls == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0; i < enc->ee_nr; i++) {
+		daos_size_t	 size = daos_iods_len(&iods[i], 1);
+		void		*buf;
+
+		sgls[i] = &enc->ee_data[i];
+		if (size == 0 || size == (daos_size_t)-1)
+			continue;
+
+		rc = daos_sgl_init(&enc->ee_data[i], 1);
+		if (rc != 0)
+			goto out;
+		D_ALLOC(buf, size);
+		if (buf == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		d_iov_set(&enc->ee_data[i].sg_iovs[0], buf, size);
+		enc->ee_data[i].sg_nr_out = 1;
+	}
+
+	rc = ds_bulk_transfer(rpc, CRT_BULK_GET, orw->orw_flags & ORF_BULK_BIND,
+			      orw->orw_bulks.ca_arrays, DAOS_HDL_INVAL, sgls,
+			      enc->ee_nr);
+out:
+	D_FREE(sgls);
+	return rc;
+}
+
+/**
+ * Encode the full stripes of an EC object update on the leader, then
+ * replace the IODs and SGLs of \a rpc by the encoded ones, so that both the
+ * local update and the updates forwarded to the other shards carry the
+ * parity. The forwarded updates pull the data and the parity from the
+ * leader by the bulk handles in \a enc.
+ *
+ * \param[in]	rpc	update RPC received by the leader
+ * \param[out]	enc	encoding state, released by ds_obj_ec_encode_fini()
+ *
+ * \return		0 if encoded or no need to encode (enc->ee_nr is 0),
+ *			negative error code otherwise.
+ */
+int
+ds_obj_ec_encode(crt_rpc_t *rpc, struct ds_obj_ec_enc *enc)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	daos_iod_t		*iods = orw->orw_iods.ca_arrays;
+	d_sg_list_t		*sgls = orw->orw_sgls.ca_arrays;
+	unsigned int		 i;
+	int			 rc;
+
+	memset(enc, 0, sizeof(*enc));
+	if (!ds_obj_ec_need_encode(orw))
+		return 0;
+
+	enc->ee_nr = orw->orw_nr;
+	D_ALLOC_ARRAY(enc->ee_eiods, enc->ee_nr);
+	D_ALLOC_ARRAY(enc->ee_iods, enc->ee_nr);
+	D_ALLOC_ARRAY(enc->ee_sgls, enc->ee_nr);
+	D_ALLOC_ARRAY(enc->ee_bulks, enc->ee_nr);
+	if (enc->ee_eiods == NULL || enc->ee_iods == NULL ||
+	    enc->ee_sgls == NULL || enc->ee_bulks == NULL)
+		D_GOTO(failed, rc = -DER_NOMEM);
+
+	if (orw->orw_bulks.ca_arrays != NULL) {
+		rc = ds_obj_ec_data_pull(rpc, enc);
+		if (rc != 0) {
+			D_ERROR(DF_UOID" failed to pull data: %d\n",
+				DP_UOID(orw->orw_oid), rc);
+			goto failed;
+		}
+		sgls = enc->ee_data;
+	}
+
+	for (i = 0; i < enc->ee_nr; i++) {
+		rc = obj_ec_encode_iod(orw->orw_oid.id_pub, &iods[i], &sgls[i],
+				       &enc->ee_eiods[i]);
+		if (rc != 0)
+			goto failed;
+
+		enc->ee_iods[i] = enc->ee_eiods[i].ei_iod;
+		enc->ee_sgls[i] = enc->ee_eiods[i].ei_sgl;
+		if (enc->ee_sgls[i].sg_nr == 0)
+			continue;
+
+		rc = crt_bulk_create(rpc->cr_ctx, &enc->ee_sgls[i],
+				     CRT_BULK_RO, &enc->ee_bulks[i]);
+		if (rc != 0)
+			goto failed;
+		rc = crt_bulk_bind(enc->ee_bulks[i], rpc->cr_ctx);
+		if (rc != 0)
+			goto failed;
+	}
+
+	D_DEBUG(DB_IO, DF_UOID" encoded %u iods on leader\n",
+		DP_UOID(orw->orw_oid), enc->ee_nr);
+
+	/* The local update copies from the encoded SGLs */
+	enc->ee_orig_iods = orw->orw_iods.ca_arrays;
+	enc->ee_orig_sgls = orw->orw_sgls.ca_arrays;
+	enc->ee_orig_sgl_nr = orw->orw_sgls.ca_count;
+	enc->ee_orig_bulks = orw->orw_bulks.ca_arrays;
+	enc->ee_orig_bulk_nr = orw->orw_bulks.ca_count;
+	orw->orw_iods.ca_arrays = enc->ee_iods;
+	orw->orw_sgls.ca_arrays = enc->ee_sgls;
+	orw->orw_sgls.ca_count = enc->ee_nr;
+	orw->orw_bulks.ca_arrays = NULL;
+	orw->orw_bulks.ca_count = 0;
+	enc->ee_swapped = 1;
+	return 0;
+
+failed:
+	ds_obj_ec_encode_fini(rpc, enc);
+	return rc;
+}
+
+/* Restores the request and recovers memory of ds_obj_ec_encode() */
+void
+ds_obj_ec_encode_fini(crt_rpc_t *rpc, struct ds_obj_ec_enc *enc)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	unsigned int		 i;
+
+	if (enc->ee_nr == 0)
+		return;
+
+	if (enc->ee_swapped) {
+		orw->orw_iods.ca_arrays = enc->ee_orig_iods;
+		orw->orw_sgls.ca_arrays = enc->ee_orig_sgls;
+		orw->orw_sgls.ca_count = enc->ee_orig_sgl_nr;
+		orw->orw_bulks.ca_arrays = enc->ee_orig_bulks;
+		orw->orw_bulks.ca_count = enc->ee_orig_bulk_nr;
+	}
+
+	for (i = 0; i < enc->ee_nr; i++) {
+		if (enc->ee_bulks != NULL && enc->ee_bulks[i] != NULL)
+			crt_bulk_free(enc->ee_bulks[i]);
+		if (enc->ee_eiods != NULL)
+			obj_ec_iod_fini(&enc->ee_eiods[i]);
+		if (enc->ee_data != NULL)
+			daos_sgl_fini(&enc->ee_data[i], true);
+	}
+	D_FREE(enc->ee_bulks);
+	D_FREE(enc->ee_sgls);
+	D_FREE(enc->ee_iods);
+	D_FREE(enc->ee_eiods);
+	D_FREE(enc->ee_data);
+	memset(enc, 0, sizeof(*enc));
+}
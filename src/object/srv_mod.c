@@ -37,10 +37,66 @@
  */
 bool srv_enable_dtx = true;
 
+static int
+obj_bulk_create(void *ctxt, d_sg_list_t *sgl, void **bulk_hdl)
+{
+	return crt_bulk_create(ctxt, sgl, CRT_BULK_RW, bulk_hdl);
+}
+
+static int
+obj_bulk_free(void *bulk_hdl)
+{
+	return crt_bulk_free(bulk_hdl);
+}
+
+int obj_metrics[OBJ_MT_NR];
+
+static struct {
+	char			*name;
+	enum dss_metric_type	 type;
+} obj_metric_defs[OBJ_MT_NR] = {
+	[OBJ_MT_UPDATE_CNT]	= { "obj_update_count",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_UPDATE_ERR]	= { "obj_update_errors",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_UPDATE_BYTES]	= { "obj_update_bytes",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_UPDATE_LAT]	= { "obj_update_lat_ns",
+				    DSS_METRIC_HISTOGRAM },
+	[OBJ_MT_FETCH_CNT]	= { "obj_fetch_count",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_FETCH_ERR]	= { "obj_fetch_errors",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_FETCH_BYTES]	= { "obj_fetch_bytes",
+				    DSS_METRIC_COUNTER },
+	[OBJ_MT_FETCH_LAT]	= { "obj_fetch_lat_ns",
+				    DSS_METRIC_HISTOGRAM },
+};
+
+static int
+obj_metrics_register(void)
+{
+	int	i, rc;
+
+	for (i = 0; i < OBJ_MT_NR; i++) {
+		rc = dss_metric_register(obj_metric_defs[i].name,
+					 obj_metric_defs[i].type,
+					 &obj_metrics[i]);
+		if (rc != 0) {
+			D_ERROR("failed to register metric %s: %d\n",
+				obj_metric_defs[i].name, rc);
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
 static int
 obj_mod_init(void)
 {
 	uint32_t	mode = DIM_DTX_FULL_ENABLED;
+	uint32_t	bulk_cache = 1;
 	int		rc;
 
 	d_getenv_int("DAOS_IO_MODE", &mode);
@@ -51,6 +107,19 @@ obj_mod_init(void)
 		D_DEBUG(DB_IO, "DTX is enabled.\n");
 	}
 
+	/**
+	 * Register DMA buffer of NVMe I/O for bulk transfer, so that data is
+	 * transferred from/to DMA buffer directly without memory registration
+	 * for each I/O.
+	 */
+	d_getenv_int("DAOS_IO_BULK_CACHE", &bulk_cache);
+	if (bulk_cache != 0)
+		bio_register_bulk_ops(obj_bulk_create, obj_bulk_free);
+
+	rc = obj_metrics_register();
+	if (rc != 0)
+		return rc;
+
 	rc = obj_ec_codec_init();
 	if (rc != 0)
 		D_ERROR("failed to obj_ec_codec_init: %d\n", rc);
@@ -88,6 +157,8 @@ obj_tls_init(const struct dss_thread_local_storage *dtls,
 	struct obj_tls *tls;
 
 	D_ALLOC_PTR(tls);
+	if (tls != NULL)
+		D_INIT_LIST_HEAD(&tls->ot_reply_bufs);
 	return tls;
 }
 
@@ -95,7 +166,13 @@ static void
 obj_tls_fini(const struct dss_thread_local_storage *dtls,
 	     struct dss_module_key *key, void *data)
 {
-	struct obj_tls *tls = data;
+	struct obj_tls		*tls = data;
+	struct obj_reply_buf	*rb;
+
+	while ((rb = d_list_pop_entry(&tls->ot_reply_bufs,
+				      struct obj_reply_buf,
+				      rb_link)) != NULL)
+		D_FREE(rb);
 
 	if (tls->ot_echo_sgl.sg_iovs != NULL)
 		daos_sgl_fini(&tls->ot_echo_sgl, true);
@@ -32,6 +32,7 @@
 
 #include <abt.h>
 #include <daos/rpc.h>
+#include <daos/checksum.h>
 #include <daos_srv/pool.h>
 #include <daos_srv/rebuild.h>
 #include <daos_srv/container.h>
@@ -51,6 +52,7 @@ ds_obj_rw_complete(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 {
 	struct obj_tls		*tls = obj_tls_get();
 	struct obj_rw_in	*orwi = crt_req_get(rpc);
+	uint64_t		 ts;
 	int			 rc;
 
 	D_TIME_START(tls->ot_sp, OBJ_PF_UPDATE_END);
@@ -60,9 +62,12 @@ ds_obj_rw_complete(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 		bool update = (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_UPDATE ||
 			       opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_TGT_UPDATE);
 
+		DSS_TRACE_BEGIN(ts);
 		rc = update ? vos_update_end(ioh, map_version, &orwi->orw_dkey,
 					     status, dth) :
 			      vos_fetch_end(ioh, status);
+		DSS_TRACE_END(update ? DSS_TR_OBJ_UPDATE_END :
+			      DSS_TR_OBJ_FETCH_END, ts);
 
 		if (rc != 0) {
 			D_ERROR(DF_UOID "%s end failed: %d\n",
@@ -91,6 +96,53 @@ ds_obj_rw_complete(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	return status;
 }
 
+/**
+ * Allocate an array for the fetch reply, small arrays are taken from the
+ * per-xstream cache to save an allocation for each small fetch.
+ */
+static void *
+obj_reply_buf_get(daos_size_t size)
+{
+	struct obj_tls		*tls = obj_tls_get();
+	struct obj_reply_buf	*rb;
+	void			*buf;
+
+	if (size > OBJ_REPLY_BUF_SIZE) {
+		D_ALLOC(buf, size);
+		return buf;
+	}
+
+	rb = d_list_pop_entry(&tls->ot_reply_bufs, struct obj_reply_buf,
+			      rb_link);
+	if (rb != NULL) {
+		tls->ot_reply_buf_nr--;
+		return rb->rb_data;
+	}
+
+	D_ALLOC_PTR(rb);
+	return rb != NULL ? rb->rb_data : NULL;
+}
+
+static void
+obj_reply_buf_put(void *buf, daos_size_t size)
+{
+	struct obj_tls		*tls = obj_tls_get();
+	struct obj_reply_buf	*rb;
+
+	if (size > OBJ_REPLY_BUF_SIZE) {
+		D_FREE(buf);
+		return;
+	}
+
+	rb = container_of(buf, struct obj_reply_buf, rb_data);
+	if (tls->ot_reply_buf_nr >= OBJ_REPLY_BUF_MAX) {
+		D_FREE(rb);
+		return;
+	}
+	d_list_add(&rb->rb_link, &tls->ot_reply_bufs);
+	tls->ot_reply_buf_nr++;
+}
+
 static void
 ds_obj_rw_reply(crt_rpc_t *rpc, int status, uint32_t map_version,
 		struct dtx_conflict_entry *dce)
@@ -116,13 +168,20 @@ ds_obj_rw_reply(crt_rpc_t *rpc, int status, uint32_t map_version,
 	if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_FETCH) {
 		struct obj_rw_out	*orwo = crt_reply_get(rpc);
 
+		/* the reply has been packed by crt_reply_send() */
 		if (orwo->orw_sizes.ca_arrays != NULL) {
-			D_FREE(orwo->orw_sizes.ca_arrays);
+			obj_reply_buf_put(orwo->orw_sizes.ca_arrays,
+					  orwo->orw_sizes.ca_count *
+					  sizeof(uint64_t));
+			orwo->orw_sizes.ca_arrays = NULL;
 			orwo->orw_sizes.ca_count = 0;
 		}
 
 		if (orwo->orw_nrs.ca_arrays != NULL) {
-			D_FREE(orwo->orw_nrs.ca_arrays);
+			obj_reply_buf_put(orwo->orw_nrs.ca_arrays,
+					  orwo->orw_nrs.ca_count *
+					  sizeof(uint32_t));
+			orwo->orw_nrs.ca_arrays = NULL;
 			orwo->orw_nrs.ca_count = 0;
 		}
 	}
@@ -137,7 +196,7 @@ struct ds_bulk_async_args {
 };
 
 static int
-bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
+bulk_complete(const struct crt_bulk_cb_info *cb_info, bool cached)
 {
 	struct ds_bulk_async_args	*arg;
 	struct crt_bulk_desc		*bulk_desc;
@@ -164,11 +223,41 @@ bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
 		ABT_eventual_set(arg->eventual, &arg->result,
 				 sizeof(arg->result));
 
-	crt_bulk_free(local_bulk_hdl);
+	/* Bulk handle of DMA chunk is cached and freed along with chunk */
+	if (!cached)
+		crt_bulk_free(local_bulk_hdl);
 	crt_req_decref(rpc);
 	return cb_info->bci_rc;
 }
 
+static int
+bulk_complete_cb(const struct crt_bulk_cb_info *cb_info)
+{
+	return bulk_complete(cb_info, false);
+}
+
+static int
+bulk_cached_complete_cb(const struct crt_bulk_cb_info *cb_info)
+{
+	return bulk_complete(cb_info, true);
+}
+
+/**
+ * Get the cached bulk handle of DMA chunk for the iov @idx of sgl @sgl_idx,
+ * returns NULL if the iov isn't in DMA buffer. The handle is registered on
+ * first use only if @create is true.
+ */
+static inline crt_bulk_t
+ds_iov_bulk(crt_rpc_t *rpc, struct bio_desc *biod, int sgl_idx,
+	    unsigned int idx, bool create, daos_off_t *bulk_off)
+{
+	if (biod == NULL)
+		return NULL;
+
+	return bio_iod_bulk(biod, create ? rpc->cr_ctx : NULL, sgl_idx, idx,
+			    bulk_off);
+}
+
 /**
  * Simulate bulk transfer by memcpy, all data are actually dropped.
  */
@@ -208,12 +297,13 @@ bulk_bypass(d_sg_list_t *sgl, crt_bulk_op_t bulk_op)
 	}
 }
 
-static int
+int
 ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 		 crt_bulk_t *remote_bulks, daos_handle_t ioh,
 		 d_sg_list_t **sgls, int sgl_nr)
 {
 	struct ds_bulk_async_args arg = { 0 };
+	struct bio_desc		*biod = NULL;
 	crt_bulk_opid_t		bulk_opid;
 	crt_bulk_perm_t		bulk_perm;
 	int			i, rc, *status, ret;
@@ -225,6 +315,10 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 
 	D_DEBUG(DB_IO, "bulk_op:%d sgl_nr%d\n", bulk_op, sgl_nr);
 
+	/* Transfer from/to the DMA buffer directly if possible */
+	if (sgls == NULL && !daos_handle_is_inval(ioh))
+		biod = vos_ioh2desc(ioh);
+
 	for (i = 0; i < sgl_nr; i++) {
 		d_sg_list_t		*sgl, tmp_sgl;
 		struct crt_bulk_desc	 bulk_desc;
@@ -268,6 +362,9 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 		while (idx < sgl->sg_nr_out) {
 			d_sg_list_t	sgl_sent;
 			daos_size_t	length = 0;
+			daos_off_t	local_off = 0;
+			daos_off_t	off;
+			crt_bulk_t	cached_hdl;
 			unsigned int	start;
 
 			/**
@@ -284,10 +381,38 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 				break;
 
 			start = idx;
+			cached_hdl = ds_iov_bulk(rpc, biod, i, idx, true,
+						 &local_off);
+			if (cached_hdl != NULL) {
+				/**
+				 * The record is in DMA chunk which has bulk
+				 * handle registered already, merge the
+				 * following records contiguous in the chunk.
+				 */
+				length = sgl->sg_iovs[idx].iov_len;
+				idx++;
+				while (idx < sgl->sg_nr_out &&
+				       sgl->sg_iovs[idx].iov_buf != NULL &&
+				       ds_iov_bulk(rpc, biod, i, idx, false,
+						   &off) == cached_hdl &&
+				       off == local_off + length) {
+					length += sgl->sg_iovs[idx].iov_len;
+					idx++;
+				}
+				local_bulk_hdl = cached_hdl;
+				goto transfer;
+			}
+
 			sgl_sent.sg_iovs = &sgl->sg_iovs[start];
-			/* Find the end of the non-empty record */
+			/* Find the end of the non-empty record, stop at the
+			 * record in DMA chunk, it will be transferred over the
+			 * cached bulk handle.
+			 */
 			while (sgl->sg_iovs[idx].iov_buf != NULL &&
 			       idx < sgl->sg_nr_out) {
+				if (idx != start && biod != NULL &&
+				    bio_iod_bulk_cacheable(biod, i, idx))
+					break;
 				length += sgl->sg_iovs[idx].iov_len;
 				idx++;
 			}
@@ -302,7 +427,7 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 					i, rc);
 				break;
 			}
-
+transfer:
 			crt_req_addref(rpc);
 
 			bulk_desc.bd_rpc	= rpc;
@@ -311,20 +436,23 @@ ds_bulk_transfer(crt_rpc_t *rpc, crt_bulk_op_t bulk_op, bool bulk_bind,
 			bulk_desc.bd_local_hdl	= local_bulk_hdl;
 			bulk_desc.bd_len	= length;
 			bulk_desc.bd_remote_off	= offset;
-			bulk_desc.bd_local_off	= 0;
+			bulk_desc.bd_local_off	= local_off;
 
 			arg.bulks_inflight++;
 			if (bulk_bind)
 				rc = crt_bulk_bind_transfer(&bulk_desc,
+					cached_hdl ? bulk_cached_complete_cb :
 					bulk_complete_cb, &arg, &bulk_opid);
 			else
 				rc = crt_bulk_transfer(&bulk_desc,
+					cached_hdl ? bulk_cached_complete_cb :
 					bulk_complete_cb, &arg, &bulk_opid);
 			if (rc < 0) {
 				D_ERROR("crt_bulk_transfer %d error (%d).\n",
 					i, rc);
 				arg.bulks_inflight--;
-				crt_bulk_free(local_bulk_hdl);
+				if (cached_hdl == NULL)
+					crt_bulk_free(local_bulk_hdl);
 				crt_req_decref(rpc);
 				break;
 			}
@@ -393,10 +521,10 @@ ds_obj_update_sizes_in_reply(crt_rpc_t *rpc)
 	iods = orw->orw_iods.ca_arrays;
 	size_count = orw->orw_iods.ca_count;
 
-	orwo->orw_sizes.ca_count = size_count;
-	D_ALLOC_ARRAY(sizes, size_count);
+	sizes = obj_reply_buf_get(size_count * sizeof(*sizes));
 	if (sizes == NULL)
 		return -DER_NOMEM;
+	orwo->orw_sizes.ca_count = size_count;
 
 	for (i = 0; i < orw->orw_iods.ca_count; i++)
 		sizes[i] = iods[i].iod_size;
@@ -425,12 +553,11 @@ ds_obj_update_nrs_in_reply(crt_rpc_t *rpc, daos_handle_t ioh,
 		return 0;
 
 	/* return num_out for sgl */
-	orwo->orw_nrs.ca_count = nrs_count;
-	D_ALLOC(orwo->orw_nrs.ca_arrays,
-		nrs_count * sizeof(uint32_t));
-
+	orwo->orw_nrs.ca_arrays = obj_reply_buf_get(nrs_count *
+						    sizeof(uint32_t));
 	if (orwo->orw_nrs.ca_arrays == NULL)
 		return -DER_NOMEM;
+	orwo->orw_nrs.ca_count = nrs_count;
 
 	nrs = orwo->orw_nrs.ca_arrays;
 	for (i = 0; i < nrs_count; i++) {
@@ -612,6 +739,74 @@ out:
 	orwo->orw_map_version = orw->orw_map_ver;
 }
 
+/**
+ * Verify the checksums provided by the client against the data landed in the
+ * buffers of \a biod, before it's written to the media. Checksums of unknown
+ * types are stored as they are. The computation is offloaded to the helper
+ * xstream of the target.
+ */
+static int
+obj_verify_csums(struct bio_desc *biod, daos_iod_t *iods, int nr)
+{
+	struct dss_acc_task	 task;
+	struct dss_acc_csum	 params;
+	struct bio_sglist	*bsgl;
+	daos_csum_t		 csum;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	const char		*name;
+	int			 i, j;
+	int			 rc;
+
+	task.at_offload_type = DSS_OFFLOAD_ULT;
+	task.at_opcode = DSS_ACC_CSUM_VERIFY;
+	task.at_params = &params;
+	task.at_cb = NULL;
+
+	sgl.sg_nr = sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	params.ac_csum = &csum;
+	params.ac_sgl = &sgl;
+
+	for (i = 0; i < nr; i++) {
+		daos_iod_t	*iod = &iods[i];
+
+		if (iod->iod_type != DAOS_IOD_ARRAY || iod->iod_csums == NULL)
+			continue;
+
+		/* One bio_iov for each recx, punched ones are holes */
+		bsgl = bio_iod_sgl(biod, i);
+		for (j = 0; j < iod->iod_nr && j < bsgl->bs_nr_out; j++) {
+			struct bio_iov	*biov = &bsgl->bs_iovs[j];
+
+			name = daos_csum_type2name(iod->iod_csums[j].cs_type);
+			if (name == NULL || biov->bi_buf == NULL ||
+			    !daos_csum_isvalid(&iod->iod_csums[j]))
+				continue;
+
+			rc = daos_csum_init(name, &csum);
+			if (rc != 0)
+				return rc;
+
+			d_iov_set(&iov, biov->bi_buf, biov->bi_data_len);
+			params.ac_off = iod->iod_recxs[j].rx_idx *
+					iod->iod_size;
+			params.ac_csum_buf = &iod->iod_csums[j];
+			rc = dss_acc_offload(&task);
+			daos_csum_free(&csum);
+			if (rc != 0) {
+				D_ERROR("Verify checksum of recx "DF_U64"/"
+					DF_U64" failed: %d\n",
+					iod->iod_recxs[j].rx_idx,
+					iod->iod_recxs[j].rx_nr, rc);
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
 static int
 obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	     struct ds_cont_child *cont, struct dtx_handle *dth)
@@ -624,6 +819,7 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	crt_bulk_op_t		bulk_op;
 	bool			rma;
 	bool			bulk_bind;
+	uint64_t		ts;
 	int			rc, err;
 
 	if (daos_oc_echo_type(daos_obj_id2class(orw->orw_oid.id_pub)) ||
@@ -643,10 +839,12 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_UPDATE ||
 	    opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_TGT_UPDATE) {
 		bulk_op = CRT_BULK_GET;
+		DSS_TRACE_BEGIN(ts);
 		rc = vos_update_begin(cont->sc_hdl, orw->orw_oid,
 				      orw->orw_epoch, &orw->orw_dkey,
 				      orw->orw_nr, orw->orw_iods.ca_arrays,
 				      &ioh, dth);
+		DSS_TRACE_END(DSS_TR_OBJ_UPDATE_BEGIN, ts);
 		if (rc) {
 			D_ERROR(DF_UOID" Update begin failed: %d\n",
 				DP_UOID(orw->orw_oid), rc);
@@ -656,9 +854,11 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 		bool size_fetch = (!rma && orw->orw_sgls.ca_arrays == NULL);
 
 		bulk_op = CRT_BULK_PUT;
+		DSS_TRACE_BEGIN(ts);
 		rc = vos_fetch_begin(cont->sc_hdl, orw->orw_oid, orw->orw_epoch,
 				     &orw->orw_dkey, orw->orw_nr,
 				     orw->orw_iods.ca_arrays, size_fetch, &ioh);
+		DSS_TRACE_END(DSS_TR_OBJ_FETCH_BEGIN, ts);
 		if (rc) {
 			D_ERROR(DF_UOID" Fetch begin failed: %d\n",
 				DP_UOID(orw->orw_oid), rc);
@@ -683,13 +883,16 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	}
 
 	biod = vos_ioh2desc(ioh);
+	DSS_TRACE_BEGIN(ts);
 	rc = bio_iod_prep(biod);
+	DSS_TRACE_END(DSS_TR_OBJ_IOD_PREP, ts);
 	if (rc) {
 		D_ERROR(DF_UOID" bio_iod_prep failed: %d.\n",
 			DP_UOID(orw->orw_oid), rc);
 		goto out;
 	}
 
+	DSS_TRACE_BEGIN(ts);
 	if (rma) {
 		bulk_bind = orw->orw_flags & ORF_BULK_BIND;
 		rc = ds_bulk_transfer(rpc, bulk_op, bulk_bind,
@@ -697,6 +900,11 @@ obj_local_rw(crt_rpc_t *rpc, struct ds_cont_hdl *cont_hdl,
 	} else if (orw->orw_sgls.ca_arrays != NULL) {
 		rc = bio_iod_copy(biod, orw->orw_sgls.ca_arrays, orw->orw_nr);
 	}
+	DSS_TRACE_END(DSS_TR_OBJ_BULK, ts);
+
+	if (rc == 0 && bulk_op == CRT_BULK_GET)
+		rc = obj_verify_csums(biod, orw->orw_iods.ca_arrays,
+				      orw->orw_nr);
 
 	if (rc == -DER_OVERFLOW) {
 		rc = -DER_REC2BIG;
@@ -731,6 +939,35 @@ ds_obj_check_dtx_config(uint32_t opc, uint32_t flags, struct dtx_id *dti)
 	return 0;
 }
 
+/*
+ * Update the metrics of object update/fetch RPC, the updates forwarded to
+ * the replicas (TGT_UPDATE) are counted as updates of the target as well.
+ */
+static void
+obj_rw_metrics(crt_rpc_t *rpc, int rc, uint64_t start)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	daos_size_t		 len;
+	bool			 update;
+
+	update = (opc_get(rpc->cr_opc) != DAOS_OBJ_RPC_FETCH);
+	dss_metric_add(obj_metrics[update ? OBJ_MT_UPDATE_CNT :
+				   OBJ_MT_FETCH_CNT], 1);
+	if (rc != 0) {
+		dss_metric_add(obj_metrics[update ? OBJ_MT_UPDATE_ERR :
+					   OBJ_MT_FETCH_ERR], 1);
+		return;
+	}
+
+	len = daos_iods_len(orw->orw_iods.ca_arrays, orw->orw_nr);
+	if (len != (daos_size_t)-1)
+		dss_metric_add(obj_metrics[update ? OBJ_MT_UPDATE_BYTES :
+					   OBJ_MT_FETCH_BYTES], len);
+	dss_metric_observe(obj_metrics[update ? OBJ_MT_UPDATE_LAT :
+				       OBJ_MT_FETCH_LAT],
+			   daos_get_ntime() - start);
+}
+
 /* Various check before access VOS */
 static int
 ds_pre_check(daos_unit_oid_t oid, uint32_t rpc_map_ver, uuid_t pool_uuid,
@@ -823,11 +1060,13 @@ ds_obj_tgt_update_handler(crt_rpc_t *rpc)
 	struct dtx_handle		*dth = NULL;
 	struct dtx_conflict_entry	 conflict = { 0 };
 	uint32_t			 map_ver = 0;
+	uint64_t			 start;
 	int				 rc;
 
 	D_ASSERT(orw != NULL);
 	D_ASSERT(orwo != NULL);
 
+	start = daos_get_ntime();
 	rc = ds_pre_check(orw->orw_oid, orw->orw_map_ver, orw->orw_pool_uuid,
 			  orw->orw_co_hdl, orw->orw_co_uuid,
 			  opc_get(rpc->cr_opc), orw->orw_flags, &orw->orw_dti,
@@ -902,6 +1141,7 @@ ds_obj_tgt_update_handler(crt_rpc_t *rpc)
 out:
 	rc = dtx_end(dth, cont_hdl, cont, rc);
 	ds_obj_rw_reply(rpc, rc, map_ver, &conflict);
+	obj_rw_metrics(rpc, rc, start);
 
 	if (cont_hdl)
 		ds_cont_hdl_put(cont_hdl);
@@ -946,19 +1186,27 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 	struct dtx_conflict_entry	 conflict = { 0 };
 	struct obj_tls			*tls = obj_tls_get();
 	struct ds_obj_exec_arg		exec_arg = { 0 };
+	struct ds_obj_ec_enc		 ec_enc = { 0 };
 	uint32_t			 map_ver = 0;
 	uint32_t			 flags = 0;
+	uint64_t			 ts_rw;
+	uint64_t			 ts;
+	uint64_t			 start;
 	int				 rc;
 
 	D_ASSERT(orw != NULL);
 	D_ASSERT(orwo != NULL);
 
+	start = daos_get_ntime();
 	D_TIME_START(tls->ot_sp, OBJ_PF_UPDATE);
+	DSS_TRACE_BEGIN(ts_rw);
 
+	DSS_TRACE_BEGIN(ts);
 	rc = ds_pre_check(orw->orw_oid, orw->orw_map_ver, orw->orw_pool_uuid,
 			  orw->orw_co_hdl, orw->orw_co_uuid,
 			  opc_get(rpc->cr_opc), orw->orw_flags, &orw->orw_dti,
 			  &cont_hdl, &cont);
+	DSS_TRACE_END(DSS_TR_OBJ_PRE_CHECK, ts);
 	if (rc)
 		goto out;
 
@@ -1034,6 +1282,17 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 	}
 	D_TIME_END(tls->ot_sp, OBJ_PF_UPDATE_PREP);
 
+	if (opc_get(rpc->cr_opc) == DAOS_OBJ_RPC_UPDATE) {
+		rc = ds_obj_ec_encode(rpc, &ec_enc);
+		if (rc != 0) {
+			D_ERROR(DF_UOID": Failed to encode update %d.\n",
+				DP_UOID(orw->orw_oid), rc);
+			D_GOTO(out, rc);
+		}
+		if (ec_enc.ee_nr != 0)
+			exec_arg.ec_enc = &ec_enc;
+	}
+
 	exec_arg.rpc = rpc;
 	exec_arg.cont_hdl = cont_hdl;
 	exec_arg.cont = cont;
@@ -1050,9 +1309,12 @@ out:
 		flags |= ORF_RESEND;
 		D_GOTO(again, rc);
 	}
+	ds_obj_ec_encode_fini(rpc, &ec_enc);
 
 	ds_obj_rw_reply(rpc, rc, map_ver, &conflict);
 	D_TIME_END(tls->ot_sp, OBJ_PF_UPDATE);
+	DSS_TRACE_END(DSS_TR_OBJ_RW, ts_rw);
+	obj_rw_metrics(rpc, rc, start);
 
 	if (cont_hdl)
 		ds_cont_hdl_put(cont_hdl);
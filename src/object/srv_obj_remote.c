@@ -142,6 +142,13 @@ ds_obj_remote_update(struct dtx_handle *dth, void *data, int idx,
 	uuid_copy(orw->orw_co_uuid, orw_parent->orw_co_uuid);
 	orw->orw_shard_tgts.ca_count	= 0;
 	orw->orw_shard_tgts.ca_arrays	= NULL;
+	if (obj_exec_arg->ec_enc != NULL) {
+		/* pull the data and parity encoded by leader */
+		orw->orw_sgls.ca_count	= 0;
+		orw->orw_sgls.ca_arrays	= NULL;
+		orw->orw_bulks.ca_count	= obj_exec_arg->ec_enc->ee_nr;
+		orw->orw_bulks.ca_arrays = obj_exec_arg->ec_enc->ee_bulks;
+	}
 	orw->orw_flags |= ORF_BULK_BIND | obj_exec_arg->flags;
 	if (!srv_enable_dtx)
 		orw->orw_flags |= ORF_DTX_DISABLED;
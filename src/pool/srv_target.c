@@ -1050,58 +1050,160 @@ cont_iter_cb(uuid_t cont_uuid, vos_iter_entry_t *ent, void *data)
 	return arg->callback(cont_uuid, ent, arg->arg);
 }
 
+/* The max count of the containers to resync DTX concurrently on a target. */
+#define POOL_DTX_RESYNC_CONT_MAX	8
+
+/* DTX resync for all the containers of the pool on current target. */
+struct pool_dtx_resync {
+	daos_handle_t	 pdr_ph;
+	uuid_t		 pdr_po_uuid;
+	uint32_t	 pdr_ver;
+	/* The containers to be resynced. */
+	uuid_t		*pdr_co_uuids;
+	int		 pdr_nr;
+	int		 pdr_cap;
+	/* The count of the in-flight and the done containers. */
+	int		 pdr_inflight;
+	int		 pdr_done;
+	int		 pdr_result;
+	/* Signaled when an in-flight container is done. */
+	ABT_mutex	 pdr_lock;
+	ABT_cond	 pdr_cond;
+};
+
 struct dtx_resync_args {
-	daos_handle_t	ph;
-	uuid_t		po_uuid;
-	uuid_t		co_uuid;
-	uint32_t	ver;
+	struct pool_dtx_resync	*pdr;
+	uuid_t			 co_uuid;
 };
 
-static int
+static void
 dtx_resync_ult(void *data)
 {
 	struct dtx_resync_args	*args = data;
+	struct pool_dtx_resync	*pdr = args->pdr;
 	int			 rc;
 
-	rc = dtx_resync(args->ph, args->po_uuid, args->co_uuid, args->ver,
-			true);
-	if (rc != 0)
+	rc = dtx_resync(pdr->pdr_ph, pdr->pdr_po_uuid, args->co_uuid,
+			pdr->pdr_ver, true);
+	if (rc != 0) {
 		D_ERROR("Fail to resync some DTX(s) for the pool/cont "
 			DF_UUID"/"DF_UUID" that will affect subsequent "
 			"object rebuild: rc = %d.\n",
-			DP_UUID(args->po_uuid), DP_UUID(args->co_uuid), rc);
-	return rc;
+			DP_UUID(pdr->pdr_po_uuid), DP_UUID(args->co_uuid), rc);
+		if (pdr->pdr_result == 0)
+			pdr->pdr_result = rc;
+	}
+
+	ABT_mutex_lock(pdr->pdr_lock);
+	pdr->pdr_inflight--;
+	pdr->pdr_done++;
+	D_DEBUG(DB_TRACE, "resync DTX for pool "DF_UUID": %d/%d containers "
+		"done\n", DP_UUID(pdr->pdr_po_uuid), pdr->pdr_done,
+		pdr->pdr_nr);
+	ABT_cond_signal(pdr->pdr_cond);
+	ABT_mutex_unlock(pdr->pdr_lock);
+
+	D_FREE_PTR(args);
 }
 
 static int
-pool_iter_cb(daos_handle_t ph, uuid_t co_uuid, void *data)
+pool_dtx_resync_collect(daos_handle_t ph, uuid_t co_uuid, void *data)
 {
-	struct cont_iter_arg *arg = data;
+	struct pool_dtx_resync	*pdr = data;
+
+	if (pdr->pdr_nr == pdr->pdr_cap) {
+		uuid_t	*uuids;
+		int	 cap = pdr->pdr_cap == 0 ? 16 : pdr->pdr_cap * 2;
+
+		D_REALLOC(uuids, pdr->pdr_co_uuids, cap * sizeof(*uuids));
+		if (uuids == NULL)
+			return -DER_NOMEM;
+
+		pdr->pdr_co_uuids = uuids;
+		pdr->pdr_cap = cap;
+	}
+
+	uuid_copy(pdr->pdr_co_uuids[pdr->pdr_nr++], co_uuid);
+	return 0;
+}
+
+/**
+ * Resync DTXs' status for all the containers of the pool before rebuild
+ * scanning. Multiple containers are resynced concurrently (by the ULTs on
+ * current xstream), then the time cost is not the sum of all containers'
+ * RPC round trips.
+ */
+static int
+pool_dtx_resync(daos_handle_t ph, uuid_t po_uuid, uint32_t ver)
+{
+	struct pool_dtx_resync	 pdr = { 0 };
+	struct dtx_resync_args	*args;
+	int			 rc;
+	int			 i;
 
-	switch (arg->intent) {
-	case DAOS_INTENT_REBUILD: {
-		struct dtx_resync_args	args;
-		int			rc;
-
-		/* For rebuild case, we need to resync DTXs' status firstly. */
-		args.ph = ph;
-		args.ver = arg->version;
-		uuid_copy(args.po_uuid, arg->po_uuid);
-		uuid_copy(args.co_uuid, co_uuid);
-		rc = dss_ult_create_execute(dtx_resync_ult, &args, NULL, NULL,
-					    DSS_ULT_DTX_RESYNC, DSS_TGT_SELF,
-					    0);
+	pdr.pdr_ph = ph;
+	uuid_copy(pdr.pdr_po_uuid, po_uuid);
+	pdr.pdr_ver = ver;
+
+	rc = ds_pool_cont_iter(ph, pool_dtx_resync_collect, &pdr);
+	if (rc != 0)
+		goto out;
+
+	rc = ABT_mutex_create(&pdr.pdr_lock);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(out, rc = dss_abterr2der(rc));
+
+	rc = ABT_cond_create(&pdr.pdr_cond);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(out, rc = dss_abterr2der(rc));
+
+	for (i = 0; i < pdr.pdr_nr; i++) {
+		ABT_mutex_lock(pdr.pdr_lock);
+		while (pdr.pdr_inflight >= POOL_DTX_RESYNC_CONT_MAX)
+			ABT_cond_wait(pdr.pdr_cond, pdr.pdr_lock);
+		ABT_mutex_unlock(pdr.pdr_lock);
+
+		D_ALLOC_PTR(args);
+		if (args == NULL)
+			D_GOTO(wait, rc = -DER_NOMEM);
+
+		args->pdr = &pdr;
+		uuid_copy(args->co_uuid, pdr.pdr_co_uuids[i]);
+		pdr.pdr_inflight++;
+		rc = dss_ult_create(dtx_resync_ult, args, DSS_ULT_DTX_RESYNC,
+				    DSS_TGT_SELF, 0, NULL);
 		if (rc != 0) {
 			D_ERROR("dtx_resync_ult failed, rc %d.\n", rc);
-			return rc;
+			pdr.pdr_inflight--;
+			D_FREE_PTR(args);
+			goto wait;
 		}
-
-		/* Fall through to the regular object iteration. */
-	}
-	default:
-		return ds_cont_iter(ph, co_uuid, cont_iter_cb, data,
-				    VOS_ITER_OBJ);
 	}
+
+wait:
+	ABT_mutex_lock(pdr.pdr_lock);
+	while (pdr.pdr_inflight > 0)
+		ABT_cond_wait(pdr.pdr_cond, pdr.pdr_lock);
+	ABT_mutex_unlock(pdr.pdr_lock);
+
+	if (rc == 0)
+		rc = pdr.pdr_result;
+
+	D_INFO("resync DTX for pool "DF_UUID": %d/%d containers done, "
+	       "rc = %d\n", DP_UUID(po_uuid), pdr.pdr_done, pdr.pdr_nr, rc);
+out:
+	if (pdr.pdr_cond)
+		ABT_cond_free(&pdr.pdr_cond);
+	if (pdr.pdr_lock)
+		ABT_mutex_free(&pdr.pdr_lock);
+	D_FREE(pdr.pdr_co_uuids);
+	return rc;
+}
+
+static int
+pool_iter_cb(daos_handle_t ph, uuid_t co_uuid, void *data)
+{
+	return ds_cont_iter(ph, co_uuid, cont_iter_cb, data, VOS_ITER_OBJ);
 }
 
 /**
@@ -1124,8 +1226,16 @@ ds_pool_iter(uuid_t pool_uuid, ds_iter_cb_t callback, void *data,
 	arg.arg = data;
 	arg.version = version;
 	arg.intent = intent;
-	rc = ds_pool_cont_iter(child->spc_hdl, pool_iter_cb, &arg);
 
+	/* For rebuild case, we need to resync DTXs' status firstly. */
+	if (intent == DAOS_INTENT_REBUILD) {
+		rc = pool_dtx_resync(child->spc_hdl, pool_uuid, version);
+		if (rc != 0)
+			goto out;
+	}
+
+	rc = ds_pool_cont_iter(child->spc_hdl, pool_iter_cb, &arg);
+out:
 	ds_pool_child_put(child);
 
 	D_DEBUG(DB_TRACE, DF_UUID" iterate pool is done\n",
@@ -73,6 +73,14 @@ struct rebuild_iter_obj_arg {
 #define PULLER_STACK_SIZE	131072
 #define MAX_BUF_SIZE		2048
 
+/** Max # of dkeys of the same object pulled by one pull ULT */
+#define REBUILD_PULL_BATCH		16
+/** # of concurrent pulls on each target without budget */
+#define REBUILD_PULL_INFLIGHT_DEF	4
+#define REBUILD_PULL_INFLIGHT_MAX	32
+/** Weight of the new sample of the moving averages of the pulls */
+#define REBUILD_PULL_AVG_WEIGHT		8
+
 static int
 rebuild_fetch_update_inline(struct rebuild_one *rdone, daos_handle_t oh,
 			    struct ds_cont_child *ds_cont)
@@ -291,15 +299,18 @@ rebuild_one_punch_keys(struct rebuild_tgt_pool_tracker *rpt,
 	return rc;
 }
 
+/**
+ * Open the object of @rdone for pulling, the handles are shared by all of the
+ * dkeys of the object which are pulled in the same batch.
+ */
 static int
-rebuild_dkey(struct rebuild_tgt_pool_tracker *rpt,
-	     struct rebuild_one *rdone)
+rebuild_obj_open(struct rebuild_tgt_pool_tracker *rpt,
+		 struct rebuild_one *rdone, daos_handle_t *cohp,
+		 daos_handle_t *ohp, struct ds_cont_child **contp)
 {
 	struct rebuild_pool_tls	*tls;
-	struct ds_cont_child *rebuild_cont;
 	daos_handle_t		coh = DAOS_HDL_INVAL;
 	daos_handle_t		oh;
-	daos_size_t		data_size;
 	int			rc;
 
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
@@ -328,17 +339,56 @@ rebuild_dkey(struct rebuild_tgt_pool_tracker *rpt,
 	if (rc)
 		D_GOTO(cont_close, rc);
 
-	if (DAOS_FAIL_CHECK(DAOS_REBUILD_TGT_NOSPACE))
-		D_GOTO(obj_close, rc = -DER_NOSPACE);
-
 	rc = ds_cont_child_lookup(rpt->rt_pool_uuid, rdone->ro_cont_uuid,
-				  &rebuild_cont);
+				  contp);
 	if (rc)
 		D_GOTO(obj_close, rc);
 
+	*cohp = coh;
+	*ohp = oh;
+	return 0;
+
+obj_close:
+	ds_obj_close(oh);
+cont_close:
+	dc_cont_local_close(tls->rebuild_pool_hdl, coh);
+free:
+	return rc;
+}
+
+static void
+rebuild_obj_close(struct rebuild_tgt_pool_tracker *rpt, daos_handle_t coh,
+		  daos_handle_t oh, struct ds_cont_child *cont)
+{
+	struct rebuild_pool_tls	*tls;
+
+	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
+				      rpt->rt_rebuild_ver);
+	D_ASSERT(tls != NULL);
+	ds_cont_child_put(cont);
+	ds_obj_close(oh);
+	dc_cont_local_close(tls->rebuild_pool_hdl, coh);
+}
+
+static int
+rebuild_dkey(struct rebuild_tgt_pool_tracker *rpt,
+	     struct rebuild_one *rdone, daos_handle_t oh,
+	     struct ds_cont_child *rebuild_cont)
+{
+	struct rebuild_pool_tls	*tls;
+	daos_size_t		data_size;
+	int			rc;
+
+	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
+				      rpt->rt_rebuild_ver);
+	D_ASSERT(tls != NULL);
+
+	if (DAOS_FAIL_CHECK(DAOS_REBUILD_TGT_NOSPACE))
+		return -DER_NOSPACE;
+
 	rc = rebuild_one_punch_keys(rpt, rdone, rebuild_cont);
 	if (rc)
-		D_GOTO(cont_put, rc);
+		return rc;
 
 	data_size = daos_iods_len(rdone->ro_iods, rdone->ro_iod_num);
 
@@ -354,13 +404,6 @@ rebuild_dkey(struct rebuild_tgt_pool_tracker *rpt,
 	}
 
 	tls->rebuild_pool_rec_count += rdone->ro_rec_num;
-cont_put:
-	ds_cont_child_put(rebuild_cont);
-obj_close:
-	ds_obj_close(oh);
-cont_close:
-	dc_cont_local_close(tls->rebuild_pool_hdl, coh);
-free:
 	return rc;
 }
 
@@ -394,10 +437,275 @@ rebuild_one_destroy(struct rebuild_one *rdone)
 	D_FREE(rdone);
 }
 
+/* Argument of the ULT pulling a batch of dkeys of the same object */
+struct rebuild_pull_arg {
+	struct rebuild_tgt_pool_tracker	*rpa_rpt;
+	struct rebuild_puller		*rpa_puller;
+	d_list_t			 rpa_list;
+	double				 rpa_start;
+	unsigned int			 rpa_dkeys;
+};
+
+/** Bytes of @rdone to be pulled, 0 if the size is unknown */
+static uint64_t
+rebuild_one_size(struct rebuild_one *rdone)
+{
+	daos_size_t size;
+
+	size = daos_iods_len(rdone->ro_iods, rdone->ro_iod_num);
+	return size == (daos_size_t)(-1) ? 0 : size;
+}
+
+/**
+ * Bytes of @rdone charged to the pull budget, the dkey of unknown size is
+ * fetched inline, so it is charged as MAX_BUF_SIZE.
+ */
+static uint64_t
+rebuild_one_charge(struct rebuild_one *rdone)
+{
+	daos_size_t size;
+
+	size = daos_iods_len(rdone->ro_iods, rdone->ro_iod_num);
+	return size == (daos_size_t)(-1) ? MAX_BUF_SIZE : size;
+}
+
 static void
-rebuild_one_ult(void *arg)
+rebuild_pull_avg(double *avg, double sample)
 {
+	if (*avg == 0)
+		*avg = sample;
+	else
+		*avg += (sample - *avg) / REBUILD_PULL_AVG_WEIGHT;
+}
+
+/**
+ * Check if the puller has used up the budget of the current one second
+ * window, and start a new window if the current one is over.
+ */
+static bool
+rebuild_pull_throttled(struct rebuild_puller *puller, double now)
+{
+	if (now - puller->rp_win_start >= 1.0) {
+		puller->rp_win_start = now;
+		puller->rp_win_bytes = 0;
+		puller->rp_win_dkeys = 0;
+	}
+
+	if (dss_rebuild_pull_iops != 0 &&
+	    puller->rp_win_dkeys >= dss_rebuild_pull_iops)
+		return true;
+
+	if (dss_rebuild_pull_bw != 0 &&
+	    puller->rp_win_bytes >= ((uint64_t)dss_rebuild_pull_bw << 20))
+		return true;
+
+	return false;
+}
+
+/**
+ * Number of concurrent pulls to meet the budget, which is the pull rate
+ * allowed by the budget multiplied by the average latency of one pull.
+ */
+static unsigned int
+rebuild_pull_inflight_max(struct rebuild_puller *puller)
+{
+	double	rate = 0;
+	double	bw_rate;
+
+	if (dss_rebuild_pull_bw == 0 && dss_rebuild_pull_iops == 0)
+		return REBUILD_PULL_INFLIGHT_DEF;
+
+	/* No sample yet, start with one pull to measure the latency */
+	if (puller->rp_lat_avg == 0)
+		return 1;
+
+	if (dss_rebuild_pull_iops != 0)
+		rate = dss_rebuild_pull_iops / max(puller->rp_dkeys_avg, 1.0);
+
+	if (dss_rebuild_pull_bw != 0 && puller->rp_size_avg > 0) {
+		bw_rate = ((double)dss_rebuild_pull_bw * (1 << 20)) /
+			  puller->rp_size_avg;
+		if (rate == 0 || bw_rate < rate)
+			rate = bw_rate;
+	}
+
+	if (rate == 0)
+		return REBUILD_PULL_INFLIGHT_DEF;
+
+	return min((unsigned int)(rate * puller->rp_lat_avg) + 1,
+		   REBUILD_PULL_INFLIGHT_MAX);
+}
+
+/**
+ * Milliseconds to sleep before dispatching the next pull: until the end of
+ * the current window if the budget is used up, or about the latency of one
+ * pull if there are enough concurrent pulls. 0 means no need to wait.
+ */
+static int
+rebuild_pull_wait(struct rebuild_puller *puller, double now)
+{
+	double	wait;
+
+	if (rebuild_pull_throttled(puller, now))
+		wait = puller->rp_win_start + 1.0 - now;
+	else if (puller->rp_pulls >= rebuild_pull_inflight_max(puller))
+		wait = min(puller->rp_lat_avg,
+			   puller->rp_win_start + 1.0 - now);
+	else
+		return 0;
+
+	return max((int)(wait * 1000), 1);
+}
+
+/**
+ * Move the first rdone of the puller list to @list, with the following small
+ * dkeys of the same object, so they can be pulled with the same handles.
+ * Return the number of dkeys and the bytes charged to the budget.
+ */
+static unsigned int
+rebuild_pull_batch_get(struct rebuild_puller *puller, d_list_t *list,
+		       uint64_t *size)
+{
+	struct rebuild_one	*first = NULL;
+	struct rebuild_one	*rdone;
+	struct rebuild_one	*tmp;
+	uint64_t		 known = 0;
+	unsigned int		 nr = 0;
+
+	*size = 0;
+	ABT_mutex_lock(puller->rp_lock);
+	d_list_for_each_entry_safe(rdone, tmp, &puller->rp_one_list, ro_list) {
+		uint64_t rd_size = rebuild_one_size(rdone);
+
+		if (first != NULL &&
+		    (rd_size >= MAX_BUF_SIZE || known >= MAX_BUF_SIZE ||
+		     daos_unit_oid_compare(first->ro_oid, rdone->ro_oid) ||
+		     uuid_compare(first->ro_cont_uuid, rdone->ro_cont_uuid)))
+			break;
+
+		if (first == NULL)
+			first = rdone;
+		d_list_move_tail(&rdone->ro_list, list);
+		known += rd_size;
+		*size += rebuild_one_charge(rdone);
+		if (++nr >= REBUILD_PULL_BATCH)
+			break;
+	}
+	if (nr > 0) {
+		puller->rp_pulls++;
+		puller->rp_inflight += nr;
+	}
+	ABT_mutex_unlock(puller->rp_lock);
+
+	return nr;
+}
+
+static void
+rebuild_pull_ult(void *data)
+{
+	struct rebuild_pull_arg		*arg = data;
+	struct rebuild_tgt_pool_tracker	*rpt = arg->rpa_rpt;
+	struct rebuild_puller		*puller = arg->rpa_puller;
 	struct rebuild_pool_tls		*tls;
+	struct rebuild_one		*rdone;
+	struct rebuild_one		*tmp;
+	struct ds_cont_child		*cont = NULL;
+	daos_handle_t			 coh = DAOS_HDL_INVAL;
+	daos_handle_t			 oh = DAOS_HDL_INVAL;
+	int				 open_rc = 0;
+
+	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
+				      rpt->rt_rebuild_ver);
+	D_ASSERT(tls != NULL);
+
+	D_ASSERT(!d_list_empty(&arg->rpa_list));
+	if (!rpt->rt_abort) {
+		rdone = d_list_entry(arg->rpa_list.next, struct rebuild_one,
+				     ro_list);
+		open_rc = rebuild_obj_open(rpt, rdone, &coh, &oh, &cont);
+	}
+
+	d_list_for_each_entry_safe(rdone, tmp, &arg->rpa_list, ro_list) {
+		int rc = 0;
+
+		d_list_del_init(&rdone->ro_list);
+		if (!rpt->rt_abort) {
+			rc = open_rc;
+			if (rc == 0)
+				rc = rebuild_dkey(rpt, rdone, oh, cont);
+			D_DEBUG(DB_REBUILD, DF_UOID" rebuild dkey %d %s"
+				" rc %d tag %d rpt %p\n",
+				DP_UOID(rdone->ro_oid),
+				(int)rdone->ro_dkey.iov_len,
+				(char *)rdone->ro_dkey.iov_buf, rc,
+				dss_get_module_info()->dmi_tgt_id, rpt);
+		}
+
+		if (rc == -DER_NOSPACE) {
+			/* If there are no space on current VOS, let's
+			 * hang the rebuild ULT on the current xstream,
+			 * and waitting for the space is reclaimed or
+			 * the drive is replaced.
+			 *
+			 * If the space is reclaimed, then it will
+			 * resume the rebuild ULT.
+			 * If the drive is replaced, then it will
+			 * abort the current rebuild by other process.
+			 */
+			rebuild_hang();
+			ABT_thread_yield();
+			D_DEBUG(DB_REBUILD, "%p rebuild got back.\n", rpt);
+			/* Added it back to rdone */
+			ABT_mutex_lock(puller->rp_lock);
+			d_list_add_tail(&rdone->ro_list, &puller->rp_one_list);
+			ABT_mutex_unlock(puller->rp_lock);
+			continue;
+		}
+
+		/* Ignore nonexistent error because puller could race
+		 * with user's container destroy:
+		 * - puller got the container+oid from a remote scanner
+		 * - user destroyed the container
+		 * - puller try to open container or pulling data
+		 *   (nonexistent)
+		 * This is just a workaround...
+		 */
+		if (tls->rebuild_pool_status == 0 && rc != 0 &&
+		    rc != -DER_NONEXIST) {
+			tls->rebuild_pool_status = rc;
+			rpt->rt_abort = 1;
+		}
+		/* XXX If rebuild fails, Should we add this back to
+		 * dkey list
+		 */
+		rebuild_one_destroy(rdone);
+	}
+
+	if (cont != NULL)
+		rebuild_obj_close(rpt, coh, oh, cont);
+
+	rebuild_pull_avg(&puller->rp_lat_avg, ABT_get_wtime() - arg->rpa_start);
+
+	ABT_mutex_lock(puller->rp_lock);
+	D_ASSERT(puller->rp_pulls > 0);
+	D_ASSERT(puller->rp_inflight >= arg->rpa_dkeys);
+	puller->rp_pulls--;
+	puller->rp_inflight -= arg->rpa_dkeys;
+	ABT_mutex_unlock(puller->rp_lock);
+
+	D_FREE(arg);
+	rpt_put(rpt);
+}
+
+/**
+ * Dispatch the dkeys queued on the puller of the current xstream to pull
+ * ULTs. The number of concurrent pulls and the pull rate are bounded by the
+ * budget set through dss_parameters_set(), so rebuild does not starve the
+ * foreground I/O.
+ */
+static void
+rebuild_one_ult(void *arg)
+{
 	struct rebuild_tgt_pool_tracker *rpt = arg;
 	struct rebuild_puller		*puller;
 	unsigned int			idx;
@@ -405,89 +713,70 @@ rebuild_one_ult(void *arg)
 	while (daos_fail_check(DAOS_REBUILD_TGT_REBUILD_HANG))
 		ABT_thread_yield();
 
-	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid,
-				      rpt->rt_rebuild_ver);
-	D_ASSERT(tls != NULL);
 	D_ASSERT(rpt->rt_pullers != NULL);
 	idx = dss_get_module_info()->dmi_tgt_id;
 	puller = &rpt->rt_pullers[idx];
 	puller->rp_ult_running = 1;
 	while (1) {
-		struct rebuild_one	*rdone;
-		struct rebuild_one	*tmp;
-		d_list_t		rebuild_list;
-		int			rc = 0;
+		struct rebuild_pull_arg	*pull;
+		double			 now = ABT_get_wtime();
+		uint64_t		 size;
+		unsigned int		 nr;
+		int			 wait;
+		int			 rc;
 
-		D_INIT_LIST_HEAD(&rebuild_list);
 		ABT_mutex_lock(puller->rp_lock);
-		d_list_for_each_entry_safe(rdone, tmp, &puller->rp_one_list,
-					   ro_list) {
-			d_list_move_tail(&rdone->ro_list, &rebuild_list);
-			puller->rp_inflight++;
+		if (d_list_empty(&puller->rp_one_list)) {
+			ABT_mutex_unlock(puller->rp_lock);
+			goto next;
 		}
 		ABT_mutex_unlock(puller->rp_lock);
 
-		d_list_for_each_entry_safe(rdone, tmp, &rebuild_list, ro_list) {
-			d_list_del_init(&rdone->ro_list);
-			if (!rpt->rt_abort) {
-				rc = rebuild_dkey(rpt, rdone);
-				D_DEBUG(DB_REBUILD, DF_UOID" rebuild dkey %d %s"
-					" rc %d tag %d rpt %p\n",
-					DP_UOID(rdone->ro_oid),
-					(int)rdone->ro_dkey.iov_len,
-					(char *)rdone->ro_dkey.iov_buf, rc,
-					idx, rpt);
-			}
-
-			D_ASSERT(puller->rp_inflight > 0);
-			puller->rp_inflight--;
-
-			if (rc == -DER_NOSPACE) {
-				/* If there are no space on current VOS, let's
-				 * hang the rebuild ULT on the current xstream,
-				 * and waitting for the space is reclaimed or
-				 * the drive is replaced.
-				 *
-				 * If the space is reclaimed, then it will
-				 * resume the rebuild ULT.
-				 * If the drive is replaced, then it will
-				 * abort the current rebuild by other process.
-				 */
-				rebuild_hang();
-				ABT_thread_yield();
-				D_DEBUG(DB_REBUILD, "%p rebuild got back.\n",
-					rpt);
-				rc = 0;
-				/* Added it back to rdone */
-				ABT_mutex_lock(puller->rp_lock);
-				d_list_add_tail(&rdone->ro_list,
-						&puller->rp_one_list);
-				ABT_mutex_unlock(puller->rp_lock);
+		/* Drain the list without throttling if it is aborted */
+		if (!rpt->rt_abort) {
+			wait = rebuild_pull_wait(puller, now);
+			if (wait > 0) {
+				dss_sleep(wait);
 				continue;
 			}
+		}
 
-			/* Ignore nonexistent error because puller could race
-			 * with user's container destroy:
-			 * - puller got the container+oid from a remote scanner
-			 * - user destroyed the container
-			 * - puller try to open container or pulling data
-			 *   (nonexistent)
-			 * This is just a workaround...
-			 */
-			if (tls->rebuild_pool_status == 0 && rc != 0 &&
-			    rc != -DER_NONEXIST) {
-				tls->rebuild_pool_status = rc;
-				rpt->rt_abort = 1;
-			}
-			/* XXX If rebuild fails, Should we add this back to
-			 * dkey list
-			 */
-			rebuild_one_destroy(rdone);
+		D_ALLOC_PTR(pull);
+		if (pull == NULL)
+			goto next;
+
+		D_INIT_LIST_HEAD(&pull->rpa_list);
+		nr = rebuild_pull_batch_get(puller, &pull->rpa_list, &size);
+		if (nr == 0) {
+			D_FREE(pull);
+			goto next;
 		}
 
+		puller->rp_win_dkeys += nr;
+		puller->rp_win_bytes += size;
+		rebuild_pull_avg(&puller->rp_dkeys_avg, nr);
+		if (size > 0)
+			rebuild_pull_avg(&puller->rp_size_avg, size);
+		pull->rpa_dkeys = nr;
+
+		rpt_get(rpt);
+		pull->rpa_rpt = rpt;
+		pull->rpa_puller = puller;
+		pull->rpa_start = now;
+		rc = dss_ult_create(rebuild_pull_ult, pull, DSS_ULT_REBUILD,
+				    DSS_TGT_SELF, PULLER_STACK_SIZE, NULL);
+		if (rc) {
+			D_DEBUG(DB_REBUILD, "create pull ULT failed: %d\n",
+				rc);
+			/* pull them by the current ULT instead */
+			rebuild_pull_ult(pull);
+		}
+		continue;
+next:
 		/* check if it should exist */
 		ABT_mutex_lock(puller->rp_lock);
-		if (d_list_empty(&puller->rp_one_list) && rpt->rt_finishing) {
+		if (d_list_empty(&puller->rp_one_list) &&
+		    puller->rp_inflight == 0 && rpt->rt_finishing) {
 			ABT_mutex_unlock(puller->rp_lock);
 			break;
 		}
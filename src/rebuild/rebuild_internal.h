@@ -54,7 +54,19 @@ struct rebuild_one {
 };
 
 struct rebuild_puller {
+	/** # of dkeys being pulled */
 	unsigned int	rp_inflight;
+	/** # of running pull ULTs */
+	unsigned int	rp_pulls;
+	/** start time of the current accounting window of the pull budget */
+	double		rp_win_start;
+	/** bytes and dkeys dispatched in the current window */
+	uint64_t	rp_win_bytes;
+	uint64_t	rp_win_dkeys;
+	/** moving average of the latency, bytes and dkeys of one pull */
+	double		rp_lat_avg;
+	double		rp_size_avg;
+	double		rp_dkeys_avg;
 	ABT_thread	rp_ult;
 	ABT_mutex	rp_lock;
 	/** serialize initialization of ULTs */
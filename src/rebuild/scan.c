@@ -45,6 +45,12 @@
 #include "rebuild_internal.h"
 
 #define REBUILD_SEND_LIMIT	512
+/**
+ * One batch of rebuild objects for a target. The scanners detach a batch
+ * from the per-target tree under scan_lock as soon as it is full, then send
+ * it after dropping the lock, so the scan memory is bounded by
+ * REBUILD_SEND_LIMIT objects per target plus the batches being sent.
+ */
 struct rebuild_send_arg {
 	struct rebuild_root *tgt_root;
 	daos_unit_oid_t	    *oids;
@@ -142,65 +148,92 @@ rebuild_cont_iter_cb(daos_handle_t ih, d_iov_t *key_iov,
 	return rc;
 }
 
+static void
+rebuild_send_arg_free(struct rebuild_send_arg *arg)
+{
+	if (arg->oids != NULL)
+		D_FREE(arg->oids);
+	if (arg->uuids != NULL)
+		D_FREE(arg->uuids);
+	if (arg->shards != NULL)
+		D_FREE(arg->shards);
+	if (arg->ephs != NULL)
+		D_FREE(arg->ephs);
+	D_FREE(arg);
+}
+
 static int
-rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
-		     struct rebuild_scan_arg *scan_arg)
+rebuild_send_arg_alloc(struct rebuild_send_arg **argp)
 {
-	struct rebuild_in	*rebuild_in = NULL;
-	struct rebuild_out	*rebuild_out = NULL;
-	struct rebuild_tgt_pool_tracker	*rpt = scan_arg->rpt;
-	struct pool_target	*target;
-	struct rebuild_send_arg *arg = NULL;
-	daos_unit_oid_t		*oids = NULL;
-	daos_epoch_t		*ephs = NULL;
-	uuid_t			*uuids = NULL;
-	unsigned int		*shards = NULL;
-	crt_rpc_t		*rpc = NULL;
-	crt_endpoint_t		tgt_ep = {0};
-	int			rc = 0;
+	struct rebuild_send_arg *arg;
 
 	D_ALLOC_PTR(arg);
 	if (arg == NULL)
 		return -DER_NOMEM;
 
-	D_ALLOC_ARRAY(oids, REBUILD_SEND_LIMIT);
-	if (oids == NULL)
-		D_GOTO(out, rc = -DER_NOMEM);
-
-	D_ALLOC_ARRAY(uuids, REBUILD_SEND_LIMIT);
-	if (uuids == NULL)
-		D_GOTO(out, rc = -DER_NOMEM);
+	D_ALLOC_ARRAY(arg->oids, REBUILD_SEND_LIMIT);
+	D_ALLOC_ARRAY(arg->uuids, REBUILD_SEND_LIMIT);
+	D_ALLOC_ARRAY(arg->shards, REBUILD_SEND_LIMIT);
+	D_ALLOC_ARRAY(arg->ephs, REBUILD_SEND_LIMIT);
+	if (arg->oids == NULL || arg->uuids == NULL || arg->shards == NULL ||
+	    arg->ephs == NULL) {
+		rebuild_send_arg_free(arg);
+		return -DER_NOMEM;
+	}
 
-	D_ALLOC_ARRAY(shards, REBUILD_SEND_LIMIT);
-	if (shards == NULL)
-		D_GOTO(out, rc = -DER_NOMEM);
+	*argp = arg;
+	return 0;
+}
 
-	D_ALLOC_ARRAY(ephs, REBUILD_SEND_LIMIT);
-	if (ephs == NULL)
-		D_GOTO(out, rc = -DER_NOMEM);
+/**
+ * Move up to REBUILD_SEND_LIMIT objects from the target tree @root into the
+ * batch @arg. The caller must serialize against the scanners inserting into
+ * the same tree.
+ */
+static int
+rebuild_objects_fill(struct rebuild_root *root, struct rebuild_send_arg *arg)
+{
+	int rc;
 
 	arg->tgt_root = root;
 	arg->count = 0;
-	arg->oids = oids;
-	arg->uuids = uuids;
-	arg->shards = shards;
-	arg->ephs = ephs;
-
 	while (!dbtree_is_empty(root->root_hdl)) {
 		rc = dbtree_iterate(root->root_hdl, DAOS_INTENT_REBUILD, false,
 				    rebuild_cont_iter_cb, arg);
 		if (rc < 0)
-			D_GOTO(out, rc);
+			return rc;
 
 		if (arg->count >= REBUILD_SEND_LIMIT)
 			break;
 	}
 
+	return 0;
+}
+
+/**
+ * Send the objects of the batch @arg to the target. It does not touch the
+ * rebuild tree, so it must be called without scan_lock, otherwise all of
+ * scanners would be blocked by the RPC and its retries. The puller returns
+ * -DER_AGAIN if it is not ready, and the caller keeps retrying, which also
+ * throttles the scanner of the current xstream.
+ */
+static int
+rebuild_objects_send(struct rebuild_send_arg *arg, unsigned int tgt_id,
+		     struct rebuild_scan_arg *scan_arg)
+{
+	struct rebuild_in	*rebuild_in = NULL;
+	struct rebuild_out	*rebuild_out = NULL;
+	struct rebuild_tgt_pool_tracker	*rpt = scan_arg->rpt;
+	struct pool_target	*target;
+	crt_rpc_t		*rpc = NULL;
+	crt_endpoint_t		tgt_ep = {0};
+	int			rc = 0;
+
 	if (arg->count == 0)
-		D_GOTO(out, rc);
+		return 0;
 
 	if (daos_fail_check(DAOS_REBUILD_TGT_SEND_OBJS_FAIL))
-		D_GOTO(out, rc = 0);
+		return 0;
 
 	D_DEBUG(DB_REBUILD, "send rebuild objects "DF_UUID" to tgt %d"
 		" cnt %d\n", DP_UUID(rpt->rt_pool_uuid), tgt_id, arg->count);
@@ -227,13 +260,13 @@ rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
 		rebuild_in = crt_req_get(rpc);
 		rebuild_in->roi_rebuild_ver = rpt->rt_rebuild_ver;
 		rebuild_in->roi_oids.ca_count = arg->count;
-		rebuild_in->roi_oids.ca_arrays = oids;
+		rebuild_in->roi_oids.ca_arrays = arg->oids;
 		rebuild_in->roi_ephs.ca_count = arg->count;
-		rebuild_in->roi_ephs.ca_arrays = ephs;
+		rebuild_in->roi_ephs.ca_arrays = arg->ephs;
 		rebuild_in->roi_uuids.ca_count = arg->count;
-		rebuild_in->roi_uuids.ca_arrays = uuids;
+		rebuild_in->roi_uuids.ca_arrays = arg->uuids;
 		rebuild_in->roi_shards.ca_count = arg->count;
-		rebuild_in->roi_shards.ca_arrays = shards;
+		rebuild_in->roi_shards.ca_arrays = arg->shards;
 		uuid_copy(rebuild_in->roi_pool_uuid, rpt->rt_pool_uuid);
 		rebuild_in->roi_tgt_idx = target->ta_comp.co_index;
 
@@ -290,16 +323,6 @@ rebuild_objects_send(struct rebuild_root *root, unsigned int tgt_id,
 out:
 	if (rpc)
 		crt_req_decref(rpc);
-	if (oids != NULL)
-		D_FREE(oids);
-	if (uuids != NULL)
-		D_FREE(uuids);
-	if (shards != NULL)
-		D_FREE(shards);
-	if (ephs != NULL)
-		D_FREE(ephs);
-	if (arg != NULL)
-		D_FREE(arg);
 
 	return rc;
 }
@@ -316,13 +339,28 @@ rebuild_tgt_fini_obj_send_cb(daos_handle_t ih, d_iov_t *key_iov,
 	tgt_id = *((unsigned int *)key_iov->iov_buf);
 	root = val_iov->iov_buf;
 
-	/* This is called when scanning is done, so the objects
-	 * under each target should less than LIMIT. And also
-	 * only 1 thread accessing the tree, so no need lock.
+	/* This is called when scanning is done, so only 1 thread is
+	 * accessing the tree, no need lock.
 	 **/
-	rc = rebuild_objects_send(root, tgt_id, arg);
-	if (rc < 0)
-		return rc;
+	if (!dbtree_is_empty(root->root_hdl)) {
+		struct rebuild_send_arg *send_arg;
+
+		rc = rebuild_send_arg_alloc(&send_arg);
+		if (rc)
+			return rc;
+
+		while (!dbtree_is_empty(root->root_hdl)) {
+			rc = rebuild_objects_fill(root, send_arg);
+			if (rc == 0)
+				rc = rebuild_objects_send(send_arg, tgt_id,
+							  arg);
+			if (rc < 0)
+				break;
+		}
+		rebuild_send_arg_free(send_arg);
+		if (rc < 0)
+			return rc;
+	}
 
 	rc = dbtree_destroy(root->root_hdl);
 	if (rc)
@@ -502,6 +540,7 @@ rebuild_object_insert(struct rebuild_scan_arg *arg, unsigned int tgt_id,
 	d_iov_t		key_iov;
 	d_iov_t		val_iov;
 	struct rebuild_root	*tgt_root;
+	struct rebuild_send_arg	*send_arg = NULL;
 	daos_handle_t		toh = arg->rebuild_tree_hdl;
 	int			rc;
 
@@ -529,19 +568,25 @@ rebuild_object_insert(struct rebuild_scan_arg *arg, unsigned int tgt_id,
 		D_GOTO(out, rc);
 	}
 
-	if (rc == 1) {
-		/* Check if we need send the object list */
-		if (++tgt_root->count >= REBUILD_SEND_LIMIT) {
-			rc = rebuild_objects_send(tgt_root, tgt_id, arg);
-			if (rc < 0)
-				D_GOTO(out, rc);
-		}
+	/* Detach the object list once it is full, and send it after
+	 * releasing the lock, so other scanners can go on meanwhile.
+	 */
+	if (++tgt_root->count >= REBUILD_SEND_LIMIT) {
+		rc = rebuild_send_arg_alloc(&send_arg);
+		if (rc == 0)
+			rc = rebuild_objects_fill(tgt_root, send_arg);
+	} else {
 		rc = 0;
 	}
-	ABT_mutex_unlock(arg->scan_lock);
-
 	D_DEBUG(DB_REBUILD, "insert "DF_UOID"/"DF_UUID" tgt %u cnt %d rc %d\n",
 		DP_UOID(oid), DP_UUID(co_uuid), tgt_id, tgt_root->count, rc);
+	ABT_mutex_unlock(arg->scan_lock);
+
+	if (send_arg != NULL) {
+		if (rc == 0)
+			rc = rebuild_objects_send(send_arg, tgt_id, arg);
+		rebuild_send_arg_free(send_arg);
+	}
 out:
 	return rc;
 }
@@ -86,6 +86,8 @@ bool			 ts_nest_iterator;
 bool			ts_rebuild_only_iteration = false;
 /* rebuild without update */
 bool			ts_rebuild_no_update = false;
+/* rebuild pull budget of each target in MiB/sec, 0 is unlimited */
+unsigned int		ts_rebuild_bw;
 
 static int
 vos_update_or_fetch(enum ts_op_type op_type, struct dts_io_credit *cred,
@@ -681,6 +683,10 @@ ts_rebuild_perf(double *start_time, double *end_time)
 				     DAOS_REBUILD_NO_UPDATE,
 				     0, NULL);
 
+	if (ts_rebuild_bw != 0)
+		daos_mgmt_set_params(NULL, -1, DSS_REBUILD_PULL_BW,
+				     ts_rebuild_bw, 0, NULL);
+
 	rc = ts_exclude_server(RANK_ZERO);
 	if (rc)
 		return rc;
@@ -692,6 +698,9 @@ ts_rebuild_perf(double *start_time, double *end_time)
 	rc = ts_add_server(RANK_ZERO);
 
 	daos_mgmt_set_params(NULL, -1, DSS_KEY_FAIL_LOC, 0, 0, NULL);
+	if (ts_rebuild_bw != 0)
+		daos_mgmt_set_params(NULL, -1, DSS_REBUILD_PULL_BW, 0, 0,
+				     NULL);
 
 	return rc;
 }
@@ -838,6 +847,10 @@ The options are as follows:\n\
 \n\
 -R	Only run rebuild performance test.\n\
 \n\
+-m number\n\
+	Rebuild pull bandwidth budget of each target in MiB/sec, it is only\n\
+	used by the rebuild test. The default value is 0 (unlimited).\n\
+\n\
 -B	Profile performance of both update and fetch.\n\
 \n\
 -I	Only run iterate performance test. Only runs in vos mode.\n\
@@ -870,6 +883,7 @@ static struct option ts_ops[] = {
 	{ "help",	no_argument,		NULL,	'h' },
 	{ "verify",	no_argument,		NULL,	'v' },
 	{ "wait",	no_argument,		NULL,	'w' },
+	{ "rebuild_bw",	required_argument,	NULL,	'm' },
 	{ NULL,		0,			NULL,	0   },
 };
 
@@ -981,7 +995,7 @@ main(int argc, char **argv)
 
 	memset(ts_pmem_file, 0, sizeof(ts_pmem_file));
 	while ((rc = getopt_long(argc, argv,
-				 "P:N:T:C:c:o:d:a:r:nAs:ztf:hUFRBvIiuw",
+				 "P:N:T:C:c:o:d:a:r:nAs:ztf:hUFRBvIiuwm:",
 				 ts_ops, NULL)) != -1) {
 		char	*endp;
 
@@ -1099,6 +1113,9 @@ main(int argc, char **argv)
 		case 'u':
 			ts_rebuild_no_update = true;
 			break;
+		case 'm':
+			ts_rebuild_bw = strtoul(optarg, NULL, 0);
+			break;
 		case 'B':
 			perf_tests[UPDATE_FETCH_TEST] = ts_update_fetch_perf;
 			break;
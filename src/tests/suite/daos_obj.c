@@ -3568,6 +3568,411 @@ io_capa_iv_fetch(void **state)
 	ioreq_fini(&req);
 }
 
+#define IO_COMBINE_NR	64
+
+/** small updates through a write-combining handle */
+static void
+io_combine(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	daos_handle_t	 oh;
+	d_iov_t		 dkey;
+	d_sg_list_t	 sgl;
+	d_iov_t		 sg_iov;
+	daos_iod_t	 iod;
+	daos_recx_t	 recx;
+	char		 akey[16];
+	char		 buf[IO_COMBINE_NR];
+	uint64_t	 val;
+	int		 i;
+	int		 rc;
+
+	oid = dts_oid_gen(dts_obj_class, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW | DAOS_OO_IO_COMBINE,
+			   &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	sgl.sg_nr	= 1;
+	sgl.sg_nr_out	= 0;
+	sgl.sg_iovs	= &sg_iov;
+	daos_csum_set(&iod.iod_kcsum, NULL, 0);
+	iod.iod_eprs	= NULL;
+	iod.iod_csums	= NULL;
+
+	print_message("buffer %d single values and array appends\n",
+		      IO_COMBINE_NR);
+	for (i = 0; i < IO_COMBINE_NR; i++) {
+		sprintf(akey, "akey%d", i);
+		d_iov_set(&iod.iod_name, akey, strlen(akey));
+		iod.iod_type	= DAOS_IOD_SINGLE;
+		iod.iod_size	= sizeof(val);
+		iod.iod_nr	= 1;
+		iod.iod_recxs	= NULL;
+		val = i;
+		d_iov_set(&sg_iov, &val, sizeof(val));
+		rc = daos_obj_update(oh, DAOS_TX_NONE, &dkey, 1, &iod, &sgl,
+				     NULL);
+		assert_int_equal(rc, 0);
+
+		d_iov_set(&iod.iod_name, "array", strlen("array"));
+		iod.iod_type	= DAOS_IOD_ARRAY;
+		iod.iod_size	= 1;
+		iod.iod_recxs	= &recx;
+		recx.rx_idx	= i;
+		recx.rx_nr	= 1;
+		buf[0] = 'a' + i % 26;
+		d_iov_set(&sg_iov, buf, 1);
+		rc = daos_obj_update(oh, DAOS_TX_NONE, &dkey, 1, &iod, &sgl,
+				     NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	/** the fetch is ordered after the buffered updates */
+	print_message("fetch through the combining handle\n");
+	memset(buf, 0, sizeof(buf));
+	recx.rx_idx	= 0;
+	recx.rx_nr	= IO_COMBINE_NR;
+	d_iov_set(&sg_iov, buf, sizeof(buf));
+	rc = daos_obj_fetch(oh, DAOS_TX_NONE, &dkey, 1, &iod, &sgl, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < IO_COMBINE_NR; i++)
+		assert_int_equal(buf[i], 'a' + i % 26);
+
+	print_message("overwrite single values, flush and close\n");
+	for (i = 0; i < IO_COMBINE_NR; i++) {
+		sprintf(akey, "akey%d", i);
+		d_iov_set(&iod.iod_name, akey, strlen(akey));
+		iod.iod_type	= DAOS_IOD_SINGLE;
+		iod.iod_size	= sizeof(val);
+		iod.iod_recxs	= NULL;
+		iod.iod_nr	= 1;
+		val = i * 2;
+		d_iov_set(&sg_iov, &val, sizeof(val));
+		rc = daos_obj_update(oh, DAOS_TX_NONE, &dkey, 1, &iod, &sgl,
+				     NULL);
+		assert_int_equal(rc, 0);
+		if (i == IO_COMBINE_NR / 2) {
+			rc = daos_obj_flush(oh, NULL);
+			assert_int_equal(rc, 0);
+		}
+	}
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("verify through a plain handle\n");
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < IO_COMBINE_NR; i++) {
+		sprintf(akey, "akey%d", i);
+		d_iov_set(&iod.iod_name, akey, strlen(akey));
+		iod.iod_size	= DAOS_REC_ANY;
+		val = 0;
+		d_iov_set(&sg_iov, &val, sizeof(val));
+		rc = daos_obj_fetch(oh, DAOS_TX_NONE, &dkey, 1, &iod, &sgl,
+				    NULL, NULL);
+		assert_int_equal(rc, 0);
+		assert_int_equal(val, i * 2);
+	}
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	print_message("all good\n");
+}
+
+/** a single value update or fetch of the write-combining tests */
+struct io_combine_req {
+	daos_event_t	ev;
+	d_iov_t		dkey;
+	daos_iod_t	iod;
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iov;
+	char		akey[16];
+	uint64_t	val;
+};
+
+static void
+io_combine_req_init(struct io_combine_req *req, const char *akey,
+		    uint64_t val)
+{
+	memset(req, 0, sizeof(*req));
+	d_iov_set(&req->dkey, "dkey", strlen("dkey"));
+	strncpy(req->akey, akey, sizeof(req->akey) - 1);
+	d_iov_set(&req->iod.iod_name, req->akey, strlen(req->akey));
+	req->iod.iod_type	= DAOS_IOD_SINGLE;
+	req->iod.iod_size	= sizeof(req->val);
+	req->iod.iod_nr		= 1;
+	req->val		= val;
+	d_iov_set(&req->sg_iov, &req->val, sizeof(req->val));
+	req->sgl.sg_nr		= 1;
+	req->sgl.sg_iovs	= &req->sg_iov;
+}
+
+/** update \a akey through the event queue \a eq, or blocking */
+static void
+io_combine_update(daos_handle_t oh, daos_handle_t eq,
+		  struct io_combine_req *req, const char *akey, uint64_t val)
+{
+	int	rc;
+
+	io_combine_req_init(req, akey, val);
+	if (!daos_handle_is_inval(eq)) {
+		rc = daos_event_init(&req->ev, eq, NULL);
+		assert_int_equal(rc, 0);
+	}
+	rc = daos_obj_update(oh, DAOS_TX_NONE, &req->dkey, 1, &req->iod,
+			     &req->sgl, daos_handle_is_inval(eq) ?
+			     NULL : &req->ev);
+	assert_int_equal(rc, 0);
+}
+
+/** blocking fetch of \a akey, return its size, which is 0 if not found */
+static daos_size_t
+io_combine_lookup(daos_handle_t oh, const char *akey, uint64_t *val)
+{
+	struct io_combine_req	req;
+	int			rc;
+
+	io_combine_req_init(&req, akey, 0);
+	req.iod.iod_size = DAOS_REC_ANY;
+	rc = daos_obj_fetch(oh, DAOS_TX_NONE, &req.dkey, 1, &req.iod,
+			    val == NULL ? NULL : &req.sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	if (val != NULL)
+		*val = req.val;
+	return req.iod.iod_size;
+}
+
+/** wait until a flush issued in background makes \a akey visible */
+static void
+io_combine_wait_flushed(daos_handle_t oh, const char *akey)
+{
+	int	i;
+
+	for (i = 0; i < 1000; i++) {
+		if (io_combine_lookup(oh, akey, NULL) != 0)
+			return;
+		usleep(1000);
+	}
+	print_message("%s has not been flushed\n", akey);
+	assert_true(false);
+}
+
+/** reap \a nr events from \a eq, all of them are expected to return \a rc */
+static void
+io_combine_eq_reap(daos_handle_t eq, int nr, int rc)
+{
+	daos_event_t	*evp;
+
+	while (nr-- > 0) {
+		assert_int_equal(daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp),
+				 1);
+		assert_int_equal(evp->ev_error, rc);
+		daos_event_fini(evp);
+	}
+}
+
+#define IO_COMBINE_EQ_NR	2
+
+/** updates combined through a handle shared by several event queues */
+static void
+io_combine_eqs(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct io_combine_req	 reqs[IO_COMBINE_NR];
+	struct io_combine_req	 flush;
+	daos_handle_t		 eqs[IO_COMBINE_EQ_NR];
+	daos_handle_t		 oh;
+	daos_handle_t		 ph;
+	daos_obj_id_t		 oid;
+	uint64_t		 val;
+	int			 i;
+	int			 rc;
+
+	oid = dts_oid_gen(dts_obj_class, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW | DAOS_OO_IO_COMBINE,
+			   &oh, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &ph, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < IO_COMBINE_EQ_NR; i++) {
+		rc = daos_eq_create(&eqs[i]);
+		assert_int_equal(rc, 0);
+	}
+
+	print_message("async update, then blocking fetch before polling\n");
+	io_combine_update(oh, eqs[0], &reqs[0], "akey", 1);
+	assert_int_equal(io_combine_lookup(oh, "akey", &val), sizeof(val));
+	assert_int_equal(val, 1);
+	io_combine_eq_reap(eqs[0], 1, 0);
+
+	/* each update conflicts with the buffered one and flushes it */
+	print_message("overwrite through %d event queues\n", IO_COMBINE_EQ_NR);
+	for (i = 0; i < IO_COMBINE_NR; i++)
+		io_combine_update(oh, eqs[i % IO_COMBINE_EQ_NR], &reqs[i],
+				  "akey", i + 2);
+	assert_int_equal(io_combine_lookup(oh, "akey", &val), sizeof(val));
+	assert_int_equal(val, IO_COMBINE_NR + 1);
+	for (i = 0; i < IO_COMBINE_EQ_NR; i++)
+		io_combine_eq_reap(eqs[i], IO_COMBINE_NR / IO_COMBINE_EQ_NR,
+				   0);
+
+	print_message("update through one queue, flush through another\n");
+	for (i = 0; i < IO_COMBINE_NR; i++)
+		io_combine_update(oh, eqs[0], &reqs[i], "akey", i);
+	rc = daos_event_init(&flush.ev, eqs[1], NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_obj_flush(oh, &flush.ev);
+	assert_int_equal(rc, 0);
+	io_combine_eq_reap(eqs[1], 1, 0);
+	assert_int_equal(io_combine_lookup(ph, "akey", &val), sizeof(val));
+	assert_int_equal(val, IO_COMBINE_NR - 1);
+	io_combine_eq_reap(eqs[0], IO_COMBINE_NR, 0);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_obj_close(ph, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < IO_COMBINE_EQ_NR; i++) {
+		rc = daos_eq_destroy(eqs[i], 0);
+		assert_int_equal(rc, 0);
+	}
+	print_message("all good\n");
+}
+
+/** the update size which still can be buffered, see OBJ_WCOMB_IO_MAX */
+#define IO_COMBINE_IO_MAX	(4 << 10)
+/** default buffer size and age, DAOS_IO_COMBINE_SIZE/USEC */
+#define IO_COMBINE_SIZE		(64 << 10)
+#define IO_COMBINE_USEC		1000
+
+/** flushes triggered by conflicting, stale and accumulated updates */
+static void
+io_combine_triggers(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct io_combine_req	 req;
+	daos_handle_t		 oh;
+	daos_handle_t		 ph;
+	daos_obj_id_t		 oid;
+	daos_recx_t		 recx;
+	char			 akey[16];
+	char			 buf[IO_COMBINE_IO_MAX];
+	int			 nr;
+	int			 i;
+	int			 rc;
+
+	if (getenv("DAOS_IO_COMBINE_SIZE") != NULL ||
+	    getenv("DAOS_IO_COMBINE_USEC") != NULL) {
+		print_message("non-default thresholds, skip the test\n");
+		skip();
+	}
+
+	oid = dts_oid_gen(dts_obj_class, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW | DAOS_OO_IO_COMBINE,
+			   &oh, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &ph, NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("overlapped array updates are flushed in order\n");
+	io_combine_req_init(&req, "array", 0);
+	req.iod.iod_type	= DAOS_IOD_ARRAY;
+	req.iod.iod_size	= 1;
+	req.iod.iod_recxs	= &recx;
+	recx.rx_nr		= 4;
+	for (i = 0; i < 2; i++) {
+		recx.rx_idx = i * 2;
+		memset(buf, 'a' + i, recx.rx_nr);
+		d_iov_set(&req.sg_iov, buf, recx.rx_nr);
+		rc = daos_obj_update(oh, DAOS_TX_NONE, &req.dkey, 1, &req.iod,
+				     &req.sgl, NULL);
+		assert_int_equal(rc, 0);
+	}
+	recx.rx_idx	= 0;
+	recx.rx_nr	= 6;
+	memset(buf, 0, recx.rx_nr);
+	d_iov_set(&req.sg_iov, buf, recx.rx_nr);
+	rc = daos_obj_fetch(oh, DAOS_TX_NONE, &req.dkey, 1, &req.iod,
+			    &req.sgl, NULL, NULL);
+	assert_int_equal(rc, 0);
+	assert_memory_equal(buf, "aabbbb", recx.rx_nr);
+
+	print_message("a stale buffer is flushed by the next update\n");
+	io_combine_update(oh, DAOS_HDL_INVAL, &req, "age0", 1);
+	usleep(IO_COMBINE_USEC * 10);
+	io_combine_update(oh, DAOS_HDL_INVAL, &req, "age1", 2);
+	io_combine_wait_flushed(ph, "age0");
+	assert_int_equal(io_combine_lookup(ph, "age1", NULL), 0);
+
+	print_message("a full buffer is flushed\n");
+	nr = IO_COMBINE_SIZE / IO_COMBINE_IO_MAX + 2;
+	memset(buf, 'x', sizeof(buf));
+	for (i = 0; i < nr; i++) {
+		sprintf(akey, "size%d", i);
+		io_combine_req_init(&req, akey, 0);
+		req.iod.iod_size = sizeof(buf);
+		d_iov_set(&req.sg_iov, buf, sizeof(buf));
+		rc = daos_obj_update(oh, DAOS_TX_NONE, &req.dkey, 1, &req.iod,
+				     &req.sgl, NULL);
+		assert_int_equal(rc, 0);
+	}
+	io_combine_wait_flushed(ph, "size0");
+	assert_int_equal(io_combine_lookup(ph, akey, NULL), 0);
+
+	print_message("close flushes the rest\n");
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(io_combine_lookup(ph, "age1", NULL), sizeof(uint64_t));
+	assert_int_equal(io_combine_lookup(ph, akey, NULL), sizeof(buf));
+	rc = daos_obj_close(ph, NULL);
+	assert_int_equal(rc, 0);
+	print_message("all good\n");
+}
+
+/** a failed flush is reported by the next daos_obj_flush() */
+static void
+io_combine_flush_error(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct io_combine_req	 req;
+	struct io_combine_req	 flush;
+	daos_handle_t		 oh;
+	daos_obj_id_t		 oid;
+	int			 rc;
+
+	oid = dts_oid_gen(dts_obj_class, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW | DAOS_OO_IO_COMBINE,
+			   &oh, NULL);
+	assert_int_equal(rc, 0);
+
+	daos_fail_loc_set(DAOS_OBJ_UPDATE_NOSPACE | DAOS_FAIL_ALWAYS);
+
+	print_message("blocking flush of a failing update\n");
+	io_combine_update(oh, DAOS_HDL_INVAL, &req, "akey", 1);
+	rc = daos_obj_flush(oh, NULL);
+	assert_int_equal(rc, -DER_NOSPACE);
+
+	print_message("async flush of a failing update\n");
+	io_combine_update(oh, DAOS_HDL_INVAL, &req, "akey", 2);
+	rc = daos_event_init(&flush.ev, arg->eq, NULL);
+	assert_int_equal(rc, 0);
+	rc = daos_obj_flush(oh, &flush.ev);
+	assert_int_equal(rc, 0);
+	io_combine_eq_reap(arg->eq, 1, -DER_NOSPACE);
+
+	daos_fail_loc_set(0);
+
+	print_message("the error is reported once\n");
+	rc = daos_obj_flush(oh, NULL);
+	assert_int_equal(rc, 0);
+	io_combine_update(oh, DAOS_HDL_INVAL, &req, "akey", 3);
+	rc = daos_obj_close(oh, NULL);
+	assert_int_equal(rc, 0);
+	print_message("all good\n");
+}
+
 static const struct CMUnitTest io_tests[] = {
 	{ "IO1: simple update/fetch/verify",
 	  io_simple, async_disable, test_case_teardown},
@@ -3644,6 +4049,14 @@ static const struct CMUnitTest io_tests[] = {
 	  fetch_mixed_keys, async_disable, test_case_teardown},
 	{ "IO38: force capablity IV fetch",
 	  io_capa_iv_fetch, async_disable, test_case_teardown},
+	{ "IO39: combine small updates",
+	  io_combine, async_disable, test_case_teardown},
+	{ "IO40: combine updates of several event queues",
+	  io_combine_eqs, async_disable, test_case_teardown},
+	{ "IO41: combine flush on conflict, age and size",
+	  io_combine_triggers, async_disable, test_case_teardown},
+	{ "IO42: combine flush error",
+	  io_combine_flush_error, async_enable, test_case_teardown},
 };
 
 int
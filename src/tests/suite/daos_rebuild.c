@@ -1819,6 +1819,60 @@ multi_pools_rebuild_concurrently(void **state)
 	rebuild_add_back_tgts(&arg, 1, &ranks_to_kill[0], NULL, 1);
 }
 
+#define EC_SRV_DATA_SIZE	(4 << 15)
+
+/**
+ * Write two full stripes through a class encoded by the leader server, and
+ * read them back after the server of a parity shard is excluded.
+ */
+static void
+rebuild_ec_srv_encode_parity(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		 oid;
+	struct ioreq		 req;
+	struct daos_obj_layout	*layout;
+	d_rank_t		 rank;
+	char			*data;
+	char			*fetch;
+	int			 i;
+
+	if (!test_runable(arg, 3))
+		return;
+
+	oid = dts_oid_gen(DAOS_OC_EC_K2P1_SRV_L32K, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_ARRAY, arg);
+
+	D_ALLOC(data, EC_SRV_DATA_SIZE);
+	assert_non_null(data);
+	D_ALLOC(fetch, EC_SRV_DATA_SIZE);
+	assert_non_null(fetch);
+	for (i = 0; i < EC_SRV_DATA_SIZE; i++)
+		data[i] = rand();
+
+	print_message("Insert %d bytes in object "DF_OID"\n",
+		      EC_SRV_DATA_SIZE, DP_OID(oid));
+	insert_single_with_rxnr("ec_dkey", "ec_akey", 0, data, 1,
+				EC_SRV_DATA_SIZE, DAOS_TX_NONE, &req);
+
+	/* the first p shards of the group hold the parity */
+	daos_obj_layout_get(arg->coh, oid, &layout);
+	rank = layout->ol_shards[0]->os_ranks[0];
+	daos_obj_layout_free(layout);
+
+	rebuild_single_pool_rank(arg, rank);
+
+	lookup_single_with_rxnr("ec_dkey", "ec_akey", 0, fetch, 1,
+				EC_SRV_DATA_SIZE, DAOS_TX_NONE, &req);
+	assert_memory_equal(data, fetch, EC_SRV_DATA_SIZE);
+
+	ioreq_fini(&req);
+	D_FREE(fetch);
+	D_FREE(data);
+
+	rebuild_add_back_tgts(&arg, 1, &rank, NULL, 1);
+}
+
 /** create a new pool/container for each test */
 static const struct CMUnitTest rebuild_tests[] = {
 	{"REBUILD1: rebuild small rec mulitple dkeys",
@@ -1889,6 +1943,8 @@ static const struct CMUnitTest rebuild_tests[] = {
 	 rebuild_fail_all_replicas_before_rebuild, NULL, test_case_teardown},
 	{"REBUILD34: rebuild fail all replicas",
 	 rebuild_fail_all_replicas, NULL, test_case_teardown},
+	{"REBUILD35: read server encoded EC object without parity shard",
+	 rebuild_ec_srv_encode_parity, NULL, test_case_teardown},
 };
 
 int
@@ -24,6 +24,9 @@
 
 #include "evt_priv.h"
 #include "vos_internal.h"
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
 
 #ifdef VOS_TRACE
 #define V_TRACE(...) D_DEBUG(__VA_ARGS__)
@@ -116,6 +119,247 @@ evt_rect_overlap(const struct evt_rect *rt1, const struct evt_rect *rt2,
 		*range = RT_OVERLAP_PARTIAL;
 }
 
+/**
+ * Bounds for scanning all entries of a tree node in one pass. They combine
+ * the searching rectangle and the optional filter, an entry is a candidate
+ * of the search only if all of them are satisfied.
+ */
+struct evt_scan_bound {
+	/** the maximum low offset of a candidate */
+	daos_off_t		sb_lo_max;
+	/** the minimum high offset of a candidate */
+	daos_off_t		sb_hi_min;
+	/** the maximum epoch of a candidate */
+	daos_epoch_t		sb_epc_max;
+	/** the minimum epoch of a candidate, only applies to leaf entries */
+	daos_epoch_t		sb_epc_min;
+};
+
+/** Number of words of the bitmap which has one bit for each node entry */
+#define EVT_SCAN_WORDS		(EVT_ORDER_MAX / 64)
+
+/* The SIMD kernels below load a whole entry as four 64-bit lanes */
+D_CASSERT(sizeof(struct evt_node_entry) == 4 * sizeof(uint64_t));
+D_CASSERT(offsetof(struct evt_node_entry, ne_rect) == 0);
+
+/**
+ * Initialize the scan bounds, it is equivalent to checking each in-tree
+ * rectangle with evt_filter_rect() and then with evt_rect_overlap(), and
+ * only accepting range overlap and RT_OVERLAP_OVER/RT_OVERLAP_SAME time
+ * overlap.
+ */
+static void
+evt_scan_bound_init(struct evt_scan_bound *sb, const struct evt_filter *filter,
+		    const struct evt_rect *rect, bool leaf)
+{
+	sb->sb_lo_max	= rect->rc_ex.ex_hi;
+	sb->sb_hi_min	= rect->rc_ex.ex_lo;
+	sb->sb_epc_max	= rect->rc_epc;
+	sb->sb_epc_min	= 0;
+
+	if (filter == NULL)
+		return;
+
+	sb->sb_lo_max = min(sb->sb_lo_max, filter->fr_ex.ex_hi);
+	sb->sb_hi_min = max(sb->sb_hi_min, filter->fr_ex.ex_lo);
+	sb->sb_epc_max = min(sb->sb_epc_max, filter->fr_epr.epr_hi);
+	/* See evt_filter_rect(), the lower epoch bound can only be applied
+	 * to leaf records.
+	 */
+	if (leaf)
+		sb->sb_epc_min = filter->fr_epr.epr_lo;
+}
+
+/** Branch free check of entries [\a at, \a nr), it can be vectorized */
+static inline void
+evt_node_scan_scalar(const struct evt_node_entry *ne, unsigned int at,
+		     unsigned int nr, const struct evt_scan_bound *sb,
+		     uint64_t *bmap)
+{
+	unsigned int	i;
+
+	for (i = at; i < nr; i++) {
+		const struct evt_rect	*rt = &ne[i].ne_rect;
+		uint64_t		 hit;
+
+		hit = (rt->rc_ex.ex_lo <= sb->sb_lo_max) &
+		      (rt->rc_ex.ex_hi >= sb->sb_hi_min) &
+		      (rt->rc_epc <= sb->sb_epc_max) &
+		      (rt->rc_epc >= sb->sb_epc_min);
+		bmap[i >> 6] |= hit << (i & 63);
+	}
+}
+
+#if defined(__AVX2__)
+/** flip the sign bit, so signed comparison can be used for unsigned values */
+#define EVT_SCAN_SIGN		0x8000000000000000ULL
+
+/**
+ * Check four entries starting from \a ne, returns a 4-bit mask of the
+ * candidates.
+ */
+static inline unsigned int
+evt_node_scan_avx2(const struct evt_node_entry *ne, __m256i lo_max,
+		   __m256i hi_min, __m256i epc_max, __m256i epc_min)
+{
+	__m256i	sign = _mm256_set1_epi64x(EVT_SCAN_SIGN);
+	__m256i	e0 = _mm256_loadu_si256((const __m256i *)&ne[0]);
+	__m256i	e1 = _mm256_loadu_si256((const __m256i *)&ne[1]);
+	__m256i	e2 = _mm256_loadu_si256((const __m256i *)&ne[2]);
+	__m256i	e3 = _mm256_loadu_si256((const __m256i *)&ne[3]);
+	__m256i	t0;
+	__m256i	t1;
+	__m256i	t2;
+	__m256i	t3;
+	__m256i	lo;
+	__m256i	hi;
+	__m256i	epc;
+	__m256i	miss;
+
+	/* Transpose entries {lo, hi, epc, child} to lanes of lo/hi/epc */
+	t0 = _mm256_unpacklo_epi64(e0, e1);	/* lo0 lo1 epc0 epc1 */
+	t1 = _mm256_unpackhi_epi64(e0, e1);	/* hi0 hi1 chd0 chd1 */
+	t2 = _mm256_unpacklo_epi64(e2, e3);	/* lo2 lo3 epc2 epc3 */
+	t3 = _mm256_unpackhi_epi64(e2, e3);	/* hi2 hi3 chd2 chd3 */
+
+	lo  = _mm256_permute2x128_si256(t0, t2, 0x20);
+	epc = _mm256_permute2x128_si256(t0, t2, 0x31);
+	hi  = _mm256_permute2x128_si256(t1, t3, 0x20);
+
+	lo  = _mm256_xor_si256(lo, sign);
+	hi  = _mm256_xor_si256(hi, sign);
+	epc = _mm256_xor_si256(epc, sign);
+
+	miss = _mm256_or_si256(_mm256_cmpgt_epi64(lo, lo_max),
+			       _mm256_cmpgt_epi64(hi_min, hi));
+	miss = _mm256_or_si256(miss, _mm256_cmpgt_epi64(epc, epc_max));
+	miss = _mm256_or_si256(miss, _mm256_cmpgt_epi64(epc_min, epc));
+
+	return ~_mm256_movemask_pd(_mm256_castsi256_pd(miss)) & 0xf;
+}
+#elif defined(__SSE4_2__)
+#define EVT_SCAN_SIGN		0x8000000000000000ULL
+
+/**
+ * Check two entries starting from \a ne, returns a 2-bit mask of the
+ * candidates.
+ */
+static inline unsigned int
+evt_node_scan_sse4(const struct evt_node_entry *ne, __m128i lo_max,
+		   __m128i hi_min, __m128i epc_max, __m128i epc_min)
+{
+	const __m128i	*p = (const __m128i *)ne;
+	__m128i		 sign = _mm_set1_epi64x(EVT_SCAN_SIGN);
+	__m128i		 r0 = _mm_loadu_si128(&p[0]);	/* lo0 hi0 */
+	__m128i		 r1 = _mm_loadu_si128(&p[2]);	/* lo1 hi1 */
+	__m128i		 lo;
+	__m128i		 hi;
+	__m128i		 epc;
+	__m128i		 miss;
+
+	lo  = _mm_xor_si128(_mm_unpacklo_epi64(r0, r1), sign);
+	hi  = _mm_xor_si128(_mm_unpackhi_epi64(r0, r1), sign);
+	epc = _mm_xor_si128(_mm_set_epi64x(ne[1].ne_rect.rc_epc,
+					   ne[0].ne_rect.rc_epc), sign);
+
+	miss = _mm_or_si128(_mm_cmpgt_epi64(lo, lo_max),
+			    _mm_cmpgt_epi64(hi_min, hi));
+	miss = _mm_or_si128(miss, _mm_cmpgt_epi64(epc, epc_max));
+	miss = _mm_or_si128(miss, _mm_cmpgt_epi64(epc_min, epc));
+
+	return ~_mm_movemask_pd(_mm_castsi128_pd(miss)) & 0x3;
+}
+#endif
+
+/**
+ * Scan entries [\a at, tn_nr) of the node \a node in one pass, and set a bit
+ * in \a bmap for each entry which satisfies \a sb. Bits of entries before
+ * \a at are always cleared.
+ */
+static void
+evt_node_scan(struct evt_context *tcx, struct evt_node *node, unsigned int at,
+	      const struct evt_scan_bound *sb, uint64_t *bmap)
+{
+	const struct evt_node_entry	*ne = evt_node_entry_at(tcx, node, 0);
+	unsigned int			 nr = node->tn_nr;
+	unsigned int			 i;
+
+	D_ASSERT(nr <= EVT_ORDER_MAX);
+	memset(bmap, 0, sizeof(*bmap) * EVT_SCAN_WORDS);
+	if (at >= nr)
+		return;
+
+#if defined(__AVX2__)
+	{
+		__m256i	sign = _mm256_set1_epi64x(EVT_SCAN_SIGN);
+		__m256i	lo_max = _mm256_xor_si256(sign,
+				_mm256_set1_epi64x(sb->sb_lo_max));
+		__m256i	hi_min = _mm256_xor_si256(sign,
+				_mm256_set1_epi64x(sb->sb_hi_min));
+		__m256i	epc_max = _mm256_xor_si256(sign,
+				_mm256_set1_epi64x(sb->sb_epc_max));
+		__m256i	epc_min = _mm256_xor_si256(sign,
+				_mm256_set1_epi64x(sb->sb_epc_min));
+
+		/* Start from a 4-aligned index, so the mask of four entries
+		 * never crosses a bitmap word, extra bits are cleared later.
+		 */
+		for (i = at & ~3U; i + 4 <= nr; i += 4) {
+			uint64_t mask;
+
+			mask = evt_node_scan_avx2(&ne[i], lo_max, hi_min,
+						  epc_max, epc_min);
+			bmap[i >> 6] |= mask << (i & 63);
+		}
+	}
+#elif defined(__SSE4_2__)
+	{
+		__m128i	sign = _mm_set1_epi64x(EVT_SCAN_SIGN);
+		__m128i	lo_max = _mm_xor_si128(sign,
+				_mm_set1_epi64x(sb->sb_lo_max));
+		__m128i	hi_min = _mm_xor_si128(sign,
+				_mm_set1_epi64x(sb->sb_hi_min));
+		__m128i	epc_max = _mm_xor_si128(sign,
+				_mm_set1_epi64x(sb->sb_epc_max));
+		__m128i	epc_min = _mm_xor_si128(sign,
+				_mm_set1_epi64x(sb->sb_epc_min));
+
+		for (i = at & ~1U; i + 2 <= nr; i += 2) {
+			uint64_t mask;
+
+			mask = evt_node_scan_sse4(&ne[i], lo_max, hi_min,
+						  epc_max, epc_min);
+			bmap[i >> 6] |= mask << (i & 63);
+		}
+	}
+#else
+	i = at;
+#endif
+	/* the scalar tail (or everything if there is no SIMD support) */
+	evt_node_scan_scalar(ne, i, nr, sb, bmap);
+
+	/* clear bits of entries before @at */
+	for (i = 0; i < (at >> 6); i++)
+		bmap[i] = 0;
+	if (at & 63)
+		bmap[at >> 6] &= ~((1ULL << (at & 63)) - 1);
+}
+
+/** Returns the first candidate at or after \a at, or \a nr if none */
+static inline unsigned int
+evt_scan_next(const uint64_t *bmap, unsigned int at, unsigned int nr)
+{
+	while (at < nr) {
+		uint64_t word = bmap[at >> 6] >> (at & 63);
+
+		if (word != 0)
+			return at + __builtin_ctzll(word);
+
+		at = (at | 63) + 1;
+	}
+	return nr;
+}
+
 /**
  * Calculate the Minimum Bounding Rectangle (MBR) of two rectangles and store
  * the MBR into the first rectangle \a rt1.
@@ -1322,6 +1566,30 @@ out:
 	return rc;
 }
 
+/**
+ * Set record size and checksum attributes of an empty tree from the first
+ * entry being inserted, the root should have been added to transaction.
+ */
+static void
+evt_root_attr_set(struct evt_context *tcx, const struct evt_entry_in *ent)
+{
+	struct evt_root		*root = tcx->tc_root;
+	const daos_csum_buf_t	*csum = &ent->ei_csum;
+
+	if (ent->ei_inob != 0)
+		tcx->tc_inob = root->tr_inob = ent->ei_inob;
+	if (daos_csum_isvalid(csum)) {
+		/**
+		 * csum len, type, and chunksize will be a configuration stored
+		 * in the container meta data. for now trust the entity checksum
+		 * to have correct values.
+		 */
+		root->tr_csum_len		= csum->cs_len;
+		root->tr_csum_type		= csum->cs_type;
+		root->tr_csum_chunk_size	= csum->cs_chunksize;
+	}
+}
+
 /**
  * Activate an empty tree by allocating a node for the root and set the
  * tree depth to one.
@@ -1334,8 +1602,6 @@ evt_root_activate(struct evt_context *tcx, const struct evt_entry_in *ent)
 	int			 rc;
 
 	root = tcx->tc_root;
-	uint32_t inob = ent->ei_inob;
-	const daos_csum_buf_t *csum = &ent->ei_csum;
 
 	D_ASSERT(root->tr_depth == 0);
 	D_ASSERT(UMOFF_IS_NULL(root->tr_node));
@@ -1351,18 +1617,7 @@ evt_root_activate(struct evt_context *tcx, const struct evt_entry_in *ent)
 
 	root->tr_node = nd_off;
 	root->tr_depth = 1;
-	if (inob != 0)
-		tcx->tc_inob = root->tr_inob = inob;
-	if (daos_csum_isvalid(csum)) {
-		/**
-		 * csum len, type, and chunksize will be a configuration stored
-		 * in the container meta data. for now trust the entity checksum
-		 * to have correct values.
-		 */
-		tcx->tc_root->tr_csum_len		= csum->cs_len;
-		tcx->tc_root->tr_csum_type		= csum->cs_type;
-		tcx->tc_root->tr_csum_chunk_size	= csum->cs_chunksize;
-	}
+	evt_root_attr_set(tcx, ent);
 
 	evt_tcx_set_dep(tcx, root->tr_depth);
 	evt_tcx_set_trace(tcx, 0, nd_off, 0);
@@ -1756,6 +2011,218 @@ out:
 	return evt_tx_end(tcx, rc);
 }
 
+/**
+ * Free a subtree built by bulk loading, it is only required if there is no
+ * transaction to roll back the allocations. The extents are owned by the
+ * caller, so only the descriptors and nodes are freed.
+ */
+static void
+evt_bulk_load_free(struct evt_context *tcx, umem_off_t nd_off)
+{
+	struct evt_node_entry	*ne;
+	struct evt_node		*nd;
+	struct evt_desc		*desc;
+	bool			 leaf;
+	int			 i;
+
+	nd = evt_off2node(tcx, nd_off);
+	leaf = evt_node_is_leaf(tcx, nd);
+	for (i = 0; i < nd->tn_nr; i++) {
+		ne = evt_node_entry_at(tcx, nd, i);
+		if (!leaf) {
+			evt_bulk_load_free(tcx, ne->ne_child);
+			continue;
+		}
+
+		if (UMOFF_IS_NULL(ne->ne_child))
+			continue;
+
+		desc = evt_off2desc(tcx, ne->ne_child);
+		vos_dtx_deregister_record(evt_umm(tcx), desc->dc_dtx,
+					  ne->ne_child, DTX_RT_EVT);
+		umem_free(evt_umm(tcx), ne->ne_child);
+	}
+	evt_node_free(tcx, nd_off);
+}
+
+/**
+ * Build one level of internal nodes on top of \a nr nodes in \a nodes, the
+ * children are evenly distributed over the minimum number of new nodes,
+ * which are stored in the head of \a nodes.
+ *
+ * On failure, the roots of all subtrees built so far are stored in the
+ * head of \a nodes, and \a nr is updated to the number of them, so the
+ * caller can free them.
+ *
+ * \return	0 on success, or negative error code.
+ */
+static int
+evt_bulk_load_level(struct evt_context *tcx, umem_off_t *nodes, int *nr)
+{
+	struct evt_node_entry	*ne;
+	struct evt_node		*nd;
+	umem_off_t		 nd_off;
+	int			 nd_nr;
+	int			 cnt;
+	int			 i;
+	int			 j;
+	int			 k;
+	int			 rc;
+
+	nd_nr = (*nr + tcx->tc_order - 1) / tcx->tc_order;
+	for (i = j = 0; i < nd_nr; i++, j += cnt) {
+		cnt = *nr / nd_nr + (i < *nr % nd_nr);
+		D_ASSERT(cnt >= 2 && cnt <= tcx->tc_order);
+
+		rc = evt_node_alloc(tcx, 0, &nd_off);
+		if (rc != 0) {
+			/* keep the new nodes and the unconsumed children */
+			memmove(&nodes[i], &nodes[j],
+				(*nr - j) * sizeof(*nodes));
+			*nr = i + *nr - j;
+			return rc;
+		}
+
+		nd = evt_off2node(tcx, nd_off);
+		for (k = 0; k < cnt; k++) {
+			ne = evt_node_entry_at(tcx, nd, k);
+			ne->ne_child = nodes[j + k];
+			ne->ne_rect  = *evt_node_mbr_get(tcx,
+					evt_off2node(tcx, nodes[j + k]));
+		}
+		nd->tn_nr = cnt;
+		evt_node_mbr_cal(tcx, nd);
+		/* NB: i <= j, nodes[j] has been consumed */
+		nodes[i] = nd_off;
+	}
+	*nr = nd_nr;
+	return 0;
+}
+
+/**
+ * Build an empty tree bottom-up, see evt_bulk_load for the details.
+ *
+ * \return	number of loaded entries, or negative error code.
+ */
+static int
+evt_bulk_load_internal(struct evt_context *tcx,
+		       const struct evt_entry_in *ents, int nr)
+{
+	struct evt_root	*root = tcx->tc_root;
+	struct evt_node	*nd = NULL;
+	umem_off_t	*nodes;
+	umem_off_t	 nd_off;
+	int		 nd_nr = 0;
+	int		 depth;
+	int		 i;
+	int		 rc;
+
+	D_ASSERT(evt_root_empty(tcx));
+
+	rc = evt_root_tx_add(tcx);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_ARRAY(nodes, nr / tcx->tc_order + 1);
+	if (nodes == NULL)
+		return -DER_NOMEM;
+
+	evt_root_attr_set(tcx, &ents[0]);
+	for (i = 0; i < nr; i++) {
+		if (i > 0 && evt_rect_cmp(&ents[i - 1].ei_rect,
+					  &ents[i].ei_rect) >= 0) {
+			V_TRACE(DB_TRACE, "Entry %d is out of order, stop bulk "
+				"loading\n", i);
+			break;
+		}
+
+		if (tcx->tc_inob && ents[i].ei_inob &&
+		    tcx->tc_inob != ents[i].ei_inob) {
+			D_ERROR("Variable record size not supported in evtree:"
+				" %d != %d\n", ents[i].ei_inob, tcx->tc_inob);
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+
+		if (nd == NULL || evt_node_is_full(tcx, nd)) {
+			rc = evt_node_alloc(tcx, EVT_NODE_LEAF, &nd_off);
+			if (rc != 0)
+				D_GOTO(out, rc);
+
+			nd = evt_off2node(tcx, nd_off);
+			nodes[nd_nr++] = nd_off;
+		}
+
+		/* NB: entries are sorted, it always appends to the leaf */
+		rc = evt_node_insert(tcx, nd, UMOFF_NULL, &ents[i], NULL);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	for (depth = 1; nd_nr > 1; depth++) {
+		rc = evt_bulk_load_level(tcx, nodes, &nd_nr);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	nd = evt_off2node(tcx, nodes[0]);
+	nd->tn_flags |= EVT_NODE_ROOT;
+	root->tr_node  = nodes[0];
+	root->tr_depth = depth;
+	evt_tcx_set_dep(tcx, depth);
+
+	V_TRACE(DB_TRACE, "Bulk loaded %d of %d entries, depth %d\n",
+		i, nr, depth);
+	rc = i;
+ out:
+	/* vmem has no transaction to roll back the allocated nodes */
+	if (rc < 0 && !evt_has_tx(tcx)) {
+		for (i = 0; i < nd_nr; i++)
+			evt_bulk_load_free(tcx, nodes[i]);
+	}
+	D_FREE(nodes);
+	return rc;
+}
+
+/**
+ * Bulk load versioned extents into a tree.
+ *
+ * Please check API comment in evtree.h for the details.
+ */
+int
+evt_bulk_load(daos_handle_t toh, const struct evt_entry_in *ents,
+	      unsigned int nr)
+{
+	struct evt_context	*tcx;
+	int			 i = 0;
+	int			 rc;
+
+	tcx = evt_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (nr == 0)
+		return 0;
+
+	rc = evt_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	if (tcx->tc_depth == 0) { /* empty tree */
+		i = evt_bulk_load_internal(tcx, ents, nr);
+		if (i < 0)
+			D_GOTO(out, rc = i);
+	}
+
+	/* the tree is not empty, or the rest are not sorted */
+	for (; i < nr; i++) {
+		rc = evt_insert(toh, &ents[i]);
+		if (rc != 0)
+			break;
+	}
+ out:
+	return evt_tx_end(tcx, rc);
+}
+
 /** Fill the entry with the extent at the specified position of \a node */
 void
 evt_entry_fill(struct evt_context *tcx, struct evt_node *node,
@@ -1817,11 +2284,14 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 		   const struct evt_rect *rect,
 		   struct evt_entry_array *ent_array)
 {
-	umem_off_t	nd_off;
-	int		level;
-	int		at;
-	int		i;
-	int		rc = 0;
+	struct evt_scan_bound	sb;
+	/* candidates of each level of the current search path */
+	uint64_t		scan[EVT_TRACE_MAX][EVT_SCAN_WORDS];
+	umem_off_t		nd_off;
+	int			level;
+	int			at;
+	int			i;
+	int			rc = 0;
 
 	V_TRACE(DB_TRACE, "Searching rectangle "DF_RECT" opc=%d\n",
 		DP_RECT(rect), find_opc);
@@ -1843,31 +2313,39 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 		leaf = evt_node_is_leaf(tcx, node);
 
 		D_ASSERT(!leaf || at == 0);
+		D_ASSERT(level < EVT_TRACE_MAX);
 		V_TRACE(DB_TRACE,
 			"Checking "DF_RECT"("DF_X64"), l=%d, a=%d, f=%d\n",
 			DP_RECT(evt_node_mbr_get(tcx, node)), nd_off, level, at,
 			leaf);
 
-		ne = evt_node_entry_at(tcx, node, at);
+		/* Scan the whole node once when entering it, the bitmap is
+		 * reused when coming back from a child node.
+		 */
+		if (at == 0) {
+			evt_scan_bound_init(&sb, filter, rect, leaf);
+			evt_node_scan(tcx, node, 0, &sb, scan[level]);
+		}
 
-		for (i = at; i < node->tn_nr; i++, ne++) {
+		for (i = evt_scan_next(scan[level], at, node->tn_nr);
+		     i < node->tn_nr;
+		     i = evt_scan_next(scan[level], i + 1, node->tn_nr)) {
 			struct evt_entry	*ent;
 			struct evt_rect		*rtmp;
 			struct evt_desc		*desc;
 			int			 time_overlap;
 			int			 range_overlap;
 
+			ne = evt_node_entry_at(tcx, node, i);
 			rtmp = &ne->ne_rect;
 
 			V_TRACE(DB_TRACE, " rect[%d]="DF_RECT"\n",
 				i, DP_RECT(rtmp));
 
-			if (evt_filter_rect(filter, rtmp, leaf)) {
-				V_TRACE(DB_TRACE, "Filtered "DF_FILTER"\n",
-					DP_FILTER(filter));
-				continue; /* Doesn't match the filter */
-			}
-
+			/* The node scan has excluded rectangles filtered out
+			 * or without overlap, the overlap type is still
+			 * required by the find opcode.
+			 */
 			evt_rect_overlap(rtmp, rect, &range_overlap,
 					 &time_overlap);
 			switch (range_overlap) {
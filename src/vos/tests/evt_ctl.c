@@ -1397,6 +1397,149 @@ test_evt_root_deactivate_bug(void **state)
 	rc = evt_destroy(toh);
 	assert_int_equal(rc, 0);
 }
+#define EVT_SCAN_NR		2000
+#define EVT_SCAN_WIDTH		8
+#define EVT_SCAN_EPOCHS		100
+#define EVT_SCAN_QUERIES	500
+
+/**
+ * Run random queries against the disjoint extents created by the scan tests,
+ * extent i is [i * EVT_SCAN_WIDTH, i * EVT_SCAN_WIDTH + EVT_SCAN_WIDTH / 2]
+ * at epochs[i].
+ */
+static void
+evt_scan_verify(daos_handle_t toh, daos_epoch_t *epochs)
+{
+	struct evt_entry_array	 ent_array;
+	struct evt_rect		 rect;
+	int			 expected;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	for (j = 0; j < EVT_SCAN_QUERIES; j++) {
+		rect.rc_ex.ex_lo = rand() % (EVT_SCAN_NR * EVT_SCAN_WIDTH);
+		rect.rc_ex.ex_hi = rect.rc_ex.ex_lo + rand() % 256;
+		rect.rc_epc = (rand() % (EVT_SCAN_EPOCHS + 1)) + 1;
+
+		expected = 0;
+		for (i = 0; i < EVT_SCAN_NR; i++) {
+			if (i * EVT_SCAN_WIDTH > rect.rc_ex.ex_hi ||
+			    i * EVT_SCAN_WIDTH + EVT_SCAN_WIDTH / 2 <
+			    rect.rc_ex.ex_lo)
+				continue;
+			if (epochs[i] <= rect.rc_epc)
+				expected++;
+		}
+
+		evt_ent_array_init(&ent_array);
+		rc = evt_find(toh, &rect, &ent_array);
+		assert_int_equal(rc, 0);
+		assert_int_equal(ent_array.ea_ent_nr, expected);
+		evt_ent_array_fini(&ent_array);
+	}
+}
+
+/* Check node scanning of evt_find() against a brute force scan */
+static void
+test_evt_find_scan(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct evt_entry_in	 entry_in = {0};
+	daos_handle_t		 toh;
+	daos_epoch_t		*epochs;
+	int			 orders[] = {16, 23, 32};
+	int			 i;
+	int			 k;
+	int			 rc;
+
+	D_ALLOC_ARRAY(epochs, EVT_SCAN_NR);
+	assert_non_null(epochs);
+
+	srand(time(0));
+	for (k = 0; k < ARRAY_SIZE(orders); k++) {
+		rc = evt_create(EVT_FEAT_DEFAULT, orders[k], arg->ta_uma,
+				arg->ta_root, DAOS_HDL_INVAL, &toh);
+		assert_int_equal(rc, 0);
+
+		/* Disjoint extents, so none of them can be covered */
+		entry_in.ei_ver = 0;
+		entry_in.ei_inob = 0;
+		bio_alloc_init(arg->ta_utx, &entry_in.ei_addr, NULL, 0);
+		for (i = 0; i < EVT_SCAN_NR; i++) {
+			epochs[i] = (rand() % EVT_SCAN_EPOCHS) + 1;
+			entry_in.ei_rect.rc_ex.ex_lo = i * EVT_SCAN_WIDTH;
+			entry_in.ei_rect.rc_ex.ex_hi = i * EVT_SCAN_WIDTH +
+						       (EVT_SCAN_WIDTH / 2);
+			entry_in.ei_rect.rc_epc = epochs[i];
+			rc = evt_insert(toh, &entry_in);
+			assert_int_equal(rc, 0);
+		}
+
+		evt_scan_verify(toh, epochs);
+
+		rc = evt_destroy(toh);
+		assert_int_equal(rc, 0);
+	}
+	D_FREE(epochs);
+}
+
+static void
+test_evt_bulk_load(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct evt_entry_in	*ents;
+	struct evt_rect		*rect;
+	daos_handle_t		 toh;
+	daos_epoch_t		*epochs;
+	int			 orders[] = {4, 16, 23};
+	int			 half = EVT_SCAN_NR / 2;
+	int			 i;
+	int			 k;
+	int			 rc;
+
+	D_ALLOC_ARRAY(epochs, EVT_SCAN_NR);
+	assert_non_null(epochs);
+	D_ALLOC_ARRAY(ents, EVT_SCAN_NR);
+	assert_non_null(ents);
+
+	srand(time(0));
+	for (k = 0; k < ARRAY_SIZE(orders); k++) {
+		rc = evt_create(EVT_FEAT_DEFAULT, orders[k], arg->ta_uma,
+				arg->ta_root, DAOS_HDL_INVAL, &toh);
+		assert_int_equal(rc, 0);
+
+		for (i = 0; i < EVT_SCAN_NR; i++) {
+			epochs[i] = (rand() % EVT_SCAN_EPOCHS) + 1;
+			rect = &ents[i].ei_rect;
+			rect->rc_ex.ex_lo = i * EVT_SCAN_WIDTH;
+			rect->rc_ex.ex_hi = i * EVT_SCAN_WIDTH +
+					    (EVT_SCAN_WIDTH / 2);
+			rect->rc_epc = epochs[i];
+			bio_alloc_init(arg->ta_utx, &ents[i].ei_addr, NULL, 0);
+		}
+
+		/* Reverse the second half, so only the first half is bulk
+		 * loaded, and the rest are inserted one by one.
+		 */
+		for (i = 0; i < (EVT_SCAN_NR - half) / 2; i++) {
+			struct evt_entry_in tmp = ents[half + i];
+
+			ents[half + i] = ents[EVT_SCAN_NR - 1 - i];
+			ents[EVT_SCAN_NR - 1 - i] = tmp;
+		}
+		rc = evt_bulk_load(toh, ents, EVT_SCAN_NR);
+		assert_int_equal(rc, 0);
+
+		evt_scan_verify(toh, epochs);
+
+		rc = evt_destroy(toh);
+		assert_int_equal(rc, 0);
+	}
+	D_FREE(ents);
+	D_FREE(epochs);
+}
+
 static int
 run_create_test(void)
 {
@@ -1511,6 +1654,12 @@ run_internal_tests(void)
 		{ "EVT013: evt_iter_flags",
 			test_evt_iter_flags,
 			setup_builtin, teardown_builtin},
+		{ "EVT014: evt_find_scan",
+			test_evt_find_scan,
+			setup_builtin, teardown_builtin},
+		{ "EVT015: evt_bulk_load",
+			test_evt_bulk_load,
+			setup_builtin, teardown_builtin},
 		{ NULL, NULL, NULL, NULL }
 	};
 
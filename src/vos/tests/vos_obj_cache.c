@@ -0,0 +1,275 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * Benchmark of the VOS object cache under a mixed workload: an interactive
+ * tenant keeps accessing a hot set of objects, while a scanning tenant
+ * (enumeration, rebuild, aggregation) touches every object of a large range
+ * once. The hit rate of the interactive tenant is compared with a plain LRU
+ * cache of the same size.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <daos/common.h>
+#include <daos/lru.h>
+#include <daos/tests_lib.h>
+#include <vos_obj.h>
+
+struct bench_obj {
+	struct daos_llink	bo_llink;
+	daos_unit_oid_t		bo_oid;
+};
+
+static void
+bench_lop_free(struct daos_llink *llink)
+{
+	struct bench_obj *obj = container_of(llink, struct bench_obj,
+					     bo_llink);
+
+	D_FREE(obj);
+}
+
+static int
+bench_lop_alloc(void *key, unsigned int ksize, void *args,
+		struct daos_llink **llink_p)
+{
+	struct bench_obj *obj;
+
+	D_ALLOC_PTR(obj);
+	if (obj == NULL)
+		return -DER_NOMEM;
+
+	obj->bo_oid = *(daos_unit_oid_t *)key;
+	*llink_p = &obj->bo_llink;
+	return 0;
+}
+
+static bool
+bench_lop_cmp_key(const void *key, unsigned int ksize,
+		  struct daos_llink *llink)
+{
+	struct bench_obj *obj = container_of(llink, struct bench_obj,
+					     bo_llink);
+
+	D_ASSERT(ksize == sizeof(obj->bo_oid));
+	return !memcmp(key, &obj->bo_oid, sizeof(obj->bo_oid));
+}
+
+static struct daos_llink_ops bench_lru_ops = {
+	.lop_free_ref	= bench_lop_free,
+	.lop_alloc_ref	= bench_lop_alloc,
+	.lop_cmp_keys	= bench_lop_cmp_key,
+};
+
+/**
+ * Reference LRU cache, objects are identified by index, which is at most
+ * bl_obj_nr.
+ */
+struct bench_lru {
+	d_list_t	 bl_lru;
+	d_list_t	*bl_links;
+	uint32_t	 bl_obj_nr;
+	uint32_t	 bl_size;
+	uint32_t	 bl_nr;
+};
+
+static int
+bench_lru_init(struct bench_lru *lru, uint32_t obj_nr, uint32_t size)
+{
+	D_ALLOC_ARRAY(lru->bl_links, obj_nr);
+	if (lru->bl_links == NULL)
+		return -DER_NOMEM;
+
+	D_INIT_LIST_HEAD(&lru->bl_lru);
+	lru->bl_obj_nr = obj_nr;
+	lru->bl_size = size;
+	lru->bl_nr = 0;
+	return 0;
+}
+
+static bool
+bench_lru_access(struct bench_lru *lru, uint32_t idx)
+{
+	d_list_t	*link = &lru->bl_links[idx];
+
+	if (link->next != NULL) {
+		d_list_move(link, &lru->bl_lru);
+		return true;
+	}
+
+	if (lru->bl_nr == lru->bl_size) {
+		d_list_t *tail = lru->bl_lru.prev;
+
+		d_list_del(tail);
+		tail->next = tail->prev = NULL;
+		lru->bl_nr--;
+	}
+	d_list_add(link, &lru->bl_lru);
+	lru->bl_nr++;
+	return false;
+}
+
+static unsigned int	cache_bits = LRU_CACHE_BITS;
+static unsigned int	hot_nr;
+static unsigned int	scan_nr;
+static unsigned int	op_nr = 4000000;
+static unsigned int	scan_pct = 50;
+
+static void
+bench_usage(void)
+{
+	printf("vos_obj_cache [OPTIONS]\n"
+	       "  -b bits     cache size is (1 << bits), default %d\n"
+	       "  -h nr       number of hot objects, default is 1/2 cache\n"
+	       "  -s nr       number of scanned objects, default is 16x cache\n"
+	       "  -p percent  percentage of scan accesses, default %d\n"
+	       "  -n nr       number of accesses, default %u\n",
+	       LRU_CACHE_BITS, scan_pct, op_nr);
+}
+
+int
+main(int argc, char **argv)
+{
+	static struct option	 opts[] = {
+		{ "bits",	required_argument,	NULL,	'b' },
+		{ "hot",	required_argument,	NULL,	'h' },
+		{ "scan",	required_argument,	NULL,	's' },
+		{ "percent",	required_argument,	NULL,	'p' },
+		{ "num",	required_argument,	NULL,	'n' },
+		{ NULL,		0,			NULL,	0   },
+	};
+	struct daos_lru_cache	*cache;
+	struct daos_llink	*llink;
+	struct daos_lru_stats	 stats;
+	struct bench_lru	 lru;
+	daos_unit_oid_t		 oid;
+	uint64_t		 hot_ops = 0;
+	uint64_t		 hot_hits = 0;
+	uint64_t		 lru_hits = 0;
+	uint64_t		 scan_at = 0;
+	uint64_t		 hits;
+	double			 then;
+	double			 now;
+	unsigned int		 i;
+	int			 opt;
+	int			 rc;
+
+	while ((opt = getopt_long(argc, argv, "b:h:s:p:n:", opts,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 'b':
+			cache_bits = atoi(optarg);
+			break;
+		case 'h':
+			hot_nr = atoi(optarg);
+			break;
+		case 's':
+			scan_nr = atoi(optarg);
+			break;
+		case 'p':
+			scan_pct = atoi(optarg);
+			break;
+		case 'n':
+			op_nr = atoi(optarg);
+			break;
+		default:
+			bench_usage();
+			return -1;
+		}
+	}
+	if (cache_bits == 0 || cache_bits > 24 || scan_pct > 100) {
+		bench_usage();
+		return -1;
+	}
+	if (hot_nr == 0)
+		hot_nr = (1 << cache_bits) / 2;
+	if (scan_nr == 0)
+		scan_nr = (1 << cache_bits) * 16;
+
+	rc = daos_debug_init(NULL);
+	if (rc != 0)
+		return rc;
+
+	rc = daos_lru_cache_create(cache_bits, D_HASH_FT_NOLOCK,
+				   &bench_lru_ops, &cache);
+	if (rc != 0)
+		goto out_debug;
+
+	/* NB: the cache evicts idle items when it reaches its size */
+	rc = bench_lru_init(&lru, hot_nr + scan_nr, (1 << cache_bits) - 1);
+	if (rc != 0)
+		goto out_cache;
+
+	printf("cache size %u, hot objects %u, scanned objects %u, "
+	       "scan %u%%, accesses %u\n", 1 << cache_bits, hot_nr, scan_nr,
+	       scan_pct, op_nr);
+
+	memset(&oid, 0, sizeof(oid));
+	then = dts_time_now();
+	for (i = 0; i < op_nr; i++) {
+		bool	hot = (rand() % 100) >= scan_pct;
+		int	idx;
+
+		if (hot) {
+			idx = rand() % hot_nr;
+		} else {
+			idx = hot_nr + scan_at % scan_nr;
+			scan_at++;
+		}
+
+		oid.id_pub.lo = idx;
+		hits = cache->dlc_stats.ls_hits;
+		rc = daos_lru_ref_hold(cache, &oid, sizeof(oid), (void *)1,
+				       &llink);
+		if (rc != 0)
+			goto out_lru;
+		daos_lru_ref_release(cache, llink);
+
+		if (bench_lru_access(&lru, idx) && hot)
+			lru_hits++;
+		if (hot) {
+			hot_ops++;
+			hot_hits += cache->dlc_stats.ls_hits - hits;
+		}
+	}
+	now = dts_time_now();
+
+	daos_lru_cache_stats_get(cache, &stats);
+	printf("%-10s %10.2f accesses/sec\n", "cache", op_nr / (now - then));
+	printf("%-10s hits "DF_U64", misses "DF_U64", evicts "DF_U64"\n",
+	       "cache", stats.ls_hits, stats.ls_misses, stats.ls_evicts);
+	printf("%-10s hot hit rate %6.2f%%\n", "cache",
+	       hot_ops ? 100.0 * hot_hits / hot_ops : 0);
+	printf("%-10s hot hit rate %6.2f%%\n", "plain LRU",
+	       hot_ops ? 100.0 * lru_hits / hot_ops : 0);
+ out_lru:
+	D_FREE(lru.bl_links);
+ out_cache:
+	daos_lru_cache_destroy(cache);
+ out_debug:
+	daos_debug_fini();
+	return rc;
+}
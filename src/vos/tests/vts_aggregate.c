@@ -1590,6 +1590,42 @@ aggregate_14(void **state)
 	assert_int_equal(i, repeat_cnt);
 }
 
+/* Aggregation waits for the refill when the budget is overdrawn */
+static void
+aggregate_15(void **state)
+{
+	struct vos_agg_throttle	*at = vos_agg_throttle_get();
+	struct vos_agg_throttle	 saved = *at;
+	unsigned int		 acts = 0;
+	uint64_t		 start;
+	uint64_t		 elapsed;
+
+	/* 1MB/s budget, full bucket */
+	at->at_bw = 1 << 20;
+	at->at_iops = 0;
+	at->at_bytes = at->at_bw;
+	at->at_ios = 0;
+	at->at_refill = d_timeus_secdiff(0);
+
+	/* Within the budget, no wait */
+	vos_agg_throttle(at->at_bw / 2, 1, &acts);
+	assert_int_equal(acts, 0);
+
+	/* Drain the bucket 100ms below zero */
+	start = d_timeus_secdiff(0);
+	vos_agg_throttle(at->at_bw / 2 + at->at_bw / 10, 1, &acts);
+	elapsed = d_timeus_secdiff(0) - start;
+
+	assert_true(acts & VOS_ITER_CB_YIELD);
+	assert_true(at->at_bytes >= 0);
+	assert_true(elapsed >= 50000);
+
+	at->at_bw = saved.at_bw;
+	at->at_iops = saved.at_iops;
+	at->at_bytes = saved.at_bytes;
+	at->at_ios = saved.at_ios;
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -1653,6 +1689,8 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_13, NULL, agg_tst_teardown },
 	{ "VOS414: Update and Aggregate EV repeatedly",
 	  aggregate_14, NULL, agg_tst_teardown },
+	{ "VOS415: Aggregation throttle waits for overdrawn budget",
+	  aggregate_15, NULL, agg_tst_teardown },
 };
 
 int
@@ -144,7 +144,7 @@ dtx_4(void **state)
 		assert_int_equal(rc, 0);
 	}
 
-	rc = vos_dtx_fetch_committable(args->ctx.tc_co_hdl, 100, &dtes);
+	rc = vos_dtx_fetch_committable(args->ctx.tc_co_hdl, 0, 100, &dtes);
 	assert_int_equal(rc, 10);
 
 	for (i = 0; i < 10; i++) {
@@ -1507,6 +1507,359 @@ dtx_30(void **state)
 	vts_dtx_shares_with_punch(*state, false, true);
 }
 
+/* DTX CoS cache fetch committable page by page */
+static void
+dtx_31(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct dtx_entry	*dtes = NULL;
+	struct dtx_id		 xid[10];
+	bool			 found[10] = { 0 };
+	int			 skip;
+	int			 rc;
+	int			 i;
+	int			 j;
+
+	for (i = 0; i < 10; i++) {
+		daos_dti_gen(&xid[i], false);
+		rc = vos_dtx_add_cos(args->ctx.tc_co_hdl, &args->oid, &xid[i],
+				     lrand48(), crt_hlc_get(), false);
+		assert_int_equal(rc, 0);
+	}
+
+	/* The pages of 4, 4 and 2 DTXs cover all of them once. */
+	for (skip = 0; skip < 10; skip += rc) {
+		rc = vos_dtx_fetch_committable(args->ctx.tc_co_hdl, skip, 4,
+					       &dtes);
+		assert_int_equal(rc, skip < 8 ? 4 : 2);
+
+		for (i = 0; i < rc; i++) {
+			for (j = 0; j < 10; j++) {
+				if (daos_dti_equal(&xid[j], &dtes[i].dte_xid))
+					break;
+			}
+			assert_true(j < 10);
+			assert_false(found[j]);
+			found[j] = true;
+		}
+		D_FREE(dtes);
+	}
+
+	rc = vos_dtx_fetch_committable(args->ctx.tc_co_hdl, 10, 4, &dtes);
+	assert_int_equal(rc, 0);
+	assert_null(dtes);
+}
+
+/* Prepare a DTX that updates a new dkey. */
+static void
+vts_dtx_prep_one(struct io_test_args *args, struct dtx_id *xid)
+{
+	struct dtx_handle		*dth = NULL;
+	struct dtx_conflict_entry	 conflict = { 0 };
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 dkey_iov;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	uint64_t			 dkey_hash;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	int				 rc;
+
+	vts_dtx_prep_update(args, xid, &val_iov, &dkey_iov, &dkey, dkey_buf,
+			    &akey, akey_buf, &iod, &sgl, &rex, update_buf,
+			    UPDATE_BUF_SIZE, UPDATE_REC_SIZE, &dkey_hash,
+			    &epoch, false);
+
+	rc = vts_dtx_begin(xid, &args->oid, args->ctx.tc_co_hdl, epoch,
+			   dkey_hash, &conflict, NULL, 0, 1,
+			   DAOS_INTENT_UPDATE, true, &dth);
+	assert_int_equal(rc, 0);
+
+	rc = io_test_obj_update(args, epoch, &dkey, &iod, &sgl, dth, false);
+	assert_int_equal(rc, 0);
+
+	vts_dtx_end(dth);
+}
+
+/* DTX hash table is rebuilt after the transaction is aborted */
+static void
+dtx_32(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct vos_container		*cont;
+	struct umem_instance		*umm;
+	struct dtx_handle		*dth = NULL;
+	struct vos_dtx_hent		*hent;
+	struct dtx_conflict_entry	 conflict = { 0 };
+	struct dtx_id			 xid[2];
+	umem_off_t			 record;
+	int				 rc;
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+	umm = &cont->vc_pool->vp_umm;
+
+	vts_dtx_prep_one(args, &xid[0]);
+
+	daos_dti_gen(&xid[1], false);
+	rc = vts_dtx_begin(&xid[1], &args->oid, args->ctx.tc_co_hdl,
+			   crt_hlc_get(), lrand48(), &conflict, NULL, 0, 1,
+			   DAOS_INTENT_UPDATE, true, &dth);
+	assert_int_equal(rc, 0);
+
+	rc = vos_tx_begin(cont->vc_pool);
+	assert_int_equal(rc, 0);
+
+	record = umem_zalloc(umm, sizeof(struct vos_irec_df));
+	assert_false(UMOFF_IS_NULL(record));
+
+	/* Allocate the DTX entry, then abort the transaction. */
+	vos_dth_set(dth);
+	rc = vos_dtx_register_record(umm, record, DTX_RT_SVT, 0);
+	vos_dth_set(NULL);
+	assert_int_equal(rc, 0);
+
+	rc = vos_dtx_hash_lookup(cont, &xid[1], &hent);
+	assert_int_equal(rc, VOS_DTX_HASH_ACTIVE);
+
+	vos_tx_end(cont->vc_pool, -DER_IO);
+	vts_dtx_end(dth);
+
+	/* The stale table is not used, and not rebuilt by the lookup. */
+	assert_int_equal(cont->vc_dtx_hash.dh_valid, 0);
+	assert_int_equal(cont->vc_dtx_hash.dh_guarded, 0);
+	rc = vos_dtx_hash_lookup(cont, &xid[1], &hent);
+	assert_int_equal(rc, VOS_DTX_HASH_UNKNOWN);
+	assert_int_equal(cont->vc_dtx_hash.dh_valid, 0);
+
+	rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL, &xid[1],
+				       0, false);
+	assert_int_equal(rc, -DER_NONEXIST);
+	assert_int_equal(cont->vc_dtx_hash.dh_valid, 1);
+
+	rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL, &xid[0],
+				       0, false);
+	assert_int_equal(rc, DTX_ST_PREPARED);
+}
+
+/* DTX hash table falls back to the committed DTX table after eviction */
+static void
+dtx_33(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_container	*cont;
+	struct vos_dtx_hent	*hent;
+	struct dtx_id		*xid;
+	struct dtx_id		 tmp;
+	int			 nr = VOS_DTX_HASH_COMMITTED_MAX + 8;
+	int			 evicted = 0;
+	int			 count;
+	int			 rc;
+	int			 i;
+	int			 j;
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+
+	D_ALLOC_ARRAY(xid, nr);
+	assert_non_null(xid);
+
+	for (i = 0; i < nr; i += count) {
+		count = min(nr - i, 512);
+		for (j = i; j < i + count; j++)
+			vts_dtx_prep_one(args, &xid[j]);
+
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[i], count);
+		assert_int_equal(rc, 0);
+	}
+
+	assert_int_equal(cont->vc_dtx_hash.dh_committed,
+			 VOS_DTX_HASH_COMMITTED_MAX);
+
+	for (i = 0; i < nr; i++) {
+		rc = vos_dtx_hash_lookup(cont, &xid[i], &hent);
+		if (rc == VOS_DTX_HASH_INACTIVE)
+			evicted++;
+		else
+			assert_int_equal(rc, VOS_DTX_HASH_COMMITTED);
+
+		/* The evicted ones are found in the committed DTX table. */
+		rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL,
+					       &xid[i], 0, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+	assert_int_equal(evicted, nr - VOS_DTX_HASH_COMMITTED_MAX);
+
+	daos_dti_gen(&tmp, false);
+	rc = vos_dtx_hash_lookup(cont, &tmp, &hent);
+	assert_int_equal(rc, VOS_DTX_HASH_INACTIVE);
+
+	rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL, &tmp, 0,
+				       false);
+	assert_int_equal(rc, -DER_NONEXIST);
+
+	/* After the evicted ones are aggregated, the table holds all the
+	 * committed DTXs again.
+	 */
+	sleep(3);
+	while ((rc = vos_dtx_aggregate(args->ctx.tc_co_hdl, 1024, 1)) == 0)
+		;
+	assert_int_equal(rc, 1);
+	assert_int_equal(cont->vc_dtx_hash.dh_committed, 0);
+
+	rc = vos_dtx_hash_lookup(cont, &tmp, &hent);
+	assert_int_equal(rc, VOS_DTX_HASH_NONEXIST);
+
+	D_FREE(xid);
+}
+
+/* DTX hash table delete inside probe clusters */
+static void
+dtx_34(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_container	*cont;
+	struct vos_dtx_hent	*hent;
+	struct dtx_id		 xid[600];
+	struct dtx_id		 aborted[300];
+	int			 rc;
+	int			 i;
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+
+	/* Fill more than half of the initial table, there are clusters. */
+	for (i = 0; i < 600; i++)
+		vts_dtx_prep_one(args, &xid[i]);
+
+	for (i = 0; i < 300; i++)
+		aborted[i] = xid[i * 2 + 1];
+
+	rc = vos_dtx_abort(args->ctx.tc_co_hdl, aborted, 300, false);
+	assert_int_equal(rc, 0);
+	assert_int_equal(cont->vc_dtx_hash.dh_count, 300);
+
+	/* Backward shift keeps the left ones reachable from their home. */
+	for (i = 0; i < 600; i++) {
+		rc = vos_dtx_hash_lookup(cont, &xid[i], &hent);
+		if (i % 2 != 0) {
+			assert_int_equal(rc, VOS_DTX_HASH_NONEXIST);
+			continue;
+		}
+
+		assert_int_equal(rc, VOS_DTX_HASH_ACTIVE);
+		assert_true(daos_dti_equal(&hent->he_xid, &xid[i]));
+
+		rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL,
+					       &xid[i], 0, false);
+		assert_int_equal(rc, DTX_ST_PREPARED);
+	}
+}
+
+static void
+vts_dtx_fetch_check(struct io_test_args *args, daos_epoch_t epoch,
+		    daos_key_t *dkey, daos_iod_t *iod, char *update_buf,
+		    bool visible)
+{
+	d_sg_list_t	sgl = { 0 };
+	d_iov_t		val_iov;
+	char		fetch_buf[UPDATE_BUF_SIZE];
+	int		rc;
+
+	memset(fetch_buf, 0, UPDATE_BUF_SIZE);
+	d_iov_set(&val_iov, fetch_buf, UPDATE_BUF_SIZE);
+	sgl.sg_iovs = &val_iov;
+	sgl.sg_nr = 1;
+	iod->iod_size = DAOS_REC_ANY;
+
+	rc = io_test_obj_fetch(args, epoch, dkey, iod, &sgl, true);
+	assert_int_equal(rc, 0);
+
+	if (visible)
+		assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
+	else
+		assert_memory_not_equal(update_buf, fetch_buf,
+					UPDATE_BUF_SIZE);
+}
+
+/* DTX availability check with the hash table agrees with the CoS cache */
+static void
+dtx_35(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_container	*cont;
+	struct dtx_id		 xid[4];
+	daos_iod_t		 iod[4];
+	d_sg_list_t		 sgl[4];
+	daos_recx_t		 rex[4];
+	daos_key_t		 dkey[4];
+	daos_key_t		 akey[4];
+	d_iov_t			 dkey_iov[4];
+	d_iov_t			 val_iov[4];
+	uint64_t		 epoch[4];
+	uint64_t		 dkey_hash[4];
+	char			 dkey_buf[4][UPDATE_DKEY_SIZE];
+	char			 akey_buf[4][UPDATE_AKEY_SIZE];
+	char			 update_buf[4][UPDATE_BUF_SIZE];
+	int			 rc;
+	int			 i;
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+
+	for (i = 0; i < 4; i++) {
+		struct dtx_handle		*dth = NULL;
+		struct dtx_conflict_entry	 conflict = { 0 };
+
+		vts_dtx_prep_update(args, &xid[i], &val_iov[i], &dkey_iov[i],
+				    &dkey[i], dkey_buf[i], &akey[i],
+				    akey_buf[i], &iod[i], &sgl[i], &rex[i],
+				    update_buf[i], UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash[i], &epoch[i],
+				    false);
+
+		rc = vts_dtx_begin(&xid[i], &args->oid, args->ctx.tc_co_hdl,
+				   epoch[i], dkey_hash[i], &conflict, NULL, 0,
+				   1, DAOS_INTENT_UPDATE, true, &dth);
+		assert_int_equal(rc, 0);
+
+		rc = io_test_obj_update(args, epoch[i], &dkey[i], &iod[i],
+					&sgl[i], dth, true);
+		assert_int_equal(rc, 0);
+
+		vts_dtx_end(dth);
+	}
+
+	/* The even ones are committable, visible to the leader. */
+	for (i = 0; i < 4; i += 2) {
+		rc = vos_dtx_add_cos(args->ctx.tc_co_hdl, &args->oid, &xid[i],
+				     dkey_hash[i], epoch[i], false);
+		assert_int_equal(rc, 0);
+	}
+
+	for (i = 0; i < 4; i++)
+		vts_dtx_fetch_check(args, epoch[i], &dkey[i], &iod[i],
+				    update_buf[i], i % 2 == 0);
+
+	/* Stale table, the fetch uses the CoS cache without rebuilding. */
+	vos_dtx_hash_invalidate(cont);
+	for (i = 0; i < 4; i++)
+		vts_dtx_fetch_check(args, epoch[i], &dkey[i], &iod[i],
+				    update_buf[i], i % 2 == 0);
+	assert_int_equal(cont->vc_dtx_hash.dh_valid, 0);
+
+	/* Rebuilt table marks the DTXs in the CoS cache as committable. */
+	rc = vos_dtx_check_committable(args->ctx.tc_co_hdl, NULL, &xid[0], 0,
+				       false);
+	assert_int_equal(rc, DTX_ST_PREPARED);
+	assert_int_equal(cont->vc_dtx_hash.dh_valid, 1);
+
+	for (i = 0; i < 4; i++)
+		vts_dtx_fetch_check(args, epoch[i], &dkey[i], &iod[i],
+				    update_buf[i], i % 2 == 0);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -1579,6 +1932,18 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_29, NULL, dtx_tst_teardown },
 	{ "VOS530: punch key during some shared DTXs, the punch is aborted",
 	  dtx_30, NULL, dtx_tst_teardown },
+	{ "VOS531: DTX CoS cache fetch committable page by page",
+	  dtx_31, NULL, dtx_tst_teardown },
+	{ "VOS532: DTX hash table is rebuilt after transaction abort",
+	  dtx_32, NULL, dtx_tst_teardown },
+	{ "VOS533: DTX hash table falls back to committed table after "
+		"eviction",
+	  dtx_33, NULL, dtx_tst_teardown },
+	{ "VOS534: DTX hash table delete inside probe clusters",
+	  dtx_34, NULL, dtx_tst_teardown },
+	{ "VOS535: DTX availability check with hash table agrees with "
+		"CoS cache",
+	  dtx_35, NULL, dtx_tst_teardown },
 };
 
 int
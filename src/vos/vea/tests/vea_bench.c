@@ -0,0 +1,409 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B620873.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * Replay an allocation trace against VEA in both the default and the
+ * segregated-fit allocation mode, and report the throughput and the
+ * fragmentation of each mode.
+ *
+ * Trace file format, one operation per line:
+ *	r <blk_cnt>	reserve & publish an extent, the extent is identified
+ *			by the sequence number of the reserve (start from 0)
+ *	f <id>		free the extent reserved by the id-th reserve
+ *
+ * If no trace file is provided, a trace of mixed 4K and 1M allocations
+ * with random frees is generated.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#include <daos/common.h>
+#include <daos/btree_class.h>
+#include <daos/tests_lib.h>
+#include <daos_srv/vea.h>
+#include "../vea_internal.h"
+
+enum {
+	OP_RESERVE,
+	OP_FREE,
+};
+
+struct trace_op {
+	int		to_op;
+	/* block count for reserve, extent id for free */
+	uint32_t	to_arg;
+};
+
+struct trace_ext {
+	uint64_t	te_off;
+	uint32_t	te_cnt;
+};
+
+static char		 pool_file[PATH_MAX];
+static char		*trace_file;
+static uint64_t		 capacity = 1ULL << 30;	/* 1GB */
+static unsigned int	 op_nr = 200000;
+static unsigned int	 fill_pct = 80;
+static unsigned int	 seed;
+
+static struct trace_op	*ops;
+static unsigned int	 ops_cnt;
+static unsigned int	 resrv_cnt;
+
+static int
+trace_add(int op, uint32_t arg)
+{
+	static unsigned int	ops_max;
+
+	if (ops_cnt == ops_max) {
+		struct trace_op	*tmp;
+
+		ops_max = ops_max ? ops_max * 2 : 1024;
+		D_REALLOC(tmp, ops, ops_max * sizeof(*ops));
+		if (tmp == NULL)
+			return -DER_NOMEM;
+		ops = tmp;
+	}
+
+	ops[ops_cnt].to_op = op;
+	ops[ops_cnt].to_arg = arg;
+	ops_cnt++;
+	if (op == OP_RESERVE)
+		resrv_cnt++;
+	return 0;
+}
+
+static int
+trace_load(const char *path)
+{
+	FILE		*fp;
+	char		 op;
+	unsigned int	 arg;
+	int		 rc = 0;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "failed to open trace %s\n", path);
+		return -DER_NONEXIST;
+	}
+
+	while (fscanf(fp, " %c %u", &op, &arg) == 2) {
+		if (op == 'r' && arg != 0) {
+			rc = trace_add(OP_RESERVE, arg);
+		} else if (op == 'f' && arg < resrv_cnt) {
+			rc = trace_add(OP_FREE, arg);
+		} else {
+			fprintf(stderr, "invalid trace op %c %u\n", op, arg);
+			rc = -DER_INVAL;
+		}
+		if (rc)
+			break;
+	}
+
+	fclose(fp);
+	return rc;
+}
+
+/*
+ * Generate a trace of mixed 4K & 1M allocations, live extents are freed
+ * randomly once the space usage reaches @fill_pct.
+ */
+static int
+trace_generate(uint32_t blk_sz)
+{
+	uint64_t	 tot_blks = capacity / blk_sz;
+	uint64_t	 used = 0;
+	uint32_t	*live, *sizes;
+	unsigned int	 live_nr = 0, i;
+	int		 rc = 0;
+
+	D_ALLOC_ARRAY(live, op_nr);
+	D_ALLOC_ARRAY(sizes, op_nr);
+	if (live == NULL || sizes == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	srand(seed);
+	for (i = 0; i < op_nr; i++) {
+		uint32_t	blk_cnt;
+
+		if (live_nr != 0 &&
+		    used * 100 >= tot_blks * fill_pct) {
+			unsigned int	idx = rand() % live_nr;
+
+			rc = trace_add(OP_FREE, live[idx]);
+			if (rc)
+				break;
+			used -= sizes[live[idx]];
+			live[idx] = live[--live_nr];
+			continue;
+		}
+
+		/* 3/4 are 4K allocations, the rest are 1M allocations */
+		blk_cnt = (rand() % 4) ? 1 : (1U << 20) / blk_sz;
+		sizes[resrv_cnt] = blk_cnt;
+		live[live_nr++] = resrv_cnt;
+		used += blk_cnt;
+
+		rc = trace_add(OP_RESERVE, blk_cnt);
+		if (rc)
+			break;
+	}
+out:
+	D_FREE(live);
+	D_FREE(sizes);
+	return rc;
+}
+
+static void
+print_stat(const char *mode, struct vea_stat *stat)
+{
+	int	i;
+
+	printf("%-8s free_blks "DF_U64", large_frags "DF_U64", small_frags "
+	       DF_U64", largest_blks %u, resrv_fail "DF_U64"\n", mode,
+	       stat->vs_free_transient, stat->vs_large_frags,
+	       stat->vs_small_frags, stat->vs_largest_blks,
+	       stat->vs_resrv_fail);
+
+	printf("%-8s frags histogram:", mode);
+	for (i = 0; i < VEA_FRAGS_HIST_SZ; i++)
+		printf(" "DF_U64, stat->vs_frags_hist[i]);
+	printf("\n");
+}
+
+static int
+trace_replay(bool seg_fit)
+{
+	const char		*mode = seg_fit ? "segfit" : "default";
+	struct umem_instance	 umm;
+	struct umem_tx_stage_data txd;
+	struct umem_attr	 uma;
+	struct vea_unmap_context unmap_ctxt = { 0 };
+	struct vea_space_info	*vsi = NULL;
+	struct vea_space_df	*md;
+	struct vea_resrvd_ext	*ext;
+	struct vea_stat		 stat;
+	struct trace_ext	*exts;
+	d_list_t		 r_list;
+	PMEMoid			 root;
+	unsigned int		 i, id = 0, fails = 0;
+	double			 then, now;
+	int			 rc;
+
+	D_ALLOC_ARRAY(exts, resrv_cnt);
+	if (exts == NULL)
+		return -DER_NOMEM;
+
+	unlink(pool_file);
+	uma.uma_id = UMEM_CLASS_PMEM;
+	uma.uma_pool = pmemobj_create(pool_file, "vea_bench", 256 << 20, 0666);
+	if (uma.uma_pool == NULL) {
+		fprintf(stderr, "create pmemobj pool error\n");
+		D_GOTO(out, rc = -DER_NOSPACE);
+	}
+
+	root = pmemobj_root(uma.uma_pool, sizeof(*md));
+	if (OID_IS_NULL(root))
+		D_GOTO(out_pool, rc = -DER_NOSPACE);
+	md = pmemobj_direct(root);
+
+	rc = umem_class_init(&uma, &umm);
+	if (rc)
+		goto out_pool;
+	umem_init_txd(&txd);
+
+	rc = vea_format(&umm, &txd, md, 0, 1, capacity, NULL, NULL, true);
+	if (rc)
+		goto out_txd;
+
+	setenv("VEA_SEG_FIT", seg_fit ? "1" : "0", 1);
+	rc = vea_load(&umm, &txd, md, &unmap_ctxt, &vsi);
+	if (rc)
+		goto out_txd;
+
+	D_INIT_LIST_HEAD(&r_list);
+	then = dts_time_now();
+	for (i = 0; i < ops_cnt; i++) {
+		struct trace_op	*op = &ops[i];
+
+		/*
+		 * The trace is replayed much faster than the real workload,
+		 * make the freed extents visible for allocation immediately
+		 * instead of waiting for VEA_MIGRATE_INTVL.
+		 */
+		vsi->vsi_agg_time = 0;
+
+		if (op->to_op == OP_FREE) {
+			struct trace_ext *te = &exts[op->to_arg];
+
+			/* Skip the free of failed reserve */
+			if (te->te_cnt == 0)
+				continue;
+
+			rc = vea_free(vsi, te->te_off, te->te_cnt);
+			if (rc)
+				break;
+			continue;
+		}
+
+		rc = vea_reserve(vsi, op->to_arg, NULL, &r_list);
+		if (rc == -DER_NOSPACE) {
+			fails++;
+			id++;
+			rc = 0;
+			continue;
+		} else if (rc) {
+			break;
+		}
+
+		ext = d_list_entry(r_list.next, struct vea_resrvd_ext,
+				   vre_link);
+		exts[id].te_off = ext->vre_blk_off;
+		exts[id].te_cnt = ext->vre_blk_cnt;
+		id++;
+
+		rc = umem_tx_begin(&umm, &txd);
+		if (rc)
+			break;
+		rc = vea_tx_publish(vsi, NULL, &r_list);
+		rc = rc ? umem_tx_abort(&umm, rc) : umem_tx_commit(&umm);
+		if (rc)
+			break;
+	}
+	now = dts_time_now();
+
+	if (rc) {
+		fprintf(stderr, "%s: replay op %u failed: %d\n", mode, i, rc);
+		goto out_vsi;
+	}
+
+	rc = vea_query(vsi, NULL, &stat);
+	if (rc)
+		goto out_vsi;
+
+	printf("%-8s %u ops, %10.2f ops/sec, %u failed reserves\n", mode,
+	       ops_cnt, ops_cnt / (now - then), fails);
+	print_stat(mode, &stat);
+out_vsi:
+	vea_unload(vsi);
+out_txd:
+	umem_fini_txd(&txd);
+out_pool:
+	pmemobj_close(uma.uma_pool);
+out:
+	D_FREE(exts);
+	return rc;
+}
+
+static void
+print_usage(void)
+{
+	printf("vea_bench [OPTIONS]\n"
+	       "  -f file     pmemobj pool file, default /mnt/daos/vea_bench\n"
+	       "  -t file     trace file to be replayed\n"
+	       "  -c MB       capacity of the block device, default %lu\n"
+	       "  -n nr       ops of the generated trace, default %u\n"
+	       "  -p percent  space usage of the generated trace, default %u\n"
+	       "  -s seed     random seed of the generated trace\n",
+	       (unsigned long)(capacity >> 20), op_nr, fill_pct);
+}
+
+int
+main(int argc, char **argv)
+{
+	static struct option long_ops[] = {
+		{ "file",	required_argument,	NULL,	'f' },
+		{ "trace",	required_argument,	NULL,	't' },
+		{ "capacity",	required_argument,	NULL,	'c' },
+		{ "num",	required_argument,	NULL,	'n' },
+		{ "percent",	required_argument,	NULL,	'p' },
+		{ "seed",	required_argument,	NULL,	's' },
+		{ "help",	no_argument,		NULL,	'h' },
+		{ NULL,		0,			NULL,	0   },
+	};
+	int rc;
+
+	memset(pool_file, 0, sizeof(pool_file));
+	while ((rc = getopt_long(argc, argv, "f:t:c:n:p:s:h", long_ops,
+				 NULL)) != -1) {
+		switch (rc) {
+		case 'f':
+			strncpy(pool_file, optarg, PATH_MAX - 1);
+			break;
+		case 't':
+			trace_file = optarg;
+			break;
+		case 'c':
+			capacity = strtoull(optarg, NULL, 0) << 20;
+			break;
+		case 'n':
+			op_nr = atoi(optarg);
+			break;
+		case 'p':
+			fill_pct = atoi(optarg);
+			break;
+		case 's':
+			seed = atoi(optarg);
+			break;
+		case 'h':
+			print_usage();
+			return 0;
+		default:
+			print_usage();
+			return -1;
+		}
+	}
+
+	if (fill_pct == 0 || fill_pct > 100 || capacity == 0) {
+		print_usage();
+		return -1;
+	}
+
+	if (strlen(pool_file) == 0)
+		strncpy(pool_file, "/mnt/daos/vea_bench", sizeof(pool_file));
+
+	rc = daos_debug_init(NULL);
+	if (rc != 0)
+		return rc;
+
+	rc = dbtree_class_register(DBTREE_CLASS_IV, BTR_FEAT_UINT_KEY,
+				   &dbtree_iv_ops);
+	if (rc != 0 && rc != -DER_EXIST)
+		goto out;
+
+	rc = trace_file ? trace_load(trace_file) : trace_generate(4096);
+	if (rc)
+		goto out;
+
+	rc = trace_replay(false);
+	if (rc == 0)
+		rc = trace_replay(true);
+out:
+	D_FREE(ops);
+	unlink(pool_file);
+	daos_debug_fini();
+	return rc;
+}
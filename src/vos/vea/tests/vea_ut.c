@@ -108,7 +108,7 @@ ut_query(void **state)
 	struct vea_attr		 attr;
 	struct vea_stat		 stat;
 	uint32_t		 blk_sz, hdr_blks, tot_blks;
-	int			 rc;
+	int			 i, rc;
 
 	rc = vea_query(args->vua_vsi, &attr, &stat);
 	assert_int_equal(rc, 0);
@@ -134,7 +134,11 @@ ut_query(void **state)
 	assert_int_equal(stat.vs_resrv_large, 0);
 	assert_int_equal(stat.vs_resrv_small, 0);
 	assert_int_equal(stat.vs_resrv_vec, 0);
+	assert_int_equal(stat.vs_resrv_fail, 0);
 	assert_int_equal(stat.vs_largest_blks, tot_blks);
+	/* single free extent in [2^14, 2^15) blocks */
+	for (i = 0; i < VEA_FRAGS_HIST_SZ; i++)
+		assert_int_equal(stat.vs_frags_hist[i], i == 14 ? 1 : 0);
 }
 
 static void
@@ -556,6 +560,7 @@ ut_reserve_special(void **state)
 	uint64_t capacity = 2UL << 30; /* 2GB, 0.5M 4k blocks in total */
 	struct vea_unmap_context unmap_ctxt;
 	uint32_t blk_sz = 0; /* use the default size */
+	struct vea_stat stat;
 	int rc;
 
 	ut_setup(&args);
@@ -581,6 +586,10 @@ ut_reserve_special(void **state)
 	assert_int_equal(rc, -DER_NOSPACE);
 	print_message("correctly failed to reserve extent\n");
 
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stat.vs_resrv_fail, 1);
+
 	/* allocation should success */
 	blk_cnt = (500 * 1024); /* a bit less than 0.5M blocks */
 	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
@@ -983,12 +992,14 @@ print_stats(struct vea_ut_args *args, bool verbose)
 	print_message("free_blks:"DF_U64"/"DF_U64", large_frags:"DF_U64", "
 		      "small_frags:"DF_U64", largest_ext_blks:%u\n"
 		      "resrv_hint:"DF_U64"\nresrv_large:"DF_U64"\n"
-		      "resrv_small:"DF_U64"\nresrv_vec:"DF_U64"\n",
+		      "resrv_small:"DF_U64"\nresrv_vec:"DF_U64"\n"
+		      "resrv_fail:"DF_U64"\n",
 		      stat.vs_free_persistent, stat.vs_free_transient,
 		      stat.vs_large_frags, stat.vs_small_frags,
 		      stat.vs_largest_blks,
 		      stat.vs_resrv_hint, stat.vs_resrv_large,
-		      stat.vs_resrv_small, stat.vs_resrv_vec);
+		      stat.vs_resrv_small, stat.vs_resrv_vec,
+		      stat.vs_resrv_fail);
 
 	if (verbose)
 		vea_dump(args->vua_vsi, true);
@@ -1261,6 +1272,176 @@ ut_fragmentation(void **state)
 	ut_teardown(&args);
 }
 
+static void
+ut_reserve_vec(void **state)
+{
+	struct vea_ut_args args;
+	struct vea_unmap_context unmap_ctxt;
+	struct vea_hint_context *h_ctxt;
+	struct vea_resrvd_ext *ext;
+	d_list_t *r_list;
+	uint32_t block_size = 0; /* use the default size */
+	uint32_t header_blocks = 1;
+	uint64_t capacity = ((VEA_LARGE_EXT_MB * 2) << 20); /* 128 MB */
+	uint32_t blk_cnts[] = { 1, 8, 3, 256, 2 };
+	unsigned int nr = ARRAY_SIZE(blk_cnts);
+	uint64_t blk_off, hint_off;
+	uint32_t total = 0;
+	int i, rc;
+
+	print_message("Test batched reserve\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, block_size,
+			header_blocks, capacity, NULL, NULL, false);
+	assert_int_equal(rc, 0);
+
+	unmap_ctxt.vnc_unmap = NULL;
+	unmap_ctxt.vnc_data = NULL;
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      &args.vua_vsi);
+	assert_int_equal(rc, 0);
+
+	r_list = &args.vua_resrvd_list[0];
+	rc = vea_hint_load(args.vua_hint[0], &h_ctxt);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < nr; i++)
+		total += blk_cnts[i];
+
+	/* The batch should be carved from one contiguous extent */
+	rc = vea_reserve_vec(args.vua_vsi, nr, blk_cnts, h_ctxt, r_list);
+	assert_int_equal(rc, 0);
+
+	i = 0;
+	blk_off = hint_off = VEA_HINT_OFF_INVAL;
+	d_list_for_each_entry(ext, r_list, vre_link) {
+		assert_true(i < nr);
+		assert_int_equal(ext->vre_blk_cnt, blk_cnts[i]);
+		assert_int_equal(ext->vre_hint_off, hint_off);
+		if (i != 0)
+			assert_int_equal(ext->vre_blk_off, blk_off);
+		blk_off = hint_off = ext->vre_blk_off + ext->vre_blk_cnt;
+		i++;
+	}
+	assert_int_equal(i, nr);
+	assert_int_equal(h_ctxt->vhc_off, blk_off);
+
+	ext = d_list_entry(r_list->next, struct vea_resrvd_ext, vre_link);
+	blk_off = ext->vre_blk_off;
+	rc = vea_verify_alloc(args.vua_vsi, true, blk_off, total);
+	assert_int_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, false, blk_off, total);
+	assert_int_equal(rc, 1);
+
+	/* Publish the whole batch */
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_int_equal(rc, 0);
+	rc = vea_tx_publish(args.vua_vsi, h_ctxt, r_list);
+	assert_int_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_int_equal(rc, 0);
+
+	rc = vea_verify_alloc(args.vua_vsi, false, blk_off, total);
+	assert_int_equal(rc, 0);
+	assert_int_equal(args.vua_hint[0]->vhd_off, blk_off + total);
+
+	/* Cancel the second batch, hint offset should be reverted */
+	rc = vea_reserve_vec(args.vua_vsi, nr, blk_cnts, h_ctxt, r_list);
+	assert_int_equal(rc, 0);
+	ext = d_list_entry(r_list->next, struct vea_resrvd_ext, vre_link);
+	assert_int_equal(ext->vre_blk_off, blk_off + total);
+
+	rc = vea_cancel(args.vua_vsi, h_ctxt, r_list);
+	assert_int_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, true, blk_off + total, total);
+	assert_int_equal(rc, 1);
+	assert_int_equal(h_ctxt->vhc_off, blk_off + total);
+
+	vea_hint_unload(h_ctxt);
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
+static void
+ut_seg_fit(void **state)
+{
+	struct vea_ut_args args;
+	struct vea_unmap_context unmap_ctxt;
+	struct vea_hint_context *h_ctxt;
+	struct vea_resrvd_ext *ext;
+	d_list_t *r_list;
+	uint32_t block_size = 0; /* use the default size */
+	uint32_t header_blocks = 1;
+	uint64_t capacity = ((VEA_LARGE_EXT_MB * 2) << 20); /* 128 MB */
+	uint64_t small_off;
+	int seg_fit, rc;
+
+	for (seg_fit = 0; seg_fit < 2; seg_fit++) {
+		print_message("Test small reserve, segregated-fit:%d\n",
+			      seg_fit);
+		ut_setup(&args);
+		rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md,
+				block_size, header_blocks, capacity, NULL,
+				NULL, false);
+		assert_int_equal(rc, 0);
+
+		setenv("VEA_SEG_FIT", seg_fit ? "1" : "0", 1);
+		unmap_ctxt.vnc_unmap = NULL;
+		unmap_ctxt.vnc_data = NULL;
+		rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md,
+			      &unmap_ctxt, &args.vua_vsi);
+		assert_int_equal(rc, 0);
+		unsetenv("VEA_SEG_FIT");
+
+		/*
+		 * Reserve two adjacent extents by hint, then free the first
+		 * one to make an isolated small free extent.
+		 */
+		r_list = &args.vua_resrvd_list[0];
+		rc = vea_hint_load(args.vua_hint[0], &h_ctxt);
+		assert_int_equal(rc, 0);
+		rc = vea_reserve(args.vua_vsi, 16, h_ctxt, r_list);
+		assert_int_equal(rc, 0);
+		rc = vea_reserve(args.vua_vsi, 16, h_ctxt, r_list);
+		assert_int_equal(rc, 0);
+		ext = d_list_entry(r_list->next, struct vea_resrvd_ext,
+				   vre_link);
+		small_off = ext->vre_blk_off;
+
+		rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+		assert_int_equal(rc, 0);
+		rc = vea_tx_publish(args.vua_vsi, h_ctxt, r_list);
+		assert_int_equal(rc, 0);
+		rc = umem_tx_commit(&args.vua_umm);
+		assert_int_equal(rc, 0);
+		vea_hint_unload(h_ctxt);
+
+		rc = vea_free(args.vua_vsi, small_off, 16);
+		assert_int_equal(rc, 0);
+		/* Force migration, make the freed extent visible */
+		args.vua_vsi->vsi_agg_time = 0;
+
+		/*
+		 * Default mode reserves from the large free extent, while
+		 * segregated-fit mode should reserve from the small one.
+		 */
+		rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+		assert_int_equal(rc, 0);
+		ext = d_list_entry(r_list->next, struct vea_resrvd_ext,
+				   vre_link);
+		if (seg_fit)
+			assert_int_equal(ext->vre_blk_off, small_off);
+		else
+			assert_int_not_equal(ext->vre_blk_off, small_off);
+
+		rc = vea_cancel(args.vua_vsi, NULL, r_list);
+		assert_int_equal(rc, 0);
+
+		vea_unload(args.vua_vsi);
+		ut_teardown(&args);
+	}
+}
+
 static const struct CMUnitTest vea_uts[] = {
 	{ "vea_format", ut_format, NULL, NULL},
 	{ "vea_load", ut_load, NULL, NULL},
@@ -1273,6 +1454,8 @@ static const struct CMUnitTest vea_uts[] = {
 	{ "vea_hint_unload", ut_hint_unload, NULL, NULL},
 	{ "vea_unload", ut_unload, NULL, NULL},
 	{ "vea_reserve_special", ut_reserve_special, NULL, NULL},
+	{ "vea_reserve_vec", ut_reserve_vec, NULL, NULL},
+	{ "vea_seg_fit", ut_seg_fit, NULL, NULL},
 	{ "vea_inval_params_format", ut_inval_params_format, NULL, NULL},
 	{ "vea_inval_params_load", ut_inval_params_load, NULL, NULL},
 	{ "vea_inval_param_reserve", ut_inval_params_reserve, NULL, NULL},
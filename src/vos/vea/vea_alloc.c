@@ -314,23 +314,56 @@ cursor_next(struct vea_free_class *vfc, struct free_ext_cursor *cursor)
 	return cursor->fec_cur;
 }
 
+/*
+ * Segregated-fit: first fit in the size class which @blk_cnt belongs to,
+ * otherwise, any extent from the smallest non-empty larger class.
+ */
+static struct vea_entry *
+seg_fit_find(struct vea_free_class *vfc, uint32_t blk_cnt)
+{
+	struct vea_entry *entry;
+	int i, idx;
+
+	idx = free_class_idx(vfc, blk_cnt);
+	d_list_for_each_entry(entry, &vfc->vfc_lrus[idx], ve_link) {
+		if (entry->ve_ext.vfe_blk_cnt >= blk_cnt)
+			return entry;
+	}
+
+	for (i = idx - 1; i >= 0; i--) {
+		if (d_list_empty(&vfc->vfc_lrus[i]))
+			continue;
+
+		entry = d_list_entry(vfc->vfc_lrus[i].next, struct vea_entry,
+				     ve_link);
+		D_ASSERT(entry->ve_ext.vfe_blk_cnt >= blk_cnt);
+		return entry;
+	}
+
+	return NULL;
+}
+
 int
 reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
 	      struct vea_resrvd_ext *resrvd)
 {
 	struct vea_free_extent vfe;
 	struct vea_entry *entry;
-	struct free_ext_cursor *cursor;
+	struct free_ext_cursor *cursor = NULL;
 	int rc = 0;
 
 	/* Skip huge allocate request */
 	if (blk_cnt > vsi->vsi_class.vfc_large_thresh)
 		return 0;
 
-	cursor = cursor_prepare(&vsi->vsi_class, blk_cnt);
-	D_ASSERT(cursor != NULL);
+	if (vsi->vsi_class.vfc_seg_fit) {
+		entry = seg_fit_find(&vsi->vsi_class, blk_cnt);
+	} else {
+		cursor = cursor_prepare(&vsi->vsi_class, blk_cnt);
+		D_ASSERT(cursor != NULL);
+		entry = cursor->fec_cur;
+	}
 
-	entry = cursor->fec_cur;
 	while (entry != NULL) {
 		if (entry->ve_ext.vfe_blk_cnt >= blk_cnt) {
 			vfe.vfe_blk_off = entry->ve_ext.vfe_blk_off;
@@ -349,6 +382,7 @@ reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
 				resrvd->vre_blk_off, resrvd->vre_blk_cnt);
 			break;
 		}
+		D_ASSERT(cursor != NULL);
 		entry = cursor_next(&vsi->vsi_class, cursor);
 	}
 
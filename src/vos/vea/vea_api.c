@@ -216,6 +216,7 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 {
 	struct umem_attr uma;
 	struct vea_space_info *vsi;
+	unsigned int seg_fit = 0;
 	int rc;
 
 	D_ASSERT(umem != NULL);
@@ -245,7 +246,8 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	vsi->vsi_agg_time = 0;
 	vsi->vsi_unmap_ctxt = *unmap_ctxt;
 
-	rc = create_free_class(&vsi->vsi_class, md);
+	d_getenv_int("VEA_SEG_FIT", &seg_fit);
+	rc = create_free_class(&vsi->vsi_class, md, seg_fit != 0);
 	if (rc)
 		goto error;
 
@@ -281,6 +283,36 @@ error:
 	return rc;
 }
 
+/* Reserve a contiguous extent from hint offset, large or small extents */
+static int
+reserve_contig(struct vea_space_info *vsi, uint32_t blk_cnt,
+	       struct vea_resrvd_ext *resrvd)
+{
+	int rc;
+
+	/* Reserve from hint offset */
+	rc = reserve_hint(vsi, blk_cnt, resrvd);
+	if (rc != 0 || resrvd->vre_blk_cnt != 0)
+		return rc;
+
+	/* Segregated-fit tries the small extents before the large ones */
+	if (vsi->vsi_class.vfc_seg_fit) {
+		rc = reserve_small(vsi, blk_cnt, resrvd);
+		if (rc != 0 || resrvd->vre_blk_cnt != 0)
+			return rc;
+
+		return reserve_large(vsi, blk_cnt, resrvd);
+	}
+
+	/* Reserve from the large extents */
+	rc = reserve_large(vsi, blk_cnt, resrvd);
+	if (rc != 0 || resrvd->vre_blk_cnt != 0)
+		return rc;
+
+	/* Reserve from the small extents */
+	return reserve_small(vsi, blk_cnt, resrvd);
+}
+
 /*
  * Reserve an extent on block device.
  *
@@ -324,22 +356,7 @@ migrate:
 	/* Trigger free extents migration */
 	migrate_free_exts(vsi);
 
-	/* Reserve from hint offset */
-	rc = reserve_hint(vsi, blk_cnt, resrvd);
-	if (rc != 0)
-		goto error;
-	else if (resrvd->vre_blk_cnt != 0)
-		goto done;
-
-	/* Reserve from the large extents */
-	rc = reserve_large(vsi, blk_cnt, resrvd);
-	if (rc != 0)
-		goto error;
-	else if (resrvd->vre_blk_cnt != 0)
-		goto done;
-
-	/* Reserve from the small extents */
-	rc = reserve_small(vsi, blk_cnt, resrvd);
+	rc = reserve_contig(vsi, blk_cnt, resrvd);
 	if (rc != 0)
 		goto error;
 	else if (resrvd->vre_blk_cnt != 0)
@@ -353,6 +370,8 @@ migrate:
 		retry = false;
 		goto migrate;
 	} else if (rc != 0) {
+		if (rc == -DER_NOSPACE)
+			vsi->vsi_stat[STAT_RESRV_FAIL] += 1;
 		goto error;
 	}
 done:
@@ -370,6 +389,96 @@ error:
 	return rc;
 }
 
+int
+vea_reserve_vec(struct vea_space_info *vsi, unsigned int nr,
+		uint32_t *blk_cnts, struct vea_hint_context *hint,
+		d_list_t *resrvd_list)
+{
+	struct vea_resrvd_ext *resrvd, *tmp;
+	struct vea_resrvd_ext whole;
+	d_list_t vec_list;
+	uint64_t blk_off, total = 0;
+	unsigned int i;
+	int rc = 0;
+
+	D_ASSERT(vsi != NULL);
+	D_ASSERT(resrvd_list != NULL);
+	D_ASSERT(nr == 0 || blk_cnts != NULL);
+
+	D_INIT_LIST_HEAD(&vec_list);
+	for (i = 0; i < nr; i++) {
+		D_ASSERT(blk_cnts[i] != 0);
+		total += blk_cnts[i];
+	}
+
+	if (nr < 2 || total > UINT32_MAX)
+		goto fallback;
+
+	/* Pre-allocate all the extents, so the split can't fail */
+	for (i = 0; i < nr; i++) {
+		D_ALLOC_PTR(resrvd);
+		if (resrvd == NULL)
+			D_GOTO(error, rc = -DER_NOMEM);
+		d_list_add_tail(&resrvd->vre_link, &vec_list);
+	}
+
+	memset(&whole, 0, sizeof(whole));
+	whole.vre_hint_off = VEA_HINT_OFF_INVAL;
+	hint_get(hint, &whole.vre_hint_off);
+
+	/* Try to satisfy the whole batch by a single contiguous extent */
+	migrate_free_exts(vsi);
+	rc = reserve_contig(vsi, total, &whole);
+	if (rc != 0)
+		goto error;
+
+	if (whole.vre_blk_cnt == 0) {
+		d_list_for_each_entry_safe(resrvd, tmp, &vec_list, vre_link) {
+			d_list_del(&resrvd->vre_link);
+			D_FREE(resrvd);
+		}
+		goto fallback;
+	}
+	D_ASSERT(whole.vre_blk_cnt == total);
+
+	/*
+	 * Split the extent as if it's reserved by a series of vea_reserve()
+	 * calls, so that the hint sequence is kept for vea_cancel().
+	 */
+	blk_off = whole.vre_blk_off;
+	i = 0;
+	d_list_for_each_entry(resrvd, &vec_list, vre_link) {
+		resrvd->vre_hint_off = (i == 0) ? whole.vre_hint_off : blk_off;
+		resrvd->vre_blk_off = blk_off;
+		resrvd->vre_blk_cnt = blk_cnts[i];
+		blk_off += blk_cnts[i];
+		hint_update(hint, blk_off, &resrvd->vre_hint_seq);
+		i++;
+	}
+	d_list_splice_init(&vec_list, resrvd_list->prev);
+
+	return 0;
+
+fallback:
+	/* Reserve the extents one by one */
+	for (i = 0; i < nr; i++) {
+		rc = vea_reserve(vsi, blk_cnts[i], hint, &vec_list);
+		if (rc != 0) {
+			vea_cancel(vsi, hint, &vec_list);
+			return rc;
+		}
+	}
+	d_list_splice_init(&vec_list, resrvd_list->prev);
+
+	return 0;
+error:
+	d_list_for_each_entry_safe(resrvd, tmp, &vec_list, vre_link) {
+		d_list_del(&resrvd->vre_link);
+		D_FREE(resrvd);
+	}
+	return rc;
+}
+
 static int
 process_resrvd_list(struct vea_space_info *vsi, struct vea_hint_context *hint,
 		    d_list_t *resrvd_list, bool publish)
@@ -635,11 +744,18 @@ count_free_transient(daos_handle_t ih, d_iov_t *key, d_iov_t *val,
 		     void *arg)
 {
 	struct vea_entry	*ve;
-	uint64_t		*free_blks = arg;
+	struct vea_stat		*stat = arg;
+	int			 bucket;
 
 	ve = (struct vea_entry *)val->iov_buf;
-	D_ASSERT(free_blks != NULL);
-	*free_blks += ve->ve_ext.vfe_blk_cnt;
+	D_ASSERT(stat != NULL);
+	stat->vs_free_transient += ve->ve_ext.vfe_blk_cnt;
+
+	/* Fill the free extent size histogram */
+	bucket = 31 - __builtin_clz(ve->ve_ext.vfe_blk_cnt);
+	if (bucket >= VEA_FRAGS_HIST_SZ)
+		bucket = VEA_FRAGS_HIST_SZ - 1;
+	stat->vs_frags_hist[bucket]++;
 
 	return 0;
 }
@@ -678,9 +794,9 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 			return rc;
 
 		stat->vs_free_transient = 0;
+		memset(stat->vs_frags_hist, 0, sizeof(stat->vs_frags_hist));
 		rc = dbtree_iterate(vsi->vsi_free_btr, DAOS_INTENT_DEFAULT,
-				    false, count_free_transient,
-				    (void *)&stat->vs_free_transient);
+				    false, count_free_transient, (void *)stat);
 		if (rc != 0)
 			return rc;
 
@@ -714,6 +830,7 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 		stat->vs_resrv_large = vsi->vsi_stat[STAT_RESRV_LARGE];
 		stat->vs_resrv_small = vsi->vsi_stat[STAT_RESRV_SMALL];
 		stat->vs_resrv_vec = vsi->vsi_stat[STAT_RESRV_VEC];
+		stat->vs_resrv_fail = vsi->vsi_stat[STAT_RESRV_FAIL];
 	}
 
 	return 0;
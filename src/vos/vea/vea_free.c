@@ -130,18 +130,7 @@ repeat:
 static d_list_t *
 blkcnt_to_lru(struct vea_free_class *vfc, uint32_t blkcnt)
 {
-	int idx;
-
-	D_ASSERTF(blkcnt <= vfc->vfc_sizes[0], "%u, %u\n",
-		  blkcnt, vfc->vfc_sizes[0]);
-	D_ASSERT(vfc->vfc_lru_cnt > 0);
-
-	for (idx = 0; idx < (vfc->vfc_lru_cnt - 1); idx++) {
-		if (blkcnt > vfc->vfc_sizes[idx + 1])
-			break;
-	}
-
-	return &vfc->vfc_lrus[idx];
+	return &vfc->vfc_lrus[free_class_idx(vfc, blkcnt)];
 }
 
 /* Free extent to in-memory compound index */
@@ -65,7 +65,8 @@ struct d_binheap_ops heap_ops = {
 };
 
 int
-create_free_class(struct vea_free_class *vfc, struct vea_space_df *md)
+create_free_class(struct vea_free_class *vfc, struct vea_space_df *md,
+		  bool seg_fit)
 {
 	uint32_t max_blks, min_blks;
 	int rc, i, lru_cnt, size;
@@ -78,11 +79,13 @@ create_free_class(struct vea_free_class *vfc, struct vea_space_df *md)
 	/*
 	 * Divide free extents smaller than VEA_LARGE_EXT_MB into bunch of
 	 * size classed groups, the size upper bound of each group will be
-	 * max_blks, max_blks/2, max_blks/4 ... min_blks.
+	 * max_blks, max_blks/2, max_blks/4 ... min_blks. The min_blks is 1MB
+	 * by default, and single block for segregated-fit mode.
 	 */
 	D_ASSERT(md->vsd_blk_sz > 0 && md->vsd_blk_sz <= (1U << 20));
 	max_blks = (VEA_LARGE_EXT_MB << 20) / md->vsd_blk_sz;
-	min_blks = (1U << 20) / md->vsd_blk_sz;
+	min_blks = seg_fit ? 1 : (1U << 20) / md->vsd_blk_sz;
+	vfc->vfc_seg_fit = seg_fit;
 
 	vfc->vfc_large_thresh = max_blks;
 	lru_cnt = 1;
@@ -66,6 +66,11 @@ struct free_ext_cursor {
  * Large free extents (>=VEA_LARGE_EXT_MB) are tracked in max a heap, small
  * free extents (< VEA_LARGE_EXT_MB) are tracked in size categorized LRUs
  * respectively.
+ *
+ * In segregated-fit mode (enabled by environment variable VEA_SEG_FIT), the
+ * size classes go down to single block, and a small reserve is satisfied
+ * from the size class it belongs to before trying larger classes and large
+ * extents, so that small requests don't keep carving the large extents.
  */
 struct vea_free_class {
 	/* Max heap for tracking the largest free extent */
@@ -88,13 +93,34 @@ struct vea_free_class {
 	 * from small extents.
 	 */
 	struct free_ext_cursor	*vfc_cursor;
+	/* Segregated-fit mode */
+	bool			 vfc_seg_fit;
 };
 
+/* Index of the size class which the extent in @blkcnt belongs to */
+static inline int
+free_class_idx(struct vea_free_class *vfc, uint32_t blkcnt)
+{
+	int idx;
+
+	D_ASSERTF(blkcnt <= vfc->vfc_sizes[0], "%u, %u\n",
+		  blkcnt, vfc->vfc_sizes[0]);
+	D_ASSERT(vfc->vfc_lru_cnt > 0);
+
+	for (idx = 0; idx < (vfc->vfc_lru_cnt - 1); idx++) {
+		if (blkcnt > vfc->vfc_sizes[idx + 1])
+			break;
+	}
+
+	return idx;
+}
+
 enum {
 	STAT_RESRV_HINT	= 0,
 	STAT_RESRV_LARGE,
 	STAT_RESRV_SMALL,
 	STAT_RESRV_VEC,
+	STAT_RESRV_FAIL,
 	STAT_MAX,
 };
 
@@ -161,7 +187,8 @@ enum vea_free_flags {
 
 /* vea_init.c */
 void destroy_free_class(struct vea_free_class *vfc);
-int create_free_class(struct vea_free_class *vfc, struct vea_space_df *md);
+int create_free_class(struct vea_free_class *vfc, struct vea_space_df *md,
+		      bool seg_fit);
 void unload_space_info(struct vea_space_info *vsi);
 int load_space_info(struct vea_space_info *vsi);
 
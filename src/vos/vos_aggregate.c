@@ -649,24 +649,123 @@ merge_window_size(struct agg_merge_window *mw)
 	return evt_extent_width(&mw->mw_ext) * mw->mw_rsize;
 }
 
+/*
+ * Sleep \a us microseconds without occupying the xstream, other ULTs (and
+ * the foreground I/O) can run meanwhile. Fall back to yield if the wait
+ * objects can't be created.
+ */
+static void
+agg_throttle_sleep(struct vos_agg_throttle *at, uint64_t us)
+{
+	struct timespec	ts;
+	int		rc;
+
+	D_ASSERT(pmemobj_tx_stage() == TX_STAGE_NONE);
+	if (at->at_lock == ABT_MUTEX_NULL) {
+		rc = ABT_mutex_create(&at->at_lock);
+		if (rc != ABT_SUCCESS)
+			goto yield;
+	}
+	if (at->at_cond == ABT_COND_NULL) {
+		rc = ABT_cond_create(&at->at_cond);
+		if (rc != ABT_SUCCESS)
+			goto yield;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += us / 1000000;
+	ts.tv_nsec += (us % 1000000) * 1000;
+	if (ts.tv_nsec >= 1000000000) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000;
+	}
+
+	/* Nobody signals the condition, it always times out */
+	ABT_mutex_lock(at->at_lock);
+	ABT_cond_timedwait(at->at_cond, at->at_lock, &ts);
+	ABT_mutex_unlock(at->at_lock);
+	return;
+yield:
+	ABT_thread_yield();
+}
+
+/*
+ * Aggregation I/O throttle, it's shared by all the aggregation ULTs running
+ * on the same xstream, so the total aggregation bandwidth & IOPS of the VOS
+ * target stays within the configured budget no matter how many containers
+ * are being aggregated concurrently.
+ */
+void
+vos_agg_throttle(daos_size_t bytes, unsigned int ios, unsigned int *acts)
+{
+	struct vos_agg_throttle	*at = vos_agg_throttle_get();
+	uint64_t		 now, elapsed, wait;
+
+	if (at->at_bw == 0 && at->at_iops == 0)
+		return;
+
+	at->at_bytes -= bytes;
+	at->at_ios -= ios;
+
+	while (1) {
+		now = d_timeus_secdiff(0);
+		elapsed = MIN(now - at->at_refill, 1000000);
+		at->at_refill = now;
+
+		/* Refill the budget, allow at most one second of burst */
+		if (at->at_bw != 0) {
+			at->at_bytes += elapsed * at->at_bw / 1000000;
+			if (at->at_bytes > (int64_t)at->at_bw)
+				at->at_bytes = at->at_bw;
+		} else {
+			at->at_bytes = 0;
+		}
+
+		if (at->at_iops != 0) {
+			at->at_ios += elapsed * at->at_iops / 1000000;
+			if (at->at_ios > (int64_t)at->at_iops)
+				at->at_ios = at->at_iops;
+		} else {
+			at->at_ios = 0;
+		}
+
+		if (at->at_bytes >= 0 && at->at_ios >= 0)
+			break;
+
+		/* Budget exhausted, sleep until the deficit is refilled and
+		 * give the CPU to foreground I/O meanwhile.
+		 */
+		wait = 1;
+		if (at->at_bytes < 0)
+			wait = max(wait, -at->at_bytes * 1000000 / at->at_bw);
+		if (at->at_ios < 0)
+			wait = max(wait, -at->at_ios * 1000000 / at->at_iops);
+
+		*acts |= VOS_ITER_CB_YIELD;
+		agg_throttle_sleep(at, wait);
+	}
+}
+
+/*
+ * Reserve new segment, and append the source and target addresses of the
+ * data transfer to @bsgl_src and @bsgl_dst.
+ */
 static int
-fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
-		 struct agg_lgc_seg *lgc_seg, unsigned int *acts)
+prep_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
+		 struct agg_lgc_seg *lgc_seg, struct bio_sglist *bsgl_src,
+		 struct bio_sglist *bsgl_dst, unsigned int *acts)
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
 	struct vos_object	*obj = oiter->it_obj;
 	struct agg_io_context	*io = &mw->mw_io_ctxt;
 	struct evt_entry_in	*ent_in = &lgc_seg->ls_ent_in;
 	struct agg_phy_ent	*phy_ent;
-	struct bio_io_context	*bio_ctxt;
-	struct bio_sglist	 bsgl;
-	d_sg_list_t		 sgl;
-	d_iov_t		 iov;
-	bio_addr_t		 addr_dst, addr_src;
-	daos_size_t		 seg_size, copy_size, buf_max;
+	struct bio_iov		*biov;
+	bio_addr_t		 addr_src;
+	daos_size_t		 seg_size, copy_size, copied = 0;
 	struct evt_extent	 ext = { 0 };
 	daos_off_t		 phy_lo;
-	unsigned int		 i, biov_idx = 0;
+	unsigned int		 i;
 	int			 rc;
 
 	D_ASSERT(obj != NULL);
@@ -678,19 +777,6 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 	seg_size = evt_rect_width(&ent_in->ei_rect) * mw->mw_rsize;
 	D_ASSERTF(seg_size > 0, "seg_size:"DF_U64"\n", seg_size);
 
-	buf_max = MAX(seg_size, merge_window_size(mw));
-	buf_max = MAX(buf_max, VOS_MW_FLUSH_THRESH);
-	if (io->ic_buf_len < buf_max) {
-		void *buffer;
-
-		D_REALLOC(buffer, io->ic_buf, buf_max);
-		if (buffer == NULL)
-			return -DER_NOMEM;
-
-		io->ic_buf = buffer;
-		io->ic_buf_len = buf_max;
-	}
-
 	rc = reserve_segment(obj, io, seg_size, &ent_in->ei_addr);
 	if (rc) {
 		D_ERROR("Reserve "DF_U64" segment error: %d\n", seg_size, rc);
@@ -701,18 +787,6 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 	D_ASSERT(lgc_seg->ls_idx_start <= lgc_seg->ls_idx_end);
 	D_ASSERT(lgc_seg->ls_idx_end < mw->mw_lgc_cnt);
 
-	bio_ctxt = obj->obj_cont->vc_pool->vp_io_ctxt;
-	D_ASSERT(bio_ctxt != NULL);
-
-	rc = bio_sgl_init(&bsgl, lgc_seg->ls_idx_end -
-			  lgc_seg->ls_idx_start + 1);
-	if (rc) {
-		D_ERROR("Init bsgl error: %d\n", rc);
-		return rc;
-	}
-
-	iov.iov_buf_len = io->ic_buf_len; /* for sanity check */
-
 	i = lgc_seg->ls_idx_start;
 	while (i <= lgc_seg->ls_idx_end) {
 		if (lgc_seg->ls_phy_ent != NULL) {
@@ -742,57 +816,48 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 		addr_src.ba_off += (ext.ex_lo - phy_lo) * ent_in->ei_inob;
 
 		D_ASSERT(!bio_addr_is_hole(&addr_src));
-		D_ASSERT(iov.iov_buf_len >= copy_size);
-
 		mark_yield(&addr_src, acts);
-		D_ASSERT(biov_idx < bsgl.bs_nr);
-		bsgl.bs_iovs[biov_idx].bi_buf = NULL;
-		bsgl.bs_iovs[biov_idx].bi_addr = addr_src;
-		bsgl.bs_iovs[biov_idx].bi_data_len = copy_size;
-		biov_idx++;
-
-		D_ASSERT(iov.iov_buf_len >= copy_size);
-		iov.iov_buf_len -= copy_size;
-	}
-	D_ASSERT(seg_size == (io->ic_buf_len - iov.iov_buf_len));
 
-	iov.iov_buf = io->ic_buf;
-	iov.iov_len = 0;
-	iov.iov_buf_len = io->ic_buf_len;
-	sgl.sg_nr = 1;
-	sgl.sg_iovs = &iov;
-	rc = bio_readv(bio_ctxt, &bsgl, &sgl);
-	if (rc) {
-		D_ERROR("Readv for "DF_RECT" error: %d\n",
-			DP_RECT(&ent_in->ei_rect), rc);
-		bio_sgl_fini(&bsgl);
-		return rc;
+		D_ASSERT(bsgl_src->bs_nr_out < bsgl_src->bs_nr);
+		biov = &bsgl_src->bs_iovs[bsgl_src->bs_nr_out++];
+		biov->bi_buf = NULL;
+		biov->bi_addr = addr_src;
+		biov->bi_data_len = copy_size;
+		copied += copy_size;
 	}
-	D_ASSERT(iov.iov_len == seg_size);
+	D_ASSERT(seg_size == copied);
 
-	addr_dst = ent_in->ei_addr;
-	D_ASSERT(!bio_addr_is_hole(&addr_dst));
-	mark_yield(&addr_dst, acts);
+	D_ASSERT(!bio_addr_is_hole(&ent_in->ei_addr));
+	mark_yield(&ent_in->ei_addr, acts);
 
-	iov.iov_buf = io->ic_buf;
-	iov.iov_buf_len = io->ic_buf_len;
-	iov.iov_len = seg_size;
-	rc = bio_write(bio_ctxt, addr_dst, &iov);
-	if (rc)
-		D_ERROR("Write "DF_RECT" error: %d\n",
-			DP_RECT(&ent_in->ei_rect), rc);
+	D_ASSERT(bsgl_dst->bs_nr_out < bsgl_dst->bs_nr);
+	biov = &bsgl_dst->bs_iovs[bsgl_dst->bs_nr_out++];
+	biov->bi_buf = NULL;
+	biov->bi_addr = ent_in->ei_addr;
+	biov->bi_data_len = seg_size;
 
-	bio_sgl_fini(&bsgl);
-	return rc;
+	return 0;
 }
 
+/*
+ * Transfer data of all the segments in merge window with a single readv and
+ * a single writev, so that the I/Os of different segments are submitted to
+ * NVMe device together instead of waiting on completion one by one.
+ */
 static int
 fill_segments(daos_handle_t ih, struct agg_merge_window *mw,
 	      unsigned int *acts)
 {
+	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
+	struct vos_object	*obj = oiter->it_obj;
 	struct agg_io_context	*io = &mw->mw_io_ctxt;
 	struct agg_lgc_seg	*lgc_seg;
-	unsigned int		 i, scm_max;
+	struct bio_io_context	*bio_ctxt;
+	struct bio_sglist	 bsgl_src, bsgl_dst;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	daos_size_t		 total = 0, buf_max;
+	unsigned int		 i, scm_max, src_nr = 0, dst_nr = 0;
 	int			 rc = 0;
 
 	scm_max = MAX(io->ic_seg_cnt, 200);
@@ -810,6 +875,45 @@ fill_segments(daos_handle_t ih, struct agg_merge_window *mw,
 	memset(io->ic_scm_exts, 0, io->ic_scm_max * sizeof(*io->ic_scm_exts));
 	D_ASSERT(io->ic_scm_cnt == 0);
 
+	for (i = 0; i < io->ic_seg_cnt; i++) {
+		lgc_seg = &io->ic_segs[i];
+		if (bio_addr_is_hole(&lgc_seg->ls_ent_in.ei_addr))
+			continue;
+
+		total += evt_rect_width(&lgc_seg->ls_ent_in.ei_rect) *
+			 mw->mw_rsize;
+		src_nr += lgc_seg->ls_idx_end - lgc_seg->ls_idx_start + 1;
+		dst_nr++;
+	}
+
+	if (dst_nr == 0)
+		return 0;
+
+	buf_max = MAX(total, VOS_MW_FLUSH_THRESH);
+	if (io->ic_buf_len < buf_max) {
+		void *buffer;
+
+		D_REALLOC(buffer, io->ic_buf, buf_max);
+		if (buffer == NULL)
+			return -DER_NOMEM;
+
+		io->ic_buf = buffer;
+		io->ic_buf_len = buf_max;
+	}
+
+	rc = bio_sgl_init(&bsgl_src, src_nr);
+	if (rc) {
+		D_ERROR("Init bsgl error: %d\n", rc);
+		return rc;
+	}
+
+	rc = bio_sgl_init(&bsgl_dst, dst_nr);
+	if (rc) {
+		D_ERROR("Init bsgl error: %d\n", rc);
+		bio_sgl_fini(&bsgl_src);
+		return rc;
+	}
+
 	for (i = 0; i < io->ic_seg_cnt; i++) {
 		lgc_seg = &io->ic_segs[i];
 
@@ -817,16 +921,45 @@ fill_segments(daos_handle_t ih, struct agg_merge_window *mw,
 			lgc_seg->ls_idx_start, lgc_seg->ls_idx_end,
 			DP_RECT(&lgc_seg->ls_ent_in.ei_rect));
 
-		rc = fill_one_segment(ih, mw, lgc_seg, acts);
+		rc = prep_one_segment(ih, mw, lgc_seg, &bsgl_src, &bsgl_dst,
+				      acts);
 		if (rc) {
 			D_ERROR("Fill seg %u-%u %p "DF_RECT" error: %d\n",
 				lgc_seg->ls_idx_start, lgc_seg->ls_idx_end,
 				lgc_seg->ls_phy_ent,
 				DP_RECT(&lgc_seg->ls_ent_in.ei_rect), rc);
-			break;
+			goto out;
 		}
 	}
+	D_ASSERT(bsgl_src.bs_nr_out == src_nr);
+	D_ASSERT(bsgl_dst.bs_nr_out == dst_nr);
 
+	vos_agg_throttle(total * 2, src_nr + dst_nr, acts);
+
+	bio_ctxt = obj->obj_cont->vc_pool->vp_io_ctxt;
+	D_ASSERT(bio_ctxt != NULL);
+
+	iov.iov_buf = io->ic_buf;
+	iov.iov_len = 0;
+	iov.iov_buf_len = io->ic_buf_len;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+	rc = bio_readv(bio_ctxt, &bsgl_src, &sgl);
+	if (rc) {
+		D_ERROR("Readv for "DF_EXT" error: %d\n",
+			DP_EXT(&mw->mw_ext), rc);
+		goto out;
+	}
+	D_ASSERT(iov.iov_len == total);
+
+	rc = bio_writev(bio_ctxt, &bsgl_dst, &sgl);
+	if (rc)
+		D_ERROR("Writev for "DF_EXT" error: %d\n",
+			DP_EXT(&mw->mw_ext), rc);
+out:
+	bio_sgl_fini(&bsgl_dst);
+	bio_sgl_fini(&bsgl_src);
 	return rc;
 }
 
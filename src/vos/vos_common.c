@@ -109,6 +109,50 @@ vos_imem_strts_destroy(struct vos_imem_strts *imem_inst)
 
 	if (imem_inst->vis_cont_hhash)
 		d_uhash_destroy(imem_inst->vis_cont_hhash);
+
+	if (imem_inst->vis_agg_throttle.at_cond != ABT_COND_NULL)
+		ABT_cond_free(&imem_inst->vis_agg_throttle.at_cond);
+	if (imem_inst->vis_agg_throttle.at_lock != ABT_MUTEX_NULL)
+		ABT_mutex_free(&imem_inst->vis_agg_throttle.at_lock);
+}
+
+/**
+ * Size of the per-xstream object cache, it can be tuned by the environment
+ * variable VOS_OBJ_CACHE_BITS, the cache holds (1 << bits) objects.
+ */
+static unsigned int
+vos_obj_cache_bits(void)
+{
+	unsigned int bits = LRU_CACHE_BITS;
+
+	d_getenv_int("VOS_OBJ_CACHE_BITS", &bits);
+	if (bits < LRU_CACHE_BITS_MIN || bits > LRU_CACHE_BITS_MAX) {
+		D_ERROR("Invalid VOS_OBJ_CACHE_BITS %u, using %u\n",
+			bits, LRU_CACHE_BITS);
+		bits = LRU_CACHE_BITS;
+	}
+	return bits;
+}
+
+static void
+vos_agg_throttle_init(struct vos_agg_throttle *at)
+{
+	unsigned int bw = 0, iops = 0;
+
+	d_getenv_int("VOS_AGG_BW", &bw);
+	d_getenv_int("VOS_AGG_IOPS", &iops);
+
+	at->at_bw = (uint64_t)bw << 20;
+	at->at_iops = iops;
+	at->at_bytes = at->at_bw;
+	at->at_ios = at->at_iops;
+	at->at_refill = d_timeus_secdiff(0);
+	at->at_lock = ABT_MUTEX_NULL;
+	at->at_cond = ABT_COND_NULL;
+
+	if (bw != 0 || iops != 0)
+		D_DEBUG(DB_EPC, "Aggregation budget %u MB/s, %u IOPS\n",
+			bw, iops);
 }
 
 static inline int
@@ -118,7 +162,9 @@ vos_imem_strts_create(struct vos_imem_strts *imem_inst)
 	int		rc;
 
 	imem_inst->vis_enable_checksum = 0;
-	rc = vos_obj_cache_create(LRU_CACHE_BITS,
+	vos_agg_throttle_init(&imem_inst->vis_agg_throttle);
+
+	rc = vos_obj_cache_create(vos_obj_cache_bits(),
 				  &imem_inst->vis_ocache);
 	if (rc) {
 		D_ERROR("Error in createing object cache\n");
@@ -196,6 +196,7 @@ cont_free(struct d_ulink *ulink)
 	cont = container_of(ulink, struct vos_container, vc_uhlink);
 	if (!daos_handle_is_inval(cont->vc_dtx_cos_hdl))
 		dbtree_destroy(cont->vc_dtx_cos_hdl);
+	vos_dtx_hash_fini(cont);
 	D_ASSERT(d_list_empty(&cont->vc_dtx_committable));
 	dbtree_close(cont->vc_dtx_active_hdl);
 	dbtree_close(cont->vc_dtx_committed_hdl);
@@ -409,6 +410,8 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		D_GOTO(exit, rc);
 	}
 
+	vos_dtx_hash_init(cont);
+
 	if (cont->vc_pool->vp_vea_info != NULL) {
 		int	i;
 
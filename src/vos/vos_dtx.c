@@ -700,14 +700,25 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti)
 	struct vos_dtx_entry_df		*dtx;
 	struct vos_dtx_entry_df		*ent;
 	struct vos_dtx_table_df		*tab;
+	struct vos_dtx_hent		*hent;
 	struct dtx_rec_bundle		 rbund;
 	d_iov_t			 kiov;
 	d_iov_t			 riov;
 	umem_off_t			 umoff;
 	int				 rc = 0;
 
+	rc = vos_dtx_hash_find(cont, dti, &hent);
+	if (rc == VOS_DTX_HASH_COMMITTED)
+		D_GOTO(out, rc = 0);
+
+	if (rc == VOS_DTX_HASH_NONEXIST)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
 	d_iov_set(&kiov, dti, sizeof(*dti));
-	rc = dbtree_delete(cont->vc_dtx_active_hdl, &kiov, &umoff);
+	if (rc == VOS_DTX_HASH_INACTIVE)
+		rc = -DER_NONEXIST;
+	else
+		rc = dbtree_delete(cont->vc_dtx_active_hdl, &kiov, &umoff);
 	if (rc == -DER_NONEXIST) {
 		d_iov_set(&riov, NULL, 0);
 		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
@@ -728,6 +739,7 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti)
 	if (rc != 0)
 		goto out;
 
+	vos_dtx_hash_commit(cont, dti);
 	tab = &cont->vc_cont_df->cd_dtx_table_df;
 	umem_tx_add_ptr(umm, tab, sizeof(*tab));
 
@@ -767,14 +779,22 @@ static int
 vos_dtx_abort_one(struct vos_container *cont, struct dtx_id *dti,
 		  bool force)
 {
+	struct vos_dtx_hent	*hent;
 	d_iov_t	 kiov;
 	umem_off_t	 dtx;
 	int		 rc;
 
-	d_iov_set(&kiov, dti, sizeof(*dti));
-	rc = dbtree_delete(cont->vc_dtx_active_hdl, &kiov, &dtx);
-	if (rc == 0)
+	rc = vos_dtx_hash_find(cont, dti, &hent);
+	if (rc != VOS_DTX_HASH_UNKNOWN && rc != VOS_DTX_HASH_ACTIVE) {
+		rc = -DER_NONEXIST;
+	} else {
+		d_iov_set(&kiov, dti, sizeof(*dti));
+		rc = dbtree_delete(cont->vc_dtx_active_hdl, &kiov, &dtx);
+	}
+	if (rc == 0) {
+		vos_dtx_hash_delete(cont, dti);
 		dtx_rec_release(&cont->vc_pool->vp_umm, dtx, true, true);
+	}
 
 	D_DEBUG(DB_TRACE, "Abort the DTX "DF_DTI": rc = %d\n", DP_DTI(dti), rc);
 
@@ -842,6 +862,7 @@ vos_dtx_alloc(struct umem_instance *umm, struct dtx_handle *dth,
 	rc = dbtree_upsert(cont->vc_dtx_active_hdl, BTR_PROBE_EQ,
 			   DAOS_INTENT_UPDATE, &kiov, &riov);
 	if (rc == 0) {
+		vos_dtx_hash_insert(cont, &dth->dth_xid, dtx_umoff);
 		dth->dth_ent = dtx_umoff;
 		*dtxp = dtx;
 	}
@@ -1196,11 +1217,21 @@ vos_dtx_check_availability(struct umem_instance *umm, daos_handle_t coh,
 		return hidden ? ALB_UNAVAILABLE : ALB_AVAILABLE_CLEAN;
 	case DTX_ST_PREPARED: {
 		struct vos_container	*cont = vos_hdl2cont(coh);
+		struct vos_dtx_hent	*hent;
 		int			 rc;
 
-		rc = vos_dtx_lookup_cos(coh, &dtx->te_oid, &dtx->te_xid,
-			dtx->te_dkey_hash,
-			dtx->te_intent == DAOS_INTENT_PUNCH ? true : false);
+		/* The hash table knows whether the DTX is in the CoS cache,
+		 * only look up the CoS cache if the hash table is unusable.
+		 * Do not rebuild the stale table on the fetch/iterate path.
+		 */
+		rc = vos_dtx_hash_lookup(cont, &dtx->te_xid, &hent);
+		if (rc == VOS_DTX_HASH_ACTIVE)
+			rc = hent->he_committable ? 0 : -DER_NONEXIST;
+		else
+			rc = vos_dtx_lookup_cos(coh, &dtx->te_oid,
+				&dtx->te_xid, dtx->te_dkey_hash,
+				dtx->te_intent == DAOS_INTENT_PUNCH ?
+				true : false);
 		if (rc == 0) {
 			/* XXX: For the committable punch DTX, if there is
 			 *	pending exchange (of sub-trees) operation,
@@ -1468,17 +1499,29 @@ vos_dtx_prepared(struct dtx_handle *dth)
 
 	dtx = umem_off2ptr(&cont->vc_pool->vp_umm, dth->dth_ent);
 	if (dth->dth_intent == DAOS_INTENT_UPDATE) {
-		d_iov_t	kiov;
-		d_iov_t	riov;
+		struct vos_dtx_hent	*hent;
+		d_iov_t			 kiov;
+		d_iov_t			 riov;
 
 		/* There is CPU yield during the bulk transfer, then it is
 		 * possible that some others (rebuild) abort this DTX by race.
 		 * So we need to locate (or verify) DTX via its ID instead of
 		 * directly using the dth_ent.
 		 */
-		d_iov_set(&kiov, &dth->dth_xid, sizeof(struct dtx_id));
-		d_iov_set(&riov, NULL, 0);
-		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
+		rc = vos_dtx_hash_find(cont, &dth->dth_xid, &hent);
+		if (rc == VOS_DTX_HASH_ACTIVE) {
+			d_iov_set(&riov, umem_off2ptr(&cont->vc_pool->vp_umm,
+						      hent->he_umoff),
+				  sizeof(*dtx));
+			rc = 0;
+		} else if (rc != VOS_DTX_HASH_UNKNOWN) {
+			rc = -DER_NONEXIST;
+		} else {
+			d_iov_set(&kiov, &dth->dth_xid, sizeof(struct dtx_id));
+			d_iov_set(&riov, NULL, 0);
+			rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov,
+					   &riov);
+		}
 		if (rc == -DER_NONEXIST)
 			/* The DTX has been aborted by race, notify the RPC
 			 * sponsor to retry via returning -DER_INPROGRESS.
@@ -1522,6 +1565,8 @@ vos_dtx_check_committable(daos_handle_t coh, daos_unit_oid_t *oid,
 			  bool punch)
 {
 	struct vos_container	*cont;
+	struct vos_dtx_entry_df	*dtx;
+	struct vos_dtx_hent	*hent;
 	d_iov_t		 kiov;
 	d_iov_t		 riov;
 	int			 rc;
@@ -1535,12 +1580,26 @@ vos_dtx_check_committable(daos_handle_t coh, daos_unit_oid_t *oid,
 			return DTX_ST_COMMITTED;
 	}
 
+	rc = vos_dtx_hash_find(cont, dti, &hent);
+	switch (rc) {
+	case VOS_DTX_HASH_ACTIVE:
+		dtx = umem_off2ptr(&cont->vc_pool->vp_umm, hent->he_umoff);
+		return dtx->te_state;
+	case VOS_DTX_HASH_COMMITTED:
+		return DTX_ST_COMMITTED;
+	case VOS_DTX_HASH_NONEXIST:
+		return -DER_NONEXIST;
+	default:
+		break;
+	}
+
 	d_iov_set(&kiov, dti, sizeof(*dti));
 	d_iov_set(&riov, NULL, 0);
-	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
+	if (rc == VOS_DTX_HASH_INACTIVE)
+		rc = -DER_NONEXIST;
+	else
+		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 	if (rc == 0) {
-		struct vos_dtx_entry_df	*dtx;
-
 		dtx = (struct vos_dtx_entry_df *)riov.iov_buf;
 		return dtx->te_state;
 	}
@@ -1649,6 +1708,7 @@ vos_dtx_aggregate(daos_handle_t coh, uint64_t max, uint64_t age)
 		d_iov_set(&kiov, &dtx->te_xid, sizeof(dtx->te_xid));
 		rc = dbtree_delete(cont->vc_dtx_committed_hdl, &kiov, &umoff);
 		D_ASSERT(rc == 0);
+		vos_dtx_hash_delete(cont, &dtx->te_xid);
 
 		tab->tt_count--;
 		dtx_umoff = dtx->te_next;
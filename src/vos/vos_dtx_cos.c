@@ -142,6 +142,7 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	d_list_add_tail(&dcrc->dcrc_committable,
 			&rbund->cont->vc_dtx_committable);
 	rbund->cont->vc_dtx_committable_count++;
+	vos_dtx_hash_set_committable(rbund->cont, rbund->dti, true);
 
 	if (rbund->punch) {
 		d_list_add_tail(&dcrc->dcrc_link, &dcr->dcr_punch_list);
@@ -222,6 +223,7 @@ dtx_cos_rec_update(struct btr_instance *tins, struct btr_record *rec,
 	d_list_add_tail(&dcrc->dcrc_committable,
 			&rbund->cont->vc_dtx_committable);
 	rbund->cont->vc_dtx_committable_count++;
+	vos_dtx_hash_set_committable(rbund->cont, rbund->dti, true);
 
 	if (rbund->punch) {
 		d_list_add_tail(&dcrc->dcrc_link, &dcr->dcr_punch_list);
@@ -429,7 +431,8 @@ vos_dtx_lookup_cos(daos_handle_t coh, daos_unit_oid_t *oid,
 }
 
 int
-vos_dtx_fetch_committable(daos_handle_t coh, int max, struct dtx_entry **dtes)
+vos_dtx_fetch_committable(daos_handle_t coh, int skip, int max,
+			  struct dtx_entry **dtes)
 {
 	struct dtx_entry		*dte = NULL;
 	struct dtx_cos_rec_child	*dcrc;
@@ -440,10 +443,12 @@ vos_dtx_fetch_committable(daos_handle_t coh, int max, struct dtx_entry **dtes)
 	cont = vos_hdl2cont(coh);
 	D_ASSERT(cont != NULL);
 
-	if (cont->vc_dtx_committable_count > max)
+	if (cont->vc_dtx_committable_count <= skip)
+		count = 0;
+	else if (cont->vc_dtx_committable_count - skip > max)
 		count = max;
 	else
-		count = cont->vc_dtx_committable_count;
+		count = cont->vc_dtx_committable_count - skip;
 
 	if (count == 0) {
 		*dtes = NULL;
@@ -456,6 +461,11 @@ vos_dtx_fetch_committable(daos_handle_t coh, int max, struct dtx_entry **dtes)
 
 	d_list_for_each_entry(dcrc, &cont->vc_dtx_committable,
 			      dcrc_committable) {
+		if (skip > 0) {
+			skip--;
+			continue;
+		}
+
 		dte[i].dte_xid = dcrc->dcrc_dti;
 		dte[i].dte_oid = dcrc->dcrc_ptr->dcr_oid;
 
@@ -503,6 +513,7 @@ vos_dtx_del_cos(struct vos_container *cont, daos_unit_oid_t *oid,
 			DP_DTI(&dcrc->dcrc_dti), (unsigned long long)dkey_hash,
 			punch ? "Punch" : "Update");
 
+		vos_dtx_hash_set_committable(cont, xid, false);
 		d_list_del(&dcrc->dcrc_committable);
 		d_list_del(&dcrc->dcrc_link);
 		D_FREE_PTR(dcrc);
@@ -532,3 +543,13 @@ vos_dtx_cos_oldest(struct vos_container *cont)
 			    struct dtx_cos_rec_child, dcrc_committable);
 	return dcrc->dcrc_time;
 }
+
+void
+vos_dtx_cos_hash_fill(struct vos_container *cont)
+{
+	struct dtx_cos_rec_child	*dcrc;
+
+	d_list_for_each_entry(dcrc, &cont->vc_dtx_committable,
+			      dcrc_committable)
+		vos_dtx_hash_set_committable(cont, &dcrc->dcrc_dti, true);
+}
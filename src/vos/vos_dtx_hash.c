@@ -0,0 +1,439 @@
+/**
+ * (C) Copyright 2019 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * GOVERNMENT LICENSE RIGHTS-OPEN SOURCE SOFTWARE
+ * The Government's rights to use, modify, reproduce, release, perform, display,
+ * or disclose this software are subject to the terms of the Apache License as
+ * provided in Contract No. B609815.
+ * Any reproduction of computer software, computer software documentation, or
+ * portions thereof marked with this legend must also reproduce the markings.
+ */
+/**
+ * This file is part of daos two-phase commit transaction.
+ *
+ * The volatile hash table for the DTXs of the container, it answers the
+ * DTX state queries without walking the DTX tables in SCM.
+ *
+ * vos/vos_dtx_hash.c
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include <daos/btree.h>
+#include <daos_srv/vos.h>
+#include "vos_layout.h"
+#include "vos_internal.h"
+
+#define VOS_DTX_HASH_BITS_INIT		10
+#define VOS_DTX_HASH_BITS_MAX		20
+#define VOS_DTX_HASH_SEED		5731
+
+static inline uint32_t
+dtx_hash_mask(struct vos_dtx_hash *dh)
+{
+	return (1U << dh->dh_bits) - 1;
+}
+
+static inline uint32_t
+dtx_hash_home(struct vos_dtx_hash *dh, struct dtx_id *xid)
+{
+	return d_hash_murmur64((unsigned char *)xid, sizeof(*xid),
+			       VOS_DTX_HASH_SEED) & dtx_hash_mask(dh);
+}
+
+/* Return the slot for the given DTX, or the empty slot to hold it. */
+static struct vos_dtx_hent *
+dtx_hash_probe(struct vos_dtx_hash *dh, struct dtx_id *xid)
+{
+	struct vos_dtx_hent	*hent;
+	uint32_t		 mask = dtx_hash_mask(dh);
+	uint32_t		 i;
+
+	for (i = dtx_hash_home(dh, xid); ; i = (i + 1) & mask) {
+		hent = &dh->dh_ents[i];
+		if (hent->he_state == 0 ||
+		    memcmp(&hent->he_xid, xid, sizeof(*xid)) == 0)
+			return hent;
+	}
+}
+
+/* Backward shift deletion, no tombstone is left behind. */
+static void
+dtx_hash_remove(struct vos_dtx_hash *dh, struct vos_dtx_hent *hent)
+{
+	uint32_t	mask = dtx_hash_mask(dh);
+	uint32_t	i = hent - dh->dh_ents;
+	uint32_t	j = i;
+	uint32_t	k;
+
+	if (hent->he_state == DTX_ST_COMMITTED)
+		dh->dh_committed--;
+	dh->dh_count--;
+
+	while (1) {
+		j = (j + 1) & mask;
+		if (dh->dh_ents[j].he_state == 0)
+			break;
+
+		/* Keep it if its home slot is cyclically in (i, j]. */
+		k = dtx_hash_home(dh, &dh->dh_ents[j].he_xid);
+		if (i < j ? (i < k && k <= j) : (i < k || k <= j))
+			continue;
+
+		dh->dh_ents[i] = dh->dh_ents[j];
+		i = j;
+	}
+
+	memset(&dh->dh_ents[i], 0, sizeof(dh->dh_ents[i]));
+}
+
+static int
+dtx_hash_resize(struct vos_dtx_hash *dh, uint32_t bits)
+{
+	struct vos_dtx_hent	*old = dh->dh_ents;
+	uint32_t		 old_nr = old != NULL ? 1U << dh->dh_bits : 0;
+	uint32_t		 i;
+
+	if (bits > VOS_DTX_HASH_BITS_MAX)
+		return -DER_NOSPACE;
+
+	D_ALLOC_ARRAY(dh->dh_ents, 1U << bits);
+	if (dh->dh_ents == NULL) {
+		dh->dh_ents = old;
+		return -DER_NOMEM;
+	}
+
+	dh->dh_bits = bits;
+	for (i = 0; i < old_nr; i++) {
+		if (old[i].he_state != 0)
+			*dtx_hash_probe(dh, &old[i].he_xid) = old[i];
+	}
+
+	D_FREE(old);
+	return 0;
+}
+
+static void
+dtx_hash_disable(struct vos_container *cont, int rc)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+
+	D_WARN("Disable DTX hash table for container "DF_UUID": rc = %d\n",
+	       DP_UUID(cont->vc_id), rc);
+
+	D_FREE(dh->dh_ents);
+	dh->dh_ents = NULL;
+	dh->dh_count = 0;
+	dh->dh_committed = 0;
+	dh->dh_valid = 0;
+	dh->dh_disabled = 1;
+}
+
+/* Evict one committed DTX, then the committed DTX table has to be looked up
+ * for the DTX that is not in the hash table.
+ */
+static void
+dtx_hash_evict(struct vos_dtx_hash *dh)
+{
+	uint32_t	mask = dtx_hash_mask(dh);
+
+	D_ASSERT(dh->dh_committed > 0);
+
+	while (1) {
+		dh->dh_hand = (dh->dh_hand + 1) & mask;
+		if (dh->dh_ents[dh->dh_hand].he_state == DTX_ST_COMMITTED)
+			break;
+	}
+
+	dtx_hash_remove(dh, &dh->dh_ents[dh->dh_hand]);
+}
+
+static int
+dtx_hash_add(struct vos_dtx_hash *dh, struct dtx_id *xid, umem_off_t umoff,
+	     uint32_t state)
+{
+	struct vos_dtx_hent	*hent;
+	int			 rc;
+
+	if (state == DTX_ST_COMMITTED &&
+	    dh->dh_committed >= VOS_DTX_HASH_COMMITTED_MAX)
+		dtx_hash_evict(dh);
+
+	/* Keep the load factor under 3/4. */
+	if ((dh->dh_count + 1) * 4 > (3U << dh->dh_bits)) {
+		rc = dtx_hash_resize(dh, dh->dh_bits + 1);
+		if (rc != 0)
+			return rc;
+	}
+
+	hent = dtx_hash_probe(dh, xid);
+	if (hent->he_state == 0) {
+		hent->he_xid = *xid;
+		dh->dh_count++;
+	} else if (hent->he_state == DTX_ST_COMMITTED) {
+		dh->dh_committed--;
+	}
+
+	hent->he_umoff = umoff;
+	hent->he_state = state;
+	hent->he_committable = 0;
+	if (state == DTX_ST_COMMITTED)
+		dh->dh_committed++;
+
+	return 0;
+}
+
+struct dtx_hash_build_args {
+	struct vos_container	*cont;
+	struct vos_dtx_hash	*dh;
+};
+
+static int
+dtx_hash_build_active(daos_handle_t ih, d_iov_t *key, d_iov_t *val, void *arg)
+{
+	struct dtx_hash_build_args	*args = arg;
+	struct vos_dtx_entry_df		*dtx = val->iov_buf;
+
+	return dtx_hash_add(args->dh, &dtx->te_xid,
+			    umem_ptr2off(&args->cont->vc_pool->vp_umm, dtx),
+			    DTX_ST_PREPARED);
+}
+
+static int
+dtx_hash_build(struct vos_container *cont)
+{
+	struct vos_dtx_hash		*dh = &cont->vc_dtx_hash;
+	struct umem_instance		*umm = &cont->vc_pool->vp_umm;
+	struct vos_dtx_table_df		*tab;
+	struct dtx_hash_build_args	 args;
+	struct vos_dtx_entry_df		*dtx;
+	umem_off_t			 umoff;
+	int				 rc;
+
+	if (dh->dh_ents != NULL)
+		memset(dh->dh_ents, 0, sizeof(*dh->dh_ents) << dh->dh_bits);
+	else
+		dh->dh_bits = 0;
+
+	dh->dh_count = 0;
+	dh->dh_committed = 0;
+	dh->dh_hand = 0;
+
+	if (dh->dh_bits < VOS_DTX_HASH_BITS_INIT) {
+		rc = dtx_hash_resize(dh, VOS_DTX_HASH_BITS_INIT);
+		if (rc != 0)
+			return rc;
+	}
+
+	args.cont = cont;
+	args.dh = dh;
+	rc = dbtree_iterate(cont->vc_dtx_active_hdl, DAOS_INTENT_DEFAULT, false,
+			    dtx_hash_build_active, &args);
+	if (rc != 0)
+		return rc;
+
+	/* The committed DTXs are in time order, cache the newest ones. */
+	tab = &cont->vc_cont_df->cd_dtx_table_df;
+	for (umoff = tab->tt_entry_tail;
+	     !dtx_is_null(umoff) &&
+	     dh->dh_committed < VOS_DTX_HASH_COMMITTED_MAX;
+	     umoff = dtx->te_prev) {
+		dtx = umem_off2ptr(umm, umoff);
+		rc = dtx_hash_add(dh, &dtx->te_xid, UMOFF_NULL,
+				  DTX_ST_COMMITTED);
+		if (rc != 0)
+			return rc;
+	}
+
+	vos_dtx_cos_hash_fill(cont);
+	return 0;
+}
+
+void
+vos_dtx_hash_init(struct vos_container *cont)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	int			 rc;
+
+	memset(dh, 0, sizeof(*dh));
+	rc = dtx_hash_build(cont);
+	if (rc != 0)
+		dtx_hash_disable(cont, rc);
+	else
+		dh->dh_valid = 1;
+}
+
+void
+vos_dtx_hash_fini(struct vos_container *cont)
+{
+	D_FREE(cont->vc_dtx_hash.dh_ents);
+	memset(&cont->vc_dtx_hash, 0, sizeof(cont->vc_dtx_hash));
+}
+
+void
+vos_dtx_hash_invalidate(struct vos_container *cont)
+{
+	cont->vc_dtx_hash.dh_valid = 0;
+}
+
+int
+vos_dtx_hash_lookup(struct vos_container *cont, struct dtx_id *xid,
+		    struct vos_dtx_hent **hentp)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	struct vos_dtx_hent	*hent;
+
+	if (dh->dh_disabled || !dh->dh_valid)
+		return VOS_DTX_HASH_UNKNOWN;
+
+	hent = dtx_hash_probe(dh, xid);
+	switch (hent->he_state) {
+	case DTX_ST_PREPARED:
+		*hentp = hent;
+		return VOS_DTX_HASH_ACTIVE;
+	case DTX_ST_COMMITTED:
+		return VOS_DTX_HASH_COMMITTED;
+	default:
+		break;
+	}
+
+	/* Some committed DTXs have been evicted and not aggregated yet. */
+	if (dh->dh_committed < cont->vc_cont_df->cd_dtx_table_df.tt_count)
+		return VOS_DTX_HASH_INACTIVE;
+
+	return VOS_DTX_HASH_NONEXIST;
+}
+
+int
+vos_dtx_hash_find(struct vos_container *cont, struct dtx_id *xid,
+		  struct vos_dtx_hent **hentp)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	int			 rc;
+
+	if (!dh->dh_disabled && !dh->dh_valid) {
+		rc = dtx_hash_build(cont);
+		if (rc != 0) {
+			dtx_hash_disable(cont, rc);
+			return VOS_DTX_HASH_UNKNOWN;
+		}
+		dh->dh_valid = 1;
+	}
+
+	return vos_dtx_hash_lookup(cont, xid, hentp);
+}
+
+static void
+dtx_hash_abort_cb(void *data, bool noop)
+{
+	struct vos_container	*cont = data;
+
+	cont->vc_dtx_hash.dh_guarded = 0;
+	/* The DTX tables are rolled back, so rebuild the hash table. */
+	if (!noop)
+		vos_dtx_hash_invalidate(cont);
+}
+
+/* Invalidate the hash table if current PMDK transaction is aborted. The
+ * caller's transaction is started with vos_txd_get(). Only register the
+ * callback once per transaction, it is always triggered when the transaction
+ * ends (with noop for commit).
+ */
+static void
+dtx_hash_guard(struct vos_container *cont)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	int			 rc;
+
+	if (dh->dh_guarded)
+		return;
+
+	dh->dh_guarded = 1;
+	rc = umem_tx_add_callback(&cont->vc_pool->vp_umm, vos_txd_get(),
+				  TX_STAGE_ONABORT, dtx_hash_abort_cb, cont);
+	if (rc != 0) {
+		dh->dh_guarded = 0;
+		dtx_hash_disable(cont, rc);
+	}
+}
+
+void
+vos_dtx_hash_insert(struct vos_container *cont, struct dtx_id *xid,
+		    umem_off_t umoff)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	int			 rc;
+
+	if (dh->dh_disabled)
+		return;
+
+	dtx_hash_guard(cont);
+	if (!dh->dh_valid)
+		return;
+
+	rc = dtx_hash_add(dh, xid, umoff, DTX_ST_PREPARED);
+	if (rc != 0)
+		dtx_hash_disable(cont, rc);
+}
+
+void
+vos_dtx_hash_commit(struct vos_container *cont, struct dtx_id *xid)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	int			 rc;
+
+	if (dh->dh_disabled)
+		return;
+
+	dtx_hash_guard(cont);
+	if (!dh->dh_valid)
+		return;
+
+	rc = dtx_hash_add(dh, xid, UMOFF_NULL, DTX_ST_COMMITTED);
+	if (rc != 0)
+		dtx_hash_disable(cont, rc);
+}
+
+void
+vos_dtx_hash_delete(struct vos_container *cont, struct dtx_id *xid)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	struct vos_dtx_hent	*hent;
+
+	if (dh->dh_disabled)
+		return;
+
+	dtx_hash_guard(cont);
+	if (!dh->dh_valid)
+		return;
+
+	hent = dtx_hash_probe(dh, xid);
+	if (hent->he_state != 0)
+		dtx_hash_remove(dh, hent);
+}
+
+void
+vos_dtx_hash_set_committable(struct vos_container *cont, struct dtx_id *xid,
+			     bool committable)
+{
+	struct vos_dtx_hash	*dh = &cont->vc_dtx_hash;
+	struct vos_dtx_hent	*hent;
+
+	if (dh->dh_ents == NULL)
+		return;
+
+	hent = dtx_hash_probe(dh, xid);
+	if (hent->he_state == DTX_ST_PREPARED)
+		hent->he_committable = committable ? 1 : 0;
+}
@@ -174,6 +174,8 @@ dtx_iter_delete(struct vos_iterator *iter, void *args)
 		return rc;
 
 	rc = dbtree_iter_delete(oiter->oit_hdl, args);
+	/* The deleted DTX is unknown, let's rebuild the DTX hash table. */
+	vos_dtx_hash_invalidate(oiter->oit_cont);
 	if (rc != 0) {
 		umem_tx_abort(umm, rc);
 		D_ERROR("Failed to delete DTX entry: rc = %d\n", rc);
@@ -103,6 +103,49 @@ struct vos_pool {
 	struct vea_space_info	*vp_vea_info;
 };
 
+/**
+ * Slot of the DTX hash table, an empty slot has zero he_state.
+ */
+struct vos_dtx_hent {
+	/** The DTX identifier. */
+	struct dtx_id		he_xid;
+	/** The DTX entry in SCM, only valid for active DTX. */
+	umem_off_t		he_umoff;
+	/** DTX_ST_PREPARED for active DTX, or DTX_ST_COMMITTED. */
+	uint32_t		he_state;
+	/** The active DTX is committable, i.e. it is in the CoS cache. */
+	uint32_t		he_committable;
+};
+
+/** The max count of committed DTXs cached in the DTX hash table. */
+#define VOS_DTX_HASH_COMMITTED_MAX	(1 << 14)
+
+/**
+ * Volatile open-addressing (linear probing) hash table for the DTXs of the
+ * container. It always contains all the active DTXs, and caches up to
+ * VOS_DTX_HASH_COMMITTED_MAX committed ones. It is rebuilt from the DTX
+ * tables on container open, or after a PMDK transaction that modified the
+ * DTX tables is aborted. All the committed DTXs are in the table as long as
+ * dh_committed equals to the count of the committed DTX table.
+ */
+struct vos_dtx_hash {
+	struct vos_dtx_hent	*dh_ents;
+	/** The table size is (1 << dh_bits). */
+	uint32_t		 dh_bits;
+	/** The count of used slots. */
+	uint32_t		 dh_count;
+	/** The count of committed DTXs in the table. */
+	uint32_t		 dh_committed;
+	/** Eviction clock hand for the committed DTXs. */
+	uint32_t		 dh_hand;
+	/** The table matches the DTX tables. */
+	unsigned int		 dh_valid:1,
+	/** The abort callback is registered for current transaction. */
+				 dh_guarded:1,
+	/** Failed to build the table, always use the DTX tables. */
+				 dh_disabled:1;
+};
+
 /**
  * VOS container (DRAM)
  */
@@ -127,6 +170,8 @@ struct vos_container {
 	d_list_t		vc_dtx_committable;
 	/* The count of commiitable DTXs. */
 	uint32_t		vc_dtx_committable_count;
+	/* The hash table for the active and recently committed DTXs. */
+	struct vos_dtx_hash	vc_dtx_hash;
 	/* Direct pointer to VOS object index
 	 * within container
 	 */
@@ -143,6 +188,25 @@ struct vos_container {
 				vc_abort_aggregation:1;
 };
 
+/**
+ * Aggregation I/O budget of a VOS xstream, it's configured by environment
+ * variables VOS_AGG_BW (MB/s) and VOS_AGG_IOPS, zero means no limit.
+ */
+struct vos_agg_throttle {
+	/** Bandwidth budget in bytes per second */
+	uint64_t		at_bw;
+	/** IOPS budget */
+	uint64_t		at_iops;
+	/** Remaining budget, refilled according to elapsed time */
+	int64_t			at_bytes;
+	int64_t			at_ios;
+	/** Last refill time in microseconds */
+	uint64_t		at_refill;
+	/** For sleeping while the budget is exhausted, created on demand */
+	ABT_mutex		at_lock;
+	ABT_cond		at_cond;
+};
+
 struct vos_imem_strts {
 	/**
 	 * In-memory object cache for the PMEM
@@ -155,6 +219,8 @@ struct vos_imem_strts {
 	struct d_hash_table	*vis_cont_hhash;
 	int			vis_enable_checksum;
 	daos_csum_t		vis_checksum;
+	/** Aggregation I/O budget */
+	struct vos_agg_throttle	vis_agg_throttle;
 };
 /* in-memory structures standalone instance */
 struct vos_imem_strts		*vsa_imems_inst;
@@ -265,6 +331,16 @@ vos_cont_hhash_get(void)
 #endif
 }
 
+static inline struct vos_agg_throttle *
+vos_agg_throttle_get(void)
+{
+#ifdef VOS_STANDALONE
+	return &vsa_imems_inst->vis_agg_throttle;
+#else
+	return &vos_tls_get()->vtl_imems_inst.vis_agg_throttle;
+#endif
+}
+
 static inline struct umem_tx_stage_data *
 vos_txd_get(void)
 {
@@ -581,6 +657,111 @@ vos_dtx_del_cos(struct vos_container *cont, daos_unit_oid_t *oid,
 uint64_t
 vos_dtx_cos_oldest(struct vos_container *cont);
 
+/**
+ * Mark all the DTXs in the CoS cache as committable in the DTX hash table.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_cos_hash_fill(struct vos_container *cont);
+
+/** The result of vos_dtx_hash_find(). */
+enum vos_dtx_hash_result {
+	/** The hash table is not usable, look up the DTX tables. */
+	VOS_DTX_HASH_UNKNOWN,
+	/** The DTX is active. */
+	VOS_DTX_HASH_ACTIVE,
+	/** The DTX is committed. */
+	VOS_DTX_HASH_COMMITTED,
+	/** The DTX is not active, look up the committed DTX table. */
+	VOS_DTX_HASH_INACTIVE,
+	/** The DTX is neither active nor committed. */
+	VOS_DTX_HASH_NONEXIST,
+};
+
+/**
+ * Build the DTX hash table from the DTX tables, it is called when open
+ * the container. If it fails, the DTX tables will be used instead.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_hash_init(struct vos_container *cont);
+
+/**
+ * Release the DTX hash table.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_hash_fini(struct vos_container *cont);
+
+/**
+ * Mark the DTX hash table as stale, it will be rebuilt by the next find.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_hash_invalidate(struct vos_container *cont);
+
+/**
+ * Find the DTX in the DTX hash table.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ * \param xid	[IN]	Pointer to the DTX identifier.
+ * \param hentp	[OUT]	The slot for VOS_DTX_HASH_ACTIVE case.
+ *
+ * \return		See enum vos_dtx_hash_result.
+ */
+int
+vos_dtx_hash_find(struct vos_container *cont, struct dtx_id *xid,
+		  struct vos_dtx_hent **hentp);
+
+/**
+ * Find the DTX in the DTX hash table without rebuilding the stale table,
+ * it is used by the fetch/iterate path.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ * \param xid	[IN]	Pointer to the DTX identifier.
+ * \param hentp	[OUT]	The slot for VOS_DTX_HASH_ACTIVE case.
+ *
+ * \return		See enum vos_dtx_hash_result, VOS_DTX_HASH_UNKNOWN
+ *			if the table is stale.
+ */
+int
+vos_dtx_hash_lookup(struct vos_container *cont, struct dtx_id *xid,
+		    struct vos_dtx_hent **hentp);
+
+/**
+ * Add the new active DTX into the DTX hash table.
+ * The caller has started PMDK transaction.
+ */
+void
+vos_dtx_hash_insert(struct vos_container *cont, struct dtx_id *xid,
+		    umem_off_t umoff);
+
+/**
+ * Mark the DTX as committed in the DTX hash table.
+ * The caller has started PMDK transaction.
+ */
+void
+vos_dtx_hash_commit(struct vos_container *cont, struct dtx_id *xid);
+
+/**
+ * Remove the aborted or aggregated DTX from the DTX hash table.
+ * The caller has started PMDK transaction.
+ */
+void
+vos_dtx_hash_delete(struct vos_container *cont, struct dtx_id *xid);
+
+/**
+ * Mark the active DTX as committable or not when it is added into (or
+ * removed from) the CoS cache.
+ */
+void
+vos_dtx_hash_set_committable(struct vos_container *cont, struct dtx_id *xid,
+			     bool committable);
+
 enum vos_tree_class {
 	/** the first reserved tree class */
 	VOS_BTR_BEGIN		= DBTREE_VOS_BEGIN,
@@ -1024,6 +1205,14 @@ enum {
 	SUBTR_EVT	= (1 << 1),	/**< subtree is evtree */
 };
 
+/* vos_aggregate.c */
+/**
+ * Charge the aggregation I/O to the budget of current xstream, sleep if the
+ * budget is exhausted and set VOS_ITER_CB_YIELD in \a acts.
+ */
+void
+vos_agg_throttle(daos_size_t bytes, unsigned int ios, unsigned int *acts);
+
 /* vos_obj.c */
 int
 key_tree_prepare(struct vos_object *obj, daos_epoch_t epoch,
@@ -1098,7 +1287,7 @@ out:
 static inline int
 vos_tx_begin(struct vos_pool *vpool)
 {
-	return umem_tx_begin(&vpool->vp_umm, NULL);
+	return umem_tx_begin(&vpool->vp_umm, vos_txd_get());
 }
 
 static inline int
@@ -102,44 +102,49 @@ vos_ioc_reserve_fini(struct vos_io_context *ioc)
 	D_ASSERT(d_list_empty(&ioc->ic_blk_exts));
 	D_ASSERT(ioc->ic_actv_at == 0);
 
-	if (ioc->ic_actv_cnt != 0) {
-		D_FREE(ioc->ic_actv);
-		ioc->ic_actv = NULL;
-	}
-
-	if (ioc->ic_umoffs != NULL) {
-		D_FREE(ioc->ic_umoffs);
-		ioc->ic_umoffs = NULL;
-	}
+	/* The arrays are allocated along with the I/O context */
+	ioc->ic_actv = NULL;
+	ioc->ic_umoffs = NULL;
 }
 
-static int
-vos_ioc_reserve_init(struct vos_io_context *ioc)
+/**
+ * Size of the reserved SCM offsets and actions for the update, they are
+ * allocated along with the I/O context, so that a small update doesn't pay
+ * for separate allocations.
+ */
+static daos_size_t
+vos_ioc_reserve_size(struct vos_container *cont, bool update,
+		     unsigned int iod_nr, daos_iod_t *iods,
+		     unsigned int *total_acts)
 {
-	int			 i, total_acts = 0;
+	daos_size_t	size;
+	int		i;
 
-	if (!ioc->ic_update)
+	*total_acts = 0;
+	if (!update)
 		return 0;
 
-	for (i = 0; i < ioc->ic_iod_nr; i++) {
-		daos_iod_t *iod = &ioc->ic_iods[i];
+	for (i = 0; i < iod_nr; i++)
+		*total_acts += iods[i].iod_nr;
 
-		total_acts += iod->iod_nr;
-	}
+	size = *total_acts * sizeof(umem_off_t);
+	if (cont->vc_pool->vp_umm.umm_ops->mo_reserve != NULL)
+		size += *total_acts * sizeof(struct pobj_action);
+	return size;
+}
 
-	D_ALLOC_ARRAY(ioc->ic_umoffs, total_acts);
-	if (ioc->ic_umoffs == NULL)
-		return -DER_NOMEM;
+static void
+vos_ioc_reserve_init(struct vos_io_context *ioc, unsigned int total_acts)
+{
+	if (!ioc->ic_update)
+		return;
 
+	ioc->ic_umoffs = (umem_off_t *)(ioc + 1);
 	if (vos_ioc2umm(ioc)->umm_ops->mo_reserve == NULL)
-		return 0;
-
-	D_ALLOC_ARRAY(ioc->ic_actv, total_acts);
-	if (ioc->ic_actv == NULL)
-		return -DER_NOMEM;
+		return;
 
+	ioc->ic_actv = (struct pobj_action *)&ioc->ic_umoffs[total_acts];
 	ioc->ic_actv_cnt = total_acts;
-	return 0;
 }
 
 static void
@@ -161,12 +166,16 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 	       daos_epoch_t epoch, unsigned int iod_nr, daos_iod_t *iods,
 	       bool size_fetch, struct vos_io_context **ioc_pp)
 {
-	struct vos_container *cont;
+	struct vos_container *cont = vos_hdl2cont(coh);
 	struct vos_io_context *ioc;
 	struct bio_io_context *bioc;
+	unsigned int total_acts;
+	daos_size_t size;
 	int i, rc;
 
-	D_ALLOC_PTR(ioc);
+	size = vos_ioc_reserve_size(cont, !read_only, iod_nr, iods,
+				    &total_acts);
+	D_ALLOC(ioc, sizeof(*ioc) + size);
 	if (ioc == NULL)
 		return -DER_NOMEM;
 
@@ -174,7 +183,7 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 	ioc->ic_iods = iods;
 	ioc->ic_epoch = epoch;
 	ioc->ic_oid = oid;
-	ioc->ic_cont = vos_hdl2cont(coh);
+	ioc->ic_cont = cont;
 	vos_cont_addref(ioc->ic_cont);
 	ioc->ic_update = !read_only;
 	ioc->ic_size_fetch = size_fetch;
@@ -183,11 +192,7 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 	ioc->ic_umoffs_cnt = ioc->ic_umoffs_at = 0;
 	D_INIT_LIST_HEAD(&ioc->ic_blk_exts);
 
-	rc = vos_ioc_reserve_init(ioc);
-	if (rc != 0)
-		goto error;
-
-	cont = vos_hdl2cont(coh);
+	vos_ioc_reserve_init(ioc, total_acts);
 
 	bioc = cont->vc_pool->vp_io_ctxt;
 	D_ASSERT(bioc != NULL);
@@ -1063,8 +1068,64 @@ done:
 	return rc;
 }
 
+/*
+ * Reserve NVMe blocks for all the recxs of current iod by one
+ * vea_reserve_vec() call, the first reserved extent is returned in @ext_p.
+ */
 static int
-vos_reserve_recx(struct vos_io_context *ioc, uint16_t media, daos_size_t size)
+vos_reserve_recxs_nvme(struct vos_io_context *ioc,
+		       struct vea_resrvd_ext **ext_p)
+{
+	daos_iod_t		*iod = &ioc->ic_iods[ioc->ic_sgl_at];
+	struct vea_space_info	*vsi = ioc->ic_cont->vc_pool->vp_vea_info;
+	struct vea_hint_context	*hint_ctxt;
+	d_list_t		*tail = ioc->ic_blk_exts.prev;
+	uint32_t		 blk_cnts_inline[16];
+	uint32_t		*blk_cnts = blk_cnts_inline;
+	daos_size_t		 size;
+	unsigned int		 i, nr = 0;
+	int			 rc;
+
+	*ext_p = NULL;
+	if (vsi == NULL || iod->iod_nr < 2)
+		return 0;
+
+	/* Only allocate the block counts for the IOD of many recxs */
+	if (iod->iod_nr > ARRAY_SIZE(blk_cnts_inline)) {
+		D_ALLOC_ARRAY(blk_cnts, iod->iod_nr);
+		if (blk_cnts == NULL)
+			return -DER_NOMEM;
+	}
+
+	for (i = 0; i < iod->iod_nr; i++) {
+		size = iod->iod_recxs[i].rx_nr * iod->iod_size;
+		if (vos_media_select(ioc->ic_cont, iod->iod_type, size) !=
+		    DAOS_MEDIA_NVME)
+			continue;
+		blk_cnts[nr++] = vos_byte2blkcnt(size);
+	}
+
+	if (nr == 0) {
+		rc = 0;
+		goto out;
+	}
+
+	hint_ctxt = ioc->ic_cont->vc_hint_ctxt[VOS_IOS_GENERIC];
+	D_ASSERT(hint_ctxt);
+
+	rc = vea_reserve_vec(vsi, nr, blk_cnts, hint_ctxt, &ioc->ic_blk_exts);
+	if (rc == 0)
+		*ext_p = d_list_entry(tail->next, struct vea_resrvd_ext,
+				      vre_link);
+out:
+	if (blk_cnts != blk_cnts_inline)
+		D_FREE(blk_cnts);
+	return rc;
+}
+
+static int
+vos_reserve_recx(struct vos_io_context *ioc, uint16_t media, daos_size_t size,
+		 struct vea_resrvd_ext **nvme_ext)
 {
 	struct bio_iov	biov;
 	uint64_t	off = 0;
@@ -1079,6 +1140,25 @@ vos_reserve_recx(struct vos_io_context *ioc, uint16_t media, daos_size_t size)
 		goto done;
 	}
 
+	/* NVMe extent has been reserved by vos_reserve_recxs_nvme() */
+	if (media == DAOS_MEDIA_NVME && *nvme_ext != NULL) {
+		struct vea_resrvd_ext *ext = *nvme_ext;
+
+		D_ASSERTF(ext->vre_blk_cnt == vos_byte2blkcnt(size),
+			  "%u != %u\n", ext->vre_blk_cnt,
+			  vos_byte2blkcnt(size));
+		D_ASSERT(ext->vre_blk_off != 0);
+		off = ext->vre_blk_off << VOS_BLK_SHIFT;
+
+		if (ext->vre_link.next == &ioc->ic_blk_exts)
+			*nvme_ext = NULL;
+		else
+			*nvme_ext = d_list_entry(ext->vre_link.next,
+						 struct vea_resrvd_ext,
+						 vre_link);
+		goto done;
+	}
+
 	/*
 	 * TODO:
 	 * To eliminate internal fragmentaion, misaligned recx (total recx size
@@ -1118,6 +1198,7 @@ static int
 akey_update_begin(struct vos_io_context *ioc)
 {
 	daos_iod_t *iod = &ioc->ic_iods[ioc->ic_sgl_at];
+	struct vea_resrvd_ext *nvme_ext = NULL;
 	int i, rc;
 
 	if (iod->iod_type == DAOS_IOD_SINGLE && iod->iod_nr != 1) {
@@ -1125,6 +1206,12 @@ akey_update_begin(struct vos_io_context *ioc)
 		return -DER_IO_INVAL;
 	}
 
+	if (iod->iod_type == DAOS_IOD_ARRAY) {
+		rc = vos_reserve_recxs_nvme(ioc, &nvme_ext);
+		if (rc)
+			return rc;
+	}
+
 	for (i = 0; i < iod->iod_nr; i++) {
 		daos_size_t size;
 		uint16_t media;
@@ -1137,7 +1224,7 @@ akey_update_begin(struct vos_io_context *ioc)
 		if (iod->iod_type == DAOS_IOD_SINGLE)
 			rc = vos_reserve_single(ioc, media, size);
 		else
-			rc = vos_reserve_recx(ioc, media, size);
+			rc = vos_reserve_recx(ioc, media, size, &nvme_ext);
 		if (rc)
 			return rc;
 	}
@@ -38,6 +38,9 @@
 #include "vos_layout.h"
 
 #define LRU_CACHE_BITS 16
+/** Range of the object cache size, see VOS_OBJ_CACHE_BITS */
+#define LRU_CACHE_BITS_MIN	4
+#define LRU_CACHE_BITS_MAX	22
 
 /**
  * Reference of a cached object.